@@ -11,7 +11,9 @@
 //  the three files that touch them:
 //
 //    token_source.c  writes and reads the word class
-//    eval_expr.c     writes and reads the name binding
+//    eval_expr.c     writes and reads the name binding, and the variable
+//                    reference of a `:name`
+//    token_source.c  also writes and reads the value of a numeral
 //    procedures.c    drops every binding when the procedure table changes
 //
 //  memory.c deliberately knows none of this: it owns the storage, callers
@@ -21,12 +23,17 @@
 //      bit  5-6   binding kind   (0 = not yet resolved)
 //      bit  7-15  binding index  (0..511)
 //
+//  or, on a numeral,
+//
+//      bit  5-15  value + 1      (0 = not cached)
+//
 //  A memo of 0 therefore means "nothing known", which is what a freshly
 //  interned atom always reads back.
 //
 
 #pragma once
 
+#include <stdbool.h>
 #include <stdint.h>
 
 #ifdef __cplusplus
@@ -46,6 +53,22 @@ extern "C"
     #define ATOM_BIND_PROCEDURE    2u
     #define ATOM_BIND_NONE         3u
 
+    // A `:name` word is never called, so its binding bits are free to hold
+    // the variable reference instead (VarRef in variables.h): an input slot
+    // of the running procedure or a global table index. Meaningful only on a
+    // word of the colon class, and a hint either way -- var_get_ref checks it
+    // on each read.
+    #define ATOM_BIND_PARAM        1u
+    #define ATOM_BIND_GLOBAL       2u
+
+    // A numeral is never called or read as a variable either, so on a word of
+    // the number class the binding bits hold its value plus one, when that is
+    // a whole number below ATOM_MEMO_NUMBER_LIMIT: `88` or `360` is then read
+    // without parsing its characters. 0 is "not cached", as for a binding, so
+    // the sweep that drops bindings drops these too and they are re-read.
+    #define ATOM_MEMO_NUMBER_SHIFT 5
+    #define ATOM_MEMO_NUMBER_LIMIT 2047u
+
     #define ATOM_MEMO_BIND_SHIFT   5
     #define ATOM_MEMO_BIND_MASK    0x0060u
 
@@ -88,6 +111,28 @@ extern "C"
                           (uint16_t)(index << ATOM_MEMO_INDEX_SHIFT));
     }
 
+    // The cached value of a numeral, if any. A numeral's class is the
+    // caller's to check.
+    static inline bool atom_memo_number(uint16_t memo, float *out)
+    {
+        unsigned stored = (unsigned)(memo >> ATOM_MEMO_NUMBER_SHIFT);
+        if (stored == 0)
+            return false;
+        *out = (float)(stored - 1);
+        return true;
+    }
+
+    // `memo` with `value` cached, or unchanged if it is not a whole number
+    // the field can hold.
+    static inline uint16_t atom_memo_set_number(uint16_t memo, float value)
+    {
+        if (!(value >= 0.0f && value < (float)ATOM_MEMO_NUMBER_LIMIT) ||
+            value != (float)(unsigned)value)
+            return memo;
+        return (uint16_t)((memo & ATOM_MEMO_CLASS_MASK) |
+                          (((unsigned)value + 1u) << ATOM_MEMO_NUMBER_SHIFT));
+    }
+
 #ifdef __cplusplus
 }
 #endif
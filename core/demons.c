@@ -185,15 +185,17 @@ Result demons_poll(void)
     g_polling = true;
     uint32_t now = logo_io_ticks_ms(io);
 
-    // Advance autonomous motion and animation. The device owns positions;
-    // dt is the wall-clock elapsed since the previous tick.
+    // Advance autonomous motion and animation, the turtles' and the tiles'.
+    // The device owns positions; dt is the wall-clock elapsed since the
+    // previous tick.
+    uint32_t dt = g_have_ticked ? (now - g_last_tick_ms) : 0;
     const LogoConsoleTurtle *turtle =
         (io->console) ? io->console->turtle : NULL;
     if (turtle && turtle->turtle_tick)
     {
-        uint32_t dt = g_have_ticked ? (now - g_last_tick_ms) : 0;
         turtle->turtle_tick(dt);
     }
+    tiles_tick(dt);
     g_last_tick_ms = now;
     g_have_ticked = true;
 
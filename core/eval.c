@@ -13,7 +13,11 @@
 #include "repl.h"
 #include "frame.h"
 #include "demons.h"
+#include "profile.h"
+#include "variables.h"
+#include "properties.h"
 #include "httpd.h"
+#include "limits.h"
 #include "devices/io.h"
 #include <string.h>
 #include "hot.h"
@@ -21,8 +25,13 @@
 // Global operation stack (shared by all evaluators)
 OpStack global_op_stack;
 
+// Instructions left before the next poll (LOGO_POLL_INSTRUCTIONS). Zero
+// polls at the next instruction, which a new evaluator asks for.
+static uint16_t poll_countdown = 0;
+
 void eval_init(Evaluator *eval, Lexer *lexer)
 {
+    poll_countdown = 0;
     token_source_init_lexer(&eval->token_source, lexer);
     eval->frames = NULL;  // Caller sets this if needed
     eval->op_stack = &global_op_stack;
@@ -55,6 +64,69 @@ bool eval_in_procedure(Evaluator *eval)
     return eval->frames != NULL && !frame_stack_is_empty(eval->frames);
 }
 
+static void eval_mark_roots(Evaluator *eval)
+{
+    // Mark the workspace roots: variables, procedure bodies, property lists
+    var_gc_mark_all();
+    proc_gc_mark_all();
+    prop_gc_mark_all();
+
+    // Mark everything the live evaluation still references: procedure
+    // frames (parameters and locals), in-flight operations on the op stack
+    // (loop bodies, saved token positions, staged arguments), the token
+    // source we are currently reading from. Pending tail calls are covered by
+    // proc_gc_mark_all().
+    // Suspended parent evaluators (e.g. across a pause) are covered too:
+    // their state lives on the shared op stack.
+    frame_gc_mark_all(proc_get_frame_stack());
+    op_stack_gc_mark(eval->op_stack);
+    token_source_gc_mark(&eval->token_source);
+    token_source_gc_mark_code();
+    demons_gc_mark_all();
+    profile_gc_mark();
+}
+
+void eval_collect_garbage(Evaluator *eval)
+{
+    // A full collection supersedes any incremental cycle in flight
+    mem_gc_cancel_incremental();
+    eval_mark_roots(eval);
+
+    // Sweep unmarked nodes; C-stack values are held by transient root scopes
+    mem_gc_sweep();
+}
+
+bool eval_gc_step(Evaluator *eval, size_t budget)
+{
+    switch (mem_gc_phase())
+    {
+    case MEM_GC_IDLE:
+        if (!mem_gc_idle_wanted())
+            return false;
+        mem_gc_begin_incremental();
+        eval_mark_roots(eval);
+        return true;
+
+    case MEM_GC_MARK:
+        // Roots are not behind the write barrier, so shade them again before
+        // the marking is declared complete.
+        if (mem_gc_mark_step(budget))
+        {
+            eval_mark_roots(eval);
+            mem_gc_finish_marking();
+        }
+        return true;
+
+    case MEM_GC_SWEEP:
+        return !mem_gc_sweep_step(budget);
+    }
+    return false;
+}
+
+// Bumped on every primitive call, so a caller can tell whether the call it
+// made ran any other primitive before returning.
+static uint32_t prim_call_serial;
+
 Result LOGO_HOT(eval_call_primitive)(Evaluator *eval, const struct Primitive *prim,
                            int argc, Value *args)
 {
@@ -67,7 +139,37 @@ Result LOGO_HOT(eval_call_primitive)(Evaluator *eval, const struct Primitive *pr
     }
     MemGcRootScope scope;
     mem_gc_roots_push(&scope, roots, count);
+
+    // This is the collector's safe point: `recycle` itself runs from here, so
+    // everything live is already reachable from a root. Answer a request the
+    // allocators raised since the last sweep before the primitive allocates.
+    if (mem_gc_requested())
+        eval_collect_garbage(eval);
+
+    if (profile_running)
+        profile_enter(prim, prim->name);
+
+    uint32_t serial = ++prim_call_serial;
+    size_t failures = mem_alloc_failures();
     Result result = prim->func(eval, argc, args);
+
+    // A primitive registered as rerunnable only builds its output, so when it
+    // runs out of space without calling back into the evaluator it has
+    // changed nothing but its own unreachable allocations: collect and run it
+    // once more. Any other primitive may already have consumed input (readlist
+    // has read its line) or drawn, and one that re-entered may have run user
+    // code; those keep their error.
+    if (result.status == RESULT_ERROR && prim->rerunnable && serial == prim_call_serial &&
+        mem_alloc_failures() != failures &&
+        result_get_error_code(result) == ERR_OUT_OF_SPACE)
+    {
+        eval_collect_garbage(eval);
+        result = prim->func(eval, argc, args);
+    }
+
+    if (profile_running)
+        profile_exit(prim);
+
     mem_gc_roots_pop(&scope);
     return result;
 }
@@ -80,9 +182,10 @@ bool eval_at_end(Evaluator *eval)
 }
 
 
-Result LOGO_HOT(eval_instruction)(Evaluator *eval)
+// The poll point: Brk, F4 and F9, the HTTP pump, and `when` demons with
+// autonomous turtle motion. An error or throw unwinds like the instruction's.
+static Result eval_poll(void)
 {
-    // Check for user interrupt at the start of each instruction
     LogoIO *io = primitives_get_io();
     if (io && logo_io_check_user_interrupt(io))
     {
@@ -193,6 +296,26 @@ Result LOGO_HOT(eval_instruction)(Evaluator *eval)
         return demon_r;
     }
 
+    return result_none();
+}
+
+Result LOGO_HOT(eval_instruction)(Evaluator *eval)
+{
+    // Poll every LOGO_POLL_INSTRUCTIONS instructions, not every one
+    if (poll_countdown == 0)
+    {
+        poll_countdown = LOGO_POLL_INSTRUCTIONS - 1;
+        Result poll_r = eval_poll();
+        if (poll_r.status != RESULT_NONE)
+        {
+            return poll_r;
+        }
+    }
+    else
+    {
+        poll_countdown--;
+    }
+
     if (eval_at_end(eval))
     {
         return result_none();
@@ -206,17 +329,121 @@ Result LOGO_HOT(eval_instruction)(Evaluator *eval)
 }
 
 
+// Threaded dispatch: each step jumps straight to the next op's handler
+// through a table of label addresses (a GCC and Clang extension), so every
+// handler ends in its own indirect branch instead of all sharing the one at
+// the top of a switch, and the switch's range check goes. It is off by
+// default: on the host it measured no faster than the switch, whose jump
+// table the compiler already builds, and user procedure calls ran ~5 %
+// slower. -DLOGO_THREADED_DISPATCH=1 selects it for a measurement on the
+// board, where there is no branch predictor for either to defeat.
+#ifndef LOGO_THREADED_DISPATCH
+#define LOGO_THREADED_DISPATCH 0
+#endif
+#if LOGO_THREADED_DISPATCH && !defined(__GNUC__)
+#error "LOGO_THREADED_DISPATCH needs GCC or Clang (labels as values)"
+#endif
+
+// After a step: an op that popped itself hands its result to its parent,
+// which is the next op to run unless the stack is back at base_depth.
+static inline void trampoline_settle(OpStack *stack, int base_depth,
+                                     int depth_before, Result r)
+{
+    int depth_after = op_stack_depth(stack);
+    if (depth_after < depth_before && depth_after > base_depth)
+    {
+        op_stack_peek(stack)->result = r;
+    }
+}
+
+// An op kind the trampoline does not know: fail the evaluation
+static Result trampoline_bad_op(Evaluator *eval, EvalOp *op)
+{
+    eval->token_source = op->saved_source;
+    op_stack_pop(eval->op_stack);
+    return result_error(ERR_STACK_OVERFLOW);
+}
+
 // Main trampoline dispatch loop.
 // Processes operations on the op stack until the stack returns to base_depth.
 Result LOGO_HOT(eval_trampoline)(Evaluator *eval, int base_depth)
 {
     OpStack *stack = eval->op_stack;
     Result r = result_none();
-
-    while (op_stack_depth(stack) > base_depth)
+    EvalOp *op;
+    int depth_before;
+
+#if LOGO_THREADED_DISPATCH
+    static const void *const handlers[] = {
+        [OP_RUN_LIST] = &&run_list,
+        [OP_RUN_LIST_EXPR] = &&run_list,
+        [OP_REPEAT] = &&repeat,
+        [OP_FOREVER] = &&forever,
+        [OP_IF] = &&if_op,
+        [OP_WHILE] = &&loop,
+        [OP_UNTIL] = &&loop,
+        [OP_DO_WHILE] = &&loop,
+        [OP_DO_UNTIL] = &&loop,
+        [OP_FOR] = &&for_op,
+        [OP_CATCH] = &&catch_op,
+        [OP_RUNRESULT] = &&runresult,
+        [OP_PROC_CALL] = &&proc_call,
+        [OP_EXPR_EVAL] = &&expr_eval,
+        [OP_PRIM_CALL] = &&prim_call,
+        [OP_PAREN_GROUP] = &&paren_group,
+    };
+
+#define TRAMPOLINE_NEXT()                                                   \
+    do                                                                      \
+    {                                                                       \
+        depth_before = op_stack_depth(stack);                               \
+        if (depth_before <= base_depth)                                     \
+            return r;                                                       \
+        op = op_stack_peek(stack);                                          \
+        if ((unsigned)op->kind >= sizeof(handlers) / sizeof(handlers[0]))   \
+            goto bad_op;                                                    \
+        goto *handlers[op->kind];                                           \
+    } while (0)
+#define TRAMPOLINE_STEP(step)                                               \
+    r = step(eval, op);                                                     \
+    trampoline_settle(stack, base_depth, depth_before, r);                  \
+    TRAMPOLINE_NEXT()
+
+    TRAMPOLINE_NEXT();
+
+run_list:
+    TRAMPOLINE_STEP(step_run_list);
+if_op:
+    TRAMPOLINE_STEP(step_if);
+repeat:
+    TRAMPOLINE_STEP(step_repeat);
+forever:
+    TRAMPOLINE_STEP(step_forever);
+loop:
+    TRAMPOLINE_STEP(step_loop);
+catch_op:
+    TRAMPOLINE_STEP(step_catch);
+runresult:
+    TRAMPOLINE_STEP(step_runresult);
+for_op:
+    TRAMPOLINE_STEP(step_for);
+proc_call:
+    TRAMPOLINE_STEP(step_proc_call);
+expr_eval:
+    TRAMPOLINE_STEP(step_expr_eval);
+prim_call:
+    TRAMPOLINE_STEP(step_prim_call);
+paren_group:
+    TRAMPOLINE_STEP(step_paren_group);
+bad_op:
+    TRAMPOLINE_STEP(trampoline_bad_op);
+
+#undef TRAMPOLINE_STEP
+#undef TRAMPOLINE_NEXT
+#else
+    while ((depth_before = op_stack_depth(stack)) > base_depth)
     {
-        EvalOp *op = op_stack_peek(stack);
-        int depth_before = op_stack_depth(stack);
+        op = op_stack_peek(stack);
 
         switch (op->kind)
         {
@@ -273,29 +500,15 @@ Result LOGO_HOT(eval_trampoline)(Evaluator *eval, int base_depth)
             break;
 
         default:
-            r = result_error(ERR_STACK_OVERFLOW);
-            eval->token_source = op->saved_source;
-            op_stack_pop(stack);
+            r = trampoline_bad_op(eval, op);
             break;
         }
 
-        int depth_after = op_stack_depth(stack);
-
-        if (depth_after < depth_before)
-        {
-            // Op was popped by step function
-            if (depth_after > base_depth)
-            {
-                // Store result in parent op for inter-phase communication
-                EvalOp *parent = op_stack_peek(stack);
-                parent->result = r;
-            }
-            // If depth_after == base_depth, loop exits and we return r
-        }
-        // If depth_after >= depth_before: op continues or pushed child, loop back
+        trampoline_settle(stack, base_depth, depth_before, r);
     }
 
     return r;
+#endif
 }
 
 Result LOGO_HOT(eval_run_list)(Evaluator *eval, Node list)
@@ -109,8 +109,22 @@ extern "C"
     // Push an OP_PROC_CALL operation. Always uses sub-trampoline (synchronous).
     Result eval_push_proc_call(Evaluator *eval, struct UserProcedure *proc, int argc, Value *args);
 
+    // Run a full collection from the evaluator's roots (workspace, frames,
+    // op stack, token source, demons) plus the transient root scopes. Only
+    // safe where every live C-stack Node is in a scope; `recycle` and
+    // eval_call_primitive call it.
+    void eval_collect_garbage(Evaluator *eval);
+
+    // Do one bounded step of an incremental collection, starting a cycle if
+    // mem_gc_idle_wanted() says one is worth it. Only call at a primitive
+    // safe point. Returns true while there is more of the cycle to do.
+    bool eval_gc_step(Evaluator *eval, size_t budget);
+
     // Invoke a primitive while its word/list arguments are registered as
-    // transient GC roots.  Use this for every direct primitive call.
+    // transient GC roots.  Use this for every direct primitive call. Answers
+    // pending collection requests first, and retries a primitive that ran
+    // out of space once after collecting if it did not re-enter the
+    // evaluator.
     Result eval_call_primitive(Evaluator *eval, const struct Primitive *prim,
                                int argc, Value *args);
 
@@ -18,6 +18,11 @@
 #include <ctype.h>
 #include "hot.h"
 
+// A VarRef is stored in the memo's binding field as it is.
+_Static_assert(VAR_REF_PARAM == ATOM_BIND_PARAM && VAR_REF_GLOBAL == ATOM_BIND_GLOBAL &&
+               VAR_REF_NONE == ATOM_BIND_UNRESOLVED,
+               "VarRef kinds must match the atom memo's colon-word binding kinds");
+
 // Record a resolved binding on the atom, so the next lookup of this name is a
 // single read. An index that will not fit the memo field is simply not cached
 // (the tables are sized to fit, so this is belt and braces).
@@ -145,42 +150,6 @@ Result apply_binary_op(TokenType op_type, Value left, Value right)
     }
 }
 
-static float parse_number(const char *str, size_t len)
-{
-    // Create null-terminated copy for strtof
-    char buf[64];
-    if (len >= sizeof(buf))
-        len = sizeof(buf) - 1;
-    memcpy(buf, str, len);
-    buf[len] = '\0';
-
-    // Handle 'n' notation: 1n4 = 0.0001
-    char *n_pos = strchr(buf, 'n');
-    if (!n_pos)
-        n_pos = strchr(buf, 'N');
-
-    if (n_pos)
-    {
-        *n_pos = '\0';
-        float mantissa = strtof(buf, NULL);
-        // Parse exponent as digits-only non-negative integer
-        int exp = 0;
-        const char *p = n_pos + 1;
-        while (*p != '\0')
-        {
-            exp = exp * 10 + (*p - '0');
-            p++;
-        }
-        float result = mantissa;
-        for (int i = 0; i < exp; i++)
-        {
-            result /= 10.0f;
-        }
-        return result;
-    }
-    return strtof(buf, NULL);
-}
-
 // Parse a list from tokens until ].
 // Returns 0 on success (with *out receiving the parsed list), otherwise an
 // error code: ERR_OUT_OF_SPACE (node pool exhausted), ERR_UNCLOSED_BRACKET
@@ -272,14 +241,20 @@ Result LOGO_HOT(eval_primary)(Evaluator *eval)
     case TOKEN_NUMBER:
     {
         advance(eval);
-        return result_ok(value_number(parse_number(t.start, t.length)));
+        float n;
+        if (!token_source_number(&eval->token_source, t, &n))
+            n = number_from_text(t.start, t.length);
+        return result_ok(value_number(n));
     }
 
     case TOKEN_QUOTED:
     {
         advance(eval);
-        // Skip the quote character and process escape sequences
-        Node atom = mem_atom_unescape(t.start + 1, t.length - 1);
+        // Skip the quote character and process escape sequences, unless
+        // the compiled procedure code already did
+        Node atom = token_source_name(&eval->token_source, t);
+        if (mem_is_nil(atom))
+            atom = mem_atom_unescape(t.start + 1, t.length - 1);
         // `mem_atom_unescape` returns NODE_NIL for two reasons: the atom region
         // is full, or the unescaped word is longer than the 255 bytes an atom's
         // length prefix can describe. Both are "no room for this word", and
@@ -303,7 +278,9 @@ Result LOGO_HOT(eval_primary)(Evaluator *eval)
         // The token includes the colon, so skip it
         // Intern the name so the pointer persists for error messages
         // Process escape sequences in variable names
-        Node name_atom = mem_atom_unescape(t.start + 1, t.length - 1);
+        Node name_atom = token_source_name(&eval->token_source, t);
+        if (mem_is_nil(name_atom))
+            name_atom = mem_atom_unescape(t.start + 1, t.length - 1);
         const char *name = mem_word_ptr(name_atom);
         // The same failure the quoted case reports above, and the same crash
         // if it is not: on a full atom region the name interns to nothing,
@@ -316,8 +293,24 @@ Result LOGO_HOT(eval_primary)(Evaluator *eval)
             return result_error(ERR_OUT_OF_SPACE);
         }
 
+        // The `:name` atom remembers where its variable was found last time,
+        // an input slot or a global, so a repeat read goes straight there.
+        uint8_t *memo = NULL;
+        if (!mem_is_nil(t.atom))
+        {
+            const char *colon;
+            size_t colon_len;
+            mem_word_view(t.atom, &colon, &colon_len, &memo);
+        }
+        uint16_t word = mem_atom_memo_get(memo);
+        VarRef ref = {atom_memo_bind_kind(word), (uint16_t)atom_memo_bind_index(word)};
+        VarRef was = ref;
+
         Value v;
-        if (!var_get(name, &v))
+        bool found = var_get_ref(name, &ref, &v);
+        if (ref.kind != was.kind || ref.index != was.index)
+            mem_atom_memo_set(memo, atom_memo_set_binding(word, ref.kind, ref.index));
+        if (!found)
         {
             return result_error_arg(ERR_NO_VALUE, NULL, name);
         }
@@ -345,8 +338,28 @@ Result LOGO_HOT(eval_primary)(Evaluator *eval)
         }
         
         // For Lexer OR NodeIterator with flat [ ] tokens: parse tokens until ]
+        //
+        // Reading a literal only allocates, and nothing refers to the part
+        // read so far, so a literal that ran out of space is collected for
+        // and read again once -- eval_call_primitive's leaf retry. Without
+        // it a typed line with new words fails on a full atom region that a
+        // collection would have emptied.
+        TokenSource start = eval->token_source;
+        Lexer start_lexer;
+        if (start.type == TOKEN_SOURCE_LEXER)
+            start_lexer = *start.lexer;
+        size_t failures = mem_alloc_failures();
+
         Node list;
         int err = parse_list(eval, &list);
+        if (err == ERR_OUT_OF_SPACE && mem_alloc_failures() != failures)
+        {
+            eval->token_source = start;
+            if (start.type == TOKEN_SOURCE_LEXER)
+                *start.lexer = start_lexer;
+            eval_collect_garbage(eval);
+            err = parse_list(eval, &list);
+        }
         if (err != 0)
         {
             return result_error(err);
@@ -394,7 +407,8 @@ Result LOGO_HOT(eval_primary)(Evaluator *eval)
                             return result_set_error_proc(r, user_name);
                         }
                         
-                        // Continue with infix expression parsing
+                        // Continue with infix expression parsing. The left
+                        // operand stays rooted while the right one runs.
                         Result lhs = r;
                         while (true)
                         {
@@ -406,7 +420,11 @@ Result LOGO_HOT(eval_primary)(Evaluator *eval)
 
                             advance(eval);
 
+                            Node lhs_root = value_to_node(lhs.value);
+                            MemGcRootScope lhs_scope;
+                            mem_gc_roots_push(&lhs_scope, &lhs_root, 1);
                             Result rhs = eval_expr_bp(eval, op_bp + 1);
+                            mem_gc_roots_pop(&lhs_scope);
                             if (rhs.status != RESULT_OK)
                             {
                                 eval->paren_depth--;
@@ -433,9 +451,16 @@ Result LOGO_HOT(eval_primary)(Evaluator *eval)
                     // Otherwise fall through to normal greedy arg collection
                 }
                 
-                // Greedily collect all arguments until )
+                // Greedily collect all arguments until ). Collected values
+                // are rooted like the fixed-arity path: a later argument can
+                // run a primitive that collects.
                 Value args[MAX_PRIM_ARGS];
                 int argc = 0;
+                Node gc_roots[MAX_PRIM_ARGS + 1];
+                size_t gc_root_count = 1;
+                gc_roots[0] = user_name_atom;
+                MemGcRootScope gc_scope;
+                mem_gc_roots_push(&gc_scope, gc_roots, gc_root_count);
 
                 // Speculative OP_PRIM_CALL for deferred expression handling
                 EvalOp *prim_staging_paren = NULL;
@@ -445,6 +470,7 @@ Result LOGO_HOT(eval_primary)(Evaluator *eval)
                     prim_staging_paren = op_stack_push(eval->op_stack);
                     if (!prim_staging_paren)
                     {
+                        mem_gc_roots_pop(&gc_scope);
                         eval->paren_depth--;
                         return result_error(ERR_STACK_OVERFLOW);
                     }
@@ -458,6 +484,7 @@ Result LOGO_HOT(eval_primary)(Evaluator *eval)
                     if (prim_staging_paren->prim_call.arg_base < 0)
                     {
                         op_stack_pop(eval->op_stack);
+                        mem_gc_roots_pop(&gc_scope);
                         eval->paren_depth--;
                         return result_error(ERR_STACK_OVERFLOW);
                     }
@@ -491,6 +518,7 @@ Result LOGO_HOT(eval_primary)(Evaluator *eval)
                     {
                         Value *staged_args = op_stack_get_prim_args(eval->op_stack,
                             prim_staging_paren->prim_call.arg_base);
+                        mem_gc_roots_pop(&gc_scope);
                         if (!staged_args)
                         {
                             eval->primitive_arg_depth--;
@@ -509,6 +537,7 @@ Result LOGO_HOT(eval_primary)(Evaluator *eval)
                     if (arg.status == RESULT_ERROR)
                     {
                         if (prim_staging_paren) op_stack_pop(eval->op_stack);
+                        mem_gc_roots_pop(&gc_scope);
                         eval->primitive_arg_depth--;
                         eval->paren_depth--;
                         return result_set_error_proc(arg, user_name);
@@ -516,6 +545,11 @@ Result LOGO_HOT(eval_primary)(Evaluator *eval)
                     if (arg.status != RESULT_OK)
                         break;
                     args[argc++] = arg.value;
+                    if (arg.value.type == VALUE_WORD || arg.value.type == VALUE_LIST)
+                    {
+                        gc_roots[gc_root_count++] = arg.value.as.node;
+                        gc_scope.count = gc_root_count;
+                    }
                 }
                 
                 eval->primitive_arg_depth--;
@@ -534,6 +568,7 @@ Result LOGO_HOT(eval_primary)(Evaluator *eval)
                 
                 // Call primitive and set error_proc if needed
                 Result r = eval_call_primitive(eval, prim, argc, args);
+                mem_gc_roots_pop(&gc_scope);
                 return result_set_error_proc(r, user_name);
             }
         }
@@ -601,7 +636,7 @@ Result LOGO_HOT(eval_primary)(Evaluator *eval)
         if (is_number_string(t.start, t.length))
         {
             advance(eval);
-            return result_ok(value_number(parse_number(t.start, t.length)));
+            return result_ok(value_number(number_from_text(t.start, t.length)));
         }
 
         // Resolve the name once, from the atom's memo where there is one
@@ -923,7 +958,12 @@ Result LOGO_HOT(eval_primary)(Evaluator *eval)
 // eval_primary defers a user procedure call (pushes OP_PROC_CALL and returns
 // result_none()), we can save our state to OP_EXPR_EVAL on the op stack and
 // yield to the trampoline instead of blocking on the C stack.
-Result LOGO_HOT(eval_expr_bp)(Evaluator *eval, int min_bp)
+//
+// Pending left operands live only in this C frame until the expression either
+// finishes or parks itself on OP_EXPR_EVAL, so the caller keeps them rooted:
+// the right operand can call a primitive, and a primitive call can collect.
+static Result LOGO_HOT(expr_bp)(Evaluator *eval, int min_bp,
+                                MemGcRootScope *left_scope, Node *left_roots)
 {
     PendingBinOp op_stack[MAX_EXPR_OPS];
     int depth = 0;
@@ -964,6 +1004,7 @@ Result LOGO_HOT(eval_expr_bp)(Evaluator *eval, int min_bp)
         while ((bp == BP_NONE || bp < min_bp) && depth > 0)
         {
             depth--;
+            left_scope->count = (size_t)depth;
             Result r = apply_binary_op(op_stack[depth].op_type, op_stack[depth].left, lhs.value);
             if (r.status != RESULT_OK)
                 return r;
@@ -991,7 +1032,9 @@ Result LOGO_HOT(eval_expr_bp)(Evaluator *eval, int min_bp)
         op_stack[depth].left = lhs.value;
         op_stack[depth].op_type = (uint8_t)op_tok.type;
         op_stack[depth].min_bp = min_bp;
+        left_roots[depth] = value_to_node(lhs.value);
         depth++;
+        left_scope->count = (size_t)depth;
         min_bp = bp + 1;
 
         depth_before_primary = op_stack_depth(eval->op_stack);
@@ -1022,6 +1065,18 @@ Result LOGO_HOT(eval_expr_bp)(Evaluator *eval, int min_bp)
     return lhs;
 }
 
+Result LOGO_HOT(eval_expr_bp)(Evaluator *eval, int min_bp)
+{
+    // Only the filled prefix is scanned (expr_bp grows the count as it
+    // shifts), but start every slot as [] so no path can expose garbage
+    Node left_roots[MAX_EXPR_OPS] = {0};
+    MemGcRootScope left_scope;
+    mem_gc_roots_push(&left_scope, left_roots, 0);
+    Result r = expr_bp(eval, min_bp, &left_scope, left_roots);
+    mem_gc_roots_pop(&left_scope);
+    return r;
+}
+
 Result eval_expression(Evaluator *eval)
 {
     return eval_expr_bp(eval, BP_NONE);
@@ -14,6 +14,7 @@
 #include "format.h"
 #include "frame.h"
 #include "repl.h"
+#include "profile.h"
 #include "devices/io.h"
 #include <string.h>
 #include <stdlib.h>
@@ -702,7 +703,7 @@ Result step_runresult(Evaluator *eval, EvalOp *op)
             Node elem;
             if (child_r.value.type == VALUE_NUMBER)
             {
-                elem = number_to_word(child_r.value.as.number);
+                elem = number_to_element(child_r.value.as.number);
                 if (mem_is_nil(elem))
                     return result_error(ERR_OUT_OF_SPACE);
             }
@@ -832,6 +833,8 @@ static Result proc_call_cleanup(Evaluator *eval, EvalOp *op, Result body_result)
     }
 
     eval_trace_exit(eval, st->proc, body_result);
+    if (profile_running)
+        profile_exit(st->proc);
 
     eval->proc_depth--;
     proc_pop_current();
@@ -851,6 +854,11 @@ Result LOGO_HOT(step_proc_call)(Evaluator *eval, EvalOp *op)
 {
     ProcCallState *st = &op->proc_call;
 
+    // A self-recursive tail call restarts at phase 0 below, within this
+    // step, so phase 0 here is a new call
+    if (st->phase == 0 && profile_running)
+        profile_enter(st->proc, st->proc->name);
+
     if (st->phase >= 1)
     {
         // A body line completed
@@ -880,6 +888,8 @@ Result LOGO_HOT(step_proc_call)(Evaluator *eval, EvalOp *op)
                         st->tco_mode = tc->is_output_call ? TCO_MODE_OUTPUT
                                                           : TCO_MODE_BARE;
                     proc_clear_tail_call();
+                    if (profile_running)
+                        profile_count(st->proc);
 
                     proc_pop_current();
                     proc_push_current(st->proc->name);
@@ -890,6 +900,8 @@ Result LOGO_HOT(step_proc_call)(Evaluator *eval, EvalOp *op)
                         word_offset_t fo = frame_push(eval->frames, st->proc, args, argc);
                         if (fo == OFFSET_NONE)
                         {
+                            if (profile_running)
+                                profile_exit(st->proc);
                             eval->proc_depth--;
                             proc_pop_current();
                             op_stack_pop(eval->op_stack);
@@ -1070,7 +1082,7 @@ Result LOGO_HOT(step_proc_call)(Evaluator *eval, EvalOp *op)
         line_op->kind = OP_RUN_LIST;
         line_op->flags = is_last_line ? OP_FLAG_ENABLE_TCO : OP_FLAG_NONE;
         line_op->saved_source = eval->token_source;
-        token_source_init_list(&eval->token_source, line_tokens);
+        token_source_init_code(&eval->token_source, line_tokens);
         return result_none();
     }
 
@@ -1114,6 +1126,8 @@ Result LOGO_HOT(step_expr_eval)(Evaluator *eval, EvalOp *op)
     }
 
     // Resume the iterative Pratt parse with the proc call's return value.
+    // st->depth tracks the working depth throughout, so op_stack_gc_mark keeps
+    // seeing every pending left operand while the next primary runs.
     PendingBinOp local_ops[MAX_EXPR_OPS];
     int depth = st->depth;
     int min_bp = st->min_bp;
@@ -1129,6 +1143,7 @@ Result LOGO_HOT(step_expr_eval)(Evaluator *eval, EvalOp *op)
         while ((bp == BP_NONE || bp < min_bp) && depth > 0)
         {
             depth--;
+            st->depth = depth;
             Result r = apply_binary_op(local_ops[depth].op_type, local_ops[depth].left, lhs.value);
             if (r.status != RESULT_OK)
             {
@@ -1154,7 +1169,9 @@ Result LOGO_HOT(step_expr_eval)(Evaluator *eval, EvalOp *op)
         local_ops[depth].left = lhs.value;
         local_ops[depth].op_type = (uint8_t)op_tok.type;
         local_ops[depth].min_bp = min_bp;
+        st->ops[depth] = local_ops[depth];
         depth++;
+        st->depth = depth;
         min_bp = bp + 1;
 
         int depth_before_primary = op_stack_depth(eval->op_stack);
@@ -315,6 +315,12 @@ Node number_to_word(float n)
     return mem_atom_cstr(buf);
 }
 
+Node number_to_element(float n)
+{
+    Node box = mem_number(n);
+    return mem_is_nil(box) ? number_to_word(n) : box;
+}
+
 //==========================================================================
 // Parenthesis helpers
 //==========================================================================
@@ -808,7 +814,15 @@ bool format_list_contents(FormatOutputFunc out, void *ctx, Node node)
         }
         first = false;
 
-        if (mem_is_word(element))
+        if (mem_is_number(element))
+        {
+            // Printed straight from the float; no atom for its text.
+            char num_buf[32];
+            format_number(num_buf, sizeof(num_buf), mem_number_value(element));
+            if (!out(ctx, num_buf))
+                return false;
+        }
+        else if (mem_is_word(element))
         {
             if (!out(ctx, mem_word_ptr(element)))
                 return false;
@@ -115,4 +115,9 @@ int format_number(char *buf, size_t size, float n);
 // Returns a Node containing the formatted number as a word.
 Node number_to_word(float n);
 
+// Convert a number to the node a list stores for it: a number node
+// (mem_number) that keeps every bit of the float, or its word when the
+// pool cannot box it. NODE_NIL only if both fail.
+Node number_to_element(float n);
+
 #endif // LOGO_FORMAT_H
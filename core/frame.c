@@ -388,6 +388,29 @@ Binding *LOGO_HOT(frame_find_binding_in_chain)(FrameStack *stack, const char *na
     return NULL;
 }
 
+Binding *LOGO_HOT(frame_param_at)(FrameHeader *frame, int slot, const char *name)
+{
+    // Only a procedure whose inputs are distinct: with `to f :x :X` the first
+    // slot wins every lookup, and the second must never be read by slot.
+    if (frame == NULL || slot < 0 || slot >= frame->param_count ||
+        frame->proc == NULL || !frame->proc->distinct_params)
+    {
+        return NULL;
+    }
+    Binding *binding = &get_bindings_ptr(frame)[slot];
+    return binding->name == name ? binding : NULL;
+}
+
+int frame_param_slot(FrameHeader *frame, const Binding *binding)
+{
+    if (frame == NULL || binding == NULL)
+    {
+        return -1;
+    }
+    ptrdiff_t slot = binding - get_bindings_ptr(frame);
+    return (slot >= 0 && slot < frame->param_count) ? (int)slot : -1;
+}
+
 //==========================================================================
 // Local Variable Operations
 //==========================================================================
@@ -274,6 +274,18 @@ extern "C"
     Binding *frame_find_binding_in_chain(FrameStack *stack, const char *name,
                                          FrameHeader **found_frame);
 
+    // Parameter slots. A procedure's inputs are bound in order at the start
+    // of its frame, so a reference that found its name in parameter slot N
+    // can try slot N first next time (variables.c, var_get_slot).
+
+    // The binding in parameter slot `slot` of `frame` when that slot binds
+    // exactly the interned `name` and is the binding frame_find_binding
+    // would return. NULL otherwise, including for any out-of-range slot.
+    Binding *frame_param_at(FrameHeader *frame, int slot, const char *name);
+
+    // The parameter slot of a binding in `frame`, or -1 if it is a local.
+    int frame_param_slot(FrameHeader *frame, const Binding *binding);
+
     //==========================================================================
     // Local Variable Operations
     //==========================================================================
@@ -967,6 +967,9 @@ Result httpd_savebody(const char *path)
         if (!write_failed && remaining > 0) truncated = true;
     }
 
+    // The stream buffers writes: the last of them fail, if at all, here
+    logo_stream_flush(f);
+    if (f->write_error) write_failed = true;
     bool disk_full = f->disk_full;
     logo_io_close(io, path);
     if (write_failed) return result_error(disk_full ? ERR_DISK_FULL : ERR_DISK_TROUBLE);
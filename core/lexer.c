@@ -113,6 +113,14 @@ void lexer_init(Lexer *lexer, const char *source)
     lexer->had_newline = true;    // Start of input acts like start of line
     lexer->newline_count = 1;     // Start of input counts as one newline
     lexer->preserve_comments = false;
+    lexer->refill = NULL;
+    lexer->refill_context = NULL;
+}
+
+void lexer_set_refill(Lexer *lexer, LexerRefill refill, void *context)
+{
+    lexer->refill = refill;
+    lexer->refill_context = context;
 }
 
 void lexer_set_preserve_comments(Lexer *lexer, bool preserve)
@@ -156,6 +164,18 @@ static void skip_whitespace(Lexer *lexer)
             continue;
         }
 
+        // The end of a piece read a line at a time: move on to the next
+        if (*lexer->current == '\0' && lexer->refill != NULL)
+        {
+            const char *next = lexer->refill(lexer->refill_context);
+            if (next != NULL)
+            {
+                lexer->source = next;
+                lexer->current = next;
+                continue;
+            }
+        }
+
         break;
     }
 }
@@ -685,13 +705,16 @@ Token lexer_peek_token(Lexer *lexer)
     // Save state
     const char *saved_current = lexer->current;
     Token saved_previous = lexer->previous;
+    LexerRefill saved_refill = lexer->refill;
 
-    // Get next token
+    // Get next token, without moving on to another piece
+    lexer->refill = NULL;
     Token token = lexer_next_token(lexer);
 
     // Restore state
     lexer->current = saved_current;
     lexer->previous = saved_previous;
+    lexer->refill = saved_refill;
 
     return token;
 }
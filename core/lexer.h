@@ -66,6 +66,11 @@ extern "C"
         TokenType type;
     } Token;
 
+    // Supplies the next piece of a source read a line at a time: a string
+    // that starts with the newline ending the piece before, or NULL at the
+    // end of the source. See lexer_set_refill.
+    typedef const char *(*LexerRefill)(void *context);
+
     // Lexer state
     typedef struct
     {
@@ -76,6 +81,8 @@ extern "C"
         bool had_newline;    // Newline in whitespace before current token
         int newline_count;   // Number of newlines in whitespace (for empty line detection)
         bool preserve_comments; // If true, return comments instead of discarding them
+        LexerRefill refill;  // Next piece of the source, or NULL for one string
+        void *refill_context;
     } Lexer;
 
     // Initialize the lexer with source input
@@ -89,10 +96,19 @@ extern "C"
     // The default is false, so comments are ignored during normal evaluation.
     void lexer_set_preserve_comments(Lexer *lexer, bool preserve);
 
-    // Peek at the next token without consuming it
+    // Read the source a piece at a time. When the current piece runs out
+    // between tokens, `refill` is asked for the next, and lexing carries on
+    // as if the pieces were one string: newlines are counted across them and
+    // the previous token still decides what a `-` is. A token never spans
+    // two pieces, so a piece may be overwritten once the token read from it
+    // has been used. The loader (core/loader.c) feeds files this way.
+    void lexer_set_refill(Lexer *lexer, LexerRefill refill, void *context);
+
+    // Peek at the next token without consuming it. Never refills: the
+    // peeked token is EOF at the end of the current piece.
     Token lexer_peek_token(Lexer *lexer);
 
-    // Check if we've reached the end of input
+    // Check if we've reached the end of the current piece
     bool lexer_is_at_end(const Lexer *lexer);
 
     // Copy token text to a caller-provided buffer.
@@ -67,11 +67,103 @@ extern "C" {
 // affected).
 #define MAX_CURRENT_PROC_DEPTH 32
 
+// Compiled procedure code: ops (one per token of a compiled body line) in
+// the shared code arena. See "Compiled procedure code" in token_source.c.
+//
+// COST: an op is 16 bytes on the target, so this is 6 KB of .bss. Turtle
+// Trails compiles about 2,400 ops in its frame alone, which no board can
+// spare SRAM for; at this size, with cold runs evicted, half of its line
+// runs, 83% of Galaxian's and 93% of Space Invaders' are compiled (at 256
+// ops, with setup code left holding the arena, none were). 512 reaches 64%,
+// 94% and 100% for 4 KB more, which the Plus 2 W's heap cannot spare. The
+// host and tests presets set 4096 (CMake LOGO_CODE_OPS), where every shipped
+// game's frame fits.
+//
+// OVERFLOW: when a line does not fit, the runs that have gone cold give up
+// their ops to it (token_source.c); what still does not fit is walked as a
+// list, as every line was before.
+#ifndef LOGO_CODE_OPS
+#define LOGO_CODE_OPS 384
+#endif
+
+// Slots in the index from a body line (or a sublist of one) to its ops.
+// A power of two, kept at most three quarters full. 12 bytes each, 3 KB;
+// a run keeps its slot when it loses its ops, and with it how often it
+// runs, which is what stops a game's frame evicting its own lines. At 128
+// slots Trails' frame did not fit the index and recompiled some 50 lines a
+// frame. The host presets set 1024 (CMake LOGO_CODE_RUNS).
+//
+// OVERFLOW: a line that finds no slot takes one from a cold run with no
+// ops, or is not registered and runs as a list.
+#ifndef LOGO_CODE_RUNS
+#define LOGO_CODE_RUNS 256
+#endif
+
+// `.profile` table: one row per procedure or primitive called while the
+// profiler runs. A 100-procedure game calls some 40 primitives besides; the
+// table is hashed on the procedure or primitive pointer and is kept at most
+// three quarters full, so 256 rows hold 192 names. A power of two.
+//
+// COST: 24 bytes a row on the target, 6 KB of heap, taken by the first
+// `.profile "true` and kept. Nothing until then.
+//
+// OVERFLOW: calls of a name that finds no row are not recorded, and the
+// report ends with a row that counts them.
+#ifndef LOGO_PROFILE_ENTRIES
+#define LOGO_PROFILE_ENTRIES 256
+#endif
+
+// Calls the profiler can have open at once, for exclusive time. A game
+// frame nests a dozen deep; deep recursion is what reaches this.
+//
+// COST: 12 bytes a level, 768 bytes, in the same heap block as the table.
+//
+// OVERFLOW: calls deeper than this are counted but not timed.
+#ifndef LOGO_PROFILE_DEPTH
+#define LOGO_PROFILE_DEPTH 64
+#endif
+
 // Segregated free-list heads for reclaimed atom storage.  Atom entries are
 // four-byte aligned and max out at 260 bytes; the last bin also accepts larger
 // blocks produced by coalescing.
 #define LOGO_ATOM_FREE_LIST_COUNT 65
 
+// Free-arena headroom, in bytes, below which the allocators ask for a
+// collection. The request is only a flag: the evaluator answers it at its next
+// primitive call, the one point where every live Node is known to be rooted,
+// so collection happens a little before exhaustion instead of at it. 1 KB is
+// 256 cells -- more than one instruction of a game frame allocates -- and is
+// small beside a 128 KB arena. `mem_set_gc_headroom` changes it at run time.
+//
+// OVERFLOW: none. A collection that cannot restore the headroom stops
+// requesting more until the next one, so a nearly full workspace does not
+// collect on every call; a real allocation failure still asks for one.
+#define LOGO_GC_HEADROOM_BYTES 1024
+
+// Free arena, in bytes, below which `sync` starts an incremental collection in
+// a frame's idle slack. Set well above LOGO_GC_HEADROOM_BYTES so a cycle has
+// several frames to finish before the headroom forces a full one mid-frame;
+// 16 KB is an eighth of the default arena.
+//
+// OVERFLOW: none. A cycle that has not finished when headroom runs out is
+// abandoned for a full collection; nothing is lost but the work already done.
+#define LOGO_GC_IDLE_START_BYTES 16384
+
+// Grey-set capacity for incremental marking, in cell indices (2 bytes each).
+// Breadth matters here, not list length: scanning a cell greys at most its
+// car and cdr, so the set stays small unless one step leaves many branches
+// open.
+//
+// OVERFLOW: a cell that does not fit is marked with its whole subgraph at
+// once, like a full collection -- correct, but that step is not bounded.
+#define LOGO_GC_GREY_STACK_DEPTH 256
+
+// Cells of marking or sweeping per incremental step. `sync` checks the clock
+// between steps, so this bounds how far the last step can run past the frame
+// boundary. A cell visit is a bitmap test and a 32-bit load, so keep this a
+// small fraction of what a frame's slack can hold.
+#define LOGO_GC_STEP_CELLS 512
+
 // Number of turtles (sprites). All eight are full turtles with pens;
 // turtle 0 boots visible as the classic single turtle, 1-7 boot hidden
 // at home. Z-order in the compositor: lower number on top. Kept modest
@@ -82,12 +174,54 @@ extern "C" {
 // ERR_DOESNT_LIKE_INPUT.
 #define MAX_TURTLES 8
 
-// Maximum pen diameter, in pixels, for `setpensize`. The pen draws by
-// stamping a filled disc of this diameter at each line step, so the value is
-// a draw-time cap only (no persistent buffer). `setpensize` rounds its input
-// to an integer and clamps it to [1, MAX_PEN_SIZE].
+// Maximum pen diameter, in pixels, for `setpensize`. A wide line is the
+// union of discs of this diameter along its path, drawn a row at a time; the
+// rasteriser keeps the last MAX_PEN_SIZE + 1 path rows on its stack, so the
+// value is a draw-time cap only (no persistent buffer). `setpensize` rounds
+// its input to an integer and clamps it to [1, MAX_PEN_SIZE].
 #define MAX_PEN_SIZE 32
 
+// Span queue lent to `fill` on a board with an aux/PSRAM region. The device's
+// own queue is 1024 spans (8 KB of SRAM). A fill whose pending spans outgrow
+// its queue still completes, by sweeping the canvas for what it dropped, but
+// each sweep reads the whole screen; 8192 spans holds any shape measured in
+// the fill benchmark (tests/test_bench_fill.c) without one.
+//
+// PSRAM: 64 KB, one permanent block from the aux region. Negligible against
+// 8 MB. Boards without the region keep the SRAM queue.
+//
+// OVERFLOW: none; as above, overflow costs sweeps, not pixels.
+#define LOGO_FILL_STORE_SIZE (64 * 1024)
+
+// Maximum number of vertices one `filled` block records. Each turtle move
+// inside the block adds the turtle's new position; the polygon is filled
+// when the block ends. 256 covers a 360-step circle drawn in two-degree
+// steps and any hand-drawn shape with room to spare.
+//
+// COST: 8 bytes a vertex, grown on demand from the heap in 32-vertex steps
+// and freed when the outermost `filled` ends, so at most 2 KB and only while
+// a block runs.
+//
+// OVERFLOW: `filled` stops recording and fails with ERR_OUT_OF_SPACE when its
+// instructions finish; nothing is filled.
+#define LOGO_FILLED_VERTICES 256
+
+// Cell size, in screen pixels, of the uniform grid `touching.any?` drops the
+// visible turtles into before testing any masks. A turtle is only tested
+// against turtles that share a cell with it. 32 is the largest costume, so a
+// turtle covers at most 2x2 cells and the grid over a 320x320 screen is 10x10.
+//
+// COST: one bitmask of turtles per cell (4 bytes), built on the stack per
+// query over at most LOGO_COLLIDE_GRID_MAX cells a side: 1 KB. The packed
+// masks the narrow phase tests are kept per turtle in SRAM, one 32-bit word
+// a row (MAX_TURTLES x LOGO_RASTER_MAX words, 1 KB), and repacked only when
+// the device rebuilds a costume.
+//
+// OVERFLOW: a screen wider or taller than LOGO_COLLIDE_GRID_MAX cells folds
+// its far cells into the last one; that costs candidates, never contacts.
+#define LOGO_COLLIDE_CELL 32
+#define LOGO_COLLIDE_GRID_MAX 16
+
 // Maximum number of armed `when` demons. Each demon holds two node
 // references (a condition expression and an action list) plus a couple of
 // flag bytes, so the table costs ~100 B — see docs/multi-sprite-design.md
@@ -104,6 +238,20 @@ extern "C" {
 // polls/second) keeps demons responsive while leaving tight loops untaxed.
 #define DEMON_POLL_MS 20
 
+// Instructions between two visits to the poll point above: Brk, F4, F9, the
+// HTTP pump and the demon budget. Each visit reads the clock twice and calls
+// through the hardware table five times, which was a fixed tax on every
+// instruction of a tight loop. The first instruction of every line typed,
+// loaded or run by a new evaluator polls at once.
+//
+// COST: none in memory; Brk, a pause or a due demon waits for at most this
+// many instructions more.
+//
+// OVERFLOW: not applicable. 1 polls before every instruction, as before.
+#ifndef LOGO_POLL_INSTRUCTIONS
+#define LOGO_POLL_INSTRUCTIONS 16
+#endif
+
 // Maximum size, in bytes, of an HTTP request or response body for `http.get` /
 // `http.post`. The effective cap is chosen at runtime by the active transfer
 // buffer (see core/primitives_http.c):
@@ -221,6 +369,81 @@ extern "C" {
 // is 320 px wide; a wider viewport than this is clipped rather than an error.
 #define TILEMAP_ROW_MAX 320
 
+// Tile map layers, drawn bottom to top by the sampler: a base, a parallax
+// layer and an overlay, with one to spare. `setlayer` picks the one the map
+// primitives address.
+//
+// COST: 24 bytes of state a layer, plus 32 bytes a layer marking the tiles
+// that hold its transparent index. The cells of every layer come out of the
+// one map pool (TILE_MAP_SIZE), so layers cost no map memory of their own.
+// A row is one pass per layer that has a map.
+//
+// OVERFLOW: `setlayer` outside 1..TILEMAP_LAYERS is ERR_DOESNT_LIKE_INPUT, and
+// a `newmap` whose cells do not fit beside the other layers' is
+// ERR_OUT_OF_SPACE.
+#define TILEMAP_LAYERS 4
+
+// Animated tiles (`animtile`): how many bank slots can cycle at once, and how
+// many frames each cycles through. Water, torches and blinking items are a
+// handful of slots of two to four frames each.
+//
+// COST: a 256-byte table of the frame each slot shows, which the sampler
+// reads once per tile run, plus 20 bytes an animation. A tick is a
+// subtraction per animation; a frame change re-bakes only the on-screen
+// cells that name the slot.
+//
+// OVERFLOW: an `animtile` beyond TILEMAP_ANIMS animated slots is
+// ERR_OUT_OF_SPACE, and a frame list longer than TILEMAP_ANIM_FRAMES is
+// ERR_DOESNT_LIKE_INPUT.
+#define TILEMAP_ANIMS 16
+#define TILEMAP_ANIM_FRAMES 8
+
+// PicoCalc sprite masks kept as runs of opaque pixels (devices/picocalc/
+// screen.c), so a composited row copies or fills whole runs instead of
+// testing every mask pixel. A 64-row mask covers every shipped sprite, and
+// 256 runs is four a row at that height.
+//
+// COST: a mask's runs are a 644-byte table (an index per row plus two bytes a
+// run), one per sprite, so at SCREEN_MAX_SPRITES (8) this is 5 KB of .bss.
+//
+// OVERFLOW: a mask taller than LOGO_SPRITE_SPAN_ROWS, or with more runs than
+// LOGO_SPRITE_SPANS, is composed pixel by pixel instead -- slower, never
+// wrong.
+#define LOGO_SPRITE_SPAN_ROWS 64
+#define LOGO_SPRITE_SPANS 256
+
+// FAT32 sector cache (devices/picocalc/fat32.c): the LRU cache every sector
+// on the SD card goes through, and where writes wait until eviction, close or
+// fat32_flush(). FAT32_CACHE_SECTORS_PSRAM is used instead when the board
+// hands the driver a PSRAM buffer (the Pico Plus 2 W).
+//
+// COST: the SRAM tier is a static buffer of 8 512-byte sectors -- 4 KB of
+// .bss on every board, PSRAM or not -- plus 9 bytes of bookkeeping a slot,
+// sized for the larger tier. The PSRAM tier is 32 KB of the aux region.
+//
+// OVERFLOW: none; a full cache evicts its least recently used sector,
+// writing it back first if it is dirty.
+#ifndef FAT32_CACHE_SECTORS
+#define FAT32_CACHE_SECTORS (8)
+#endif
+#ifndef FAT32_CACHE_SECTORS_PSRAM
+#define FAT32_CACHE_SECTORS_PSRAM (64)
+#endif
+
+// FAT32 free-cluster map (devices/picocalc/fat32.c): one bit per group of FAT
+// sectors, clear where a search found the group full, so an allocation skips
+// full regions of the card without reading them. 8,192 bits is one FAT sector
+// a bit up to 32 GB of 32 KB clusters.
+//
+// COST: 1 KB of .bss, which with the sector cache above makes 5 KB of SRAM
+// for the SD card driver.
+//
+// OVERFLOW: none; a larger volume puts more FAT sectors behind each bit, so a
+// search reads a little more of a group that is not full.
+#ifndef FAT32_FREE_MAP_BYTES
+#define FAT32_FREE_MAP_BYTES (1024)
+#endif
+
 // Sound synthesizer (P8, docs/sound-design.md). The engine renders eight
 // voices: three tone plus one noise per stereo ear (the SN76489 layout,
 // doubled). Voices are numbered by ear: 0-2 tone + 3 noise (left),
@@ -0,0 +1,133 @@
+//
+//  Pico Logo
+//  Copyright 2026 Blair Leduc. See LICENSE for details.
+//
+//  The file loader behind `load`. See loader.h.
+//
+//  Each line is read into one buffer behind a newline, which the lexer
+//  counts as it would in a single string, so a body keeps its layout and
+//  `end` is recognised at the start of a line exactly as in the editor.
+//  Tokens are interned as they are read, so the buffer is free for the next
+//  line as soon as the lexer asks for it.
+//
+
+#include "loader.h"
+#include "error.h"
+#include "eval.h"
+#include "lexer.h"
+#include "memory.h"
+#include "procedures.h"
+#include <string.h>
+#include <strings.h>
+
+// Longest line read whole; a longer one is read as several
+#define LOADER_LINE_MAX 256
+
+typedef struct
+{
+    LoaderReadLine read_line;
+    void *context;
+    LoadStats *stats;
+    char buf[LOADER_LINE_MAX + 1];  // A newline, then the line
+} LoadSource;
+
+static const char *next_line(void *context)
+{
+    LoadSource *src = (LoadSource *)context;
+    int len = src->read_line(src->context, src->buf + 1, sizeof(src->buf) - 1);
+    if (len < 0)
+    {
+        return NULL;
+    }
+    while (len > 0 && (src->buf[len] == '\n' || src->buf[len] == '\r'))
+    {
+        src->buf[len--] = '\0';
+    }
+    src->stats->bytes += (uint32_t)len + 1;
+    src->stats->lines++;
+    src->buf[0] = '\n';
+    return src->buf;
+}
+
+// `to`, as the first word of a line
+static bool token_is_to(const Token *t)
+{
+    return t->type == TOKEN_WORD && t->length == 2 && strncasecmp(t->start, "to", 2) == 0;
+}
+
+// Run one line list at top level, instruction by instruction, as the REPL
+// would run the line. An expression's value is ignored, unlike at the REPL.
+static Result run_line(Node line, LoadStats *stats)
+{
+    Lexer none;
+    Evaluator eval;
+    lexer_init(&none, "");
+    eval_init(&eval, &none);
+    eval_set_frames(&eval, proc_get_frame_stack());
+    token_source_init_list(&eval.token_source, line);
+
+    // Nothing else holds the line while it runs
+    MemGcRootScope scope;
+    mem_gc_roots_push(&scope, &line, 1);
+
+    Result result = result_none();
+    while (!eval_at_end(&eval))
+    {
+        Result r = eval_instruction(&eval);
+        stats->instructions++;
+        if (r.status == RESULT_ERROR || r.status == RESULT_THROW)
+        {
+            result = r;
+            break;
+        }
+    }
+
+    mem_gc_roots_pop(&scope);
+    return result;
+}
+
+Result loader_run(LoaderReadLine read_line, void *context, LoadStats *stats)
+{
+    memset(stats, 0, sizeof(*stats));
+    size_t atoms_before = mem_atoms_interned();
+    size_t cells_before = mem_cells_allocated();
+
+    LoadSource src = {.read_line = read_line, .context = context, .stats = stats};
+    Lexer lexer;
+    lexer_init(&lexer, "");
+    lexer_set_refill(&lexer, next_line, &src);
+
+    Result result = result_none();
+    Token t = lexer_next_token(&lexer);
+    while (t.type != TOKEN_EOF && result.status == RESULT_NONE)
+    {
+        if (token_is_to(&t))
+        {
+            // Comments belong to the body, as the editor keeps them
+            lexer_set_preserve_comments(&lexer, true);
+            Result r = proc_define_from_lexer(&lexer, &t, true);
+            lexer_set_preserve_comments(&lexer, false);
+            if (r.status == RESULT_ERROR)
+            {
+                result = r;
+                break;
+            }
+            stats->procedures++;
+            if (t.type != TOKEN_EOF)
+            {
+                t = lexer_next_token(&lexer);  // Past the `end`
+            }
+            continue;
+        }
+
+        Node line = proc_parse_line(&lexer, &t);
+        if (!mem_is_nil(line))
+        {
+            result = run_line(line, stats);
+        }
+    }
+
+    stats->atoms = (uint32_t)(mem_atoms_interned() - atoms_before);
+    stats->cells = (uint32_t)(mem_cells_allocated() - cells_before);
+    return result;
+}
@@ -0,0 +1,47 @@
+//
+//  Pico Logo
+//  Copyright 2026 Blair Leduc. See LICENSE for details.
+//
+//  The file loader behind `load`: reads a source a line at a time through
+//  one lexer (lexer_set_refill), so each character is lexed once. A `to`
+//  definition is built straight into its body lists as its lines arrive,
+//  with no text buffer and so no limit on its size; any other instruction
+//  is built into a line list, which may run across lines inside brackets,
+//  and runs as soon as that line is complete.
+//
+
+#pragma once
+
+#include "value.h"
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+    // Reads the next line into `line` (at most `size` - 1 characters, NUL
+    // terminated, the line ending dropped or not). Returns its length, or -1
+    // at the end of the source.
+    typedef int (*LoaderReadLine)(void *context, char *line, size_t size);
+
+    // What a load did, for `.load.report` and logo-bench
+    typedef struct LoadStats
+    {
+        uint32_t bytes;         // Source read, a newline per line
+        uint32_t lines;
+        uint32_t procedures;    // Defined with `to`
+        uint32_t instructions;  // Run at top level
+        uint32_t atoms;         // Interned while loading
+        uint32_t cells;         // Allocated while loading
+        uint32_t us;            // Wall time; the caller owns the clock
+    } LoadStats;
+
+    // Load a source. Stops at the first error or throw and returns it;
+    // otherwise RESULT_NONE. Fills `stats` (except `us`) either way.
+    Result loader_run(LoaderReadLine read_line, void *context, LoadStats *stats);
+
+#ifdef __cplusplus
+}
+#endif
@@ -15,15 +15,18 @@
 //  - Words are references to interned atoms (never stored in pool)
 //  - Lists are references to cons cells in the pool
 //  - Word references in cells use high bit (0x8000) to distinguish from list indices
+//  - Numbers in lists are boxed in a cell of their own (mem_number)
 //  - Free nodes managed via free list (reuses cell storage)
 //  - Collision detection prevents atoms and nodes from overlapping
 //
 
 #include "core/memory.h"
+#include "core/format.h"
 #include "core/limits.h"
 
 #include <assert.h>
 #include <ctype.h>
+#include <math.h>
 #include <string.h>
 #include "hot.h"
 
@@ -48,6 +51,7 @@ _Static_assert(LOGO_MEMORY_SIZE % 4 == 0,
 //   reference == CELL_EMPTY_LIST    -> the empty list ([])
 //   (reference & CELL_WORD_MARKER)  -> word reference; low 15 bits are the
 //                                      atom offset within the atom table
+//     ... and (reference & 3) != 0  -> number reference (see below)
 //   otherwise                       -> list pool index in [1, MAX_LIST_INDEX]
 //
 // These markers must be kept in sync with mem_atom() (which caps atom
@@ -68,6 +72,18 @@ _Static_assert(LOGO_MEMORY_SIZE % 4 == 0,
 // sentinel and the word-reference marker bit).
 #define MAX_LIST_INDEX    0x7FFEu
 
+// Atom offsets are four-byte aligned, so a word reference's low two bits are
+// always zero. The other three values of those bits, with the 13 bits above
+// them (v), are numbers:
+//   low bits 3     -> the integer v - NUMBER_IMMEDIATE_BIAS, no cell at all
+//   low bits 1, 2  -> a box, pool index v * 2 + low bits
+// Boxes therefore reach pool indices 1..MAX_NUMBER_INDEX; mem_number refuses
+// a cell above it.
+#define CELL_NUMBER_BITS       0x0003u
+#define CELL_NUMBER_IMMEDIATE  0x0003u
+#define NUMBER_IMMEDIATE_BIAS  4096
+#define MAX_NUMBER_INDEX       16384u
+
 // Upper bound on the atom table size in bytes. Atom offsets must fit in
 // the 15-bit CELL_WORD_MASK so that a word reference fits in a 16-bit cell.
 #define LOGO_ATOM_LIMIT   ((size_t)CELL_WORD_MASK + 1u)  // 0x8000 = 32768
@@ -140,8 +156,48 @@ static uint16_t atom_free_lists[LOGO_ATOM_FREE_LIST_COUNT];
 // workspace, on the hot path it was added to serve. The free lists change in
 // exactly two places, so the count is cheap to keep exact.
 static size_t atom_free_bytes;
+
+// The text of the last number a reader asked for (number_text).
+static uint32_t number_text_bits;
+static uint16_t number_text_offset = ATOM_CHAIN_END;
+static char number_text_spill[4][32];
+static unsigned number_text_spill_next;
+
 static MemGcRootScope *gc_root_scopes;
 
+// Allocation-triggered collection. The allocators cannot collect themselves --
+// their callers hold Nodes in C locals nobody has rooted -- so they raise a
+// request and the evaluator answers it at its next safe point. The request is
+// raised by a failed allocation, or by one that leaves less free arena than
+// gc_headroom. gc_headroom_armed is cleared by a collection that could not
+// restore the headroom, so a full workspace does not collect on every call.
+static bool gc_requested;
+static bool gc_headroom_armed;
+static size_t gc_headroom;
+static size_t gc_count;
+static size_t alloc_failures;
+
+// Allocations handed out since logo_mem_init, live or not
+static size_t cells_allocated;
+static size_t atoms_interned;
+static size_t blobs_allocated;
+
+// Bit array for marking (1 bit per possible node)
+// Size based on maximum possible nodes (total memory / 4 bytes per node)
+static uint32_t gc_marks[(LOGO_MEMORY_SIZE / 4 + 31) / 32];
+
+// Incremental collection (see the Garbage Collection section). A set mark bit
+// is grey while the index is on gc_grey and black once it has been scanned.
+// While marking, new cells, atoms and blobs are allocated black and every
+// pointer written into a cell is shaded -- a Dijkstra insertion barrier -- so
+// nothing the program stores between steps can hide from the marker.
+static MemGcPhase gc_phase;
+static uint16_t gc_grey[LOGO_GC_GREY_STACK_DEPTH];
+static size_t gc_grey_top;
+static uint16_t gc_sweep_cursor;  // next cell the sweep phase looks at
+static uint16_t gc_sweep_limit;   // last cell it owns (highest live at finish)
+static size_t gc_idle_start;
+
 //==========================================================================
 // Blob Heap (auxiliary region, e.g. PSRAM)
 //==========================================================================
@@ -396,9 +452,8 @@ Node mem_newline_marker = NODE_NIL;
 Node mem_true_node = NODE_NIL;
 Node mem_false_node = NODE_NIL;
 
-// Initialize the memory system.
-// Must be called before any other memory functions.
-void logo_mem_init(void)
+// The empty arena: no atoms, no cells, no collection in progress.
+static void arena_reset(void)
 {
     // Initialize atom table (grows upward from 0)
     atom_next = 0;
@@ -408,7 +463,10 @@ void logo_mem_init(void)
     for (size_t i = 0; i < LOGO_ATOM_FREE_LIST_COUNT; i++)
         atom_free_lists[i] = ATOM_CHAIN_END;
     atom_free_bytes = 0;
-    gc_root_scopes = NULL;
+    number_text_offset = ATOM_CHAIN_END;
+    gc_phase = MEM_GC_IDLE;
+    gc_grey_top = 0;
+    memset(gc_marks, 0, sizeof(gc_marks));
 
     // Initialize node region (grows downward from top)
     // Start with no nodes allocated
@@ -418,13 +476,13 @@ void logo_mem_init(void)
     // Initialize free list as empty
     free_list = 0;
     free_count = 0;
+}
 
-    // Drop any blob region: a fresh interpreter has no PSRAM until the device
-    // (or a test) supplies one via logo_mem_set_aux_region().
-    blob_region = NULL;
-    blob_region_size = 0;
-    blob_reset();
-
+// Intern the atoms every arena starts with. Into an empty table they land at
+// the same offsets every time, which is what lets a workspace image check it
+// was made by a compatible build.
+static void intern_bootstrap_atoms(void)
+{
     // Create the newline marker atom (SOH character, non-printable)
     mem_newline_marker = mem_atom("\x01", 1);
 
@@ -433,6 +491,31 @@ void logo_mem_init(void)
     mem_false_node = mem_atom("false", 5);
 }
 
+// Initialize the memory system.
+// Must be called before any other memory functions.
+void logo_mem_init(void)
+{
+    arena_reset();
+    gc_root_scopes = NULL;
+    gc_requested = false;
+    gc_headroom_armed = true;
+    gc_headroom = LOGO_GC_HEADROOM_BYTES;
+    gc_count = 0;
+    alloc_failures = 0;
+    cells_allocated = 0;
+    atoms_interned = 0;
+    blobs_allocated = 0;
+    gc_idle_start = LOGO_GC_IDLE_START_BYTES;
+
+    // Drop any blob region: a fresh interpreter has no PSRAM until the device
+    // (or a test) supplies one via logo_mem_set_aux_region().
+    blob_region = NULL;
+    blob_region_size = 0;
+    blob_reset();
+
+    intern_bootstrap_atoms();
+}
+
 // Provide an auxiliary memory region (e.g. PSRAM) to back the blob heap.
 void logo_mem_set_aux_region(void *base, size_t size)
 {
@@ -449,6 +532,81 @@ void *mem_region_alloc(size_t size)
     return blob_alloc(size);
 }
 
+//==========================================================================
+// Collection Requests
+//==========================================================================
+
+static void gc_note_failure(void)
+{
+    alloc_failures++;
+    gc_requested = true;
+}
+
+// `gap` is the free arena left after extending a region by one entry.
+static inline void gc_check_headroom(size_t gap)
+{
+    if (gap < gc_headroom && gc_headroom_armed)
+        gc_requested = true;
+}
+
+bool mem_gc_requested(void)
+{
+    return gc_requested;
+}
+
+void mem_set_gc_headroom(size_t bytes)
+{
+    gc_headroom = bytes;
+    gc_headroom_armed = true;
+}
+
+size_t mem_gc_count(void)
+{
+    return gc_count;
+}
+
+size_t mem_alloc_failures(void)
+{
+    return alloc_failures;
+}
+
+size_t mem_cells_allocated(void)
+{
+    return cells_allocated;
+}
+
+size_t mem_atoms_interned(void)
+{
+    return atoms_interned;
+}
+
+size_t mem_blobs_allocated(void)
+{
+    return blobs_allocated;
+}
+
+void mem_set_gc_idle_start(size_t bytes)
+{
+    gc_idle_start = bytes;
+}
+
+bool mem_gc_idle_wanted(void)
+{
+    if (gc_phase != MEM_GC_IDLE || gc_requested)
+        return true;
+    return mem_free_nodes() * 4 < gc_idle_start || mem_free_atoms() < gc_idle_start;
+}
+
+MemGcPhase mem_gc_phase(void)
+{
+    return gc_phase;
+}
+
+static inline void gc_set_mark(uint16_t index)
+{
+    gc_marks[index / 32] |= 1u << (index % 32);
+}
+
 //==========================================================================
 // Node Allocation
 //==========================================================================
@@ -467,6 +625,9 @@ static uint16_t alloc_cell(void)
             uint32_t cell = *cell_ptr;
             free_list = CELL_GET_CDR(cell);
             free_count--;
+            cells_allocated++;
+            if (gc_phase == MEM_GC_MARK)
+                gc_set_mark(index);
             return index;
         }
     }
@@ -477,12 +638,14 @@ static uint16_t alloc_cell(void)
     // This must not overlap with atom_next
     if (node_bottom < 4 || mem_would_collide(0) || (node_bottom - 4) < atom_next)
     {
+        gc_note_failure();
         return 0; // Out of memory - would collide with atom table
     }
     
     // Allocate new node at the bottom of the node region
     node_bottom -= 4;
     node_count++;
+    gc_check_headroom(node_bottom - atom_next);
     
     // Calculate the index for this new node
     uint16_t index = (uint16_t)((LOGO_MEMORY_SIZE - node_bottom) / 4);
@@ -494,9 +657,13 @@ static uint16_t alloc_cell(void)
         // Restore state and fail
         node_bottom += 4;
         node_count--;
+        gc_note_failure();
         return 0;
     }
-    
+
+    cells_allocated++;
+    if (gc_phase == MEM_GC_MARK)
+        gc_set_mark(index);
     return index;
 }
 
@@ -529,6 +696,19 @@ static uint16_t node_to_index(Node n)
         }
         return (uint16_t)index;
     }
+    else if (NODE_WORD_IS_NUMBER(n))
+    {
+        uint32_t v = NODE_GET_NUMBER_INDEX(n);
+        if (v & NODE_NUMBER_IMMEDIATE_BIT)
+        {
+            return (uint16_t)(CELL_WORD_MARKER | (v & 0x1FFFu) << 2 | CELL_NUMBER_IMMEDIATE);
+        }
+        if (v == 0 || v > MAX_NUMBER_INDEX)
+        {
+            return 0;
+        }
+        return (uint16_t)(CELL_WORD_MARKER | ((v - 1) / 2) << 2 | ((v - 1) % 2 + 1));
+    }
     else if (type == NODE_TYPE_WORD)
     {
         // Word - encode with high bit set
@@ -561,6 +741,15 @@ static Node index_to_node(uint16_t index)
     // Check if this is a word reference (high bit set)
     if (index & CELL_WORD_MARKER)
     {
+        uint32_t low = index & CELL_NUMBER_BITS;
+        if (low == CELL_NUMBER_IMMEDIATE)
+        {
+            return NODE_MAKE_NUMBER(NODE_NUMBER_IMMEDIATE_BIT | (index & CELL_WORD_MASK) >> 2);
+        }
+        if (low != 0)
+        {
+            return NODE_MAKE_NUMBER(((index & CELL_WORD_MASK) >> 2) * 2 + low);
+        }
         uint32_t offset = index & CELL_WORD_MASK;
         return NODE_MAKE_WORD(offset);
     }
@@ -576,6 +765,9 @@ static Node index_to_node(uint16_t index)
 // Create a cons cell (list node) with car and cdr.
 // Returns NODE_NIL if out of memory or if either operand cannot be encoded
 // in 16 bits (e.g. an atom whose offset is >= LOGO_ATOM_LIMIT).
+static void gc_mark_node(Node n);
+static uint32_t *gc_cell(uint16_t index);
+
 Node mem_cons(Node car, Node cdr)
 {
     // Encode operands first so allocation isn't wasted on an unencodable cell.
@@ -602,6 +794,13 @@ Node mem_cons(Node car, Node cdr)
     
     *cell_ptr = CELL_MAKE(car_idx, cdr_idx);
 
+    // The new cell is black, so what it points at must not stay white.
+    if (gc_phase == MEM_GC_MARK)
+    {
+        gc_mark_node(car);
+        gc_mark_node(cdr);
+    }
+
     return NODE_MAKE_LIST(index);
 }
 
@@ -831,9 +1030,13 @@ Node mem_atom(const char *str, size_t len)
     {
         size_t atom_limit = node_bottom < LOGO_ATOM_LIMIT ? node_bottom : LOGO_ATOM_LIMIT;
         if (atom_next + entry_size > atom_limit)
+        {
+            gc_note_failure();
             return NODE_NIL;
+        }
         offset = atom_next;
         atom_next += entry_size;
+        gc_check_headroom(atom_limit - atom_next);
     }
 
     uint8_t bucket = atom_hash(str, len);
@@ -847,6 +1050,9 @@ Node mem_atom(const char *str, size_t len)
     memory_block[offset + 3 + len + 1] = 0;
     memory_block[offset + 3 + len + 2] = 0;
     atom_buckets[bucket] = (uint16_t)offset;
+    atoms_interned++;
+    if (gc_phase == MEM_GC_MARK)
+        atom_entry_set_next(offset, atom_entry_next(offset) | ATOM_LINK_MARK);
     return NODE_MAKE_WORD(offset);
 }
 
@@ -930,6 +1136,7 @@ Node mem_blob(const char *str, size_t len)
     }
     if (handle < 0)
     {
+        gc_note_failure();
         return NODE_NIL; // Descriptor table full
     }
 
@@ -937,6 +1144,7 @@ Node mem_blob(const char *str, size_t len)
     void *p = blob_alloc(len + 1);
     if (p == NULL)
     {
+        gc_note_failure();
         return NODE_NIL; // Region out of space
     }
 
@@ -944,6 +1152,9 @@ Node mem_blob(const char *str, size_t len)
     ((char *)p)[len] = '\0';
     blob_table[handle].ptr = p;
     blob_table[handle].len = (uint32_t)len;
+    blobs_allocated++;
+    if (gc_phase == MEM_GC_MARK)
+        blob_mark[handle / 8] |= (uint8_t)(1u << (handle % 8));
 
     return NODE_MAKE_BLOB((uint32_t)handle);
 }
@@ -958,6 +1169,119 @@ Node mem_word(const char *str, size_t len)
     return mem_blob(str, len);
 }
 
+//==========================================================================
+// Numbers (small integers in the node, other floats boxed in pool cells)
+//==========================================================================
+
+// A small integer goes in the node itself. Any other number is boxed in a
+// cell of its own, which holds the float's bits instead of two references,
+// so the GC marks it and never scans it (gc_mark_node).
+Node mem_number(float n)
+{
+    if (n >= -NUMBER_IMMEDIATE_BIAS && n < NUMBER_IMMEDIATE_BIAS &&
+        n == (float)(int32_t)n && !(n == 0.0f && signbit(n)))
+    {
+        uint32_t v = (uint32_t)((int32_t)n + NUMBER_IMMEDIATE_BIAS);
+        return NODE_MAKE_NUMBER(NODE_NUMBER_IMMEDIATE_BIT | v);
+    }
+
+    uint16_t index = alloc_cell();
+    if (index == 0)
+    {
+        return NODE_NIL;
+    }
+
+    uint32_t *cell_ptr = get_node_ptr(index);
+    if (index > MAX_NUMBER_INDEX)
+    {
+        // No list cell could refer to it: hand it back for a cons to use.
+        *cell_ptr = CELL_MAKE(0, free_list);
+        free_list = index;
+        free_count++;
+        return NODE_NIL;
+    }
+
+    memcpy(cell_ptr, &n, sizeof(n));
+    return NODE_MAKE_NUMBER(index);
+}
+
+// The number a number node stands for. False if `n` is not one.
+static bool number_value(Node n, float *out)
+{
+    if (!NODE_WORD_IS_NUMBER(n))
+    {
+        return false;
+    }
+    uint32_t v = NODE_GET_NUMBER_INDEX(n);
+    if (v & NODE_NUMBER_IMMEDIATE_BIT)
+    {
+        *out = (float)((int32_t)(v & ~NODE_NUMBER_IMMEDIATE_BIT) - NUMBER_IMMEDIATE_BIAS);
+        return true;
+    }
+    if (v == 0 || v > MAX_NUMBER_INDEX)
+    {
+        return false;
+    }
+    uint32_t *cell_ptr = get_node_ptr((uint16_t)v);
+    if (cell_ptr == NULL)
+    {
+        return false;
+    }
+    memcpy(out, cell_ptr, sizeof(*out));
+    return true;
+}
+
+float mem_number_value(Node n)
+{
+    float value = 0.0f;
+    number_value(n, &value);
+    return value;
+}
+
+// A number's characters are interned the first time a reader asks for them,
+// and are only as durable as any other unreferenced atom: valid until the
+// next GC, which is mem_word_ptr's contract anyway. The text is a function of
+// the float's bits alone, so the last one made is remembered until a sweep
+// could have collected it, and mem_word_ptr followed by mem_word_len formats
+// once. With the atom table full, the characters go to one of a few static
+// buffers instead, so a reader never sees NULL for a number.
+
+static bool number_text(Node n, const char **str, size_t *len, uint8_t **memo)
+{
+    float value;
+    if (!number_value(n, &value))
+    {
+        return false;
+    }
+
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    if (number_text_offset == ATOM_CHAIN_END || bits != number_text_bits)
+    {
+        char *buf = number_text_spill[number_text_spill_next];
+        int chars = format_number(buf, sizeof(number_text_spill[0]), value);
+
+        Node atom = mem_atom(buf, (size_t)chars);
+        if (mem_is_nil(atom))
+        {
+            number_text_spill_next = (number_text_spill_next + 1) % 4;
+            *str = buf;
+            *len = (size_t)chars;
+            *memo = NULL;
+            return true;
+        }
+        number_text_bits = bits;
+        number_text_offset = (uint16_t)NODE_GET_INDEX(atom);
+    }
+
+    size_t offset = number_text_offset;
+    size_t chars = memory_block[offset + 2];
+    *str = (const char *)&memory_block[offset + 3];
+    *len = chars;
+    *memo = &memory_block[offset + 3 + chars + 1];
+    return true;
+}
+
 // Resolve a blob node to its descriptor, or NULL if invalid.
 static BlobDesc *blob_desc(Node n)
 {
@@ -1065,6 +1389,8 @@ bool mem_set_car(Node n, Node value)
     uint16_t car_idx = node_to_index(value);
 
     *cell_ptr = CELL_MAKE(car_idx, cdr_idx);
+    if (gc_phase == MEM_GC_MARK)
+        gc_mark_node(value);  // write barrier
 
     return true;
 }
@@ -1093,6 +1419,8 @@ bool mem_set_cdr(Node n, Node value)
     uint16_t cdr_idx = node_to_index(value);
 
     *cell_ptr = CELL_MAKE(car_idx, cdr_idx);
+    if (gc_phase == MEM_GC_MARK)
+        gc_mark_node(value);  // write barrier
 
     return true;
 }
@@ -1145,6 +1473,12 @@ bool mem_is_blob(Node n)
     return NODE_WORD_IS_BLOB(n);
 }
 
+// Check if a node is a boxed number.
+bool mem_is_number(Node n)
+{
+    return NODE_WORD_IS_NUMBER(n);
+}
+
 // Check if a node is the newline marker.
 bool mem_is_newline(Node n)
 {
@@ -1187,6 +1521,14 @@ const char *mem_word_ptr(Node n)
         return d ? (const char *)d->ptr : NULL;
     }
 
+    if (NODE_WORD_IS_NUMBER(n))
+    {
+        const char *str;
+        size_t len;
+        uint8_t *memo;
+        return number_text(n, &str, &len, &memo) ? str : NULL;
+    }
+
     uint32_t offset = NODE_GET_INDEX(n);
     if (offset >= atom_next || atom_entry_is_free(offset))
     {
@@ -1212,6 +1554,14 @@ size_t mem_word_len(Node n)
         return d ? d->len : 0;
     }
 
+    if (NODE_WORD_IS_NUMBER(n))
+    {
+        const char *str;
+        size_t len;
+        uint8_t *memo;
+        return number_text(n, &str, &len, &memo) ? len : 0;
+    }
+
     uint32_t offset = NODE_GET_INDEX(n);
     if (offset >= atom_next || atom_entry_is_free(offset))
     {
@@ -1239,6 +1589,9 @@ bool LOGO_HOT(mem_word_view)(Node n, const char **str, size_t *len, uint8_t **me
         return true;
     }
 
+    if (NODE_WORD_IS_NUMBER(n))
+        return number_text(n, str, len, memo);
+
     uint32_t offset = NODE_GET_INDEX(n);
     if (offset >= atom_next || atom_entry_is_free(offset))
         return false;
@@ -1319,6 +1672,15 @@ bool mem_words_equal(Node a, Node b)
         return true;
     }
 
+    // Two numbers with the same bits spell the same word. Any other pair
+    // involving a number is compared by its characters below.
+    float number_a, number_b;
+    if (number_value(a, &number_a) && number_value(b, &number_b) &&
+        memcmp(&number_a, &number_b, sizeof(float)) == 0)
+    {
+        return true;
+    }
+
     const char *pa = mem_word_ptr(a);
     const char *pb = mem_word_ptr(b);
     if (pa == NULL || pb == NULL)
@@ -1332,12 +1694,9 @@ bool mem_words_equal(Node a, Node b)
 // Garbage Collection
 //==========================================================================
 
-// Bit array for marking (1 bit per possible node)
-// Size based on maximum possible nodes (total memory / 4 bytes per node)
-static uint32_t gc_marks[(LOGO_MEMORY_SIZE / 4 + 31) / 32];
-
 // Recursive mark function
 static void gc_mark_index(uint16_t index);
+static void gc_shade_index(uint16_t index);
 
 // Mark a node and its reachable nodes
 static void gc_mark_node(Node n)
@@ -1351,7 +1710,15 @@ static void gc_mark_node(Node n)
 
     if (type == NODE_TYPE_WORD)
     {
-        if (NODE_WORD_IS_BLOB(n))
+        if (NODE_WORD_IS_NUMBER(n))
+        {
+            // A box holds its float, so it is marked, never scanned. A small
+            // integer is out of range here: it has no cell.
+            uint32_t index = NODE_GET_NUMBER_INDEX(n);
+            if (index <= MAX_NUMBER_INDEX && gc_cell((uint16_t)index) != NULL)
+                gc_set_mark((uint16_t)index);
+        }
+        else if (NODE_WORD_IS_BLOB(n))
         {
             uint32_t handle = NODE_GET_BLOB_HANDLE(n);
             if (handle < LOGO_MAX_BLOBS && blob_table[handle].ptr != NULL)
@@ -1373,7 +1740,37 @@ static void gc_mark_node(Node n)
         return;
     }
 
-    gc_mark_index((uint16_t)NODE_GET_INDEX(n));
+    if (gc_phase == MEM_GC_MARK)
+        gc_shade_index((uint16_t)NODE_GET_INDEX(n));
+    else
+        gc_mark_index((uint16_t)NODE_GET_INDEX(n));
+}
+
+// The cell for `index`, or NULL if it is not an allocated pool cell.
+static uint32_t *gc_cell(uint16_t index)
+{
+    // Reject sentinel/word-tagged values that should never reach the GC
+    // marker — they indicate either a corrupted reference or a caller
+    // that forgot to strip the type bits before calling us.
+    if (index > MAX_LIST_INDEX)
+    {
+        return NULL;
+    }
+
+    // Validate that the index is within our allocated node region
+    uint32_t *cell_ptr = get_node_ptr(index);
+    if (cell_ptr == NULL)
+    {
+        return NULL;
+    }
+
+    // Check if the node is actually allocated (within node_bottom to LOGO_MEMORY_SIZE)
+    size_t byte_offset = (uint8_t *)cell_ptr - memory_block;
+    if (byte_offset < node_bottom || byte_offset >= LOGO_MEMORY_SIZE)
+    {
+        return NULL;
+    }
+    return cell_ptr;
 }
 
 static void gc_mark_index(uint16_t index)
@@ -1382,27 +1779,11 @@ static void gc_mark_index(uint16_t index)
     // Only car branches recurse (bounded by list nesting depth, not length).
     while (index != 0)
     {
-        // Reject sentinel/word-tagged values that should never reach the GC
-        // marker — they indicate either a corrupted reference or a caller
-        // that forgot to strip the type bits before calling us.
-        if (index > MAX_LIST_INDEX)
-        {
-            return;
-        }
-
-        // Validate that the index is within our allocated node region
-        uint32_t *cell_ptr = get_node_ptr(index);
+        uint32_t *cell_ptr = gc_cell(index);
         if (cell_ptr == NULL)
         {
             return;
         }
-        
-        // Check if the node is actually allocated (within node_bottom to LOGO_MEMORY_SIZE)
-        size_t byte_offset = (uint8_t *)cell_ptr - memory_block;
-        if (byte_offset < node_bottom || byte_offset >= LOGO_MEMORY_SIZE)
-        {
-            return;
-        }
 
         // Check if already marked
         uint32_t word_idx = index / 32;
@@ -1439,31 +1820,74 @@ static void gc_mark_index(uint16_t index)
     }
 }
 
-// Mark a node and its reachable nodes
+// Grey a white cell: mark it and queue it for scanning. A full grey stack
+// falls back to marking the cell's whole subgraph now, which is what a full
+// collection does anyway -- correct, just not bounded for that one step.
+static void gc_shade_index(uint16_t index)
+{
+    if (index == 0 || gc_cell(index) == NULL)
+        return;
+    if (gc_marks[index / 32] & (1u << (index % 32)))
+        return;
+    if (gc_grey_top == LOGO_GC_GREY_STACK_DEPTH)
+    {
+        gc_mark_index(index);
+        return;
+    }
+    gc_set_mark(index);
+    gc_grey[gc_grey_top++] = index;
+}
+
+// Shade whatever a cell field refers to.
+static void gc_shade_ref(uint16_t ref)
+{
+    if (ref & CELL_WORD_MARKER)
+        gc_mark_node(index_to_node(ref));
+    else if (ref != 0 && ref != CELL_EMPTY_LIST)
+        gc_shade_index(ref);
+}
+
+// Mark a node and its reachable nodes. While an incremental cycle is
+// marking, this only shades the node; mem_gc_mark_step does the rest.
 void mem_gc_mark(Node n)
 {
     gc_mark_node(n);
 }
 
-void mem_gc_mark_atom_ptr(const char *ptr)
+// The offset of the live atom whose text starts at `ptr`, or SIZE_MAX.
+static size_t atom_offset_of(const char *ptr)
 {
     if (ptr == NULL)
-        return;
+        return SIZE_MAX;
 
     uintptr_t address = (uintptr_t)(const void *)ptr;
     uintptr_t base = (uintptr_t)(void *)memory_block;
     if (address < base + 3 || address >= base + atom_next)
-        return;
+        return SIZE_MAX;
 
     size_t offset = (size_t)(address - base - 3);
     if ((offset & 3u) != 0 || offset >= atom_next ||
         atom_entry_is_free(offset) ||
         (const char *)&memory_block[offset + 3] != ptr)
+        return SIZE_MAX;
+    return offset;
+}
+
+void mem_gc_mark_atom_ptr(const char *ptr)
+{
+    size_t offset = atom_offset_of(ptr);
+    if (offset == SIZE_MAX)
         return;
 
     atom_entry_set_next(offset, atom_entry_next(offset) | ATOM_LINK_MARK);
 }
 
+Node mem_atom_of_ptr(const char *ptr)
+{
+    size_t offset = atom_offset_of(ptr);
+    return offset == SIZE_MAX ? NODE_NIL : NODE_MAKE_WORD(offset);
+}
+
 void mem_gc_roots_push(MemGcRootScope *scope, const Node *roots, size_t count)
 {
     assert(scope != NULL);
@@ -1498,17 +1922,18 @@ static void atom_clear_marks(void)
     }
 }
 
-// Sweep unmarked nodes back to free list
-void mem_gc_sweep(void)
+// Mark the atoms logo_mem_init interns and every active transient scope.
+static void gc_mark_implicit_roots(void)
 {
     mem_gc_mark(mem_newline_marker);
     mem_gc_mark(mem_true_node);
     mem_gc_mark(mem_false_node);
     mem_gc_mark_transient_roots();
+}
 
-    free_list = 0;
-    free_count = 0;
-
+// The highest marked cell in the pool, 0 if none.
+static uint16_t gc_highest_live(void)
+{
     // Calculate the maximum node index based on allocated region
     uint16_t max_index = (uint16_t)((LOGO_MEMORY_SIZE - node_bottom) / 4);
 
@@ -1520,10 +1945,21 @@ void mem_gc_sweep(void)
         if (gc_marks[word_idx] & (1u << bit_idx))
             highest_live = i;
     }
+    return highest_live;
+}
+
+// Dead trailing cells cease to be part of the pool, returning the shared
+// arena to atoms.
+static void gc_trim_nodes(uint16_t highest_live)
+{
+    node_count = highest_live;
+    node_bottom = LOGO_MEMORY_SIZE - (size_t)highest_live * 4;
+}
 
-    // Rebuild free cells only through the last live cell.  Dead trailing cells
-    // cease to be part of the pool, returning the shared arena to atoms.
-    for (uint16_t i = 1; i <= highest_live; i++)
+// Free or keep cells [first, last] by their marks, clearing the marks kept.
+static void gc_sweep_cells(uint16_t first, uint16_t last)
+{
+    for (uint32_t i = first; i <= last; i++)
     {
         uint32_t word_idx = i / 32;
         uint32_t bit_idx = i % 32;
@@ -1534,17 +1970,47 @@ void mem_gc_sweep(void)
         else
         {
             // Not marked - free it
-            uint32_t *cell_ptr = get_node_ptr(i);
+            uint32_t *cell_ptr = get_node_ptr((uint16_t)i);
             if (cell_ptr != NULL)
             {
                 *cell_ptr = CELL_MAKE(0, free_list);
-                free_list = i;
+                free_list = (uint16_t)i;
                 free_count++;
             }
         }
     }
-    node_count = highest_live;
-    node_bottom = LOGO_MEMORY_SIZE - (size_t)highest_live * 4;
+}
+
+// Rebuild the hash chains and free lists from a walk of the atom table.
+static void atom_reindex(void)
+{
+    for (size_t i = 0; i < ATOM_BUCKET_COUNT; i++)
+        atom_buckets[i] = ATOM_CHAIN_END;
+    for (size_t i = 0; i < LOGO_ATOM_FREE_LIST_COUNT; i++)
+        atom_free_lists[i] = ATOM_CHAIN_END;
+    atom_free_bytes = 0;
+    for (size_t offset = 0; offset < atom_next; )
+    {
+        size_t size = atom_entry_size(offset);
+        if (atom_entry_is_free(offset))
+        {
+            atom_free_add(offset, size);
+        }
+        else
+        {
+            uint8_t bucket = atom_hash((const char *)&memory_block[offset + 3],
+                                       memory_block[offset + 2]);
+            atom_entry_set_next(offset, atom_buckets[bucket]);
+            atom_buckets[bucket] = (uint16_t)offset;
+        }
+        offset += size;
+    }
+}
+
+// Sweep the atom table and the blob heap by their marks, clearing them.
+static void gc_sweep_atoms_and_blobs(void)
+{
+    number_text_offset = ATOM_CHAIN_END;
 
     // Sweep and coalesce atom entries in place. A trailing free run is trimmed
     // from the atom high-water mark; the remaining entries are then indexed.
@@ -1588,27 +2054,7 @@ void mem_gc_sweep(void)
     if (free_start != SIZE_MAX)
         atom_next = free_start;
 
-    for (size_t i = 0; i < ATOM_BUCKET_COUNT; i++)
-        atom_buckets[i] = ATOM_CHAIN_END;
-    for (size_t i = 0; i < LOGO_ATOM_FREE_LIST_COUNT; i++)
-        atom_free_lists[i] = ATOM_CHAIN_END;
-    atom_free_bytes = 0;
-    for (offset = 0; offset < atom_next; )
-    {
-        size_t size = atom_entry_size(offset);
-        if (atom_entry_is_free(offset))
-        {
-            atom_free_add(offset, size);
-        }
-        else
-        {
-            uint8_t bucket = atom_hash((const char *)&memory_block[offset + 3],
-                                       memory_block[offset + 2]);
-            atom_entry_set_next(offset, atom_buckets[bucket]);
-            atom_buckets[bucket] = (uint16_t)offset;
-        }
-        offset += size;
-    }
+    atom_reindex();
 
     // Sweep the blob heap: free any descriptor not reached during marking.
     for (int i = 0; i < LOGO_MAX_BLOBS; i++)
@@ -1625,9 +2071,6 @@ void mem_gc_sweep(void)
         blob_table[i].ptr = NULL;
         blob_table[i].len = 0;
     }
-
-    // Clear any remaining marks (nodes and blobs)
-    memset(gc_marks, 0, sizeof(gc_marks));
     memset(blob_mark, 0, sizeof(blob_mark));
 
     // The maintained count and the walk must agree. A collection is the one
@@ -1638,9 +2081,129 @@ void mem_gc_sweep(void)
            == mem_free_atoms_by_scan());
 }
 
+// A collection answers any pending request. Only re-arm the headroom trigger
+// if it actually bought the headroom back.
+static void gc_cycle_done(void)
+{
+    gc_count++;
+    gc_requested = false;
+    gc_headroom_armed = mem_free_nodes() * 4 >= gc_headroom &&
+                        mem_free_atoms() >= gc_headroom;
+}
+
+// Sweep unmarked nodes back to free list
+void mem_gc_sweep(void)
+{
+    // Marking for a full collection means shading while a cycle is marking,
+    // so callers abandon the cycle first (mem_gc_cancel_incremental).
+    assert(gc_phase == MEM_GC_IDLE);
+    gc_mark_implicit_roots();
+
+    free_list = 0;
+    free_count = 0;
+
+    // Rebuild free cells only through the last live cell.
+    uint16_t highest_live = gc_highest_live();
+    gc_sweep_cells(1, highest_live);
+    gc_trim_nodes(highest_live);
+    gc_sweep_atoms_and_blobs();
+
+    // Clear any remaining marks
+    memset(gc_marks, 0, sizeof(gc_marks));
+    gc_cycle_done();
+}
+
+//==========================================================================
+// Incremental Collection
+//==========================================================================
+//
+// The same mark-and-sweep, cut into steps a caller can fit around other work
+// (the `sync` primitive spends a frame's idle slack on it). Marking is
+// tri-colour: mem_gc_begin_incremental whitens everything, the caller shades
+// its roots, and each mem_gc_mark_step scans a bounded number of grey cells.
+// Between steps the program keeps running, covered by black allocation and
+// the insertion barrier in mem_cons/mem_set_car/mem_set_cdr. Roots are not
+// barriered, so mem_gc_finish_marking runs after the caller shades them a
+// second time: it drains the grey stack atomically, then sweeps atoms and
+// blobs at once -- their free lists are rebuilt whole -- and hands the node
+// pool to bounded mem_gc_sweep_step calls.
+
+void mem_gc_begin_incremental(void)
+{
+    assert(gc_phase == MEM_GC_IDLE);
+    gc_grey_top = 0;
+    gc_phase = MEM_GC_MARK;
+}
+
+bool mem_gc_mark_step(size_t budget)
+{
+    while (budget > 0 && gc_grey_top > 0)
+    {
+        uint16_t index = gc_grey[--gc_grey_top];
+        uint32_t cell = *get_node_ptr(index);
+        gc_shade_ref(CELL_GET_CAR(cell));
+        gc_shade_ref(CELL_GET_CDR(cell));
+        budget--;
+    }
+    return gc_grey_top == 0;
+}
+
+void mem_gc_finish_marking(void)
+{
+    assert(gc_phase == MEM_GC_MARK);
+    gc_mark_implicit_roots();
+    mem_gc_mark_step(SIZE_MAX);
+
+    uint16_t highest_live = gc_highest_live();
+    gc_trim_nodes(highest_live);
+    gc_sweep_atoms_and_blobs();
+
+    // Unswept cells are neither live nor on the free list until the sweep
+    // reaches them; new cells come from the region below until it does.
+    free_list = 0;
+    free_count = 0;
+    gc_sweep_cursor = 1;
+    gc_sweep_limit = highest_live;
+    gc_phase = MEM_GC_SWEEP;
+}
+
+bool mem_gc_sweep_step(size_t budget)
+{
+    if (gc_phase != MEM_GC_SWEEP)
+        return true;
+    size_t left = (size_t)gc_sweep_limit + 1 - gc_sweep_cursor;
+    uint16_t last = (uint16_t)(gc_sweep_cursor - 1 + (budget < left ? budget : left));
+    gc_sweep_cells(gc_sweep_cursor, last);
+    gc_sweep_cursor = (uint16_t)(last + 1);
+    if (gc_sweep_cursor <= gc_sweep_limit)
+        return false;
+
+    gc_phase = MEM_GC_IDLE;
+    gc_cycle_done();
+    return true;
+}
+
+void mem_gc_cancel_incremental(void)
+{
+    if (gc_phase == MEM_GC_IDLE)
+        return;
+
+    // The cycle's marks are not a sound starting point for another collection:
+    // grey cells were never scanned, and in the sweep phase an unswept cell
+    // may since have been pointed at a cell allocated white. Drop them all;
+    // the free list is rebuilt whole by whichever sweep comes next.
+    memset(gc_marks, 0, sizeof(gc_marks));
+    memset(blob_mark, 0, sizeof(blob_mark));
+    atom_clear_marks();
+    gc_grey_top = 0;
+    gc_phase = MEM_GC_IDLE;
+}
+
 // Run garbage collection over an explicit root array.
 void mem_gc(Node *roots, size_t num_roots)
 {
+    mem_gc_cancel_incremental();
+
     // Clear mark bits
     memset(gc_marks, 0, sizeof(gc_marks));
     memset(blob_mark, 0, sizeof(blob_mark));
@@ -1656,6 +2219,101 @@ void mem_gc(Node *roots, size_t num_roots)
     mem_gc_sweep();
 }
 
+//==========================================================================
+// Workspace Images
+//==========================================================================
+
+const uint8_t *mem_image_layout(MemImageLayout *out)
+{
+    out->atom_bytes = (uint32_t)atom_next;
+    out->node_bytes = (uint32_t)(LOGO_MEMORY_SIZE - node_bottom);
+    out->free_list = free_list;
+    out->free_count = (uint32_t)free_count;
+    out->roots[0] = mem_newline_marker;
+    out->roots[1] = mem_true_node;
+    out->roots[2] = mem_false_node;
+    return memory_block;
+}
+
+bool mem_image_blob(int handle, const char **data, size_t *len)
+{
+    if (handle < 0 || handle >= LOGO_MAX_BLOBS || blob_table[handle].ptr == NULL)
+        return false;
+    *data = (const char *)blob_table[handle].ptr;
+    *len = blob_table[handle].len;
+    return true;
+}
+
+bool mem_image_layout_fits(const MemImageLayout *layout)
+{
+    size_t cells = layout->node_bytes / 4;
+    return layout->atom_bytes % 4 == 0 && layout->node_bytes % 4 == 0 &&
+           layout->atom_bytes <= LOGO_ATOM_LIMIT &&
+           (size_t)layout->atom_bytes + layout->node_bytes <= LOGO_MEMORY_SIZE &&
+           cells <= MAX_LIST_INDEX &&
+           layout->free_list <= cells && layout->free_count <= cells &&
+           layout->roots[0] == mem_newline_marker &&
+           layout->roots[1] == mem_true_node &&
+           layout->roots[2] == mem_false_node;
+}
+
+// Cancel collection, drop the blobs and blind the transient scopes: the state
+// both a restore and a clear start from.
+static void image_release(void)
+{
+    mem_gc_cancel_incremental();
+    for (int i = 0; i < LOGO_MAX_BLOBS; i++)
+    {
+        if (blob_table[i].ptr != NULL)
+        {
+            blob_free(blob_table[i].ptr);
+            blob_table[i].ptr = NULL;
+            blob_table[i].len = 0;
+        }
+    }
+    for (MemGcRootScope *scope = gc_root_scopes; scope != NULL;
+         scope = scope->previous)
+        scope->count = 0;
+    gc_requested = false;
+}
+
+uint8_t *mem_image_begin_restore(const MemImageLayout *layout)
+{
+    image_release();
+    arena_reset();
+    atom_next = layout->atom_bytes;
+    node_bottom = LOGO_MEMORY_SIZE - layout->node_bytes;
+    node_count = layout->node_bytes / 4;
+    free_list = (uint16_t)layout->free_list;
+    free_count = layout->free_count;
+    return memory_block;
+}
+
+char *mem_image_restore_blob(int handle, size_t len)
+{
+    if (handle < 0 || handle >= LOGO_MAX_BLOBS || blob_table[handle].ptr != NULL)
+        return NULL;
+    char *p = (char *)blob_alloc(len + 1);
+    if (p == NULL)
+        return NULL;
+    p[len] = '\0';
+    blob_table[handle].ptr = p;
+    blob_table[handle].len = (uint32_t)len;
+    return p;
+}
+
+void mem_image_finish_restore(void)
+{
+    atom_reindex();
+}
+
+void mem_image_clear(void)
+{
+    image_release();
+    arena_reset();
+    intern_bootstrap_atoms();
+}
+
 //==========================================================================
 // Memory Statistics
 //==========================================================================
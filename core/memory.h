@@ -79,6 +79,14 @@ extern "C"
     //       Bits 28-0:  Blob handle (index into the blob descriptor table)
     //    To the outside world a blob is still a word (mem_is_word is true);
     //    mem_word_ptr/mem_word_len read its bytes transparently.
+    //    c) Number (bit 28 == 1): a number held in a list (mem_number).
+    //       Bits 31-30: 10 (NODE_TYPE_WORD)
+    //       Bit  28:    1
+    //       Bit  27:    1 = small integer, 0 = float boxed in a pool cell
+    //       Bits 26-0:  the integer plus 4096, or the pool index of the cell
+    //                   holding the float's bits
+    //    Also a word to the outside world: its characters are the formatted
+    //    number, interned the first time anyone asks for them.
     //
     // 3. List reference (index into node pool):
     //    Bits 31-30: 01 (NODE_TYPE_LIST) 
@@ -122,6 +130,15 @@ extern "C"
     ((NODE_GET_TYPE(n) == NODE_TYPE_WORD) && (NODE_GET_INDEX(n) & NODE_WORD_BLOB_BIT))
 #define NODE_GET_BLOB_HANDLE(n) (NODE_GET_INDEX(n) & ~NODE_WORD_BLOB_BIT)
 
+    // Number sub-encoding within NODE_TYPE_WORD (see comment above).
+#define NODE_WORD_NUMBER_BIT (1u << 28)
+#define NODE_MAKE_NUMBER(index) NODE_MAKE_WORD(NODE_WORD_NUMBER_BIT | (index))
+#define NODE_WORD_IS_NUMBER(n) \
+    ((NODE_GET_TYPE(n) == NODE_TYPE_WORD) && \
+     (NODE_GET_INDEX(n) & (NODE_WORD_BLOB_BIT | NODE_WORD_NUMBER_BIT)) == NODE_WORD_NUMBER_BIT)
+#define NODE_GET_NUMBER_INDEX(n) (NODE_GET_INDEX(n) & ~NODE_WORD_NUMBER_BIT)
+#define NODE_NUMBER_IMMEDIATE_BIT (1u << 27)
+
     // Cons cell macros (for cells stored in node pool)
 #define CELL_GET_CAR(cell) ((cell) >> 16)
 #define CELL_GET_CDR(cell) ((cell) & 0xFFFF)
@@ -189,6 +206,18 @@ extern "C"
     // cell (mem_cons returns NODE_NIL for a blob operand).
     Node mem_blob(const char *str, size_t len);
 
+    // A number as a word node. Lists hold numbers this way so that storing
+    // one formats nothing and interns nothing, and reading one back
+    // (mem_number_value) parses nothing; the characters are only made when
+    // a reader asks mem_word_ptr for them. An integer from -4096 to 4095 is
+    // carried in the node itself; any other float is boxed in a pool cell,
+    // collected like any other.
+    //
+    // Returns NODE_NIL when the pool is full or the cell it was given cannot
+    // be encoded in a list cell (only the first 16,384 can); callers fall
+    // back to the number's word (number_to_word).
+    Node mem_number(float n);
+
     // Create a word of any length: interns as an atom when len <= 255, otherwise
     // allocates a blob in the aux region. Returns NODE_NIL on failure (e.g. a
     // long value with no aux region available). Use this for values that may
@@ -224,6 +253,12 @@ extern "C"
     // A blob is also a word, so mem_is_word(n) is true whenever mem_is_blob(n) is.
     bool mem_is_blob(Node n);
 
+    // Check if a node is a number node (mem_number). Also a word.
+    bool mem_is_number(Node n);
+
+    // The float a number node holds; 0 for any other node.
+    float mem_number_value(Node n);
+
     //==========================================================================
     // Newline Marker
     //==========================================================================
@@ -333,6 +368,101 @@ extern "C"
     // Roots are provided as an array of node pointers.
     void mem_gc(Node *roots, size_t num_roots);
 
+    // True when an allocation failed, or left less free arena than the
+    // headroom, since the last sweep. The allocators never collect on their
+    // own; the evaluator polls this at a safe point (eval_call_primitive).
+    bool mem_gc_requested(void);
+
+    // Set the free-arena headroom, in bytes, that raises a request
+    // (default LOGO_GC_HEADROOM_BYTES). Zero requests only on failure.
+    void mem_set_gc_headroom(size_t bytes);
+
+    // Sweeps completed since logo_mem_init, and allocations refused for lack
+    // of space (cells, atoms, blobs). Both only ever count up.
+    size_t mem_gc_count(void);
+    size_t mem_alloc_failures(void);
+
+    // Cells (boxed numbers included), newly interned atoms and blobs handed
+    // out since logo_mem_init, whether still live or not. They only ever
+    // count up; logo-bench takes the difference across the code it times.
+    size_t mem_cells_allocated(void);
+    size_t mem_atoms_interned(void);
+    size_t mem_blobs_allocated(void);
+
+    //==========================================================================
+    // Incremental Collection
+    //==========================================================================
+
+    // One cycle: begin, shade the roots (mem_gc_mark), mark_step until it
+    // reports the grey set empty, shade the roots again, finish_marking, then
+    // sweep_step until it reports done. Each step does at most `budget` cells
+    // of work; finish_marking drains what the second root pass found and
+    // sweeps the atom table whole. A full collection must first cancel.
+    typedef enum
+    {
+        MEM_GC_IDLE,
+        MEM_GC_MARK,
+        MEM_GC_SWEEP
+    } MemGcPhase;
+
+    MemGcPhase mem_gc_phase(void);
+    void mem_gc_begin_incremental(void);
+    bool mem_gc_mark_step(size_t budget);
+    void mem_gc_finish_marking(void);
+    bool mem_gc_sweep_step(size_t budget);
+    void mem_gc_cancel_incremental(void);
+
+    // True when idle time is worth spending on a cycle: one is in progress, a
+    // collection was requested, or free arena is below the idle threshold
+    // (default LOGO_GC_IDLE_START_BYTES).
+    bool mem_gc_idle_wanted(void);
+    void mem_set_gc_idle_start(size_t bytes);
+
+    //==========================================================================
+    // Workspace Images (core/workspace_image.c)
+    //==========================================================================
+    //
+    // Everything in the arena refers to everything else by atom offset or cell
+    // index, so the used ends of the block, copied out and copied back, mean
+    // the same thing in any session of the same build. Collect first, so an
+    // image carries only what is reachable.
+
+    typedef struct MemImageLayout
+    {
+        uint32_t atom_bytes;   // Atom table, from offset 0
+        uint32_t node_bytes;   // Node pool, ending at LOGO_MEMORY_SIZE
+        uint32_t free_list;    // Head of the cell free list
+        uint32_t free_count;   // Cells on it
+        Node roots[3];         // The atoms logo_mem_init interns
+    } MemImageLayout;
+
+    // The arena and its current layout.
+    const uint8_t *mem_image_layout(MemImageLayout *out);
+
+    // Live blob `handle`'s bytes; false for a free slot.
+    bool mem_image_blob(int handle, const char **data, size_t *len);
+
+    // True when an image of `layout` fits this build's arena. Changes nothing.
+    bool mem_image_layout_fits(const MemImageLayout *layout);
+
+    // Replace the arena with an image of `layout` (which must fit). Cancels any
+    // collection, frees every blob and blinds the active transient root
+    // scopes, whose Nodes name the old arena; returns the block for the caller
+    // to fill: layout->atom_bytes at the bottom, layout->node_bytes at the top.
+    // Then restore the blobs, each into the slot it had, and finish, which
+    // rebuilds the atom index. restore_blob returns the `len` bytes to fill,
+    // or NULL if the slot is taken or the region is full.
+    uint8_t *mem_image_begin_restore(const MemImageLayout *layout);
+    char *mem_image_restore_blob(int handle, size_t len);
+    void mem_image_finish_restore(void);
+
+    // Empty the arena after a restore that could not finish, leaving what
+    // logo_mem_init leaves but keeping the aux region and its permanent blocks.
+    void mem_image_clear(void);
+
+    // The atom whose text mem_word_ptr returned as `ptr`, or NODE_NIL.
+    Node mem_atom_of_ptr(const char *ptr);
+
     //==========================================================================
     // Memory Statistics
     //==========================================================================
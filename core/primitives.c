@@ -60,6 +60,7 @@ void primitives_set_io(LogoIO *io)
     // The console arrives after primitives_init has run, so this is the first
     // moment the editor can be told anything (B34)
     primitives_editor_console_ready();
+    primitives_turtle_console_ready();
 }
 
 LogoIO *primitives_get_io(void)
@@ -153,6 +154,15 @@ void primitive_register(const char *name, int default_args, PrimitiveFunc func)
     primitives_sorted = false;
 }
 
+void primitive_register_rerunnable(const char *name, int default_args, PrimitiveFunc func)
+{
+    if (primitive_count >= MAX_PRIMITIVES)
+        return;
+
+    primitive_register(name, default_args, func);
+    primitives[primitive_count - 1].rerunnable = true;
+}
+
 // Order `name` (exactly `len` bytes, not NUL-terminated) against a registered
 // primitive name the same way strcasecmp would, so the binary search below
 // stays valid for both entry points.
@@ -223,7 +233,8 @@ bool primitive_register_alias(const char *alias_name, const Primitive *source)
     primitives[primitive_count++] = (Primitive){
         .name = alias_name,
         .default_args = source->default_args,
-        .func = source->func};
+        .func = source->func,
+        .rerunnable = source->rerunnable};
     primitives_sorted = false;
     // copydef can register an alias mid-evaluation, so a name that already
     // resolved to "neither a primitive nor a procedure" -- or to a user
@@ -109,6 +109,7 @@ extern "C"
         const char *name;
         int default_args; // Number of args to parse without parentheses
         PrimitiveFunc func;
+        bool rerunnable;  // Safe to run again after out of space (see below)
     } Primitive;
 
     // Initialize all primitives
@@ -135,6 +136,12 @@ extern "C"
     // Registration helper for primitive modules
     void primitive_register(const char *name, int default_args, PrimitiveFunc func);
 
+    // The same, for a primitive that only builds its output from its inputs:
+    // when it runs out of space, the evaluator collects garbage and runs it
+    // again. Anything that reads input, draws, or changes state before it can
+    // fail must use primitive_register, or the second run repeats that.
+    void primitive_register_rerunnable(const char *name, int default_args, PrimitiveFunc func);
+
     // Register an alias for an existing primitive
     // The alias_name should be an interned string (from mem_word_ptr)
     // Returns true on success, false if out of space or primitive not found
@@ -157,6 +164,8 @@ extern "C"
     // Push the editor settings the console cannot ask for (key layer, undo
     // journal) once a console is registered — see primitives_set_io.
     void primitives_editor_console_ready(void);
+    // Lend the console's flood fill its queue store, likewise.
+    void primitives_turtle_console_ready(void);
 
     // Capacity of the editor buffers, chosen at init: large when they landed in
     // the aux/PSRAM region, the SRAM fallback size otherwise.
@@ -194,6 +203,16 @@ extern "C"
     // selection this visits each turtle in turn and leaves turtle 0 selected.
     void turtle_stop_motion(void);
 
+    // Advance the tile animations by dt_ms, re-baking the cells whose frame
+    // changed if `stampmap` has put the board on the canvas. Called from the
+    // demon poll beside the device's turtle_tick.
+    void tiles_tick(uint32_t dt_ms);
+
+    // The canvas no longer shows the stamped board (`cs`, `clean`,
+    // `loadpic`), so bulk updates and animations stop re-baking until the
+    // next `stampmap`.
+    void tiles_unstamp(void);
+
     // Route the device to the lowest turtle in the `tell` set, the one a
     // query answers for. Shared with the tile primitives, whose capture
     // happens at the turtle exactly as snapsh's does. No-op without a device.
@@ -2,7 +2,8 @@
 //  Pico Logo
 //  Copyright 2026 Blair Leduc. See LICENSE for details.
 //
-//  Debugging primitives: step, unstep, trace, untrace
+//  Debugging primitives: step, unstep, trace, untrace, .profile,
+//  .profile.report
 //
 //  These primitives help debug Logo procedures by:
 //  
@@ -21,6 +22,13 @@
 //  
 //  unstep "name / unstep [name1 name2 ...]
 //    - Disables stepping for the specified procedure(s)
+//  
+//  .profile "true / .profile "false
+//    - Starts (clearing the figures) or stops the call profiler
+//  
+//  .profile.report
+//    - Outputs [name calls inclusive exclusive] per procedure and primitive,
+//      times in microseconds, most exclusive time first
 //
 
 #include "primitives.h"
@@ -28,6 +36,9 @@
 #include "memory.h"
 #include "error.h"
 #include "eval.h"
+#include "format.h"
+#include "profile.h"
+#include <strings.h>
 
 // step "name or step [name1 name2 ...]
 // Set stepped flag on procedure(s)
@@ -205,10 +216,110 @@ static Result prim_untrace(Evaluator *eval, int argc, Value *args)
     return result_none();
 }
 
+// .profile "true or .profile "false
+// Start the profiler with a clear table, or stop it
+static Result prim_profile(Evaluator *eval, int argc, Value *args)
+{
+    UNUSED(eval);
+    UNUSED(argc);
+
+    const char *str = value_to_string(args[0]);
+    if (str == NULL)
+    {
+        return result_error_arg(ERR_NOT_BOOL, NULL, NULL);
+    }
+    if (strcasecmp(str, "true") == 0)
+    {
+        if (!profile_start(primitives_get_io()))
+        {
+            return result_error(ERR_OUT_OF_SPACE);
+        }
+    }
+    else if (strcasecmp(str, "false") == 0)
+    {
+        profile_stop();
+    }
+    else
+    {
+        return result_error_arg(ERR_NOT_BOOL, NULL, str);
+    }
+
+    return result_none();
+}
+
+// Build [name calls inclusive exclusive]; NODE_NIL when out of space
+static Node profile_row_list(const char *name, uint32_t calls,
+                             uint32_t total_us, uint32_t self_us)
+{
+    Node name_word = mem_atom_cstr(name);
+    Node calls_node = number_to_element((float)calls);
+    Node total_node = number_to_element((float)total_us);
+    Node self_node = number_to_element((float)self_us);
+    if (mem_is_nil(name_word) || mem_is_nil(calls_node) ||
+        mem_is_nil(total_node) || mem_is_nil(self_node))
+    {
+        return NODE_NIL;
+    }
+
+    Node list = mem_cons(self_node, NODE_NIL);
+    if (!mem_is_nil(list))
+        list = mem_cons(total_node, list);
+    if (!mem_is_nil(list))
+        list = mem_cons(calls_node, list);
+    if (!mem_is_nil(list))
+        list = mem_cons(name_word, list);
+    return list;
+}
+
+// .profile.report
+// Output the profiler's figures, most exclusive time first. Calls that
+// found the table full are counted by a last row named ?.
+static Result prim_profile_report(Evaluator *eval, int argc, Value *args)
+{
+    UNUSED(eval); UNUSED(argc); UNUSED(args);
+
+    Node head = NODE_NIL;
+    Node tail = NODE_NIL;
+    ProfileRow row;
+    int cursor = -1;
+    bool more = profile_next(&cursor, &row);
+    uint32_t dropped = profile_dropped();
+
+    while (more || dropped > 0)
+    {
+        Node row_list;
+        if (more)
+        {
+            row_list = profile_row_list(row.name, row.calls, row.total_us, row.self_us);
+            more = profile_next(&cursor, &row);
+        }
+        else
+        {
+            row_list = profile_row_list("?", dropped, 0, 0);
+            dropped = 0;
+        }
+
+        Node cell = mem_is_nil(row_list) ? NODE_NIL : mem_cons(row_list, NODE_NIL);
+        if (mem_is_nil(cell))
+        {
+            return result_error(ERR_OUT_OF_SPACE);
+        }
+        if (mem_is_nil(head))
+            head = cell;
+        else
+            mem_set_cdr(tail, cell);
+        tail = cell;
+    }
+
+    return result_ok(value_list(head));
+}
+
 void primitives_debug_init(void)
 {
     primitive_register("step", 1, prim_step);
     primitive_register("unstep", 1, prim_unstep);
     primitive_register("trace", 1, prim_trace);
     primitive_register("untrace", 1, prim_untrace);
+    primitive_register(".profile", 1, prim_profile);
+    primitive_register(".profile.report", 0, prim_profile_report);
 }
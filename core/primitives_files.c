@@ -16,6 +16,27 @@
 
 //==========================================================================
 
+// Drain a stream's buffered writes and report any write error left on it.
+// print only flushes console writers, so a full disk under a file writer
+// shows up here when the file is closed or stops being the writer.
+static Result drain_writes(LogoStream *stream)
+{
+    if (!stream)
+    {
+        return result_none();
+    }
+
+    logo_stream_flush(stream);
+    if (!logo_stream_has_write_error(stream))
+    {
+        return result_none();
+    }
+
+    bool disk_full = stream->disk_full;
+    logo_stream_clear_write_error(stream);
+    return result_error(disk_full ? ERR_DISK_FULL : ERR_DISK_TROUBLE);
+}
+
 // open file or network connection - opens for read/write
 // For files: creates if doesn't exist
 // For network: connects to host:port
@@ -84,8 +105,9 @@ static Result prim_close(Evaluator *eval, int argc, Value *args)
         return result_error_arg(ERR_FILE_NOT_OPEN, NULL, target);
     }
 
+    Result r = drain_writes(logo_io_find_open(io, target));
     logo_io_close(io, target);
-    return result_none();
+    return r;
 }
 
 // closeall - closes all open files (not dribble)
@@ -94,12 +116,21 @@ static Result prim_closeall(Evaluator *eval, int argc, Value *args)
     UNUSED(eval); UNUSED(argc); UNUSED(args);
 
     LogoIO *io = primitives_get_io();
+    Result r = result_none();
     if (io)
     {
+        for (int i = 0; i < LOGO_MAX_OPEN_FILES; i++)
+        {
+            Result drained = drain_writes(io->open_streams[i]);
+            if (r.status != RESULT_ERROR)
+            {
+                r = drained;
+            }
+        }
         logo_io_close_all(io);
     }
 
-    return result_none();
+    return r;
 }
 
 // setread file - sets current reader to file (empty list for keyboard)
@@ -156,8 +187,9 @@ static Result prim_setwrite(Evaluator *eval, int argc, Value *args)
     // Empty list means reset to screen
     if (args[0].type == VALUE_LIST && mem_is_nil(args[0].as.node))
     {
+        Result r = drain_writes(io->writer);
         logo_io_set_writer(io, NULL);
-        return result_none();
+        return r;
     }
 
     if (args[0].type != VALUE_WORD)
@@ -178,8 +210,13 @@ static Result prim_setwrite(Evaluator *eval, int argc, Value *args)
         return result_error_arg(ERR_FILE_NOT_OPEN, NULL, target);
     }
 
+    Result r = result_none();
+    if (io->writer != stream)
+    {
+        r = drain_writes(io->writer);
+    }
     logo_io_set_writer(io, stream);
-    return result_none();
+    return r;
 }
 
 // reader - outputs the current reader name (empty list for keyboard)
@@ -464,12 +501,14 @@ static Result prim_nodribble(Evaluator *eval, int argc, Value *args)
     UNUSED(eval); UNUSED(argc); UNUSED(args);
 
     LogoIO *io = primitives_get_io();
+    Result r = result_none();
     if (io)
     {
+        r = drain_writes(io->dribble);
         logo_io_stop_dribble(io);
     }
 
-    return result_none();
+    return r;
 }
 
 //==========================================================================
@@ -525,6 +525,10 @@ static Result prim_erase_file(Evaluator *eval, int argc, Value *args)
         return result_error_arg(ERR_UNSUPPORTED_ON_DEVICE, NULL, NULL);
     }
 
+    if (logo_io_is_open(io, filename))
+    {
+        return result_error_arg(ERR_FILE_ALREADY_OPEN, NULL, filename);
+    }
     if (!logo_io_file_delete(io, filename))
     {
         return result_error_arg(ERR_FILE_NOT_FOUND, "", filename);
@@ -781,6 +785,33 @@ static Result prim_free(Evaluator *eval, int argc, Value *args)
     return result_ok(value_list(list));
 }
 
+// .sdcache - outputs [hits misses read written]: the SD card's sector cache
+// lookups served from memory and not, and the sectors it has read from and
+// written to the card, since boot.
+static Result prim_sdcache(Evaluator *eval, int argc, Value *args)
+{
+    UNUSED(eval);
+    UNUSED(argc);
+    UNUSED(args);
+    LogoIO *io = primitives_get_io();
+    if (!io)
+    {
+        return result_error_arg(ERR_UNSUPPORTED_ON_DEVICE, NULL, NULL);
+    }
+
+    LogoCacheStats stats;
+    if (!logo_io_cache_stats(io, "/sd", &stats))
+    {
+        return result_error(ERR_NO_SD_CARD);
+    }
+
+    Node list = mem_cons(number_to_word((float)stats.sectors_written), NODE_NIL);
+    list = mem_cons(number_to_word((float)stats.sectors_read), list);
+    list = mem_cons(number_to_word((float)stats.misses), list);
+    list = mem_cons(number_to_word((float)stats.hits), list);
+    return result_ok(value_list(list));
+}
+
 //==========================================================================
 // Registration
 //==========================================================================
@@ -790,6 +821,7 @@ void primitives_files_directory_init(void)
     // Directory listing
     primitive_register("files", 0, prim_files);
     primitive_register("free", 0, prim_free);
+    primitive_register(".sdcache", 0, prim_sdcache);
     primitive_register("directories", 0, prim_directories);
     primitive_register("cat", 0, prim_cat);
     primitive_register("catalog", 0, prim_catalog);
@@ -13,8 +13,8 @@
 #include "error.h"
 #include "eval.h"
 #include "format.h"
-#include "lexer.h"
-#include "repl.h"
+#include "loader.h"
+#include "workspace_image.h"
 #include "devices/io.h"
 #include <string.h>
 #include <strings.h>
@@ -28,18 +28,52 @@ static bool loading_in_progress = false;
 // Load helpers
 //==========================================================================
 
-// Procedure-definition accumulation is shared with the REPL; see
-// repl_line_starts_with_to / repl_proc_def_append in core/repl.h.
+// The next line of a mapped file into `line`, as logo_stream_read_line
+// reads one: up to a newline or carriage return, which is consumed, or
+// until `size - 1` characters. Returns -1 at end of file.
+static int load_mapped_line(const char **cursor, const char *end, char *line, size_t size)
+{
+    const char *p = *cursor;
+    if (p >= end)
+    {
+        return -1;
+    }
+
+    size_t n = 0;
+    while (p < end && n < size - 1)
+    {
+        char c = *p++;
+        if (c == '\n' || c == '\r')
+        {
+            break;
+        }
+        line[n++] = c;
+    }
+    line[n] = '\0';
+    *cursor = p;
+    return (int)n;
+}
+
+// A mapped file being read a line at a time
+typedef struct
+{
+    const char *cursor;
+    const char *end;
+} MappedLines;
 
-// Maximum line length for load
-#define LOAD_MAX_LINE 256
+static int read_mapped_line(void *context, char *line, size_t size)
+{
+    MappedLines *lines = (MappedLines *)context;
+    return load_mapped_line(&lines->cursor, lines->end, line, size);
+}
 
-// Maximum procedure buffer for load
-#define LOAD_MAX_PROC 4096
+static int read_stream_line(void *context, char *line, size_t size)
+{
+    return logo_stream_read_line((LogoStream *)context, line, size);
+}
 
-// Static buffer for assembling procedure definitions during load.
-// Safe as static because loading_in_progress prevents reentrancy.
-static char load_proc_buffer[LOAD_MAX_PROC];
+// What the last load did, for .load.report
+static LoadStats last_load;
 
 // load pathname - loads and executes file contents
 static Result prim_load(Evaluator *eval, int argc, Value *args)
@@ -72,11 +106,26 @@ static Result prim_load(Evaluator *eval, int argc, Value *args)
     Value startup_before = {0};
     bool startup_existed_before = var_get("startup", &startup_before);
 
-    // Open the file for reading (logo_io_open resolves path internally)
-    LogoStream *stream = logo_io_open(io, pathname);
-    if (!stream)
-    {
-        return result_error_arg(ERR_FILE_NOT_FOUND, "", pathname);
+    // Read the file in place when the storage can map it, which skips the
+    // stream and its buffers. A file open as a stream may hold writes the
+    // mapping would not see, so it is read through that stream as before.
+    // While mapped the file counts as open, so a line that tries to rewrite,
+    // erase or rename it fails instead of pulling the bytes out from under
+    // the lines still to be read.
+    const char *mapped = NULL;
+    size_t mapped_len = 0;
+    LogoStream *stream = NULL;
+    if (logo_io_is_open(io, pathname) ||
+        !logo_io_map_file(io, pathname, &mapped, &mapped_len))
+    {
+        mapped = NULL;
+
+        // Open the file for reading (logo_io_open resolves path internally)
+        stream = logo_io_open(io, pathname);
+        if (!stream)
+        {
+            return result_error_arg(ERR_FILE_NOT_FOUND, "", pathname);
+        }
     }
 
     // Set the loading flag to prevent recursive loads
@@ -87,109 +136,23 @@ static Result prim_load(Evaluator *eval, int argc, Value *args)
     // inside the guard above (B3). Resumed below, before `startup` runs.
     demons_suspend();
 
-    // Read and execute the file line by line
-    char line[LOAD_MAX_LINE];
-    char *proc_buffer = load_proc_buffer;
-    size_t proc_len = 0;
-    bool in_procedure_def = false;
-    Result result = result_none();
-
-    while (logo_stream_read_line(stream, line, sizeof(line)) >= 0)
+    // Lex the file once, defining and running as it goes
+    uint32_t started = logo_io_ticks_us(io);
+    Result result;
+    if (mapped)
     {
-        // Strip trailing newline/carriage return
-        size_t len = strlen(line);
-        while (len > 0 && (line[len - 1] == '\n' || line[len - 1] == '\r'))
-        {
-            line[--len] = '\0';
-        }
-
-        // Skip empty lines
-        if (len == 0)
-        {
-            continue;
-        }
-
-        // Handle procedure definitions
-        if (!in_procedure_def && repl_line_starts_with_to(line))
-        {
-            in_procedure_def = true;
-            proc_len = 0;
-        }
-
-        if (in_procedure_def)
-        {
-            ProcDefStatus status = repl_proc_def_append(proc_buffer, LOAD_MAX_PROC, &proc_len, line);
-            if (status == PROC_DEF_OVERFLOW)
-            {
-                // The definition is larger than the in-memory buffer.
-                // Returning ERR_OUT_OF_SPACE is preferable to silently
-                // dropping or truncating it: the user needs to know their
-                // code did not load.
-                in_procedure_def = false;
-                result = result_error_arg(ERR_OUT_OF_SPACE, NULL, pathname);
-                break;
-            }
-
-            if (status == PROC_DEF_COMPLETE)
-            {
-                in_procedure_def = false;
-
-                // Parse and define the procedure
-                Result r = proc_define_from_text(proc_buffer);
-                if (r.status == RESULT_ERROR)
-                {
-                    result = r;
-                    break;
-                }
-
-                proc_len = 0;
-            }
-            continue;
-        }
-
-        // Regular instruction - evaluate it
-        Lexer lexer;
-        Evaluator load_eval;
-        lexer_init(&lexer, line);
-        eval_init(&load_eval, &lexer);
-        // eval_init leaves the frame stack NULL for the caller to supply.
-        // Without it, a line that calls a user-defined procedure - including
-        // one this same file has just defined - pushes a frame through a NULL
-        // stack and crashes. The REPL and demons set it the same way.
-        eval_set_frames(&load_eval, proc_get_frame_stack());
-
-        // Evaluate all instructions on the line
-        while (!eval_at_end(&load_eval))
-        {
-            Result r = eval_instruction(&load_eval);
-
-            if (r.status == RESULT_ERROR)
-            {
-                result = r;
-                break;
-            }
-            else if (r.status == RESULT_THROW)
-            {
-                // Propagate throw
-                result = r;
-                break;
-            }
-            else if (r.status == RESULT_OK)
-            {
-                // Expression returned a value - ignore in load
-                // (Unlike REPL, we don't report "I don't know what to do with")
-            }
-            // RESULT_NONE means command completed successfully - continue
-        }
-
-        if (result.status != RESULT_NONE)
-        {
-            break;
-        }
+        MappedLines lines = {.cursor = mapped, .end = mapped + mapped_len};
+        result = loader_run(read_mapped_line, &lines, &last_load);
+        logo_io_unmap_file(io, mapped, mapped_len);
     }
+    else
+    {
+        result = loader_run(read_stream_line, stream, &last_load);
 
-    // Close the file (logo_io_close resolves path internally)
-    logo_io_close(io, pathname);
+        // Close the file (logo_io_close resolves path internally)
+        logo_io_close(io, pathname);
+    }
+    last_load.us = logo_io_ticks_us(io) - started;
 
     // Clear the loading flag
     loading_in_progress = false;
@@ -241,6 +204,33 @@ static Result prim_load(Evaluator *eval, int argc, Value *args)
     return result;
 }
 
+// .load.report
+// Output [bytes microseconds atoms cells procedures instructions] for the
+// last load: what it read, how long it took, and what it made and ran.
+static Result prim_load_report(Evaluator *eval, int argc, Value *args)
+{
+    UNUSED(eval); UNUSED(argc); UNUSED(args);
+
+    const uint32_t figures[] = {
+        last_load.bytes, last_load.us, last_load.atoms,
+        last_load.cells, last_load.procedures, last_load.instructions,
+    };
+
+    // Built from the back, so each number is held by the list as it grows
+    Node list = NODE_NIL;
+    for (int i = (int)(sizeof(figures) / sizeof(figures[0])) - 1; i >= 0; i--)
+    {
+        Node n = number_to_element((float)figures[i]);
+        Node cell = mem_is_nil(n) ? NODE_NIL : mem_cons(n, list);
+        if (mem_is_nil(cell))
+        {
+            return result_error(ERR_OUT_OF_SPACE);
+        }
+        list = cell;
+    }
+    return result_ok(value_list(list));
+}
+
 //==========================================================================
 // Save helper functions
 //==========================================================================
@@ -456,6 +446,14 @@ static Result prim_savel(Evaluator *eval, int argc, Value *args)
     return result_none();
 }
 
+// A picture named *.rle is saved run-length encoded (RLE8). It is still a
+// BMP, which loadpic reads whatever it is called.
+static bool picture_wants_rle(const char *pathname)
+{
+    size_t len = strlen(pathname);
+    return len >= 4 && strcasecmp(pathname + len - 4, ".rle") == 0;
+}
+
 // savepic pathname - saves the graphics screen as a BMP file
 static Result prim_savepic(Evaluator *eval, int argc, Value *args)
 {
@@ -490,7 +488,7 @@ static Result prim_savepic(Evaluator *eval, int argc, Value *args)
         return result_error(ERR_DISK_TROUBLE);
     }
 
-    int err = turtle->gfx_save(stream);
+    int err = turtle->gfx_save(stream, picture_wants_rle(pathname));
     logo_io_close(io, pathname);
     if (err != 0)
     {
@@ -536,6 +534,10 @@ static Result prim_loadpic(Evaluator *eval, int argc, Value *args)
 
     int err = turtle->gfx_load(stream);
     logo_io_close(io, pathname);
+
+    // The picture replaces any board stampmap baked, even one that failed
+    // part way through
+    tiles_unstamp();
     if (err != 0)
     {
         // Check for specific error codes
@@ -549,6 +551,150 @@ static Result prim_loadpic(Evaluator *eval, int argc, Value *args)
     return result_none();
 }
 
+//==========================================================================
+// Workspace images
+//==========================================================================
+
+// Longest pathname .savews and .loadws hold on to. The argument is an atom,
+// and both primitives outlive it: .savews collects garbage first, .loadws
+// replaces the whole arena.
+#define WS_IMAGE_MAX_PATH 256
+
+static bool copy_pathname(Value arg, char *buf, size_t size)
+{
+    const char *pathname = mem_word_ptr(arg.as.node);
+    size_t len = strlen(pathname);
+    if (len >= size)
+    {
+        return false;
+    }
+    memcpy(buf, pathname, len + 1);
+    return true;
+}
+
+// .savews pathname - saves the whole workspace as a binary image
+static Result prim_savews(Evaluator *eval, int argc, Value *args)
+{
+    UNUSED(argc);
+    REQUIRE_WORD(args[0]);
+
+    char pathname[WS_IMAGE_MAX_PATH];
+    if (!copy_pathname(args[0], pathname, sizeof(pathname)))
+    {
+        return result_error_arg(ERR_FILE_NOT_FOUND, "", mem_word_ptr(args[0].as.node));
+    }
+
+    LogoIO *io = primitives_get_io();
+    if (!io)
+    {
+        return result_error_arg(ERR_UNSUPPORTED_ON_DEVICE, NULL, NULL);
+    }
+
+    // Check if file already exists (logo_io_file_exists resolves path internally)
+    if (logo_io_file_exists(io, pathname))
+    {
+        return result_error_arg(ERR_FILE_EXISTS, "", pathname);
+    }
+
+    LogoStream *stream = logo_io_open(io, pathname);
+    if (!stream)
+    {
+        return result_error(ERR_DISK_TROUBLE);
+    }
+
+    // Only what is reachable goes into the image
+    eval_collect_garbage(eval);
+
+    int err = workspace_image_save(stream);
+    logo_io_close(io, pathname);
+    if (err != 0)
+    {
+        return result_error(err);
+    }
+    return result_none();
+}
+
+// .loadws pathname - replaces the workspace with a saved image, then runs
+// startup if the image has it
+static Result prim_loadws(Evaluator *eval, int argc, Value *args)
+{
+    UNUSED(argc);
+    REQUIRE_WORD(args[0]);
+
+    if (loading_in_progress)
+    {
+        return result_error(ERR_NO_FILE_BUFFERS);
+    }
+
+    // Every Value in flight names the arena being replaced, so only a
+    // top-level instruction typed or loaded on its own may do it
+    if (eval->token_source.type != TOKEN_SOURCE_LEXER || eval_in_procedure(eval) ||
+        op_stack_depth(eval->op_stack) != 0 || demons_running())
+    {
+        return result_error_arg(ERR_CANT_USE_PROCEDURE, ".loadws", NULL);
+    }
+
+    char pathname[WS_IMAGE_MAX_PATH];
+    if (!copy_pathname(args[0], pathname, sizeof(pathname)))
+    {
+        return result_error_arg(ERR_FILE_NOT_FOUND, "", mem_word_ptr(args[0].as.node));
+    }
+
+    LogoIO *io = primitives_get_io();
+    if (!io)
+    {
+        return result_error_arg(ERR_UNSUPPORTED_ON_DEVICE, NULL, NULL);
+    }
+
+    if (!logo_io_file_exists(io, pathname))
+    {
+        return result_error_arg(ERR_FILE_NOT_FOUND, "", pathname);
+    }
+
+    // In place when the storage can map it, as load reads source. Nothing
+    // runs until the image is copied out and the file unmapped.
+    const char *mapped = NULL;
+    size_t mapped_len = 0;
+    LogoStream *stream = NULL;
+    if (logo_io_is_open(io, pathname) ||
+        !logo_io_map_file(io, pathname, &mapped, &mapped_len))
+    {
+        mapped = NULL;
+        stream = logo_io_open(io, pathname);
+        if (!stream)
+        {
+            return result_error_arg(ERR_FILE_NOT_FOUND, "", pathname);
+        }
+    }
+
+    int err = workspace_image_load((const uint8_t *)mapped, mapped_len, stream);
+
+    if (mapped)
+    {
+        logo_io_unmap_file(io, mapped, mapped_len);
+    }
+    else
+    {
+        logo_io_close(io, pathname);
+    }
+    if (err != 0)
+    {
+        return result_error_arg(err, ".loadws", NULL);
+    }
+
+    Result result = result_none();
+    Value startup;
+    if (var_get("startup", &startup) && value_is_list(startup))
+    {
+        result = eval_run_list(eval, startup.as.node);
+    }
+    if (result.status == RESULT_NONE)
+    {
+        result = demons_poll();
+    }
+    return result;
+}
+
 //==========================================================================
 // pofile
 //==========================================================================
@@ -626,4 +772,7 @@ void primitives_files_load_save_init(void)
     primitive_register("savepic", 1, prim_savepic);
     primitive_register("loadpic", 1, prim_loadpic);
     primitive_register("pofile", 1, prim_pofile);
+    primitive_register(".savews", 1, prim_savews);
+    primitive_register(".loadws", 1, prim_loadws);
+    primitive_register(".load.report", 0, prim_load_report);
 }
@@ -38,12 +38,25 @@ static bool print_output(void *ctx, const char *str)
     return true;
 }
 
+// Console and network writers are flushed so each print shows at once.
+// File writers keep their buffer until close, setwrite or a full buffer
+// drains it, and report write errors then. The dribble file is flushed every
+// time: it is a transcript, and on the SD card its sectors would otherwise
+// wait in the FAT32 cache until nodribble.
 static void flush_writer(void)
 {
     LogoIO *io = primitives_get_io();
-    if (io)
+    if (!io)
+    {
+        return;
+    }
+    if (io->writer && io->writer->type != LOGO_STREAM_FILE)
     {
-        logo_io_flush(io);
+        logo_stream_flush(io->writer);
+    }
+    if (io->dribble)
+    {
+        logo_stream_flush(io->dribble);
     }
 }
 
@@ -141,12 +154,30 @@ static Result prim_keyhitp(Evaluator *eval, int argc, Value *args)
     return result_ok(value_bool(logo_io_key_hit(io, (int)code_f)));
 }
 
+// The read primitives consume their input before they allocate, so they are
+// not rerunnable: a second run would read the next line.  Instead, when the
+// arena is full they collect here and build the result again from the text
+// they already hold.  Nothing they have allocated is live yet, and their
+// callers' values are rooted by eval_call_primitive, so this is as safe a
+// point to collect as the evaluator's own.
+static Node intern_input(Evaluator *eval, const char *text, int len)
+{
+    size_t failures = mem_alloc_failures();
+    Node word = mem_atom(text, len);
+    if (word == NODE_NIL && mem_alloc_failures() != failures)
+    {
+        eval_collect_garbage(eval);
+        word = mem_atom(text, len);
+    }
+    return word;
+}
+
 // readchar (rc) - outputs the first character typed at the keyboard
 // Does not echo the character.
 // Returns empty list if reading from file and at EOF.
 static Result prim_readchar(Evaluator *eval, int argc, Value *args)
 {
-    UNUSED(eval); UNUSED(argc); UNUSED(args);
+    UNUSED(argc); UNUSED(args);
 
     LogoIO *io = primitives_get_io();
     if (!io)
@@ -168,7 +199,11 @@ static Result prim_readchar(Evaluator *eval, int argc, Value *args)
 
     // Return single character as a word
     char buf[2] = {(char)ch, '\0'};
-    Node word = mem_atom(buf, 1);
+    Node word = intern_input(eval, buf, 1);
+    if (word == NODE_NIL)
+    {
+        return result_error(ERR_OUT_OF_SPACE);
+    }
     return result_ok(value_word(word));
 }
 
@@ -177,7 +212,7 @@ static Result prim_readchar(Evaluator *eval, int argc, Value *args)
 // Returns empty list if at EOF before reading any characters.
 static Result prim_readchars(Evaluator *eval, int argc, Value *args)
 {
-    UNUSED(eval); UNUSED(argc);
+    UNUSED(argc);
     REQUIRE_NUMBER(args[0], count_f);
 
     int count = (int)count_f;
@@ -212,8 +247,12 @@ static Result prim_readchars(Evaluator *eval, int argc, Value *args)
     }
 
     buffer[read_count] = '\0';
-    Node word = mem_atom(buffer, read_count);
+    Node word = intern_input(eval, buffer, read_count);
     free(buffer);
+    if (word == NODE_NIL)
+    {
+        return result_error(ERR_OUT_OF_SPACE);
+    }
     return result_ok(value_word(word));
 }
 
@@ -224,7 +263,7 @@ static Result prim_readchars(Evaluator *eval, int argc, Value *args)
 // Echoes the input. Returns empty word if at EOF.
 static Result prim_readlist(Evaluator *eval, int argc, Value *args)
 {
-    UNUSED(eval); UNUSED(argc); UNUSED(args);
+    UNUSED(argc); UNUSED(args);
 
     LogoIO *io = primitives_get_io();
     if (!io)
@@ -244,9 +283,15 @@ static Result prim_readlist(Evaluator *eval, int argc, Value *args)
         return result_ok(value_word(mem_atom("", 0)));
     }
 
-    // Parse the line into a list
+    // Parse the line into a list, collecting once if the arena is full (see
+    // intern_input)
     ParseListResult parse_result = parse_list_from_string(buffer);
     if (!parse_result.success)
+    {
+        eval_collect_garbage(eval);
+        parse_result = parse_list_from_string(buffer);
+    }
+    if (!parse_result.success)
     {
         return result_error(ERR_OUT_OF_SPACE);
     }
@@ -257,7 +302,7 @@ static Result prim_readlist(Evaluator *eval, int argc, Value *args)
 // Echoes the input. Returns empty word if press Enter without typing, empty list at EOF.
 static Result prim_readword(Evaluator *eval, int argc, Value *args)
 {
-    UNUSED(eval); UNUSED(argc); UNUSED(args);
+    UNUSED(argc); UNUSED(args);
 
     LogoIO *io = primitives_get_io();
     if (!io)
@@ -290,7 +335,12 @@ static Result prim_readword(Evaluator *eval, int argc, Value *args)
     }
 
     // Return as a single word (even if empty)
-    Node word = mem_atom(buffer, len);
+    size_t failures = mem_alloc_failures();
+    Node word = intern_input(eval, buffer, len);
+    if (word == NODE_NIL && mem_alloc_failures() != failures)
+    {
+        return result_error(ERR_OUT_OF_SPACE);
+    }
     return result_ok(value_word(word));
 }
 
@@ -223,6 +223,19 @@ static Result prim_define(Evaluator *eval, int argc, Value *args)
     return result_none();
 }
 
+// True when nothing but blanks or a comment follows token `t` on its line.
+// A lexer fed a line at a time (lexer_set_refill) ends each piece where the
+// line ends, so the NUL counts as well as the newline.
+static bool token_ends_line(const Token *t)
+{
+    const char *p = t->start + t->length;
+    while (*p == ' ' || *p == '\t' || *p == '\r')
+    {
+        p++;
+    }
+    return *p == '\0' || *p == '\n' || *p == ';';
+}
+
 // Simple text-based procedure definition for testing
 // This parses: to name :param1 :param2 ... body... end
 // Used when we have the full definition as a string
@@ -233,15 +246,21 @@ Result proc_define_from_text(const char *text)
     lexer_init(&lexer, text);
     lexer_set_preserve_comments(&lexer, true);
     
-    // Skip 'to'
     Token t = lexer_next_token(&lexer);
+    return proc_define_from_lexer(&lexer, &t, false);
+}
+
+// The token `*t` is the `to`
+Result proc_define_from_lexer(Lexer *lexer, Token *t_io, bool end_closes_line)
+{
+    Token t = *t_io;
     if (t.type != TOKEN_WORD)
     {
         return result_error_arg(ERR_DOESNT_LIKE_INPUT, NULL, "expected procedure name");
     }
     
     // Get procedure name
-    t = lexer_next_token(&lexer);
+    t = lexer_next_token(lexer);
     if (t.type != TOKEN_WORD)
     {
         return result_error_arg(ERR_NOT_ENOUGH_INPUTS, NULL, NULL);
@@ -262,7 +281,7 @@ Result proc_define_from_text(const char *text)
     
     while (true)
     {
-        t = lexer_next_token(&lexer);
+        t = lexer_next_token(lexer);
         if (t.type == TOKEN_EOF)
             break;
         if (t.type == TOKEN_COLON && param_count < MAX_PROC_PARAMS)
@@ -286,7 +305,7 @@ Result proc_define_from_text(const char *text)
     Node body_tail = NODE_NIL;
     Node current_line = NODE_NIL;   // Current line being built
     Node current_line_tail = NODE_NIL;
-    bool at_line_start = lexer.had_newline;  // Check if we crossed a newline to get here
+    bool at_line_start = lexer->had_newline;  // Check if we crossed a newline to get here
     bool body_started = false;      // Have we added any content to body?
     int paren_depth = 0;            // Open `(` on the line being built
 
@@ -294,9 +313,11 @@ Result proc_define_from_text(const char *text)
     {
         // Check for 'end' only at line start. This is checked inside an open
         // paren too, so an unbalanced `(` cannot swallow `end` and absorb the
-        // procedures that follow it.
-        if (at_line_start && t.type == TOKEN_WORD && t.length == 3 &&
-            strncasecmp(t.start, "end", 3) == 0)
+        // procedures that follow it. A file may also close a definition with
+        // an `end` that ends a line.
+        if (t.type == TOKEN_WORD && t.length == 3 && strncasecmp(t.start, "end", 3) == 0 &&
+            (end_closes_line ? (at_line_start || paren_depth == 0) && token_ends_line(&t)
+                             : at_line_start))
         {
             break;
         }
@@ -317,8 +338,8 @@ Result proc_define_from_text(const char *text)
         {
             // Recursively parse bracket contents to create a nested list
             // This handles brackets spanning multiple lines
-            t = lexer_next_token(&lexer);
-            item = parse_bracket_contents(&lexer, &t, 0);
+            t = lexer_next_token(lexer);
+            item = parse_bracket_contents(lexer, &t, 0);
             // Mark as nested list
             item = NODE_MAKE_LIST(NODE_GET_INDEX(item));
             
@@ -338,11 +359,11 @@ Result proc_define_from_text(const char *text)
             }
             
             // Check if we crossed newlines while parsing bracket contents
-            if (lexer.had_newline)
+            if (lexer->had_newline)
             {
-                int newline_count = lexer.newline_count;
-                lexer.had_newline = false;
-                lexer.newline_count = 0;
+                int newline_count = lexer->newline_count;
+                lexer->had_newline = false;
+                lexer->newline_count = 0;
 
                 // Inside an open `(` the newline is whitespace: keep
                 // accumulating into the same body line.
@@ -415,14 +436,14 @@ Result proc_define_from_text(const char *text)
             }
         }
         
-        t = lexer_next_token(&lexer);
+        t = lexer_next_token(lexer);
         
         // Check if the lexer crossed newline(s) to get the next token
-        if (lexer.had_newline)
+        if (lexer->had_newline)
         {
-            int newline_count = lexer.newline_count;
-            lexer.had_newline = false;
-            lexer.newline_count = 0;
+            int newline_count = lexer->newline_count;
+            lexer->had_newline = false;
+            lexer->newline_count = 0;
             
             // Skip leading newlines before the body starts.
             if (!body_started && mem_is_nil(current_line))
@@ -494,6 +515,14 @@ Result proc_define_from_text(const char *text)
         }
     }
     
+    *t_io = t;
+
+    // A file that ends before the `end` is cut short: define nothing
+    if (end_closes_line && t.type == TOKEN_EOF)
+    {
+        return result_error(ERR_END_OF_DATA);
+    }
+
     // Define the procedure
     if (!proc_define(name, params, param_count, body))
     {
@@ -503,6 +532,40 @@ Result proc_define_from_text(const char *text)
     return result_ok(value_word(name_atom));
 }
 
+Node proc_parse_line(Lexer *lexer, Token *t)
+{
+    Node line = NODE_NIL;
+    Node tail = NODE_NIL;
+
+    while (t->type != TOKEN_EOF)
+    {
+        if (t->type == TOKEN_LEFT_BRACKET)
+        {
+            *t = lexer_next_token(lexer);
+            Node item = parse_bracket_contents(lexer, t, 0);
+            tail = append_to_list(&line, &tail, NODE_MAKE_LIST(NODE_GET_INDEX(item)));
+        }
+        else
+        {
+            // A stray ] is kept, as in a body, for the evaluator to report
+            Node item = t->type == TOKEN_RIGHT_BRACKET ? mem_atom("]", 1) : token_to_atom(t);
+            if (!mem_is_nil(item))
+            {
+                tail = append_to_list(&line, &tail, item);
+            }
+            *t = lexer_next_token(lexer);
+        }
+
+        if (lexer->had_newline)
+        {
+            lexer->had_newline = false;
+            lexer->newline_count = 0;
+            break;
+        }
+    }
+    return line;
+}
+
 // text "name - outputs the text (definition) of a procedure as a list
 static Result prim_text(Evaluator *eval, int argc, Value *args)
 {
@@ -10,6 +10,7 @@
 #include "error.h"
 #include "eval.h"
 #include "frame_sync.h"
+#include "limits.h"
 #include "devices/io.h"
 #include <stdio.h>
 #include <string.h>
@@ -257,7 +258,7 @@ static Result prim_refresh(Evaluator *eval, int argc, Value *args)
 
 static Result prim_sync(Evaluator *eval, int argc, Value *args)
 {
-    UNUSED(eval); UNUSED(argc); UNUSED(args);
+    UNUSED(argc); UNUSED(args);
 
     // Present this frame, exactly like refresh.
     const LogoConsoleScreen *screen = get_screen_ops();
@@ -278,9 +279,18 @@ static Result prim_sync(Evaluator *eval, int argc, Value *args)
         return result_none();
     }
 
+    // Spend the slack on the collector first, a bounded step at a time, so a
+    // collection happens here instead of inside the next frame's body.
+    uint32_t now = logo_io_ticks_ms(io);
+    int ms = (int)frame_sync_wait_ms(now);
+    uint32_t boundary = now + (uint32_t)ms;
+    while (ms > 0 && eval_gc_step(eval, LOGO_GC_STEP_CELLS))
+    {
+        ms = (int32_t)(boundary - logo_io_ticks_ms(io));
+    }
+
     // Sleep the computed remainder in interruptible chunks, like wait, so a
     // game loop can still be stopped with the interrupt key.
-    int ms = (int)frame_sync_wait_ms(logo_io_ticks_ms(io));
     while (ms > 0)
     {
         if (logo_io_check_user_interrupt(io))
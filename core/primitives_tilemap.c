@@ -13,6 +13,15 @@
 //  canvas: a C loop in place of hundreds of Logo stamps, after which the
 //  baked pixels are ordinary canvas that the pen draws over.
 //
+//  `settiles`, `filltiles`, `copytiles` and `shifttiles` change many cells
+//  in one call, and `animtile` cycles a bank slot through other slots on the
+//  demon tick; once `stampmap` has put the board on the canvas, both re-bake
+//  just the cells that changed.
+//
+//  `setlayer` picks which of the stacked maps the map primitives address,
+//  and `setscroll` and `settransparent` set that layer's offset and
+//  see-through colour; `stampmap` bakes all the layers at once.
+//
 //  The storage and the sampler live in core/tilemap.c; this file is the Logo
 //  surface plus the two device calls the bake needs (capture a canvas region,
 //  write a run of canvas pixels).
@@ -22,7 +31,10 @@
 #include "error.h"
 #include "limits.h"
 #include "tilemap.h"
+#include "format.h"
+#include "memory.h"
 #include "devices/io.h"
+#include <math.h>
 
 // Get the console's turtle operations, or NULL if not available
 static const LogoConsoleTurtle *get_turtle_ops(void)
@@ -86,11 +98,132 @@ static void bake_rect(const LogoConsoleTurtle *turtle, int x, int y, int w, int
     }
 }
 
-// Ready to bake: a bank, a map, and a device that can write the canvas.
+// Ready to bake: a bank, a map on some layer, and a device that can write
+// the canvas.
 static bool bake_ready(const LogoConsoleTurtle *turtle)
 {
     return turtle && turtle->canvas_write_row &&
-           tilemap_tile_size() > 0 && tilemap_cols() > 0;
+           tilemap_tile_size() > 0 && tilemap_has_map();
+}
+
+// Set by `stampmap`, cleared by `cs`, `clean`, `loadpic`, `newtiles`,
+// `newmap` and `setscroll`: while the board is on the canvas, the bulk
+// primitives and the animations re-bake the cells they change. The viewport
+// it was baked through is kept as well; only C code moves the viewport, and
+// a board baked through another one is as stale.
+static bool stamped = false;
+static int stamp_view[4];
+
+// True while the board stampmap baked is still the one on the canvas
+static bool board_stamped(const LogoConsoleTurtle *turtle)
+{
+    int x, y, w, h;
+    if (stamped && !(turtle && view_rect(turtle, &x, &y, &w, &h) &&
+                     x == stamp_view[0] && y == stamp_view[1] &&
+                     w == stamp_view[2] && h == stamp_view[3]))
+    {
+        stamped = false;
+    }
+    return stamped;
+}
+
+// Re-bake every on-screen copy of a rectangle of the current layer's cells
+// (0-based). Sampling wraps, so a world smaller than the viewport shows a
+// cell more than once, and a scroll that is not a whole number of tiles
+// shows part of one at the viewport's left or top edge.
+static void bake_cells(const LogoConsoleTurtle *turtle, int col, int row, int w, int h)
+{
+    int vx, vy, vw, vh;
+    if (!bake_ready(turtle) || tilemap_cols() == 0 || !view_rect(turtle, &vx, &vy, &vw, &vh))
+    {
+        return;
+    }
+
+    int size = tilemap_tile_size();
+    int world_w = tilemap_cols() * size;
+    int world_h = tilemap_rows() * size;
+    int scroll_x, scroll_y;
+    tilemap_get_scroll(&scroll_x, &scroll_y);
+
+    // The first copy starts up to a world's width left of the viewport, so
+    // one that straddles its edge is caught too
+    int first_x = vx + wrap_mod(col * size - scroll_x, world_w) - world_w;
+    int first_y = vy + wrap_mod(row * size - scroll_y, world_h) - world_h;
+
+    for (int sy = first_y; sy < vy + vh; sy += world_h)
+    {
+        int y0 = sy > vy ? sy : vy;
+        int y1 = sy + h * size < vy + vh ? sy + h * size : vy + vh;
+        if (y1 <= y0) continue;
+
+        for (int sx = first_x; sx < vx + vw; sx += world_w)
+        {
+            int x0 = sx > vx ? sx : vx;
+            int x1 = sx + w * size < vx + vw ? sx + w * size : vx + vw;
+            if (x1 <= x0) continue;
+
+            bake_rect(turtle, x0, y0, x1 - x0, y1 - y0);
+        }
+    }
+}
+
+// Re-bake the on-screen cells, on every layer, whose map value is a slot set
+// in `slots`: only the cells on screen are looked at, not the whole map.
+static void bake_slots(const LogoConsoleTurtle *turtle, const uint8_t *slots)
+{
+    int vx, vy, vw, vh;
+    if (!bake_ready(turtle) || !view_rect(turtle, &vx, &vy, &vw, &vh))
+    {
+        return;
+    }
+
+    int size = tilemap_tile_size();
+    int saved = tilemap_layer();
+    for (int l = 0; l < TILEMAP_LAYERS; l++)
+    {
+        tilemap_select_layer(l);
+        int cols = tilemap_cols();
+        int rows = tilemap_rows();
+        if (cols == 0)
+        {
+            continue;
+        }
+
+        int scroll_x, scroll_y;
+        tilemap_get_scroll(&scroll_x, &scroll_y);
+        int c0 = wrap_mod(scroll_x, cols * size) / size;
+        int r0 = wrap_mod(scroll_y, rows * size) / size;
+
+        // A part cell at each edge, and no cell twice
+        int across = vw / size + 2 < cols ? vw / size + 2 : cols;
+        int down = vh / size + 2 < rows ? vh / size + 2 : rows;
+
+        for (int r = 0; r < down; r++)
+        {
+            int row = (r0 + r) % rows;
+            for (int c = 0; c < across; c++)
+            {
+                int col = (c0 + c) % cols;
+                int slot = tilemap_cell(col, row);
+                if (slot > 0 && (slots[slot / 8] & (1u << (slot % 8))))
+                {
+                    bake_cells(turtle, col, row, 1, 1);
+                }
+            }
+        }
+    }
+    tilemap_select_layer(saved);
+}
+
+// After a bulk update of the current layer: re-bake what changed, if the
+// board is on the canvas
+static void bulk_done(int col, int row, int w, int h)
+{
+    const LogoConsoleTurtle *turtle = get_turtle_ops();
+    if (board_stamped(turtle))
+    {
+        bake_cells(turtle, col, row, w, h);
+    }
 }
 
 //==========================================================================
@@ -109,6 +242,8 @@ static Result prim_newtiles(Evaluator *eval, int argc, Value *args)
         return result_error_arg(ERR_DOESNT_LIKE_INPUT, NULL, value_to_string(args[0]));
     }
 
+    // The board was baked from the old bank, whether or not a new one fits
+    tiles_unstamp();
     if (!tilemap_new_tiles((int)size))
     {
         return result_error(ERR_OUT_OF_SPACE);
@@ -168,6 +303,7 @@ static Result prim_newmap(Evaluator *eval, int argc, Value *args)
     }
 
     // Dimensions are sound, so a refusal here is the tier's capacity.
+    tiles_unstamp();
     if (!tilemap_new_map((int)cols, (int)rows))
     {
         return result_error(ERR_OUT_OF_SPACE);
@@ -222,6 +358,407 @@ static Result prim_tile(Evaluator *eval, int argc, Value *args)
     return result_ok(value_number((float)tilemap_cell((int)col - 1, (int)row - 1)));
 }
 
+//==========================================================================
+// Bulk updates and animation
+//==========================================================================
+
+// A tile number, 0..255, from a list element
+static bool tile_number(Node element, uint8_t *out)
+{
+    float n;
+    if (!value_to_number(value_of_element(element), &n) || !is_int_in(n, 0, 255))
+    {
+        return false;
+    }
+    *out = (uint8_t)n;
+    return true;
+}
+
+// Count the tile numbers of one row list; -1 if any is not a tile number
+static int row_length(Node list)
+{
+    int n = 0;
+    uint8_t cell;
+    for (; !mem_is_nil(list); list = mem_cdr(list), n++)
+    {
+        if (!tile_number(mem_car(list), &cell))
+        {
+            return -1;
+        }
+    }
+    return n;
+}
+
+// The shape of a `settiles` input: a list of row lists, or one row as a list
+// of numbers. False if any row holds something other than tile numbers.
+static bool block_shape(Node list, int *w, int *h)
+{
+    *w = 0;
+    *h = 0;
+    if (mem_is_nil(list))
+    {
+        return true;
+    }
+    if (mem_is_word(mem_car(list)))
+    {
+        *w = row_length(list);
+        *h = 1;
+        return *w >= 0;
+    }
+    for (; !mem_is_nil(list); list = mem_cdr(list), (*h)++)
+    {
+        Node row = mem_car(list);
+        int n = mem_is_word(row) ? -1 : row_length(row);
+        if (n < 0)
+        {
+            return false;
+        }
+        if (n > *w)
+        {
+            *w = n;
+        }
+    }
+    return true;
+}
+
+static void write_row(int col, int row, Node list)
+{
+    uint8_t cell = 0;
+    for (; !mem_is_nil(list); list = mem_cdr(list), col++)
+    {
+        tile_number(mem_car(list), &cell);
+        tilemap_set_cell(col, row, cell);
+    }
+}
+
+// settiles col row list - Write a block of cells with its top-left at (col,
+// row): a list of rows, each a list of tile numbers, or a single row as a
+// list of numbers. Rows may differ in length; a short row leaves the cells
+// past its end alone.
+static Result prim_settiles(Evaluator *eval, int argc, Value *args)
+{
+    UNUSED(eval);
+    REQUIRE_ARGC(3);
+    REQUIRE_NUMBER(args[0], col);
+    REQUIRE_NUMBER(args[1], row);
+    REQUIRE_LIST(args[2]);
+
+    if (!is_int_in(col, 1, tilemap_cols()))
+    {
+        return result_error_arg(ERR_DOESNT_LIKE_INPUT, NULL, value_to_string(args[0]));
+    }
+    if (!is_int_in(row, 1, tilemap_rows()))
+    {
+        return result_error_arg(ERR_DOESNT_LIKE_INPUT, NULL, value_to_string(args[1]));
+    }
+
+    // Check the whole block before writing any of it
+    Node list = args[2].as.node;
+    int w, h;
+    if (!block_shape(list, &w, &h) ||
+        w > tilemap_cols() - ((int)col - 1) || h > tilemap_rows() - ((int)row - 1))
+    {
+        return result_error_arg(ERR_DOESNT_LIKE_INPUT, NULL, value_to_string(args[2]));
+    }
+    if (w == 0)
+    {
+        return result_none();
+    }
+
+    int c = (int)col - 1;
+    int r = (int)row - 1;
+    if (mem_is_word(mem_car(list)))
+    {
+        write_row(c, r, list);
+    }
+    else
+    {
+        for (Node rows = list; !mem_is_nil(rows); rows = mem_cdr(rows))
+        {
+            write_row(c, r++, mem_car(rows));
+        }
+    }
+
+    bulk_done((int)col - 1, (int)row - 1, w, h);
+    return result_none();
+}
+
+// The rectangle at args[0..3] (col row width height, 1-based), checked
+// against the current layer's map
+static Result rect_input(Value *args, int *col, int *row, int *w, int *h)
+{
+    float n[4];
+    for (int i = 0; i < 4; i++)
+    {
+        if (!value_to_number(args[i], &n[i]))
+        {
+            return result_error_arg(ERR_DOESNT_LIKE_INPUT, NULL, value_to_string(args[i]));
+        }
+    }
+    float c = n[0], r = n[1], cw = n[2], rh = n[3];
+
+    if (!is_int_in(c, 1, tilemap_cols()))
+    {
+        return result_error_arg(ERR_DOESNT_LIKE_INPUT, NULL, value_to_string(args[0]));
+    }
+    if (!is_int_in(r, 1, tilemap_rows()))
+    {
+        return result_error_arg(ERR_DOESNT_LIKE_INPUT, NULL, value_to_string(args[1]));
+    }
+    if (!is_int_in(cw, 1, tilemap_cols() - ((int)c - 1)))
+    {
+        return result_error_arg(ERR_DOESNT_LIKE_INPUT, NULL, value_to_string(args[2]));
+    }
+    if (!is_int_in(rh, 1, tilemap_rows() - ((int)r - 1)))
+    {
+        return result_error_arg(ERR_DOESNT_LIKE_INPUT, NULL, value_to_string(args[3]));
+    }
+
+    *col = (int)c - 1;
+    *row = (int)r - 1;
+    *w = (int)cw;
+    *h = (int)rh;
+    return result_none();
+}
+
+// filltiles col row width height slot - Set a rectangle of cells to one tile
+static Result prim_filltiles(Evaluator *eval, int argc, Value *args)
+{
+    UNUSED(eval);
+    REQUIRE_ARGC(5);
+
+    int col, row, w, h;
+    Result r = rect_input(args, &col, &row, &w, &h);
+    if (r.status != RESULT_NONE)
+    {
+        return r;
+    }
+    REQUIRE_NUMBER(args[4], slot);
+    if (!is_int_in(slot, 0, 255))
+    {
+        return result_error_arg(ERR_DOESNT_LIKE_INPUT, NULL, value_to_string(args[4]));
+    }
+
+    tilemap_fill_rect(col, row, w, h, (uint8_t)slot);
+    bulk_done(col, row, w, h);
+    return result_none();
+}
+
+// copytiles col row width height tocol torow - Copy a rectangle of cells to
+// another place in the same map; the two may overlap
+static Result prim_copytiles(Evaluator *eval, int argc, Value *args)
+{
+    UNUSED(eval);
+    REQUIRE_ARGC(6);
+
+    int col, row, w, h;
+    Result r = rect_input(args, &col, &row, &w, &h);
+    if (r.status != RESULT_NONE)
+    {
+        return r;
+    }
+    REQUIRE_NUMBER(args[4], to_col);
+    REQUIRE_NUMBER(args[5], to_row);
+    if (!is_int_in(to_col, 1, tilemap_cols() - w + 1))
+    {
+        return result_error_arg(ERR_DOESNT_LIKE_INPUT, NULL, value_to_string(args[4]));
+    }
+    if (!is_int_in(to_row, 1, tilemap_rows() - h + 1))
+    {
+        return result_error_arg(ERR_DOESNT_LIKE_INPUT, NULL, value_to_string(args[5]));
+    }
+
+    tilemap_copy_rect(col, row, w, h, (int)to_col - 1, (int)to_row - 1);
+    bulk_done((int)to_col - 1, (int)to_row - 1, w, h);
+    return result_none();
+}
+
+// shifttiles dx dy - Move every cell of the map dx columns right and dy rows
+// down; what goes off one edge comes back at the other
+static Result prim_shifttiles(Evaluator *eval, int argc, Value *args)
+{
+    UNUSED(eval);
+    REQUIRE_ARGC(2);
+    REQUIRE_NUMBER(args[0], dx);
+    REQUIRE_NUMBER(args[1], dy);
+
+    if (tilemap_cols() == 0)
+    {
+        return result_error_arg(ERR_DOESNT_LIKE_INPUT, NULL, value_to_string(args[0]));
+    }
+    if (!is_int_in(dx, -65535, 65535))
+    {
+        return result_error_arg(ERR_DOESNT_LIKE_INPUT, NULL, value_to_string(args[0]));
+    }
+    if (!is_int_in(dy, -65535, 65535))
+    {
+        return result_error_arg(ERR_DOESNT_LIKE_INPUT, NULL, value_to_string(args[1]));
+    }
+
+    tilemap_shift((int)dx, (int)dy);
+    bulk_done(0, 0, tilemap_cols(), tilemap_rows());
+    return result_none();
+}
+
+// animtile slot frames interval - Show slot as each tile in frames in turn,
+// moving on every interval milliseconds ([] or 0 stops)
+static Result prim_animtile(Evaluator *eval, int argc, Value *args)
+{
+    UNUSED(eval);
+    REQUIRE_ARGC(3);
+    REQUIRE_NUMBER(args[0], slot);
+    REQUIRE_LIST(args[1]);
+    REQUIRE_NUMBER(args[2], interval);
+
+    if (!is_int_in(slot, 1, tilemap_bank_slots() - 1))
+    {
+        return result_error_arg(ERR_DOESNT_LIKE_INPUT, NULL, value_to_string(args[0]));
+    }
+
+    uint8_t frames[TILEMAP_ANIM_FRAMES];
+    int count = 0;
+    for (Node list = args[1].as.node; !mem_is_nil(list); list = mem_cdr(list))
+    {
+        if (count == TILEMAP_ANIM_FRAMES || !tile_number(mem_car(list), &frames[count]))
+        {
+            return result_error_arg(ERR_DOESNT_LIKE_INPUT, NULL, value_to_string(args[1]));
+        }
+        count++;
+    }
+    if (!is_int_in(interval, 0, 65535))
+    {
+        return result_error_arg(ERR_DOESNT_LIKE_INPUT, NULL, value_to_string(args[2]));
+    }
+
+    int before = tilemap_frame((int)slot);
+    if (!tilemap_animate((int)slot, frames, count, (uint32_t)interval))
+    {
+        return result_error(ERR_OUT_OF_SPACE);
+    }
+
+    if (tilemap_frame((int)slot) != before && board_stamped(get_turtle_ops()))
+    {
+        uint8_t changed[TILEMAP_MAX_SLOTS / 8] = {0};
+        changed[(int)slot / 8] = (uint8_t)(1u << ((int)slot % 8));
+        bake_slots(get_turtle_ops(), changed);
+    }
+    return result_none();
+}
+
+//==========================================================================
+// Layers and scroll
+//==========================================================================
+
+// setlayer n - Choose the layer (1 = base) the map primitives address
+static Result prim_setlayer(Evaluator *eval, int argc, Value *args)
+{
+    UNUSED(eval);
+    REQUIRE_ARGC(1);
+    REQUIRE_NUMBER(args[0], layer);
+
+    if (!is_int_in(layer, 1, TILEMAP_LAYERS))
+    {
+        return result_error_arg(ERR_DOESNT_LIKE_INPUT, NULL, value_to_string(args[0]));
+    }
+
+    tilemap_select_layer((int)layer - 1);
+    return result_none();
+}
+
+// layer - Output the current layer
+static Result prim_layer(Evaluator *eval, int argc, Value *args)
+{
+    UNUSED(eval); UNUSED(argc); UNUSED(args);
+    return result_ok(value_number((float)(tilemap_layer() + 1)));
+}
+
+// settransparent colour - Make a palette index see-through on the current
+// layer; -1 makes the layer opaque again
+static Result prim_settransparent(Evaluator *eval, int argc, Value *args)
+{
+    UNUSED(eval);
+    REQUIRE_ARGC(1);
+    REQUIRE_NUMBER(args[0], colour);
+
+    if (!is_int_in(colour, -1, 255))
+    {
+        return result_error_arg(ERR_DOESNT_LIKE_INPUT, NULL, value_to_string(args[0]));
+    }
+
+    tilemap_set_transparent((int)colour);
+    return result_none();
+}
+
+// transparent - Output the current layer's see-through index, or -1
+static Result prim_transparent(Evaluator *eval, int argc, Value *args)
+{
+    UNUSED(eval); UNUSED(argc); UNUSED(args);
+    return result_ok(value_number((float)tilemap_transparent()));
+}
+
+// A scroll offset in world pixels: any number, taken down to the pixel
+// below it, within a range whose wrap arithmetic cannot overflow
+static bool scroll_input(Value v, int *out)
+{
+    float f;
+    if (!value_to_number(v, &f) || !(f > -1e9f && f < 1e9f))
+    {
+        return false;
+    }
+    *out = (int)floorf(f);
+    return true;
+}
+
+// setscroll x y - Set the world pixel at the current layer's viewport
+// top-left (x right, y down, like col and row)
+static Result prim_setscroll(Evaluator *eval, int argc, Value *args)
+{
+    UNUSED(eval);
+    REQUIRE_ARGC(2);
+
+    int x, y;
+    if (!scroll_input(args[0], &x))
+    {
+        return result_error_arg(ERR_DOESNT_LIKE_INPUT, NULL, value_to_string(args[0]));
+    }
+    if (!scroll_input(args[1], &y))
+    {
+        return result_error_arg(ERR_DOESNT_LIKE_INPUT, NULL, value_to_string(args[1]));
+    }
+
+    // The board sits at the old scroll; re-baking cells at the new one
+    // would patch it in the wrong places
+    int old_x, old_y;
+    tilemap_get_scroll(&old_x, &old_y);
+    tilemap_set_scroll(x, y);
+    int new_x, new_y;
+    tilemap_get_scroll(&new_x, &new_y);
+    if (new_x != old_x || new_y != old_y)
+    {
+        tiles_unstamp();
+    }
+    return result_none();
+}
+
+// scroll - Output the current layer's scroll as [x y]
+static Result prim_scroll(Evaluator *eval, int argc, Value *args)
+{
+    UNUSED(eval); UNUSED(argc); UNUSED(args);
+
+    int x, y;
+    tilemap_get_scroll(&x, &y);
+
+    Node x_node = number_to_element((float)x);
+    Node y_node = number_to_element((float)y);
+    Node list = mem_is_nil(y_node) ? NODE_NIL : mem_cons(y_node, NODE_NIL);
+    list = mem_is_nil(list) || mem_is_nil(x_node) ? NODE_NIL : mem_cons(x_node, list);
+    if (mem_is_nil(list))
+    {
+        return result_error(ERR_OUT_OF_SPACE);
+    }
+    return result_ok(value_list(list));
+}
+
 //==========================================================================
 // The bake path
 //==========================================================================
@@ -236,6 +773,11 @@ static Result prim_stampmap(Evaluator *eval, int argc, Value *args)
     if (bake_ready(turtle) && view_rect(turtle, &x, &y, &w, &h))
     {
         bake_rect(turtle, x, y, w, h);
+        stamped = true;
+        stamp_view[0] = x;
+        stamp_view[1] = y;
+        stamp_view[2] = w;
+        stamp_view[3] = h;
     }
 
     return result_none();
@@ -258,50 +800,46 @@ static Result prim_stamptile(Evaluator *eval, int argc, Value *args)
         return result_error_arg(ERR_DOESNT_LIKE_INPUT, NULL, value_to_string(args[1]));
     }
 
-    const LogoConsoleTurtle *turtle = get_turtle_ops();
-    int vx, vy, vw, vh;
-    if (!bake_ready(turtle) || !view_rect(turtle, &vx, &vy, &vw, &vh))
-    {
-        return result_none();
-    }
-
-    int size = tilemap_tile_size();
-    int world_w = tilemap_cols() * size;
-    int world_h = tilemap_rows() * size;
-    int scroll_x, scroll_y;
-    tilemap_get_scroll(&scroll_x, &scroll_y);
-
-    // Sampling wraps, so a world smaller than the viewport shows the same
-    // cell more than once; re-bake every copy of it that is on screen.
-    int first_x = vx + wrap_mod(((int)col - 1) * size - scroll_x, world_w);
-    int first_y = vy + wrap_mod(((int)row - 1) * size - scroll_y, world_h);
+    bake_cells(get_turtle_ops(), (int)col - 1, (int)row - 1, 1, 1);
+    return result_none();
+}
 
-    for (int sy = first_y; sy < vy + vh; sy += world_h)
+void tiles_tick(uint32_t dt_ms)
+{
+    uint8_t changed[TILEMAP_MAX_SLOTS / 8] = {0};
+    const LogoConsoleTurtle *turtle = get_turtle_ops();
+    if (tilemap_tick(dt_ms, changed) && board_stamped(turtle))
     {
-        int h = size;
-        if (sy + h > vy + vh) h = vy + vh - sy;
-
-        for (int sx = first_x; sx < vx + vw; sx += world_w)
-        {
-            int w = size;
-            if (sx + w > vx + vw) w = vx + vw - sx;
-
-            bake_rect(turtle, sx, sy, w, h);
-        }
+        bake_slots(turtle, changed);
     }
+}
 
-    return result_none();
+void tiles_unstamp(void)
+{
+    stamped = false;
 }
 
 void primitives_tilemap_init(void)
 {
     tilemap_reset();
+    stamped = false;
 
     primitive_register("newtiles", 1, prim_newtiles);
     primitive_register("snaptile", 1, prim_snaptile);
     primitive_register("newmap", 2, prim_newmap);
     primitive_register("settile", 3, prim_settile);
     primitive_register("tile", 2, prim_tile);
+    primitive_register("settiles", 3, prim_settiles);
+    primitive_register("filltiles", 5, prim_filltiles);
+    primitive_register("copytiles", 6, prim_copytiles);
+    primitive_register("shifttiles", 2, prim_shifttiles);
+    primitive_register("animtile", 3, prim_animtile);
+    primitive_register("setlayer", 1, prim_setlayer);
+    primitive_register("layer", 0, prim_layer);
+    primitive_register("settransparent", 1, prim_settransparent);
+    primitive_register("transparent", 0, prim_transparent);
+    primitive_register("setscroll", 2, prim_setscroll);
+    primitive_register("scroll", 0, prim_scroll);
     primitive_register("stampmap", 0, prim_stampmap);
     primitive_register("stamptile", 2, prim_stamptile);
 }
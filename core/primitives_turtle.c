@@ -11,10 +11,12 @@
 #include "eval.h"
 #include "frame_sync.h"
 #include "limits.h"
+#include "memory.h"
 #include "devices/io.h"
 #include "devices/palette.h"
 #include <math.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 #include <strings.h>
 
@@ -194,6 +196,48 @@ static Value make_position_list(float x, float y)
     return value_list(mem_cons(x_atom, mem_cons(y_atom, NODE_NIL)));
 }
 
+//==========================================================================
+// Polygon recording for `filled`
+//
+// While a `filled` block runs, every turtle move appends the first active
+// turtle's new position here. The buffer grows on demand and is freed when
+// the outermost block ends, so it costs nothing outside one.
+//==========================================================================
+
+static float *filled_xy = NULL;     // x, y pairs in Logo coordinates
+static int filled_count = 0;
+static int filled_capacity = 0;
+static int filled_depth = 0;        // Nesting of running `filled` blocks
+static bool filled_overflow = false;
+
+// Record the first active turtle's position as the next vertex, if a
+// `filled` block is running. Called after the fan-out loop of each move.
+static void filled_note(const LogoConsoleTurtle *turtle)
+{
+    if (filled_depth == 0 || filled_overflow || !turtle->get_position)
+    {
+        return;
+    }
+    if (filled_count == filled_capacity)
+    {
+        int capacity = filled_capacity + 32;
+        float *xy = NULL;
+        if (capacity <= LOGO_FILLED_VERTICES)
+        {
+            xy = (float *)realloc(filled_xy, (size_t)capacity * 2 * sizeof(float));
+        }
+        if (xy == NULL)
+        {
+            filled_overflow = true;
+            return;
+        }
+        filled_xy = xy;
+        filled_capacity = capacity;
+    }
+    turtle->get_position(&filled_xy[filled_count * 2], &filled_xy[filled_count * 2 + 1]);
+    filled_count++;
+}
+
 //==========================================================================
 // Movement primitives
 //==========================================================================
@@ -218,6 +262,7 @@ static Result prim_back(Evaluator *eval, int argc, Value *args)
             }
         }
         select_first_active(turtle);
+        filled_note(turtle);
     }
 
     return result_none();
@@ -243,6 +288,7 @@ static Result prim_forward(Evaluator *eval, int argc, Value *args)
             }
         }
         select_first_active(turtle);
+        filled_note(turtle);
     }
 
     return result_none();
@@ -262,6 +308,7 @@ static Result prim_home(Evaluator *eval, int argc, Value *args)
             turtle->home();
         }
         select_first_active(turtle);
+        filled_note(turtle);
     }
 
     return result_none();
@@ -293,6 +340,7 @@ static Result prim_setpos(Evaluator *eval, int argc, Value *args)
             }
         }
         select_first_active(turtle);
+        filled_note(turtle);
     }
 
     return result_none();
@@ -320,6 +368,7 @@ static Result prim_setx(Evaluator *eval, int argc, Value *args)
             }
         }
         select_first_active(turtle);
+        filled_note(turtle);
     }
 
     return result_none();
@@ -347,6 +396,7 @@ static Result prim_sety(Evaluator *eval, int argc, Value *args)
             }
         }
         select_first_active(turtle);
+        filled_note(turtle);
     }
 
     return result_none();
@@ -863,6 +913,9 @@ static Result prim_clearscreen(Evaluator *eval, int argc, Value *args)
     // http.unlisten).
     turtle_stop_motion();
 
+    // The tile map survives, but the board baked from it does not
+    tiles_unstamp();
+
     const LogoConsoleTurtle *turtle = get_turtle_ops();
     if (turtle)
     {
@@ -941,6 +994,9 @@ static Result prim_clean(Evaluator *eval, int argc, Value *args)
 {
     UNUSED(eval); UNUSED(argc); UNUSED(args);
 
+    // As for cs: the board baked on the canvas goes with it
+    tiles_unstamp();
+
     const LogoConsoleTurtle *turtle = get_turtle_ops();
     if (turtle && turtle->clear)
     {
@@ -1024,6 +1080,50 @@ static Result prim_fill(Evaluator *eval, int argc, Value *args)
     return result_none();
 }
 
+// filled colour [instructions] - Run the instructions, recording where the
+// turtle goes, then fill the polygon it traced with colour (even-odd). The
+// path starts at the turtle's position when the block begins and is closed
+// back to it. Lines the instructions draw are drawn as usual; the fill goes
+// over them.
+static Result prim_filled(Evaluator *eval, int argc, Value *args)
+{
+    REQUIRE_ARGC(2);
+    REQUIRE_NUMBER(args[0], colour);
+    REQUIRE_LIST(args[1]);
+
+    const LogoConsoleTurtle *turtle = get_turtle_ops();
+    if (!turtle)
+    {
+        return eval_run_list(eval, args[1].as.node);
+    }
+
+    int start = filled_count;
+    filled_depth++;
+    filled_note(turtle);
+
+    Result r = eval_run_list(eval, args[1].as.node);
+    if (r.status == RESULT_NONE && filled_overflow)
+    {
+        r = result_error(ERR_OUT_OF_SPACE);
+    }
+    if (r.status == RESULT_NONE && filled_count - start >= 3 && turtle->fill_polygon)
+    {
+        turtle->fill_polygon(&filled_xy[start * 2], filled_count - start, (uint8_t)colour);
+    }
+
+    filled_depth--;
+    if (filled_depth == 0)
+    {
+        free(filled_xy);
+        filled_xy = NULL;
+        filled_count = 0;
+        filled_capacity = 0;
+        filled_overflow = false;
+    }
+
+    return r;
+}
+
 // arc - Draw an arc centred on the turtle; the turtle does not move
 static Result prim_arc(Evaluator *eval, int argc, Value *args)
 {
@@ -1799,35 +1899,113 @@ static inline bool raster_solid(const LogoTurtleRaster *r, int i)
     return r->indexed ? (v != LOGO_RASTER_TRANSPARENT) : (v != 0);
 }
 
+// Packed collision mask for one turtle's raster: bit c of rows[r] is set when
+// mask pixel (c, r) is opaque, and x0..x1/y0..y1 (exclusive) box the opaque
+// pixels. Kept per turtle and repacked only when the device reports a new
+// serial, so a turtle that is not being rebuilt costs one compare per test.
+typedef struct
+{
+    const uint8_t *mask;
+    uint32_t serial;
+    uint8_t w, h;
+    bool indexed;
+    bool empty;                  // No opaque pixel at all
+    uint8_t x0, y0, x1, y1;
+    uint32_t rows[LOGO_RASTER_MAX];
+} CollideMask;
+
+static CollideMask collide_masks[MAX_TURTLES];
+
+// Turtle n's packed mask for raster r, repacking it if r is new
+static const CollideMask *collide_mask(uint8_t n, const LogoTurtleRaster *r)
+{
+    CollideMask *m = &collide_masks[n];
+    if (r->serial != 0 && m->serial == r->serial && m->mask == r->mask &&
+        m->w == r->w && m->h == r->h && m->indexed == r->indexed)
+    {
+        return m;
+    }
+
+    m->mask = r->mask;
+    m->serial = r->serial;
+    m->w = r->w;
+    m->h = r->h;
+    m->indexed = r->indexed;
+
+    int w = r->w < LOGO_RASTER_MAX ? r->w : LOGO_RASTER_MAX;
+    int h = r->h < LOGO_RASTER_MAX ? r->h : LOGO_RASTER_MAX;
+    int x0 = w, y0 = h, x1 = 0, y1 = 0;
+    for (int row = 0; row < h; row++)
+    {
+        uint32_t bits = 0;
+        for (int col = 0; col < w; col++)
+        {
+            if (raster_solid(r, row * r->w + col))
+            {
+                bits |= (uint32_t)1 << col;
+            }
+        }
+        m->rows[row] = bits;
+        if (bits)
+        {
+            int first = __builtin_ctz(bits);
+            int last = 32 - __builtin_clz(bits);
+            if (first < x0) x0 = first;
+            if (last > x1) x1 = last;
+            if (row < y0) y0 = row;
+            y1 = row + 1;
+        }
+    }
+    m->empty = (x1 == 0);
+    m->x0 = (uint8_t)x0;
+    m->y0 = (uint8_t)y0;
+    m->x1 = (uint8_t)x1;
+    m->y1 = (uint8_t)y1;
+    return m;
+}
+
 // True when any opaque pixel of raster a coincides with one of raster b.
 // In wrap mode (sw/sh nonzero) b is also tested shifted by +/- the screen
 // size, so a contact that straddles an edge counts (the compositor draws
-// such a sprite on both sides).
-static bool rasters_overlap(const LogoTurtleRaster *a, const LogoTurtleRaster *b,
+// such a sprite on both sides). Each placement is rejected on the opaque
+// boxes first; the rows that survive are tested 32 pixels at a time, b's
+// row shifted onto a's columns and AND-ed with a's.
+static bool rasters_overlap(const LogoTurtleRaster *a, const CollideMask *ma,
+                            const LogoTurtleRaster *b, const CollideMask *mb,
                             int sw, int sh)
 {
+    if (ma->empty || mb->empty)
+    {
+        return false;
+    }
+
+    int ax0 = a->x + ma->x0, ax1 = a->x + ma->x1;
+    int ay0 = a->y + ma->y0, ay1 = a->y + ma->y1;
+
     for (int kx = (sw ? -1 : 0); kx <= (sw ? 1 : 0); kx++)
     {
         for (int ky = (sh ? -1 : 0); ky <= (sh ? 1 : 0); ky++)
         {
             int bx = b->x + kx * sw;
             int by = b->y + ky * sh;
+            if (bx + mb->x1 <= ax0 || bx + mb->x0 >= ax1 ||
+                by + mb->y1 <= ay0 || by + mb->y0 >= ay1)
+            {
+                continue;
+            }
 
-            int x0 = a->x > bx ? a->x : bx;
-            int y0 = a->y > by ? a->y : by;
-            int x1 = (a->x + a->w) < (bx + b->w) ? (a->x + a->w) : (bx + b->w);
-            int y1 = (a->y + a->h) < (by + b->h) ? (a->y + a->h) : (by + b->h);
-
+            // b's column c lies on a's column c + dx. The boxes overlap, so
+            // |dx| < LOGO_RASTER_MAX and the shift is defined.
+            int dx = bx - a->x;
+            int y0 = ay0 > by + mb->y0 ? ay0 : by + mb->y0;
+            int y1 = ay1 < by + mb->y1 ? ay1 : by + mb->y1;
             for (int y = y0; y < y1; y++)
             {
-                for (int x = x0; x < x1; x++)
+                uint32_t brow = mb->rows[y - by];
+                brow = dx >= 0 ? brow << dx : brow >> -dx;
+                if (ma->rows[y - a->y] & brow)
                 {
-                    int ai = (y - a->y) * a->w + (x - a->x);
-                    int bi = (y - by) * b->w + (x - bx);
-                    if (raster_solid(a, ai) && raster_solid(b, bi))
-                    {
-                        return true;
-                    }
+                    return true;
                 }
             }
         }
@@ -1869,7 +2047,176 @@ static Result prim_touchingp(Evaluator *eval, int argc, Value *args)
         {
             turtle->sense_metrics(&sw, &sh, &wrap);
         }
-        hit = rasters_overlap(&ra, &rb, wrap ? sw : 0, wrap ? sh : 0);
+        hit = rasters_overlap(&ra, collide_mask(a, &ra), &rb, collide_mask(b, &rb),
+                              wrap ? sw : 0, wrap ? sh : 0);
+    }
+
+    return result_ok(value_bool(hit));
+}
+
+_Static_assert(MAX_TURTLES <= 32, "a grid cell holds its turtles in one word");
+
+// The broad phase: a coarse uniform grid over the screen whose cells each
+// hold a bitmask of the turtles whose opaque box covers them.
+typedef struct
+{
+    uint32_t cells[LOGO_COLLIDE_GRID_MAX * LOGO_COLLIDE_GRID_MAX];
+    int cols, rows;
+    int width, height;
+    bool wrap;
+} CollideGrid;
+
+// Cell count along an axis of `size` pixels. With no screen size to go by
+// (a device without sense_metrics) the grid spans its largest extent.
+static int grid_extent(int *size)
+{
+    if (*size <= 0)
+    {
+        *size = LOGO_COLLIDE_GRID_MAX * LOGO_COLLIDE_CELL;
+    }
+    int cells = (*size + LOGO_COLLIDE_CELL - 1) / LOGO_COLLIDE_CELL;
+    return cells < LOGO_COLLIDE_GRID_MAX ? cells : LOGO_COLLIDE_GRID_MAX;
+}
+
+static int grid_cell(int p, int cells)
+{
+    int c = p >= 0 ? p / LOGO_COLLIDE_CELL : -((-p + LOGO_COLLIDE_CELL - 1) / LOGO_COLLIDE_CELL);
+    return c < 0 ? 0 : (c >= cells ? cells - 1 : c);
+}
+
+// Cell ranges [lo[i], hi[i]] that the pixels [p0, p1) cover on one axis:
+// one range, or two when a wrapped interval crosses the screen edge.
+// Outside wrap mode, cells beyond the screen fold into the edge ones.
+static int grid_ranges(int p0, int p1, int size, int cells, bool wrap,
+                       int lo[2], int hi[2])
+{
+    if (!wrap)
+    {
+        lo[0] = grid_cell(p0, cells);
+        hi[0] = grid_cell(p1 - 1, cells);
+        return 1;
+    }
+    if (p1 - p0 >= size)
+    {
+        lo[0] = 0;
+        hi[0] = cells - 1;
+        return 1;
+    }
+    int start = ((p0 % size) + size) % size;
+    int end = start + (p1 - p0);
+    lo[0] = grid_cell(start, cells);
+    if (end <= size)
+    {
+        hi[0] = grid_cell(end - 1, cells);
+        return 1;
+    }
+    hi[0] = cells - 1;
+    lo[1] = 0;
+    hi[1] = grid_cell(end - size - 1, cells);
+    return 2;
+}
+
+// Visit every cell under a turtle's opaque box: collect the turtles already
+// there, then add `bit` (0 to only look).
+static uint32_t grid_visit(CollideGrid *g, const LogoTurtleRaster *r,
+                           const CollideMask *m, uint32_t bit)
+{
+    int xlo[2], xhi[2], ylo[2], yhi[2];
+    int nx = grid_ranges(r->x + m->x0, r->x + m->x1, g->width, g->cols, g->wrap,
+                         xlo, xhi);
+    int ny = grid_ranges(r->y + m->y0, r->y + m->y1, g->height, g->rows, g->wrap,
+                         ylo, yhi);
+
+    uint32_t seen = 0;
+    for (int j = 0; j < ny; j++)
+    {
+        for (int cy = ylo[j]; cy <= yhi[j]; cy++)
+        {
+            for (int i = 0; i < nx; i++)
+            {
+                for (int cx = xlo[i]; cx <= xhi[i]; cx++)
+                {
+                    uint32_t *cell = &g->cells[cy * g->cols + cx];
+                    seen |= *cell;
+                    *cell |= bit;
+                }
+            }
+        }
+    }
+    return seen;
+}
+
+// touching.any? t - true when turtle t touches any other visible turtle.
+// The visible turtles go into the grid first, so only those sharing a cell
+// with t reach the mask test; with MAX_TURTLES small this mostly saves the
+// pairwise box tests, and keeps the query flat if the turtle count grows.
+static Result prim_touching_anyp(Evaluator *eval, int argc, Value *args)
+{
+    UNUSED(eval);
+    REQUIRE_ARGC(1);
+
+    uint8_t target;
+    Result error;
+    if (!arg_turtle(args[0], &target, &error)) return error;
+
+    const LogoConsoleTurtle *turtle = get_turtle_ops();
+    if (!turtle || !turtle->get_raster)
+    {
+        return result_ok(value_bool(false));
+    }
+
+    LogoTurtleRaster rasters[MAX_TURTLES];
+    const CollideMask *masks[MAX_TURTLES];
+    uint32_t shown = 0;
+    for (uint8_t n = 0; n < MAX_TURTLES; n++)
+    {
+        select_turtle(turtle, n);
+        if (turtle->get_raster(&rasters[n]) && rasters[n].visible)
+        {
+            masks[n] = collide_mask(n, &rasters[n]);
+            if (!masks[n]->empty)
+            {
+                shown |= (uint32_t)1 << n;
+            }
+        }
+    }
+    select_first_active(turtle);
+
+    if (!(shown & ((uint32_t)1 << target)))
+    {
+        return result_ok(value_bool(false));
+    }
+
+    CollideGrid grid;
+    int sw = 0, sh = 0;
+    grid.wrap = false;
+    if (turtle->sense_metrics)
+    {
+        turtle->sense_metrics(&sw, &sh, &grid.wrap);
+    }
+    grid.wrap = grid.wrap && sw > 0 && sh > 0;
+    grid.width = sw;
+    grid.height = sh;
+    grid.cols = grid_extent(&grid.width);
+    grid.rows = grid_extent(&grid.height);
+    memset(grid.cells, 0, sizeof(uint32_t) * (size_t)(grid.cols * grid.rows));
+
+    for (uint8_t n = 0; n < MAX_TURTLES; n++)
+    {
+        if (n != target && (shown & ((uint32_t)1 << n)))
+        {
+            grid_visit(&grid, &rasters[n], masks[n], (uint32_t)1 << n);
+        }
+    }
+
+    uint32_t near = grid_visit(&grid, &rasters[target], masks[target], 0);
+    bool hit = false;
+    while (near && !hit)
+    {
+        uint8_t n = (uint8_t)__builtin_ctz(near);
+        near &= near - 1;
+        hit = rasters_overlap(&rasters[target], masks[target], &rasters[n], masks[n],
+                              grid.wrap ? sw : 0, grid.wrap ? sh : 0);
     }
 
     return result_ok(value_bool(hit));
@@ -1974,6 +2321,21 @@ static Result prim_distance(Evaluator *eval, int argc, Value *args)
 // Registration
 //==========================================================================
 
+// The fill queue lent from the aux region, if there is one
+static void *fill_store = NULL;
+static size_t fill_store_size = 0;
+
+// The console is registered after primitives_turtle_init runs, so
+// primitives_set_io calls this too (as for the editor, B34).
+void primitives_turtle_console_ready(void)
+{
+    const LogoConsoleTurtle *turtle = get_turtle_ops();
+    if (turtle && turtle->set_fill_store)
+    {
+        turtle->set_fill_store(fill_store, fill_store_size);
+    }
+}
+
 void primitives_turtle_init(void)
 {
     // Initialize the core 24-bit palette from default values
@@ -1982,6 +2344,10 @@ void primitives_turtle_init(void)
     // Boot addresses turtle 0 only
     reset_active_set();
 
+    fill_store = mem_region_alloc(LOGO_FILL_STORE_SIZE);
+    fill_store_size = fill_store != NULL ? LOGO_FILL_STORE_SIZE : 0;
+    primitives_turtle_console_ready();
+
     // Movement primitives
     primitive_register("back", 1, prim_back);
     primitive_register("bk", 1, prim_back);
@@ -2046,6 +2412,7 @@ void primitives_turtle_init(void)
     primitive_register("dot?", 1, prim_dotp);
     primitive_register("dotp", 1, prim_dotp);
     primitive_register("fill", 0, prim_fill);
+    primitive_register("filled", 2, prim_filled);
     primitive_register("arc", 2, prim_arc);
     primitive_register("write", 1, prim_write);
     
@@ -2083,6 +2450,8 @@ void primitives_turtle_init(void)
     // Sensing and collision
     primitive_register("touching?", 2, prim_touchingp);
     primitive_register("touchingp", 2, prim_touchingp);
+    primitive_register("touching.any?", 1, prim_touching_anyp);
+    primitive_register("touching.anyp", 1, prim_touching_anyp);
     primitive_register("over?", 1, prim_overp);
     primitive_register("overp", 1, prim_overp);
     primitive_register("colourunder", 0, prim_colourunder);
@@ -77,15 +77,7 @@ static Result prim_first(Evaluator *eval, int argc, Value *args)
             return result_error_arg(ERR_TOO_FEW_ITEMS, NULL, "[]");
         }
         Node first = mem_car(list);
-        // Determine if it's a word or list
-        if (mem_is_word(first))
-        {
-            return result_ok(value_word(first));
-        }
-        else
-        {
-            return result_ok(value_list(first));
-        }
+        return result_ok(value_of_element(first));
     }
     
     return result_error_arg(ERR_DOESNT_LIKE_INPUT, NULL, value_to_string(obj));
@@ -127,14 +119,7 @@ static Result prim_last(Evaluator *eval, int argc, Value *args)
         {
             last = mem_car(n);
         }
-        if (mem_is_word(last))
-        {
-            return result_ok(value_word(last));
-        }
-        else
-        {
-            return result_ok(value_list(last));
-        }
+        return result_ok(value_of_element(last));
     }
     
     return result_error_arg(ERR_DOESNT_LIKE_INPUT, NULL, value_to_string(obj));
@@ -345,14 +330,7 @@ static Result prim_item(Evaluator *eval, int argc, Value *args)
             return result_error_arg(ERR_TOO_FEW_ITEMS, NULL, "[]");
         }
         Node item = mem_car(list);
-        if (mem_is_word(item))
-        {
-            return result_ok(value_word(item));
-        }
-        else
-        {
-            return result_ok(value_list(item));
-        }
+        return result_ok(value_of_element(item));
     }
     
     return result_error_arg(ERR_DOESNT_LIKE_INPUT, NULL, value_to_string(obj));
@@ -570,10 +548,10 @@ static bool member_value_to_node(Value v, Node *out_node, Result *out_err)
 {
     if (value_is_number(v))
     {
-        Node w = number_to_word(v.as.number);
+        Node w = number_to_element(v.as.number);
         if (mem_is_nil(w))
         {
-            *out_err = result_error(ERR_OUT_OF_SPACE); // atom table exhausted
+            *out_err = result_error(ERR_OUT_OF_SPACE); // no cell or atom left
             return false;
         }
         *out_node = w;
@@ -779,11 +757,7 @@ static Result prim_pick(Evaluator *eval, int argc, Value *args)
             list = mem_next_cell(list);
         }
         Node item = mem_car(list);
-        if (mem_is_word(item))
-        {
-            return result_ok(value_word(item));
-        }
-        return result_ok(value_list(item));
+        return result_ok(value_of_element(item));
     }
 
     return result_error_arg(ERR_DOESNT_LIKE_INPUT, NULL, value_to_string(obj));
@@ -1297,8 +1271,7 @@ static Result prim_fput(Evaluator *eval, int argc, Value *args)
     }
     else if (value_is_number(obj))
     {
-        // Convert number to word
-        obj_node = number_to_word(obj.as.number);
+        obj_node = number_to_element(obj.as.number);
     }
     else
     {
@@ -1334,7 +1307,7 @@ static Result prim_list(Evaluator *eval, int argc, Value *args)
         }
         else if (value_is_number(args[i]))
         {
-            obj_node = number_to_word(args[i].as.number);
+            obj_node = number_to_element(args[i].as.number);
         }
         else
         {
@@ -1374,7 +1347,7 @@ static Result prim_lput(Evaluator *eval, int argc, Value *args)
     }
     else if (value_is_number(obj))
     {
-        obj_node = number_to_word(obj.as.number);
+        obj_node = number_to_element(obj.as.number);
     }
     else
     {
@@ -1475,7 +1448,7 @@ static Result prim_sentence(Evaluator *eval, int argc, Value *args)
             }
             else if (value_is_number(args[i]))
             {
-                obj_node = number_to_word(args[i].as.number);
+                obj_node = number_to_element(args[i].as.number);
             }
             else
             {
@@ -1868,39 +1841,39 @@ void primitives_words_lists_init(void)
     // Basic element access
     primitive_register("first", 1, prim_first);
     primitive_register("last", 1, prim_last);
-    primitive_register("butfirst", 1, prim_butfirst);
-    primitive_register("bf", 1, prim_butfirst);
-    primitive_register("butlast", 1, prim_butlast);
-    primitive_register("bl", 1, prim_butlast);
+    primitive_register_rerunnable("butfirst", 1, prim_butfirst);
+    primitive_register_rerunnable("bf", 1, prim_butfirst);
+    primitive_register_rerunnable("butlast", 1, prim_butlast);
+    primitive_register_rerunnable("bl", 1, prim_butlast);
     primitive_register("item", 2, prim_item);
-    primitive_register("replace", 3, prim_replace);
+    primitive_register_rerunnable("replace", 3, prim_replace);
     primitive_register(".setfirst", 2, prim_dsetfirst);
     primitive_register(".setbf", 2, prim_dsetbf);
     primitive_register(".setitem", 3, prim_dsetitem);
     primitive_register("member", 2, prim_member);
-    primitive_register("pick", 1, prim_pick);
-    primitive_register("reverse", 1, prim_reverse);
-    primitive_register("shuffle", 1, prim_shuffle);
-    primitive_register("sort", 1, prim_sort);
-    primitive_register("remove", 2, prim_remove);
-    primitive_register("remdup", 1, prim_remdup);
+    primitive_register_rerunnable("pick", 1, prim_pick);
+    primitive_register_rerunnable("reverse", 1, prim_reverse);
+    primitive_register_rerunnable("shuffle", 1, prim_shuffle);
+    primitive_register_rerunnable("sort", 1, prim_sort);
+    primitive_register_rerunnable("remove", 2, prim_remove);
+    primitive_register_rerunnable("remdup", 1, prim_remdup);
     
     // List construction
-    primitive_register("fput", 2, prim_fput);
-    primitive_register("list", 2, prim_list);
-    primitive_register("lput", 2, prim_lput);
-    primitive_register("sentence", 2, prim_sentence);
-    primitive_register("se", 2, prim_sentence);
+    primitive_register_rerunnable("fput", 2, prim_fput);
+    primitive_register_rerunnable("list", 2, prim_list);
+    primitive_register_rerunnable("lput", 2, prim_lput);
+    primitive_register_rerunnable("sentence", 2, prim_sentence);
+    primitive_register_rerunnable("se", 2, prim_sentence);
     
     // Word operations
-    primitive_register("word", 2, prim_word);
-    primitive_register("parse", 1, prim_parse);
+    primitive_register_rerunnable("word", 2, prim_word);
+    primitive_register_rerunnable("parse", 1, prim_parse);
     
     // Character operations
     primitive_register("ascii", 1, prim_ascii);
-    primitive_register("char", 1, prim_char);
-    primitive_register("lowercase", 1, prim_lowercase);
-    primitive_register("uppercase", 1, prim_uppercase);
+    primitive_register_rerunnable("char", 1, prim_char);
+    primitive_register_rerunnable("lowercase", 1, prim_lowercase);
+    primitive_register_rerunnable("uppercase", 1, prim_uppercase);
     
     // Predicates
     primitive_register("count", 1, prim_count);
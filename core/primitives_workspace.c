@@ -759,27 +759,7 @@ static Result prim_atoms(Evaluator *eval, int argc, Value *args)
 static Result prim_recycle(Evaluator *eval, int argc, Value *args)
 {
     UNUSED(argc); UNUSED(args);
-
-    // Mark the workspace roots: variables, procedure bodies, property lists
-    var_gc_mark_all();
-    proc_gc_mark_all();
-    prop_gc_mark_all();
-
-    // Mark everything the live evaluation still references: procedure
-    // frames (parameters and locals), in-flight operations on the op stack
-    // (loop bodies, saved token positions, staged arguments), the token
-    // source we are currently reading from. Pending tail calls are covered by
-    // proc_gc_mark_all().
-    // Suspended parent evaluators (e.g. across a pause) are covered too:
-    // their state lives on the shared op stack.
-    frame_gc_mark_all(proc_get_frame_stack());
-    op_stack_gc_mark(eval->op_stack);
-    token_source_gc_mark(&eval->token_source);
-    demons_gc_mark_all();
-
-    // Sweep unmarked nodes
-    mem_gc_sweep();
-
+    eval_collect_garbage(eval);
     return result_none();
 }
 
@@ -13,6 +13,7 @@
 #include "primitives.h"
 #include "frame.h"
 #include "limits.h"
+#include "token_source.h"
 #include "devices/io.h"
 #include <ctype.h>
 #include <string.h>
@@ -42,9 +43,19 @@ _Static_assert(MAX_PROCEDURES <= ATOM_MEMO_INDEX_LIMIT,
 // survive into a slot that has been emptied or refilled with another name.
 // Defining happens at load time, not inside frame loops, so a sweep of the
 // atom region is paid where nobody is counting milliseconds.
+//
+// The compiled body code goes with them. It holds no bindings, so this is
+// for space rather than correctness: a replaced body's ops would otherwise
+// hold the arena, and nothing else evicts them. Bodies recompile once they
+// have run twice more.
+//
+// So do the direct global references of variables.c: the new table may give
+// some procedure an input named after a global.
 static void invalidate_name_bindings(void)
 {
     mem_atom_memo_mask_all(ATOM_MEMO_KEEP_CLASS);
+    token_source_flush_code();
+    var_refs_invalidate();
 }
 
 // Tail call state (global for trampoline)
@@ -110,6 +121,22 @@ static int find_procedure_index(const char *name)
     return find_procedure_index_n(name, strlen(name));
 }
 
+// Whether each input name is the one a lookup would find in its slot. With a
+// repeated name (`to f :x :X`) the first always wins, and a cached slot for
+// the second would read the wrong binding.
+static bool params_are_distinct(const char **params, int param_count)
+{
+    for (int i = 1; i < param_count && i < MAX_PROC_PARAMS; i++)
+    {
+        for (int j = 0; j < i; j++)
+        {
+            if (strcasecmp(params[i], params[j]) == 0)
+                return false;
+        }
+    }
+    return true;
+}
+
 bool proc_define(const char *name, const char **params, int param_count, Node body)
 {
     // Check if already exists
@@ -122,6 +149,7 @@ bool proc_define(const char *name, const char **params, int param_count, Node bo
         {
             procedures[idx].params[i] = params[i];
         }
+        procedures[idx].distinct_params = params_are_distinct(params, param_count);
         procedures[idx].body = body;
         invalidate_name_bindings();
         return true;
@@ -138,6 +166,7 @@ bool proc_define(const char *name, const char **params, int param_count, Node bo
             {
                 procedures[i].params[j] = params[j];
             }
+            procedures[i].distinct_params = params_are_distinct(params, param_count);
             procedures[i].body = body;
             procedures[i].buried = false;
             procedures[i].stepped = false;
@@ -182,6 +211,21 @@ UserProcedure *proc_by_index(int index)
     return &procedures[index];
 }
 
+bool proc_has_input_named(const char *name)
+{
+    for (int i = 0; i < procedure_count; i++)
+    {
+        if (procedures[i].name == NULL)
+            continue;
+        for (int j = 0; j < procedures[i].param_count; j++)
+        {
+            if (strcasecmp(procedures[i].params[j], name) == 0)
+                return true;
+        }
+    }
+    return false;
+}
+
 bool proc_exists(const char *name)
 {
     return find_procedure_index(name) >= 0;
@@ -471,6 +515,36 @@ void proc_gc_mark_all(void)
     }
 }
 
+// Workspace images. Only ever run at top level, so there is no procedure
+// running and no tail call pending to keep.
+void proc_image_begin(void)
+{
+    for (int i = 0; i < MAX_PROCEDURES; i++)
+    {
+        procedures[i].name = NULL;
+        procedures[i].param_count = 0;
+        procedures[i].body = NODE_NIL;
+    }
+    procedure_count = 0;
+    proc_clear_tail_call();
+    current_proc_depth = 0;
+}
+
+bool proc_image_add(const UserProcedure *proc)
+{
+    if (procedure_count >= MAX_PROCEDURES || proc->param_count > MAX_PROC_PARAMS)
+        return false;
+    UserProcedure *slot = &procedures[procedure_count++];
+    *slot = *proc;
+    slot->distinct_params = params_are_distinct(slot->params, slot->param_count);
+    return true;
+}
+
+void proc_image_end(void)
+{
+    invalidate_name_bindings();
+}
+
 // Get the global frame stack
 FrameStack *proc_get_frame_stack(void)
 {
@@ -24,6 +24,7 @@
 #include "value.h"
 #include "frame.h"
 #include "limits.h"
+#include "lexer.h"
 
 #ifdef __cplusplus
 extern "C"
@@ -45,6 +46,8 @@ extern "C"
         bool buried;                // If true, hidden from poall/erall/etc
         bool stepped;               // If true, pause at each instruction
         bool traced;                // If true, print trace info on call/return
+        bool distinct_params;       // No two inputs share a name (ignoring case),
+                                    // so a parameter slot can be cached
     } UserProcedure;
 
     // Tail call information for optimization
@@ -95,6 +98,11 @@ extern "C"
     int proc_index_of(const UserProcedure *proc);
     UserProcedure *proc_by_index(int index);
 
+    // Whether any defined procedure has an input called `name` (ignoring
+    // case) -- a name a call could bind in its frame. variables.c asks before
+    // it reads a global without searching the frames.
+    bool proc_has_input_named(const char *name);
+
     // Bury/unbury procedures
     void proc_bury(const char *name);
     void proc_unbury(const char *name);
@@ -137,9 +145,30 @@ extern "C"
     // Returns a Result - RESULT_NONE on success, RESULT_ERROR on failure
     Result proc_define_from_text(const char *text);
 
+    // The same, reading from `lexer`, whose token `*t` is the `to`. Stops
+    // with `*t` the closing `end` (or EOF), not yet past it. With
+    // `end_closes_line` an `end` counts only as the last word on its line,
+    // outside any parentheses unless it starts the line -- the rule `load`
+    // has always used, which lets a one-line definition close on the line it
+    // opens, and reaching EOF first is an error (End of data) that defines
+    // nothing. Without it, `end` must start a line and EOF closes the body.
+    Result proc_define_from_lexer(Lexer *lexer, Token *t, bool end_closes_line);
+
+    // One instruction line read from `lexer`, starting at `*t`, as the list
+    // a procedure body holds for it: up to the first token on a later line,
+    // which is left in `*t`. A bracketed list may run across lines.
+    Node proc_parse_line(Lexer *lexer, Token *t);
+
     // Mark all procedure bodies as GC roots
     void proc_gc_mark_all(void);
 
+    // Workspace images (core/workspace_image.c): empty the table, refill it
+    // in order with procedures whose names and bodies are already in the
+    // arena, then drop every cached binding once at the end.
+    void proc_image_begin(void);
+    bool proc_image_add(const UserProcedure *proc);
+    void proc_image_end(void);
+
     // Get the global frame stack (for passing to evaluator).
     //
     // OWNERSHIP: the frame stack is owned (allocated and zeroed) by
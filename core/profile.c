@@ -0,0 +1,299 @@
+//
+//  Pico Logo
+//  Copyright 2026 Blair Leduc. See LICENSE for details.
+//
+//  `.profile`: call counts and inclusive/exclusive time per procedure and
+//  primitive. See profile.h.
+//
+//  The table is open-addressed on the UserProcedure or Primitive pointer,
+//  so entering a call is a hash, usually one probe, and a clock read. A
+//  shadow stack of open calls carries each call's start time and the time
+//  spent in the calls it made; when a call ends its elapsed time, less its
+//  children's, is its exclusive time, and the whole of it is charged to its
+//  caller's children. A recursive procedure's inclusive time is taken only
+//  when its outermost call ends, so the recursion is not counted twice.
+//
+//  The table and stack are one heap block, allocated by the first start and
+//  kept: a workspace that never profiles pays nothing for them.
+//
+
+#include "profile.h"
+#include "limits.h"
+#include "memory.h"
+#include <stdlib.h>
+#include <string.h>
+
+_Static_assert((LOGO_PROFILE_ENTRIES & (LOGO_PROFILE_ENTRIES - 1)) == 0,
+               "LOGO_PROFILE_ENTRIES must be a power of two");
+_Static_assert(LOGO_PROFILE_ENTRIES <= 65536,
+               "a profile stack level holds a 16-bit row index");
+
+typedef struct
+{
+    const void *key;   // UserProcedure or Primitive; NULL when the row is free
+    const char *name;
+    uint32_t calls;
+    uint32_t total_us;
+    uint32_t self_us;
+    uint16_t active;   // Calls of this key open on the stack
+} ProfileEntry;
+
+typedef struct
+{
+    uint16_t entry;
+    uint32_t start;
+    uint32_t child_us;
+} ProfileLevel;
+
+typedef struct
+{
+    ProfileEntry entries[LOGO_PROFILE_ENTRIES];
+    ProfileLevel stack[LOGO_PROFILE_DEPTH];
+} ProfileTable;
+
+bool profile_running = false;
+
+static ProfileTable *g_table = NULL;
+static LogoIO *g_io = NULL;
+static int g_used = 0;          // Rows in use
+static int g_depth = 0;         // Levels in use
+static uint32_t g_deep = 0;     // Calls open beyond LOGO_PROFILE_DEPTH
+static uint32_t g_dropped = 0;  // Calls that found no row
+
+static inline uint32_t profile_hash(const void *key)
+{
+    return ((uint32_t)((uintptr_t)key >> 2) * 2654435761u) &
+           (LOGO_PROFILE_ENTRIES - 1);
+}
+
+// The row for `key`, claimed if new. NULL once the table is three quarters
+// full and `key` is not in it.
+static ProfileEntry *profile_find(const void *key, const char *name)
+{
+    uint32_t i = profile_hash(key);
+    for (;;)
+    {
+        ProfileEntry *e = &g_table->entries[i];
+        if (e->key == key)
+        {
+            return e;
+        }
+        if (e->key == NULL)
+        {
+            if (g_used >= LOGO_PROFILE_ENTRIES / 4 * 3)
+            {
+                return NULL;
+            }
+            e->key = key;
+            e->name = name;
+            g_used++;
+            return e;
+        }
+        i = (i + 1) & (LOGO_PROFILE_ENTRIES - 1);
+    }
+}
+
+bool profile_start(LogoIO *io)
+{
+    if (g_table == NULL)
+    {
+        g_table = (ProfileTable *)malloc(sizeof(ProfileTable));
+        if (g_table == NULL)
+        {
+            return false;
+        }
+    }
+    memset(g_table, 0, sizeof(ProfileTable));
+    g_io = io;
+    g_used = 0;
+    g_depth = 0;
+    g_deep = 0;
+    g_dropped = 0;
+    profile_running = true;
+    return true;
+}
+
+void profile_stop(void)
+{
+    profile_running = false;
+    g_depth = 0;
+    g_deep = 0;
+}
+
+void profile_clear(void)
+{
+    if (g_table != NULL)
+    {
+        memset(g_table, 0, sizeof(ProfileTable));
+    }
+    g_used = 0;
+    g_depth = 0;
+    g_deep = 0;
+    g_dropped = 0;
+}
+
+void profile_enter(const void *key, const char *name)
+{
+    if (!profile_running)
+    {
+        return;
+    }
+
+    ProfileEntry *e = profile_find(key, name);
+    if (e == NULL)
+    {
+        g_dropped++;
+        return;
+    }
+    e->calls++;
+    if (g_depth >= LOGO_PROFILE_DEPTH)
+    {
+        g_deep++;
+        return;
+    }
+
+    ProfileLevel *level = &g_table->stack[g_depth++];
+    level->entry = (uint16_t)(e - g_table->entries);
+    level->child_us = 0;
+    e->active++;
+    level->start = logo_io_ticks_us(g_io);
+}
+
+void profile_exit(const void *key)
+{
+    if (!profile_running)
+    {
+        return;
+    }
+    if (g_deep > 0)
+    {
+        g_deep--;
+        return;
+    }
+
+    // A call that began before the profiler started is not on the stack
+    int match = g_depth - 1;
+    while (match >= 0 && g_table->entries[g_table->stack[match].entry].key != key)
+    {
+        match--;
+    }
+    if (match < 0)
+    {
+        return;
+    }
+
+    uint32_t now = logo_io_ticks_us(g_io);
+    while (g_depth > match)
+    {
+        ProfileLevel *level = &g_table->stack[--g_depth];
+        ProfileEntry *e = &g_table->entries[level->entry];
+        uint32_t elapsed = now - level->start;
+
+        e->self_us += elapsed - level->child_us;
+        if (--e->active == 0)
+        {
+            e->total_us += elapsed;
+        }
+        if (g_depth > 0)
+        {
+            g_table->stack[g_depth - 1].child_us += elapsed;
+        }
+    }
+}
+
+void profile_count(const void *key)
+{
+    if (!profile_running)
+    {
+        return;
+    }
+    // The row exists unless the call that entered it was dropped
+    uint32_t i = profile_hash(key);
+    while (g_table->entries[i].key != NULL)
+    {
+        if (g_table->entries[i].key == key)
+        {
+            g_table->entries[i].calls++;
+            return;
+        }
+        i = (i + 1) & (LOGO_PROFILE_ENTRIES - 1);
+    }
+    g_dropped++;
+}
+
+// True if row `a` reports before row `b`: more exclusive time, then more
+// calls, then the lower row so the order is total.
+static bool profile_before(int a, int b)
+{
+    const ProfileEntry *ea = &g_table->entries[a];
+    const ProfileEntry *eb = &g_table->entries[b];
+    if (ea->self_us != eb->self_us)
+    {
+        return ea->self_us > eb->self_us;
+    }
+    if (ea->calls != eb->calls)
+    {
+        return ea->calls > eb->calls;
+    }
+    return a < b;
+}
+
+bool profile_next(int *cursor, ProfileRow *out)
+{
+    if (g_table == NULL)
+    {
+        return false;
+    }
+
+    // Selection by scan: the report is read rarely and the table is small
+    int prev = *cursor;
+    int best = -1;
+    for (int i = 0; i < LOGO_PROFILE_ENTRIES; i++)
+    {
+        if (g_table->entries[i].key == NULL)
+        {
+            continue;
+        }
+        if (prev >= 0 && !profile_before(prev, i))
+        {
+            continue;
+        }
+        if (best < 0 || profile_before(i, best))
+        {
+            best = i;
+        }
+    }
+    if (best < 0)
+    {
+        return false;
+    }
+
+    const ProfileEntry *e = &g_table->entries[best];
+    out->name = e->name;
+    out->calls = e->calls;
+    out->total_us = e->total_us;
+    out->self_us = e->self_us;
+    *cursor = best;
+    return true;
+}
+
+uint32_t profile_dropped(void)
+{
+    return g_dropped;
+}
+
+void profile_gc_mark(void)
+{
+    if (g_table == NULL)
+    {
+        return;
+    }
+    // Primitive names are C strings; mem_gc_mark_atom_ptr ignores them
+    for (int i = 0; i < LOGO_PROFILE_ENTRIES; i++)
+    {
+        if (g_table->entries[i].key != NULL)
+        {
+            mem_gc_mark_atom_ptr(g_table->entries[i].name);
+        }
+    }
+}
@@ -0,0 +1,73 @@
+//
+//  Pico Logo
+//  Copyright 2026 Blair Leduc. See LICENSE for details.
+//
+//  `.profile`: an instrumented profiler for procedures and primitives.
+//  While it runs, every procedure call (step_proc_call) and primitive call
+//  (eval_call_primitive) is counted and timed on the device's microsecond
+//  clock, inclusive and exclusive of the calls it makes, into a fixed
+//  table. `.profile.report` reads the table back as a Logo list.
+//
+
+#pragma once
+
+#include "devices/io.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+    // True while the profiler runs. The call sites test it before calling in,
+    // so a stopped profiler costs a load and a branch per call.
+    extern bool profile_running;
+
+    // Clear the table and start timing on `io`'s clock. False if the table
+    // could not be allocated (the first start allocates it).
+    bool profile_start(LogoIO *io);
+
+    // Stop timing. The table keeps its figures for the report.
+    void profile_stop(void);
+
+    // Forget every row, running or not. The rows are keyed on procedure
+    // slots and name their atoms, so a workspace image that replaces both
+    // (.loadws) drops them.
+    void profile_clear(void);
+
+    // A call of `key` (a UserProcedure or Primitive) named `name` begins.
+    void profile_enter(const void *key, const char *name);
+
+    // The innermost call of `key` ends. Calls above it on the profiler's
+    // stack that never ended -- unwound by an error or a throw -- end with
+    // it, at the same time.
+    void profile_exit(const void *key);
+
+    // A self-recursive tail call of `key` reused its frame: one more call,
+    // timed as part of the call it replaced.
+    void profile_count(const void *key);
+
+    // One row of the report.
+    typedef struct
+    {
+        const char *name;
+        uint32_t calls;
+        uint32_t total_us;   // Inclusive; a recursive call counts once
+        uint32_t self_us;    // Exclusive of timed calls it made
+    } ProfileRow;
+
+    // Walk the rows in order of exclusive time, largest first: start with
+    // `*cursor` at -1; false after the last row.
+    bool profile_next(int *cursor, ProfileRow *out);
+
+    // Calls that found the table full and were not recorded.
+    uint32_t profile_dropped(void);
+
+    // GC root support: a procedure's name is an atom, and the procedure may
+    // be erased before the report is read.
+    void profile_gc_mark(void);
+
+#ifdef __cplusplus
+}
+#endif
@@ -38,19 +38,10 @@ static Node prop_value_to_node(Value v)
     }
     else if (value_is_number(v))
     {
-        // Store numbers as word atoms.
-        //
-        // PRECISION NOTE: this round-trips the value through
-        // `format_number` (single-precision %g style) and then back via
-        // `value_to_number` on read. The on-disk representation is the
-        // formatted text, not the binary float, so very small or very
-        // large values may lose a few least-significant bits compared
-        // to the original. Callers that need bit-exact storage should
-        // wrap the value in a single-element list, which is preserved
-        // verbatim.
-        char buf[32];
-        format_number(buf, sizeof(buf), v.as.number);
-        return mem_atom_cstr(buf);
+        // Store numbers as number nodes, which keep the float bit-exact.
+        // Only when the pool cannot box one is it stored as its word,
+        // which round-trips through `format_number`'s six digits.
+        return number_to_element(v.as.number);
     }
     return NODE_NIL;
 }
@@ -62,6 +53,10 @@ static Value prop_node_to_value(Node n)
     {
         return value_list(NODE_NIL);
     }
+    else if (mem_is_number(n))
+    {
+        return value_number(mem_number_value(n));
+    }
     else if (mem_is_word(n))
     {
         // Check if it's a number (handles e/E and n/N notation)
@@ -362,3 +357,13 @@ void prop_gc_mark_all(void)
     // Mark the entire property list structure
     mem_gc_mark(property_lists);
 }
+
+Node prop_image_list(void)
+{
+    return property_lists;
+}
+
+void prop_image_restore(Node lists)
+{
+    property_lists = lists;
+}
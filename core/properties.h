@@ -50,6 +50,10 @@ extern "C"
     // Mark all property values as GC roots
     void prop_gc_mark_all(void);
 
+    // Workspace images (core/workspace_image.c): the master list whole.
+    Node prop_image_list(void);
+    void prop_image_restore(Node lists);
+
 #ifdef __cplusplus
 }
 #endif
@@ -13,9 +13,6 @@
 #include "limits.h"
 #include "memory.h"
 
-// Highest map cell value, and so the highest addressable slot.
-#define TILEMAP_MAX_SLOTS 256
-
 static uint8_t *bank_pool = NULL;   // tile pixels, slot n at n * slot_bytes
 static size_t bank_bytes = 0;
 static uint8_t *map_pool = NULL;    // one byte per cell, row-major
@@ -26,11 +23,44 @@ static int tile_shift = 0;          // log2(tile_size)
 static int bank_slots = 0;
 static uint8_t slot_filled_bits[TILEMAP_MAX_SLOTS / 8];
 
-static int map_cols = 0;
-static int map_rows = 0;
+// Per layer, the filled slots holding that layer's transparent index: the
+// only tiles the sampler copies pixel by pixel. Kept current by
+// tilemap_slot_fill_done and tilemap_set_transparent.
+static uint8_t slot_keyed_bits[TILEMAP_LAYERS][TILEMAP_MAX_SLOTS / 8];
+
+// A layer's map lives in the map pool at `offset`; the layers' maps are
+// packed in layer order, so resizing one moves those above it.
+typedef struct
+{
+    size_t offset;
+    int cols;                       // 0 = no map on this layer
+    int rows;
+    int scroll_x, scroll_y;
+    bool keyed;                     // Has a see-through palette index...
+    uint8_t transparent;            // ...which is this
+} TileLayer;
+
+static TileLayer layers[TILEMAP_LAYERS];
+static int current = 0;             // The layer the map and view calls address
+
+// An animated slot steps through `frames`, one every `period_ms`; `elapsed`
+// is the time since the current frame came up.
+typedef struct
+{
+    uint8_t slot;                   // 0 = this entry is free
+    uint8_t count;
+    uint8_t frame;                  // Index into frames
+    uint8_t frames[TILEMAP_ANIM_FRAMES];
+    uint32_t period_ms;
+    uint32_t elapsed_ms;
+} TileAnim;
+
+static TileAnim anims[TILEMAP_ANIMS];
+
+// The slot the sampler draws for each map value: itself, unless animated.
+static uint8_t slot_frame[TILEMAP_MAX_SLOTS];
 
 static int view_x = 0, view_y = 0, view_w = 0, view_h = 0;
-static int scroll_x = 0, scroll_y = 0;
 
 // Both pools follow the HTTP transfer buffer's pattern: prefer the aux/PSRAM
 // region, else one process-lifetime heap allocation of the SRAM tier. Neither
@@ -66,6 +96,81 @@ static int wrap_mod(int v, int m)
     return (v < 0) ? v + m : v;
 }
 
+static bool bit_test(const uint8_t *bits, int n)
+{
+    return (bits[n / 8] & (uint8_t)(1u << (n % 8))) != 0;
+}
+
+static void bit_set(uint8_t *bits, int n, bool on)
+{
+    if (on)
+        bits[n / 8] |= (uint8_t)(1u << (n % 8));
+    else
+        bits[n / 8] &= (uint8_t)~(1u << (n % 8));
+}
+
+// Does a slot's tile hold the palette index `key` anywhere?
+static bool slot_holds(int slot, int key)
+{
+    size_t bytes = (size_t)(tile_size * tile_size);
+    return memchr(tilemap_slot_pixels(slot), key, bytes) != NULL;
+}
+
+static void anims_clear(void)
+{
+    memset(anims, 0, sizeof(anims));
+    for (int i = 0; i < TILEMAP_MAX_SLOTS; i++)
+    {
+        slot_frame[i] = (uint8_t)i;
+    }
+}
+
+// The current layer's cells from (col, row), a row of the map apart
+static uint8_t *cell_ptr(int col, int row)
+{
+    const TileLayer *layer = &layers[current];
+    return map_pool + layer->offset + (size_t)row * (size_t)layer->cols + (size_t)col;
+}
+
+static bool rect_in_map(int col, int row, int w, int h)
+{
+    const TileLayer *layer = &layers[current];
+    return w >= 1 && h >= 1 && col >= 0 && row >= 0 &&
+           w <= layer->cols - col && h <= layer->rows - row;
+}
+
+static void reverse(uint8_t *p, size_t n)
+{
+    for (size_t i = 0, j = n; i + 1 < j; i++, j--)
+    {
+        uint8_t t = p[i];
+        p[i] = p[j - 1];
+        p[j - 1] = t;
+    }
+}
+
+// Rotate p[0 .. n) right by k in place: three reversals, no buffer
+static void rotate_right(uint8_t *p, size_t n, size_t k)
+{
+    if (n == 0 || (k %= n) == 0)
+    {
+        return;
+    }
+    reverse(p, n);
+    reverse(p, k);
+    reverse(p + k, n - k);
+}
+
+static void layer_clear(TileLayer *layer)
+{
+    layer->cols = 0;
+    layer->rows = 0;
+    layer->scroll_x = 0;
+    layer->scroll_y = 0;
+    layer->keyed = false;
+    layer->transparent = 0;
+}
+
 //
 // Bank
 //
@@ -88,6 +193,8 @@ bool tilemap_new_tiles(int size)
     bank_slots = (slots > TILEMAP_MAX_SLOTS) ? TILEMAP_MAX_SLOTS : slots;
 
     memset(slot_filled_bits, 0, sizeof(slot_filled_bits));
+    memset(slot_keyed_bits, 0, sizeof(slot_keyed_bits));
+    anims_clear();
     return true;
 }
 
@@ -112,9 +219,18 @@ uint8_t *tilemap_slot_pixels(int slot)
 
 void tilemap_slot_fill_done(int slot)
 {
-    if (slot >= 0 && slot < bank_slots)
+    if (slot < 0 || slot >= bank_slots)
+    {
+        return;
+    }
+    bit_set(slot_filled_bits, slot, true);
+
+    // Scan the tile once here so the sampler knows, per layer, whether it
+    // can copy it whole
+    for (int l = 0; l < TILEMAP_LAYERS; l++)
     {
-        slot_filled_bits[slot / 8] |= (uint8_t)(1u << (slot % 8));
+        bit_set(slot_keyed_bits[l], slot,
+                layers[l].keyed && slot_holds(slot, layers[l].transparent));
     }
 }
 
@@ -124,7 +240,7 @@ bool tilemap_slot_filled(int slot)
     {
         return false;
     }
-    return (slot_filled_bits[slot / 8] & (uint8_t)(1u << (slot % 8))) != 0;
+    return bit_test(slot_filled_bits, slot);
 }
 
 //
@@ -152,48 +268,276 @@ bool tilemap_new_map(int cols, int rows)
     {
         return false;
     }
+
+    // Every layer's map shares the pool, so the room left for this one is
+    // what the others do not use
+    TileLayer *layer = &layers[current];
+    size_t old_cells = (size_t)layer->cols * (size_t)layer->rows;
+    size_t others = 0;
+    for (int l = 0; l < TILEMAP_LAYERS; l++)
+    {
+        others += (size_t)layers[l].cols * (size_t)layers[l].rows;
+    }
+    others -= old_cells;
+    int room = capacity - (int)others;
+
     // Guard the product against overflow before comparing it to the cap:
     // both inputs are already positive, so the division is exact enough.
-    if (cols > capacity / rows)
+    if (room <= 0 || cols > room / rows)
     {
         return false;
     }
 
-    map_cols = cols;
-    map_rows = rows;
-    memset(map_pool, 0, (size_t)cols * (size_t)rows);
+    // Move the maps above this one to just past its new end
+    size_t new_cells = (size_t)cols * (size_t)rows;
+    size_t above = others;
+    for (int l = 0; l < current; l++)
+    {
+        above -= (size_t)layers[l].cols * (size_t)layers[l].rows;
+    }
+    memmove(map_pool + layer->offset + new_cells, map_pool + layer->offset + old_cells, above);
+    for (int l = current + 1; l < TILEMAP_LAYERS; l++)
+    {
+        layers[l].offset = layers[l].offset + new_cells - old_cells;
+    }
+
+    layer->cols = cols;
+    layer->rows = rows;
+    memset(map_pool + layer->offset, 0, new_cells);
     return true;
 }
 
+bool tilemap_has_map(void)
+{
+    for (int l = 0; l < TILEMAP_LAYERS; l++)
+    {
+        if (layers[l].cols > 0)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
 int tilemap_cols(void)
 {
-    return map_cols;
+    return layers[current].cols;
 }
 
 int tilemap_rows(void)
 {
-    return map_rows;
+    return layers[current].rows;
 }
 
 int tilemap_cell(int col, int row)
 {
-    if (col < 0 || col >= map_cols || row < 0 || row >= map_rows)
+    const TileLayer *layer = &layers[current];
+    if (col < 0 || col >= layer->cols || row < 0 || row >= layer->rows)
     {
         return -1;
     }
-    return map_pool[(size_t)row * (size_t)map_cols + (size_t)col];
+    return map_pool[layer->offset + (size_t)row * (size_t)layer->cols + (size_t)col];
 }
 
 bool tilemap_set_cell(int col, int row, uint8_t value)
 {
-    if (col < 0 || col >= map_cols || row < 0 || row >= map_rows)
+    const TileLayer *layer = &layers[current];
+    if (col < 0 || col >= layer->cols || row < 0 || row >= layer->rows)
     {
         return false;
     }
-    map_pool[(size_t)row * (size_t)map_cols + (size_t)col] = value;
+    map_pool[layer->offset + (size_t)row * (size_t)layer->cols + (size_t)col] = value;
     return true;
 }
 
+bool tilemap_fill_rect(int col, int row, int w, int h, uint8_t value)
+{
+    if (!rect_in_map(col, row, w, h))
+    {
+        return false;
+    }
+    for (int r = 0; r < h; r++)
+    {
+        memset(cell_ptr(col, row + r), value, (size_t)w);
+    }
+    return true;
+}
+
+bool tilemap_copy_rect(int src_col, int src_row, int w, int h, int dst_col, int dst_row)
+{
+    if (!rect_in_map(src_col, src_row, w, h) || !rect_in_map(dst_col, dst_row, w, h))
+    {
+        return false;
+    }
+
+    // Rows overlap only when the rectangles do; copy them in the order that
+    // reads each source row before it is written over (memmove covers the
+    // overlap within a row)
+    for (int i = 0; i < h; i++)
+    {
+        int r = (dst_row > src_row) ? h - 1 - i : i;
+        memmove(cell_ptr(dst_col, dst_row + r), cell_ptr(src_col, src_row + r), (size_t)w);
+    }
+    return true;
+}
+
+void tilemap_shift(int dx, int dy)
+{
+    const TileLayer *layer = &layers[current];
+    if (layer->cols == 0)
+    {
+        return;
+    }
+
+    // The map is row-major, so moving whole rows down is one rotation of
+    // all the cells, and moving cells right is one rotation of each row
+    size_t cols = (size_t)layer->cols;
+    size_t rows = (size_t)layer->rows;
+    rotate_right(cell_ptr(0, 0), cols * rows, (size_t)wrap_mod(dy, layer->rows) * cols);
+
+    size_t k = (size_t)wrap_mod(dx, layer->cols);
+    for (size_t r = 0; k != 0 && r < rows; r++)
+    {
+        rotate_right(cell_ptr(0, (int)r), cols, k);
+    }
+}
+
+//
+// Animation
+//
+
+bool tilemap_animate(int slot, const uint8_t *frames, int count, uint32_t period_ms)
+{
+    if (slot < 1 || slot >= bank_slots || count < 0 || count > TILEMAP_ANIM_FRAMES)
+    {
+        return false;
+    }
+
+    TileAnim *anim = NULL;
+    TileAnim *free_anim = NULL;
+    for (int i = 0; i < TILEMAP_ANIMS; i++)
+    {
+        if (anims[i].slot == slot)
+            anim = &anims[i];
+        else if (anims[i].slot == 0 && free_anim == NULL)
+            free_anim = &anims[i];
+    }
+
+    if (count == 0 || period_ms == 0)
+    {
+        if (anim)
+        {
+            anim->slot = 0;
+        }
+        slot_frame[slot] = (uint8_t)slot;
+        return true;
+    }
+
+    if (anim == NULL)
+    {
+        anim = free_anim;
+    }
+    if (anim == NULL)
+    {
+        return false;
+    }
+
+    anim->slot = (uint8_t)slot;
+    anim->count = (uint8_t)count;
+    anim->frame = 0;
+    memcpy(anim->frames, frames, (size_t)count);
+    anim->period_ms = period_ms;
+    anim->elapsed_ms = 0;
+    slot_frame[slot] = frames[0];
+    return true;
+}
+
+int tilemap_frame(int slot)
+{
+    if (slot < 0 || slot >= TILEMAP_MAX_SLOTS)
+    {
+        return slot;
+    }
+    return slot_frame[slot];
+}
+
+bool tilemap_tick(uint32_t dt_ms, uint8_t *changed)
+{
+    bool any = false;
+    for (int i = 0; i < TILEMAP_ANIMS; i++)
+    {
+        TileAnim *anim = &anims[i];
+        if (anim->slot == 0)
+        {
+            continue;
+        }
+
+        // A long gap (a slow frame, a `wait`) skips frames rather than
+        // playing them all back
+        anim->elapsed_ms += dt_ms;
+        if (anim->elapsed_ms < anim->period_ms)
+        {
+            continue;
+        }
+        uint32_t steps = anim->elapsed_ms / anim->period_ms;
+        anim->elapsed_ms %= anim->period_ms;
+        anim->frame = (uint8_t)((anim->frame + steps % anim->count) % anim->count);
+
+        uint8_t shown = anim->frames[anim->frame];
+        if (slot_frame[anim->slot] != shown)
+        {
+            slot_frame[anim->slot] = shown;
+            bit_set(changed, anim->slot, true);
+            any = true;
+        }
+    }
+    return any;
+}
+
+//
+// Layers
+//
+
+bool tilemap_select_layer(int layer)
+{
+    if (layer < 0 || layer >= TILEMAP_LAYERS)
+    {
+        return false;
+    }
+    current = layer;
+    return true;
+}
+
+int tilemap_layer(void)
+{
+    return current;
+}
+
+void tilemap_set_transparent(int index)
+{
+    TileLayer *layer = &layers[current];
+    layer->keyed = index >= 0 && index <= 255;
+    layer->transparent = layer->keyed ? (uint8_t)index : 0;
+
+    memset(slot_keyed_bits[current], 0, sizeof(slot_keyed_bits[current]));
+    if (!layer->keyed)
+    {
+        return;
+    }
+    for (int slot = 1; slot < bank_slots; slot++)
+    {
+        if (tilemap_slot_filled(slot) && slot_holds(slot, layer->transparent))
+        {
+            bit_set(slot_keyed_bits[current], slot, true);
+        }
+    }
+}
+
+int tilemap_transparent(void)
+{
+    return layers[current].keyed ? layers[current].transparent : -1;
+}
+
 //
 // View
 //
@@ -216,42 +560,50 @@ void tilemap_get_viewport(int *x, int *y, int *w, int *h)
 
 void tilemap_set_scroll(int x, int y)
 {
-    scroll_x = x;
-    scroll_y = y;
+    layers[current].scroll_x = x;
+    layers[current].scroll_y = y;
 }
 
 void tilemap_get_scroll(int *x, int *y)
 {
-    if (x) *x = scroll_x;
-    if (y) *y = scroll_y;
+    if (x) *x = layers[current].scroll_x;
+    if (y) *y = layers[current].scroll_y;
 }
 
 //
 // Sampler
 //
 
-void tilemap_fill_row(uint8_t *dst, int y, int x0, int x1, uint8_t bg)
+// Copy a run of tile pixels, leaving dst alone where the tile has `key`
+// (or painting `bg` there, for the base layer)
+static void copy_keyed(uint8_t *dst, const uint8_t *src, int count, uint8_t key,
+                       bool base, uint8_t bg)
 {
-    int count = x1 - x0;
-    if (dst == NULL || count <= 0)
-    {
-        return;
-    }
-    if (tile_size == 0 || map_cols == 0)
+    for (int i = 0; i < count; i++)
     {
-        memset(dst, bg, (size_t)count);
-        return;
+        uint8_t p = src[i];
+        if (p != key)
+            dst[i] = p;
+        else if (base)
+            dst[i] = bg;
     }
+}
 
+// One layer's pixels for dst[0 .. count), screen row `y` from column x0.
+// The base layer covers the whole span, painting `bg` where it has no tile;
+// a layer above it draws only its tiles' opaque pixels.
+static void fill_layer(int l, uint8_t *dst, int y, int x0, int count, bool base, uint8_t bg)
+{
+    const TileLayer *layer = &layers[l];
     const int mask = tile_size - 1;
-    int world_w = map_cols * tile_size;
-    int world_h = map_rows * tile_size;
+    int world_w = layer->cols * tile_size;
+    int world_h = layer->rows * tile_size;
 
-    int wy = wrap_mod(scroll_y + (y - view_y), world_h);
-    const uint8_t *cells = map_pool + (size_t)(wy >> tile_shift) * (size_t)map_cols;
+    int wy = wrap_mod(layer->scroll_y + (y - view_y), world_h);
+    const uint8_t *cells = map_pool + layer->offset + (size_t)(wy >> tile_shift) * (size_t)layer->cols;
     int ty = wy & mask;
 
-    int wx = wrap_mod(scroll_x + (x0 - view_x), world_w);
+    int wx = wrap_mod(layer->scroll_x + (x0 - view_x), world_w);
     int done = 0;
 
     while (done < count)
@@ -265,13 +617,20 @@ void tilemap_fill_row(uint8_t *dst, int y, int x0, int x1, uint8_t bg)
             run = count - done;
         }
 
-        int cell = cells[wx >> tile_shift];
+        int cell = slot_frame[cells[wx >> tile_shift]];
         if (cell != 0 && tilemap_slot_filled(cell))
         {
             const uint8_t *src = tilemap_slot_pixels(cell) + (size_t)ty * (size_t)tile_size + (size_t)tx;
-            memcpy(dst + done, src, (size_t)run);
+            if (bit_test(slot_keyed_bits[l], cell))
+            {
+                copy_keyed(dst + done, src, run, layer->transparent, base, bg);
+            }
+            else
+            {
+                memcpy(dst + done, src, (size_t)run);
+            }
         }
-        else
+        else if (base)
         {
             memset(dst + done, bg, (size_t)run);
         }
@@ -285,16 +644,50 @@ void tilemap_fill_row(uint8_t *dst, int y, int x0, int x1, uint8_t bg)
     }
 }
 
+void tilemap_fill_row(uint8_t *dst, int y, int x0, int x1, uint8_t bg)
+{
+    int count = x1 - x0;
+    if (dst == NULL || count <= 0)
+    {
+        return;
+    }
+    if (tile_size == 0 || layers[0].cols == 0)
+    {
+        memset(dst, bg, (size_t)count);
+    }
+    else
+    {
+        fill_layer(0, dst, y, x0, count, true, bg);
+    }
+    if (tile_size == 0)
+    {
+        return;
+    }
+
+    for (int l = 1; l < TILEMAP_LAYERS; l++)
+    {
+        if (layers[l].cols > 0)
+        {
+            fill_layer(l, dst, y, x0, count, false, bg);
+        }
+    }
+}
+
 void tilemap_reset(void)
 {
     tile_size = 0;
     tile_shift = 0;
     bank_slots = 0;
     memset(slot_filled_bits, 0, sizeof(slot_filled_bits));
+    memset(slot_keyed_bits, 0, sizeof(slot_keyed_bits));
+    anims_clear();
 
-    map_cols = 0;
-    map_rows = 0;
+    for (int l = 0; l < TILEMAP_LAYERS; l++)
+    {
+        layers[l].offset = 0;
+        layer_clear(&layers[l]);
+    }
+    current = 0;
 
     view_x = view_y = view_w = view_h = 0;
-    scroll_x = scroll_y = 0;
 }
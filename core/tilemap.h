@@ -13,6 +13,19 @@
 //  `stampmap` bakes into the canvas (and, once the live view lands, what the
 //  compositor will build a row from).
 //
+//  There are TILEMAP_LAYERS maps, each with its own scroll and optionally a
+//  transparent palette index, drawn bottom to top into the same row: a
+//  starfield scrolling slowly under a faster playfield, or an overlay over
+//  both. Layer 0 is the base and paints the background where it has no tile;
+//  the layers above draw only their tiles' opaque pixels. The map and view
+//  calls below address the *current* layer (tilemap_select_layer); the
+//  viewport and the bank are shared.
+//
+//  A slot can also be animated: the sampler draws it as each of a list of
+//  slots in turn, advanced by tilemap_tick, so every cell naming it changes
+//  at once with no change to the map. The bulk calls fill, copy and rotate
+//  a rectangle of the current layer's cells in one pass.
+//
 //  Everything here is device-independent -- no console ops, no screen size --
 //  so the whole storage and sampling layer unit-tests natively. The one
 //  concession to the display is that view state is in *screen pixels*: the
@@ -25,13 +38,16 @@
 #include <stdbool.h>
 #include <stdint.h>
 
+// Map cells are bytes, so this many slots can be named (slot 0 is background)
+#define TILEMAP_MAX_SLOTS 256
+
 //
 // Bank
 //
 
-// Set the tile size (8 or 16) and clear the bank. Allocates the pool on
-// first use, preferring the aux/PSRAM region. Returns false when the size is
-// not 8 or 16, or when no pool could be allocated.
+// Set the tile size (8 or 16) and clear the bank, stopping every animation.
+// Allocates the pool on first use, preferring the aux/PSRAM region. Returns
+// false when the size is not 8 or 16, or when no pool could be allocated.
 bool tilemap_new_tiles(int size);
 
 // Tile size in pixels, or 0 when there is no bank yet.
@@ -45,7 +61,8 @@ int tilemap_bank_slots(void);
 // Writable pixels of a bank slot (tile_size * tile_size bytes, row-major), or
 // NULL when the slot is out of range. Filling a slot through this pointer
 // must be followed by tilemap_slot_fill_done() so the sampler stops treating
-// it as empty.
+// it as empty; that is also where the tile is scanned once for each layer's
+// transparent index, so the sampler copies whole any tile without it.
 uint8_t *tilemap_slot_pixels(int slot);
 void tilemap_slot_fill_done(int slot);
 
@@ -57,17 +74,22 @@ bool tilemap_slot_filled(int slot);
 // Map
 //
 
-// Allocate (on first use) and zero a cols x rows map. Returns false when the
-// dimensions are not positive, the product exceeds the active tier's cap, or
-// no pool could be allocated.
+// Allocate (on first use) and zero a cols x rows map on the current layer.
+// All layers share the pool, and the others keep their cells. Returns false
+// when the dimensions are not positive, the product exceeds what the other
+// layers leave of the active tier's cap, or no pool could be allocated.
 bool tilemap_new_map(int cols, int rows);
 
+// True when any layer has a map.
+bool tilemap_has_map(void);
+
 // Map dimensions in cells; 0 when there is no map.
 int tilemap_cols(void);
 int tilemap_rows(void);
 
-// Largest number of cells the active tier allows. Allocates the pool if it
-// has not been allocated yet, so `newmap` can report the real cap.
+// Largest number of cells the active tier allows, across all layers.
+// Allocates the pool if it has not been allocated yet, so `newmap` can report
+// the real cap.
 int tilemap_map_capacity(void);
 
 // Read/write a cell, 0-based (the primitives are 1-based, like `item`).
@@ -75,11 +97,57 @@ int tilemap_map_capacity(void);
 int tilemap_cell(int col, int row);
 bool tilemap_set_cell(int col, int row, uint8_t value);
 
+// Bulk updates on the current layer, 0-based. Each returns false, changing
+// nothing, when the rectangle does not lie wholly inside the map.
+bool tilemap_fill_rect(int col, int row, int w, int h, uint8_t value);
+
+// Copy a w x h rectangle of cells from (src_col, src_row) to (dst_col,
+// dst_row); the two may overlap.
+bool tilemap_copy_rect(int src_col, int src_row, int w, int h, int dst_col, int dst_row);
+
+// Rotate the whole map dx cells right and dy cells down, the cells pushed
+// off one edge coming back in at the other, as the sampler wraps.
+void tilemap_shift(int dx, int dy);
+
+//
+// Animation
+//
+
+// Animate `slot` through `count` frames (slot numbers, 0 for background),
+// starting on the first and moving on every `period_ms`. A count or period
+// of 0 stops it, and the slot shows itself again. Returns false when the
+// slot is not 1..tilemap_bank_slots()-1, count exceeds TILEMAP_ANIM_FRAMES,
+// or TILEMAP_ANIMS other slots are already animated.
+bool tilemap_animate(int slot, const uint8_t *frames, int count, uint32_t period_ms);
+
+// The slot the sampler draws for `slot` now: itself unless animated.
+int tilemap_frame(int slot);
+
+// Advance every animation by dt_ms. Sets the bit (n % 8 of byte n / 8) in
+// `changed`, TILEMAP_MAX_SLOTS / 8 bytes, of each slot whose frame changed,
+// and returns true if any did.
+bool tilemap_tick(uint32_t dt_ms, uint8_t *changed);
+
+//
+// Layers
+//
+
+// Choose the layer (0 .. TILEMAP_LAYERS-1) the map and scroll calls address.
+// Returns false, changing nothing, when out of range.
+bool tilemap_select_layer(int layer);
+int tilemap_layer(void);
+
+// Make a palette index see-through on the current layer, or none with -1
+// (the default). Rescans the filled slots for it.
+void tilemap_set_transparent(int index);
+int tilemap_transparent(void);
+
 //
 // View
 //
 // The viewport is the screen rectangle the map is drawn through, and scroll
-// is the world pixel that appears at its top-left corner. Sampling wraps
+// is the world pixel that appears at its top-left corner, per layer, so
+// layers scrolled at different rates give parallax. Sampling wraps
 // modulo the world's pixel size in both axes; a bounded world clamps its own
 // scroll values.
 //
@@ -96,16 +164,20 @@ void tilemap_get_scroll(int *x, int *y);
 // Sampler
 //
 // Fill dst[0 .. x1-x0) with the map pixels for screen row `y`, screen columns
-// [x0, x1). `bg` is the colour painted for cell 0 and for cells naming an
-// empty slot. The caller has already clipped the span to the viewport; the
-// span's position relative to the viewport origin is what selects the world
-// pixels. A call with no bank or no map fills the span with `bg`.
+// [x0, x1), every layer with a map composited in order. `bg` is the colour
+// the base layer paints for cell 0, for cells naming an empty slot, and for
+// its transparent index; on the layers above, those show what is beneath.
+// Tiles without the layer's transparent index are copied a run at a time.
+// The caller has already clipped the span to the viewport; the span's
+// position relative to the viewport origin is what selects the world
+// pixels. A call with no bank or no base map fills the span with `bg`.
 //
 void tilemap_fill_row(uint8_t *dst, int y, int x0, int x1, uint8_t bg);
 
-// Forget the bank, the map, and the view (the pools themselves are kept for
-// the life of the process, as the HTTP transfer buffer is). Called from
-// primitives_init so a fresh interpreter starts with no tiles.
+// Forget the bank, every layer's map, the animations, and the view (the
+// pools themselves are kept for the life of the process, as the HTTP
+// transfer buffer is). Called from primitives_init so a fresh interpreter
+// starts with no tiles.
 void tilemap_reset(void);
 
 #endif // TILEMAP_H
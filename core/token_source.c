@@ -5,8 +5,12 @@
 
 #include "token_source.h"
 #include "core/atom_memo.h"
+#include "limits.h"
+#include "value.h"
+#include <stdlib.h>
 #include <string.h>
 #include <ctype.h>
+#include <math.h>
 #include "hot.h"
 
 // Check if a word string represents a number
@@ -243,90 +247,717 @@ void token_source_init_lexer(TokenSource *ts, Lexer *lexer)
     ts->has_current = false;
 }
 
-// Initialize token source from a Node list
-void token_source_init_list(TokenSource *ts, Node list)
+//==========================================================================
+// Compiled procedure code
+//
+// A procedure body is a list and stays one: `po`, `save`, `text` and the
+// editor read it, and it is what runs whenever the code below disagrees
+// with it. What a body line compiles to is the token stream node_iter_next
+// would produce from it, flattened into an array of ops -- the element, its
+// characters and class, and the value of a numeral -- so that running the
+// line is one array step per token instead of a cons walk, a newline and
+// comment skip, and a walk of the atom entry.
+//
+// An op is a hint, keyed by the cell it was compiled from. It is used only
+// while the iterator stands on that cell and the cell still holds the op's
+// element, and the iterator still steps with the cell's live cdr. So a token
+// is always the one the list gives -- after `.setfirst` on a body, after a
+// flush or an eviction left a running line's index pointing at another
+// line's ops, after a cell was freed and reused. A mismatch walks that token the slow way and
+// moves on to the next op.
+//
+// An op also carries what the evaluator would otherwise derive from the
+// token each time it runs: the float of a numeral, and the interned name of
+// a `"word` or `:name`, which is a hash and probe of the atom table per use.
+// The evaluator asks for them with token_source_number/_name. Ops are GC
+// roots (token_source_gc_mark_code) so a cached name outlives no collection.
+//
+// An arithmetic expression of numerals alone, such as `360 / 7`, is folded
+// when its line compiles: the op of its first numeral becomes a CODE_FOLD
+// carrying the result and how many ops the expression spans, and reads as
+// that one number while every cell of the span still holds its element. It
+// is folded only where the parse would group it the same way -- see
+// code_fold -- and never when it would raise an error, which is left to run.
+//
+// Lines are compiled on their second run (token_source_init_code), and their
+// sublists when they are first run as lists, so setup code and a `[0 0]`
+// that is only ever data cost an index slot and no ops. The arena is
+// flushed when the procedure table changes (procedures.c), which is load
+// time.
+//
+// When the arena is full, a line that wants in takes the ops of the runs
+// that have gone cold: that have not run for twice the longest gap seen
+// between their runs (code_evict). The survivors' ops are closed up. Setup
+// code and a title screen's loop go cold, so the game loop gets the room,
+// but no run of a loop that is still going is overdue, however big the
+// loop, so what did not fit walks. A run keeps its slot, and the gap, when
+// it loses its ops: a line that runs a few times a frame is seen to go
+// cold inside the frame once, and its period then spans the frame. Slots
+// are only taken back when the index is full, from cold runs with no ops,
+// which for a line that has run once is any time at all.
+//==========================================================================
+
+#define CODE_END     0u          // ATOM_CLASS_NONE: ends a run, as do zeroed ops
+#define CODE_FOLD    0xFEu       // a numeral that starts a folded expression
+#define CODE_SUBLIST 0xFFu       // the element is a list, not a word
+
+#define CODE_PENDING 0u                // compile the run when it next runs
+#define CODE_COLD    (UINT16_MAX - 1)  // a body line that has run once
+#define CODE_NEVER   UINT16_MAX        // no room: walk it until an eviction
+
+typedef struct
 {
-    ts->type = TOKEN_SOURCE_NODE_ITERATOR;
-    ts->node_iter.current = list;
-    ts->node_iter.pending_sublist = NODE_NIL;
-    ts->node_iter.has_pending_sublist = false;
-    ts->node_iter.previous_was_delimiter = true;  // Start of list acts like delimiter
-    ts->has_current = false;
+    Node element;       // word atom or sublist
+    const char *str;    // the word's characters; atoms never move
+    union
+    {
+        float number;   // value of a numeral (class TOKEN_NUMBER)
+        Node name;      // the word after its `"` or `:`, interned
+        Node value;     // number node the expression folds to (CODE_FOLD)
+    };
+    uint16_t cell;      // index of the list cell the element came from
+    uint8_t length;     // the word's length; atoms are at most 255 bytes.
+                        // CODE_FOLD: the ops the expression spans
+    uint8_t cls;        // atom class of a word, CODE_SUBLIST or CODE_END
+} CodeOp;
+
+typedef struct
+{
+    Node list;          // head of the run; NODE_NIL marks a free slot
+    uint16_t first;     // its first op, or one of the CODE_ states above
+    uint16_t period;    // the longest gap between its runs, saturated
+    uint32_t stamp;     // code_clock when it last ran
+} CodeRun;
+
+_Static_assert((LOGO_CODE_RUNS & (LOGO_CODE_RUNS - 1)) == 0,
+    "LOGO_CODE_RUNS must be a power of two");
+_Static_assert(LOGO_CODE_OPS < CODE_COLD, "op indices must fit 16 bits");
+
+static CodeOp code_ops[LOGO_CODE_OPS];      // op 0 is a permanent end
+static CodeRun code_runs[LOGO_CODE_RUNS];
+static uint16_t code_used = 1;
+static uint16_t code_run_count = 0;
+
+// code_find calls so far, which is what ages and gaps are counted in, and
+// times before which no run with ops, and no run without, goes cold: they
+// keep a line that finds no room from scanning the index each time it runs
+// while there is nothing to evict (code_evict).
+static uint32_t code_clock = 0;
+static uint32_t code_ops_due = 0;
+static uint32_t code_slot_due = 0;
+
+// Body line runs served from ops and walked, and runs that lost their ops
+// (token_source_code_stats).
+static uint32_t code_compiled = 0;
+static uint32_t code_walked = 0;
+static uint32_t code_evicted = 0;
+
+// Step `*pos` over newline markers and comment runs to the next element.
+// False at the end of the list. `*pos` is left on the element's cell, and a
+// word is looked up once here: its characters, length and class come back
+// with it.
+static inline bool next_element(Node *pos, Node *element, const char **str,
+                                size_t *len, uint8_t *cls)
+{
+    *cls = ATOM_CLASS_NONE;
+    for (;;)
+    {
+        if (mem_is_nil(*pos))
+            return false;
+
+        *element = mem_car(*pos);
+
+        // Newline markers are for formatting only
+        if (mem_is_newline(*element))
+        {
+            *pos = mem_cdr(*pos);
+            continue;
+        }
+        if (!mem_is_word(*element))
+            return true;
+
+        *cls = word_view(*element, str, len);
+        if (*cls != ATOM_CLASS_COMMENT)
+            return true;
+
+        // Drop the comment and the rest of its line.
+        *pos = mem_cdr(*pos);
+        while (!mem_is_nil(*pos))
+        {
+            Node skipped = mem_car(*pos);
+            *pos = mem_cdr(*pos);
+            if (mem_is_newline(skipped))
+                break;
+        }
+    }
 }
 
-// Get next token from node iterator
-static Token node_iter_next(NodeIterator *iter)
+// Ops past code_used are kept zeroed, so an index left in a running
+// iterator reads an end and the iterator walks on.
+void token_source_flush_code(void)
 {
-    // Skip newline markers - they are for formatting only - and comment runs,
-    // then take the element that follows. A word is looked up once here and
-    // the result carries through to the token below.
-    Node element = NODE_NIL;
-    const char *str = NULL;
-    size_t len = 0;
-    uint8_t cls = ATOM_CLASS_NONE;
+    memset(code_ops + 1, 0, (size_t)(code_used - 1) * sizeof(CodeOp));
+    memset(code_runs, 0, sizeof(code_runs));
+    code_run_count = 0;
+    code_used = 1;
+    code_ops_due = code_clock;
+    code_slot_due = code_clock;
+}
+
+int token_source_code_used(void)
+{
+    return code_used - 1;
+}
+
+void token_source_code_stats(uint32_t *compiled, uint32_t *walked,
+                             uint32_t *evicted)
+{
+    *compiled = code_compiled;
+    *walked = code_walked;
+    *evicted = code_evicted;
+}
+
+static inline unsigned code_hash(Node list)
+{
+    return (unsigned)(NODE_GET_INDEX(list) * 40503u);
+}
+
+// The index slot for `list`: its own, or the free one it would take.
+static CodeRun *code_slot(Node list)
+{
+    unsigned i = code_hash(list) & (LOGO_CODE_RUNS - 1);
+    while (!mem_is_nil(code_runs[i].list) && code_runs[i].list != list)
+        i = (i + 1) & (LOGO_CODE_RUNS - 1);
+    return &code_runs[i];
+}
+
+// The clock time at which a run that ran at `stamp` goes cold.
+static inline uint32_t code_cold_at(uint32_t stamp, uint16_t period)
+{
+    return stamp + 2u * period;
+}
+
+// True if clock time `a` is before `b`, across the clock wrapping.
+static inline bool code_before(uint32_t a, uint32_t b)
+{
+    return (int32_t)(a - b) < 0;
+}
 
+static inline bool code_has_ops(const CodeRun *run)
+{
+    return run->first != CODE_PENDING && run->first != CODE_COLD &&
+           run->first != CODE_NEVER;
+}
+
+// Bring the due time for `run`'s kind forward to when it goes cold. Running
+// only puts that later, so this is needed when a run is registered and
+// when it is given ops.
+static void code_track(const CodeRun *run)
+{
+    uint32_t *due = code_has_ops(run) ? &code_ops_due : &code_slot_due;
+    uint32_t cold = code_cold_at(run->stamp, run->period);
+    if (code_before(cold, *due))
+        *due = cold;
+}
+
+// Note that `run` ran now, `gap` after it last did.
+static inline void code_touch(CodeRun *run, uint32_t gap)
+{
+    if (gap > run->period)
+        run->period = gap < UINT16_MAX ? (uint16_t)gap : UINT16_MAX;
+    run->stamp = code_clock;
+}
+
+// Register `list` as code, expected to run every `period` lookups. NULL when
+// the index is as full as it may get.
+static CodeRun *code_register(Node list, uint16_t period)
+{
+    CodeRun *run = code_slot(list);
+    if (run->list == list)
+        return run;
+    if (code_run_count >= LOGO_CODE_RUNS / 4 * 3)
+        return NULL;
+    run->list = list;
+    run->first = CODE_PENDING;
+    run->period = period;
+    run->stamp = code_clock;
+    code_run_count++;
+    code_track(run);
+    return run;
+}
+
+// Empty index slot `i`, shifting back the runs after it that probed past it
+// so that every run stays reachable from its home slot.
+static void code_unregister(unsigned i)
+{
+    unsigned j = i;
     for (;;)
     {
-        // Check for end of list
-        if (mem_is_nil(iter->current))
+        code_runs[i].list = NODE_NIL;
+        for (;;)
         {
-            return (Token){.type = TOKEN_EOF};
+            j = (j + 1) & (LOGO_CODE_RUNS - 1);
+            if (mem_is_nil(code_runs[j].list))
+            {
+                code_run_count--;
+                return;
+            }
+            unsigned home = code_hash(code_runs[j].list) & (LOGO_CODE_RUNS - 1);
+            if (i <= j ? (i < home && home <= j) : (i < home || home <= j))
+                continue;
+            break;
         }
+        code_runs[i] = code_runs[j];
+        i = j;
+    }
+}
+
+static int code_by_first(const void *a, const void *b)
+{
+    return (int)code_runs[*(const uint16_t *)a].first -
+           (int)code_runs[*(const uint16_t *)b].first;
+}
 
-        element = mem_car(iter->current);
+// Make room: take the ops from the runs that have gone cold, close up the
+// rest and give the runs that found no room another go. With `slot`, also
+// unregister the cold runs, which moves runs in the index; without, a run
+// stays where it is. True if anything was freed.
+static bool code_evict(bool slot)
+{
+    if (!code_before(code_ops_due, code_clock) &&
+        !(slot && code_before(code_slot_due, code_clock)))
+        return false;
 
-        if (mem_is_newline(element))
+    bool freed_ops = false;
+    bool freed_slot = false;
+    uint32_t far = code_clock + 2u * UINT16_MAX + 1;
+    uint32_t ops_due = far;
+    uint32_t slot_due = far;
+    unsigned i = 0;
+    while (i < LOGO_CODE_RUNS)
+    {
+        CodeRun *run = &code_runs[i];
+        if (mem_is_nil(run->list))
         {
-            iter->current = mem_cdr(iter->current);
+            i++;
             continue;
         }
-        if (!mem_is_word(element))
+        uint32_t cold = code_cold_at(run->stamp, run->period);
+        bool is_cold = code_before(cold, code_clock);
+        if (is_cold && code_has_ops(run))
         {
+            run->first = CODE_PENDING;
+            freed_ops = true;
+            code_evicted++;
+        }
+        if (is_cold && slot)
+        {
+            code_unregister(i);     // another run may have moved into i
+            freed_slot = true;
+            continue;
+        }
+        uint32_t *due = code_has_ops(run) ? &ops_due : &slot_due;
+        if (code_before(cold, *due))
+            *due = cold;
+        i++;
+    }
+    code_ops_due = ops_due;
+    code_slot_due = slot_due;
+    if (!freed_ops)
+        return freed_slot;
+
+    // The ops of the runs left, in arena order, moved down over the gaps.
+    uint16_t order[LOGO_CODE_RUNS / 4 * 3];
+    unsigned count = 0;
+    for (i = 0; i < LOGO_CODE_RUNS; i++)
+    {
+        CodeRun *run = &code_runs[i];
+        if (mem_is_nil(run->list))
+            continue;
+        if (run->first == CODE_NEVER)
+            run->first = CODE_PENDING;
+        else if (code_has_ops(run))
+            order[count++] = (uint16_t)i;
+    }
+    qsort(order, count, sizeof(order[0]), code_by_first);
+
+    uint16_t to = 1;
+    for (unsigned k = 0; k < count; k++)
+    {
+        CodeRun *run = &code_runs[order[k]];
+        uint16_t end = run->first;
+        while (code_ops[end].cls != CODE_END)
+            end++;
+        uint16_t length = (uint16_t)(end + 1 - run->first);
+        memmove(code_ops + to, code_ops + run->first, length * sizeof(CodeOp));
+        run->first = to;
+        to = (uint16_t)(to + length);
+    }
+    memset(code_ops + to, 0, (size_t)(code_used - to) * sizeof(CodeOp));
+    code_used = to;
+    return true;
+}
+
+// How tightly an op binds as an infix operator, in the order of the
+// evaluator's binding powers (get_infix_bp): 3 for * and /, 2 for + and -,
+// 1 for the comparisons, 0 if it is not one. A lone `-` is binary here: it
+// is only asked about after a numeral.
+static int code_infix_rank(const CodeOp *op)
+{
+    if (op->cls == ATOM_CLASS_CONTEXT)
+        return op->length == 1 ? 2 : 0;
+    switch (op->cls)
+    {
+    case ATOM_CLASS_OF(TOKEN_MULTIPLY):
+    case ATOM_CLASS_OF(TOKEN_DIVIDE):
+        return 3;
+    case ATOM_CLASS_OF(TOKEN_PLUS):
+        return 2;
+    case ATOM_CLASS_OF(TOKEN_EQUALS):
+    case ATOM_CLASS_OF(TOKEN_LESS_THAN):
+    case ATOM_CLASS_OF(TOKEN_GREATER_THAN):
+        return 1;
+    default:
+        return 0;
+    }
+}
+
+// The value of a numeral op or of a folded expression, and the ops it spans.
+static bool code_literal(const CodeOp *op, float *value, uint16_t *span)
+{
+    if (op->cls == ATOM_CLASS_OF(TOKEN_NUMBER))
+    {
+        *value = op->number;
+        *span = 1;
+        return true;
+    }
+    if (op->cls == CODE_FOLD)
+    {
+        *value = mem_number_value(op->value);
+        *span = op->length;
+        return true;
+    }
+    return false;
+}
+
+// `left op right` for the operator class `cls`, one of + - * /. False for
+// a division by zero or a result that is not finite, which the evaluator is
+// left to report or produce.
+static bool code_apply(uint8_t cls, float left, float right, float *out)
+{
+    switch (cls)
+    {
+    case ATOM_CLASS_OF(TOKEN_MULTIPLY):
+        *out = left * right;
+        break;
+    case ATOM_CLASS_OF(TOKEN_DIVIDE):
+        if (right == 0)
+            return false;
+        *out = left / right;
+        break;
+    case ATOM_CLASS_OF(TOKEN_PLUS):
+        *out = left + right;
+        break;
+    default:
+        *out = left - right;
+        break;
+    }
+    return isfinite(*out);
+}
+
+// One left-to-right pass folding `a op b [op c ...]` runs of numerals in the
+// ops [start, end), where a folded run counts as a numeral for the next
+// pass. `complete` is false when the line goes on past `end` uncompiled.
+// True if anything folded.
+//
+// A run folds only where the evaluator would group it the same way: the op
+// before its first numeral binds less tightly than each operator folded, or
+// is not an operator; a `-` there may be unary and bind the first numeral
+// alone, so only * and / fold after one; and the op after each right
+// operand binds no more tightly than the operator before it.
+static bool code_fold(uint16_t start, uint16_t end, bool complete)
+{
+    bool changed = false;
+    uint16_t i = start;
+
+    while (i < end)
+    {
+        CodeOp *a = &code_ops[i];
+        float left;
+        uint16_t span;
+        if (!code_literal(a, &left, &span))
+        {
+            i++;
+            continue;
+        }
+
+        const CodeOp *before = i > start ? &code_ops[i - 1] : NULL;
+        bool after_minus = before != NULL && before->cls == ATOM_CLASS_CONTEXT;
+        int before_rank = before != NULL && !after_minus ? code_infix_rank(before) : 0;
+
+        uint16_t j = (uint16_t)(i + span);
+        while (j + 1 < end)
+        {
+            const CodeOp *op = &code_ops[j];
+            int rank = code_infix_rank(op);
+            if (rank < 2 || (after_minus ? rank != 3 : before_rank >= rank))
+                break;
+
+            float right;
+            uint16_t right_span;
+            if (!code_literal(&code_ops[j + 1], &right, &right_span))
+                break;
+            uint16_t k = (uint16_t)(j + 1 + right_span);
+            if (k < end ? code_infix_rank(&code_ops[k]) > rank : !complete)
+                break;
+
+            float v;
+            if (!code_apply(op->cls, left, right, &v) || k - i > UINT8_MAX)
+                break;
+            left = v;
+            j = k;
+        }
+
+        if (j > i + span)
+        {
+            Node value = mem_number(left);
+            if (!mem_is_nil(value))
+            {
+                a->cls = CODE_FOLD;
+                a->value = value;
+                a->length = (uint8_t)(j - i);
+                changed = true;
+            }
+        }
+        i = j;
+    }
+    return changed;
+}
+
+// Append the ops for `list` and register its sublists, which run as often
+// as it does. Returns the first op, or 0 when the arena has no room for
+// them, in which case none are kept.
+static uint16_t code_emit(Node list, uint16_t period)
+{
+    uint16_t n = code_used;
+    Node pos = list;
+    Node element = NODE_NIL;
+    const char *str = NULL;
+    size_t len = 0;
+    uint8_t cls;
+
+    bool complete = false;
+
+    for (;;)
+    {
+        if (!next_element(&pos, &element, &str, &len, &cls))
+        {
+            complete = true;
             break;
         }
+        if (n >= LOGO_CODE_OPS - 1)     // keep room for the end
+        {
+            memset(code_ops + code_used, 0, (size_t)(n - code_used) * sizeof(CodeOp));
+            return 0;
+        }
 
-        cls = word_view(element, &str, &len);
-        if (cls != ATOM_CLASS_COMMENT)
+        CodeOp *op = &code_ops[n];
+        *op = (CodeOp){.element = element, .cell = (uint16_t)NODE_GET_INDEX(pos)};
+        if (mem_is_word(element))
+        {
+            // A blob's bytes can move and can run past 255, and a number's
+            // text is an atom nothing roots; the rest of the line walks.
+            if (NODE_WORD_IS_BLOB(element) || NODE_WORD_IS_NUMBER(element) ||
+                len > UINT8_MAX)
+                break;
+            op->str = str;
+            op->length = (uint8_t)len;
+            op->cls = cls;
+            if (cls == ATOM_CLASS_OF(TOKEN_NUMBER))
+                op->number = number_from_text(str, len);
+            else if (cls == ATOM_CLASS_OF(TOKEN_QUOTED) ||
+                     cls == ATOM_CLASS_OF(TOKEN_COLON))
+                op->name = len > 0 ? mem_atom_unescape(str + 1, len - 1) : NODE_NIL;
+        }
+        else if (mem_is_list(element) || mem_is_nil(element))
+        {
+            op->cls = CODE_SUBLIST;
+            if (!mem_is_nil(element))
+                code_register(element, period);     // if full, it runs as a list
+        }
+        else
         {
             break;
         }
+        n++;
+        pos = mem_cdr(pos);
+    }
 
-        // Drop the comment and the rest of its line.
-        iter->current = mem_cdr(iter->current);
-        while (!mem_is_nil(iter->current))
+    code_ops[n] = (CodeOp){.cls = CODE_END};
+    while (code_fold(code_used, n, complete))
+        ;
+    uint16_t first = code_used;
+    code_used = (uint16_t)(n + 1);
+    return first;
+}
+
+// The first op to run `list` from, or 0 to walk it. `is_code` registers a
+// body line the first time it runs and compiles it the second, so a line
+// that runs once -- setup, most of a load -- takes no ops. A sublist is
+// registered when its line compiles and compiled the first time it runs.
+// When the arena or the index is full, code_evict may make room; what still
+// does not fit walks.
+static uint16_t code_find(Node list, bool is_code)
+{
+    if (mem_is_nil(list))
+        return 0;
+
+    code_clock++;
+    CodeRun *run = code_slot(list);
+    if (run->list != list)
+    {
+        if (is_code)
         {
-            Node skipped = mem_car(iter->current);
-            iter->current = mem_cdr(iter->current);
-            if (mem_is_newline(skipped))
+            run = code_register(list, 0);
+            if (run == NULL && code_evict(true))
+                run = code_register(list, 0);
+            if (run != NULL)
+                run->first = CODE_COLD;
+            code_walked++;
+        }
+        return 0;
+    }
+    code_touch(run, code_clock - run->stamp);
+
+    if (run->first == CODE_NEVER)
+        code_evict(false);          // leaves it pending if anything went
+    if (run->first == CODE_COLD || run->first == CODE_PENDING)
+    {
+        uint16_t first = code_emit(list, run->period);
+        if (first == 0 && code_evict(false))
+            first = code_emit(list, run->period);
+        run->first = first != 0 ? first : CODE_NEVER;
+        code_track(run);
+    }
+
+    uint16_t first = run->first == CODE_NEVER ? 0 : run->first;
+    if (is_code)
+    {
+        if (first != 0)
+            code_compiled++;
+        else
+            code_walked++;
+    }
+    return first;
+}
+
+static void init_node_iter(TokenSource *ts, Node list, uint16_t code)
+{
+    ts->type = TOKEN_SOURCE_NODE_ITERATOR;
+    ts->node_iter.current = list;
+    ts->node_iter.pending_sublist = NODE_NIL;
+    ts->node_iter.code = code;
+    ts->node_iter.has_pending_sublist = false;
+    ts->node_iter.previous_was_delimiter = true;  // Start of list acts like delimiter
+    ts->has_current = false;
+}
+
+// Initialize token source from a Node list
+void token_source_init_list(TokenSource *ts, Node list)
+{
+    init_node_iter(ts, list, code_find(list, false));
+}
+
+// Initialize token source from a procedure body line
+void token_source_init_code(TokenSource *ts, Node list)
+{
+    init_node_iter(ts, list, code_find(list, true));
+}
+
+// The token for a word element at this point in the list.
+static inline Token word_token(NodeIterator *iter, Node element, uint8_t cls,
+                               const char *str, size_t len)
+{
+    Token t = token_from_class(cls, str, len, iter->previous_was_delimiter);
+    t.atom = element;
+    iter->previous_was_delimiter = is_delimiter_token(t.type);
+    return t;
+}
+
+// List elements appear as sublists [...]. The evaluator retrieves the list
+// via token_source_get_sublist(); TOKEN_LEFT_BRACKET signals a list literal.
+static inline Token sublist_token(NodeIterator *iter, Node element)
+{
+    iter->pending_sublist = element;
+    iter->has_pending_sublist = true;
+    iter->previous_was_delimiter = true;
+    return (Token){.type = TOKEN_LEFT_BRACKET};
+}
+
+// Get next token from node iterator
+static Token node_iter_next(NodeIterator *iter)
+{
+    if (iter->code != 0)
+    {
+        const CodeOp *op = &code_ops[iter->code];
+        if (op->cls == CODE_END)
+        {
+            iter->code = 0;
+        }
+        else
+        {
+            iter->code++;
+            Node cell = NODE_MAKE_LIST(op->cell);
+            if (op->cls == CODE_FOLD)
             {
-                break;
+                // The whole span reads as its value, or it walks from here
+                Node pos = iter->current;
+                uint16_t k = 0;
+                while (k < op->length && NODE_MAKE_LIST(op[k].cell) == pos &&
+                       mem_car(pos) == op[k].element)
+                {
+                    pos = mem_cdr(pos);
+                    k++;
+                }
+                if (k == op->length)
+                {
+                    iter->code = (uint16_t)(iter->code + k - 1);
+                    iter->current = pos;
+                    return word_token(iter, op->value, ATOM_CLASS_OF(TOKEN_NUMBER),
+                                      op->str, 0);
+                }
+            }
+            else if (cell == iter->current && mem_car(cell) == op->element)
+            {
+                iter->current = mem_cdr(cell);
+                if (op->cls == CODE_SUBLIST)
+                    return sublist_token(iter, op->element);
+                return word_token(iter, op->element, op->cls, op->str, op->length);
             }
         }
     }
 
+    Node element = NODE_NIL;
+    const char *str = NULL;
+    size_t len = 0;
+    uint8_t cls;
+
+    if (!next_element(&iter->current, &element, &str, &len, &cls))
+    {
+        return (Token){.type = TOKEN_EOF};
+    }
+
     iter->current = mem_cdr(iter->current);
 
-    // Handle word elements
     if (mem_is_word(element))
     {
-        Token t = token_from_class(cls, str, len, iter->previous_was_delimiter);
-        t.atom = element;
-        iter->previous_was_delimiter = is_delimiter_token(t.type);
-        return t;
+        return word_token(iter, element, cls, str, len);
     }
-    
-    // Handle list elements - these appear as sublists [...]
-    // The evaluator will handle these specially
     if (mem_is_list(element) || mem_is_nil(element))
     {
-        // Store the sublist for the evaluator to retrieve via token_source_get_sublist()
-        // Return TOKEN_LEFT_BRACKET to signal a list literal
-        iter->pending_sublist = element;
-        iter->has_pending_sublist = true;
-        iter->previous_was_delimiter = true;
-        return (Token){.type = TOKEN_LEFT_BRACKET};
+        return sublist_token(iter, element);
     }
-    
+
     // Shouldn't reach here
     return (Token){.type = TOKEN_EOF};
 }
@@ -369,6 +1000,57 @@ bool token_source_at_end(TokenSource *ts)
     return t.type == TOKEN_EOF;
 }
 
+// The value of a numeral the compiled code parsed, or of a number node. `t`
+// was the last token, so its op is the one before the iterator's; the atom
+// check makes sure the token really came from that op.
+bool token_source_number(const TokenSource *ts, Token t, float *out)
+{
+    if (mem_is_number(t.atom))
+    {
+        *out = mem_number_value(t.atom);
+        return true;
+    }
+    if (ts->type == TOKEN_SOURCE_NODE_ITERATOR && ts->node_iter.code != 0)
+    {
+        const CodeOp *op = &code_ops[ts->node_iter.code - 1];
+        if (op->cls == ATOM_CLASS_OF(TOKEN_NUMBER) && op->element == t.atom)
+        {
+            *out = op->number;
+            return true;
+        }
+    }
+
+    // A numeral read from a list that did not compile: its value is cached
+    // on the atom when it is small and whole (atom_memo.h)
+    const char *str = NULL;
+    size_t len = 0;
+    uint8_t *memo = NULL;
+    if (mem_is_nil(t.atom) || !mem_word_view(t.atom, &str, &len, &memo) || memo == NULL)
+        return false;
+    uint16_t word = mem_atom_memo_get(memo);
+    if (atom_memo_class(word) != ATOM_CLASS_OF(TOKEN_NUMBER))
+        return false;
+    if (atom_memo_number(word, out))
+        return true;
+    *out = number_from_text(str, len);
+    if (len > 0 && isdigit((unsigned char)str[0]))
+        mem_atom_memo_set(memo, atom_memo_set_number(word, *out));
+    return true;
+}
+
+// The interned name of a `"word` or `:name` token the compiled code already
+// interned, as token_source_number finds its numeral; NODE_NIL if none.
+Node token_source_name(const TokenSource *ts, Token t)
+{
+    if (ts->type != TOKEN_SOURCE_NODE_ITERATOR || ts->node_iter.code == 0)
+        return NODE_NIL;
+    const CodeOp *op = &code_ops[ts->node_iter.code - 1];
+    if ((op->cls != ATOM_CLASS_OF(TOKEN_QUOTED) &&
+         op->cls != ATOM_CLASS_OF(TOKEN_COLON)) || op->element != t.atom)
+        return NODE_NIL;
+    return op->name;
+}
+
 // Copy state for lookahead
 void token_source_copy(TokenSource *dest, const TokenSource *src)
 {
@@ -433,6 +1115,24 @@ void token_source_gc_mark(const TokenSource *ts)
     }
 }
 
+// Mark what the compiled ops hold (GC root support): their elements, which a
+// body mutated with `.setfirst` no longer holds, and their interned names.
+void token_source_gc_mark_code(void)
+{
+    for (uint16_t i = 1; i < code_used; i++)
+    {
+        const CodeOp *op = &code_ops[i];
+        if (op->cls == CODE_END)
+            continue;
+        mem_gc_mark(op->element);
+        if (op->cls == ATOM_CLASS_OF(TOKEN_QUOTED) ||
+            op->cls == ATOM_CLASS_OF(TOKEN_COLON))
+            mem_gc_mark(op->name);
+        else if (op->cls == CODE_FOLD)
+            mem_gc_mark(op->value);
+    }
+}
+
 // Restore position from saved Node (for CPS continuation)
 void token_source_set_position(TokenSource *ts, Node position)
 {
@@ -440,6 +1140,7 @@ void token_source_set_position(TokenSource *ts, Node position)
     {
         ts->node_iter.current = position;
         ts->node_iter.pending_sublist = NODE_NIL;
+        ts->node_iter.code = 0;
         ts->node_iter.has_pending_sublist = false;
             ts->node_iter.previous_was_delimiter = true;
         ts->has_current = false;
@@ -38,6 +38,7 @@ extern "C"
     {
         Node current;           // Current position in list
         Node pending_sublist;   // Sublist element (when TOKEN_LEFT_BRACKET returned)
+        uint16_t code;          // Next compiled op for this list, 0 = walk it
         bool has_pending_sublist; // True if a sublist (including empty) is pending
         bool previous_was_delimiter; // For unary minus detection
     } NodeIterator;
@@ -58,9 +59,28 @@ extern "C"
     // Initialize a token source from a Lexer
     void token_source_init_lexer(TokenSource *ts, Lexer *lexer);
 
-    // Initialize a token source from a Node list
+    // Initialize a token source from a Node list. A list registered as
+    // procedure code (below) runs from its compiled ops.
     void token_source_init_list(TokenSource *ts, Node list);
 
+    // Initialize a token source from a procedure body line, compiling the
+    // line the second time it runs. Its sublists are registered as code too,
+    // and are compiled when init_list first runs them. Yields exactly the
+    // tokens token_source_init_list would.
+    void token_source_init_code(TokenSource *ts, Node list);
+
+    // Drop all compiled code. procedures.c calls this whenever the
+    // procedure table changes; a running line simply walks its list.
+    void token_source_flush_code(void);
+
+    // Ops in use in the code arena (0 when empty), for tests.
+    int token_source_code_used(void);
+
+    // Body line runs served from compiled ops and walked as lists, and runs
+    // whose ops were evicted, since start-up: for the throughput benchmarks.
+    void token_source_code_stats(uint32_t *compiled, uint32_t *walked,
+                                 uint32_t *evicted);
+
     // Get the next token (advances position)
     Token token_source_next(TokenSource *ts);
 
@@ -70,6 +90,15 @@ extern "C"
     // Check if at end of input
     bool token_source_at_end(TokenSource *ts);
 
+    // The value of numeral token `t`, just consumed from `ts`, when the
+    // compiled code already parsed it or it is a number node (mem_number).
+    // False means read it from t.start.
+    bool token_source_number(const TokenSource *ts, Token t, float *out);
+
+    // Likewise the interned word after the `"` or `:` of token `t`, or
+    // NODE_NIL when it has to be interned from t.start.
+    Node token_source_name(const TokenSource *ts, Token t);
+
     // Copy the current state for lookahead
     void token_source_copy(TokenSource *dest, const TokenSource *src);
 
@@ -95,6 +124,9 @@ extern "C"
     // Lexer sources read raw text and hold no nodes, so they are a no-op.
     void token_source_gc_mark(const TokenSource *ts);
 
+    // GC root support: mark what the compiled procedure code holds.
+    void token_source_gc_mark_code(void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -44,6 +44,13 @@ Value value_bool(bool b)
     return value_word(b ? mem_true_node : mem_false_node);
 }
 
+Value value_of_element(Node node)
+{
+    if (mem_is_number(node))
+        return value_number(mem_number_value(node));
+    return mem_is_word(node) ? value_word(node) : value_list(node);
+}
+
 //==========================================================================
 // Value Predicates
 //==========================================================================
@@ -123,8 +130,8 @@ bool values_equal(Value a, Value b)
         {
             Node car_a = mem_car(la);
             Node car_b = mem_car(lb);
-            Value va = mem_is_word(car_a) ? value_word(car_a) : value_list(car_a);
-            Value vb = mem_is_word(car_b) ? value_word(car_b) : value_list(car_b);
+            Value va = value_of_element(car_a);
+            Value vb = value_of_element(car_b);
             if (!values_equal(va, vb))
             {
                 return false;
@@ -194,6 +201,46 @@ bool is_number_string(const char *str, size_t len)
     return has_digit && i == len;
 }
 
+// The value of a word already known to be a numeral (is_number_string), read
+// from its characters. The evaluator reads literals with it and the compiled
+// procedure code (token_source.c) pre-parses them with it, so both produce
+// the same float.
+float number_from_text(const char *str, size_t len)
+{
+    // Create null-terminated copy for strtof
+    char buf[64];
+    if (len >= sizeof(buf))
+        len = sizeof(buf) - 1;
+    memcpy(buf, str, len);
+    buf[len] = '\0';
+
+    // Handle 'n' notation: 1n4 = 0.0001
+    char *n_pos = strchr(buf, 'n');
+    if (!n_pos)
+        n_pos = strchr(buf, 'N');
+
+    if (n_pos)
+    {
+        *n_pos = '\0';
+        float mantissa = strtof(buf, NULL);
+        // Parse exponent as digits-only non-negative integer
+        int exp = 0;
+        const char *p = n_pos + 1;
+        while (*p != '\0')
+        {
+            exp = exp * 10 + (*p - '0');
+            p++;
+        }
+        float result = mantissa;
+        for (int i = 0; i < exp; i++)
+        {
+            result /= 10.0f;
+        }
+        return result;
+    }
+    return strtof(buf, NULL);
+}
+
 bool value_to_number(Value v, float *out)
 {
     if (v.type == VALUE_NUMBER)
@@ -203,6 +250,12 @@ bool value_to_number(Value v, float *out)
     }
     if (v.type == VALUE_WORD)
     {
+        if (mem_is_number(v.as.node))
+        {
+            *out = mem_number_value(v.as.node);
+            return true;
+        }
+
         // Try to parse word as number
         const char *str = mem_word_ptr(v.as.node);
         if (str == NULL)
@@ -105,6 +105,10 @@ extern "C"
     // The word "true" or "false" (cached atoms; no interning per call).
     Value value_bool(bool b);
 
+    // The value of a list member: a number for a number node (mem_number),
+    // a word for any other word, and a list otherwise.
+    Value value_of_element(Node node);
+
     //==========================================================================
     // Value Predicates
     //==========================================================================
@@ -131,6 +135,9 @@ extern "C"
     // of a numeral, shared by the lexer and by value_to_number.
     bool is_number_string(const char *str, size_t len);
 
+    // The value of a numeral's characters (checked with is_number_string).
+    float number_from_text(const char *str, size_t len);
+
     bool value_to_number(Value v, float *out);
 
     // Get the node from a word or list value
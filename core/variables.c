@@ -8,6 +8,7 @@
 #include "procedures.h"  // For proc_get_frame_stack()
 #include "frame.h"
 #include "limits.h"
+#include "atom_memo.h"
 #include <string.h>
 #include <strings.h>
 #include <stdio.h>
@@ -23,6 +24,8 @@ typedef struct
     bool active;
     bool has_value;   // false if declared but not yet assigned
     bool buried;      // if true, hidden from pons/erns/etc
+    bool ref_ok;      // no procedure input shares the name (see ref_generation)
+    uint32_t ref_generation; // when ref_ok was last worked out
 } Variable;
 
 // Global variables storage
@@ -107,6 +110,19 @@ static void global_hash_rebuild(void)
     }
 }
 
+// A `:name` reference can remember the global it read (VarRef) and go
+// straight to it next time, skipping the frame chain and the hash. Skipping
+// the chain is only right while no frame can bind the name, and a frame binds
+// a name as a procedure input or a local. So an entry is read directly only
+// if no input anywhere has its name (`ref_ok`), worked out once per
+// generation; the generation moves when the procedure table changes, when a
+// local is declared over a global, and when a global is erased.
+static uint32_t ref_generation = 1;
+
+_Static_assert(MAX_GLOBAL_VARIABLES <= ATOM_MEMO_INDEX_LIMIT &&
+               MAX_PROC_PARAMS <= ATOM_MEMO_INDEX_LIMIT,
+               "a VarRef index must fit the atom memo's binding field");
+
 // Top-level (global) test state
 static bool global_test_valid = false;
 static bool global_test_value = false;
@@ -119,7 +135,9 @@ void variables_init(void)
         global_variables[i].active = false;
         global_variables[i].has_value = false;
         global_variables[i].buried = false;
+        global_variables[i].ref_generation = 0;
     }
+    ref_generation++;
     global_test_valid = false;
     global_test_value = false;
     memset(global_hash, 0, sizeof(global_hash));
@@ -158,7 +176,9 @@ bool var_declare_local(const char *name)
     FrameStack *frames = proc_get_frame_stack();
     if (frames && !frame_stack_is_empty(frames))
     {
-        // Declare local in current frame
+        // Declare local in current frame, where it hides any global
+        if (find_global(name) >= 0)
+            ref_generation++;
         return frame_declare_local(frames, name);
     }
 
@@ -197,6 +217,8 @@ bool var_set_local(const char *name, Value value)
     if (frames && !frame_stack_is_empty(frames))
     {
         // Add or update local in current frame
+        if (find_global(name) >= 0)
+            ref_generation++;
         return frame_add_local(frames, name, value);
     }
 
@@ -260,6 +282,22 @@ bool LOGO_HOT(var_set)(const char *name, Value value)
     return false;
 }
 
+// The global part of var_get.
+static bool get_global(const char *name, Value *out)
+{
+    int idx = find_global(name);
+    if (idx >= 0)
+    {
+        if (!global_variables[idx].has_value)
+        {
+            return false;  // Declared but no value
+        }
+        *out = global_variables[idx].value;
+        return true;
+    }
+    return false;
+}
+
 bool LOGO_HOT(var_get)(const char *name, Value *out)
 {
     // First, search frame stack for local bindings (if in a procedure)
@@ -275,18 +313,95 @@ bool LOGO_HOT(var_get)(const char *name, Value *out)
         }
     }
 
-    // Check globals
-    int idx = find_global(name);
-    if (idx >= 0)
+    return get_global(name, out);
+}
+
+// A reference to global entry `idx` for `name`, or VAR_REF_NONE if it could
+// not be read directly: the name is spelled differently (the pointer check
+// would always miss) or a procedure input could bind it.
+static VarRef global_ref(int idx, const char *name)
+{
+    VarRef ref = {VAR_REF_NONE, 0};
+    if (idx < 0 || global_variables[idx].name != name)
     {
-        if (!global_variables[idx].has_value)
+        return ref;
+    }
+    Variable *var = &global_variables[idx];
+    if (var->ref_generation != ref_generation)
+    {
+        var->ref_generation = ref_generation;
+        var->ref_ok = !proc_has_input_named(name);
+    }
+    if (var->ref_ok)
+    {
+        ref.kind = VAR_REF_GLOBAL;
+        ref.index = (uint16_t)idx;
+    }
+    return ref;
+}
+
+// Inside a procedure, `:x` for one of its own inputs is by far the commonest
+// read, and the chain search pays for it with a strcasecmp on every binding
+// in front of it; outside one, or for a game's state, it is a global, and the
+// search and the hash pay for it. The reference is the answer from last time,
+// and it is checked rather than trusted: an input slot must be the current
+// frame's and bind this very atom, and a global must still be this name's,
+// in a generation where no frame can hide it. Otherwise the dynamic search
+// runs as before.
+bool LOGO_HOT(var_get_ref)(const char *name, VarRef *ref, Value *out)
+{
+    if (ref->kind == VAR_REF_GLOBAL && ref->index < MAX_GLOBAL_VARIABLES)
+    {
+        Variable *var = &global_variables[ref->index];
+        if (var->active && var->name == name && var->ref_ok &&
+            var->ref_generation == ref_generation)
         {
-            return false;  // Declared but no value
+            if (!var->has_value)
+            {
+                return false;  // Declared but no value
+            }
+            *out = var->value;
+            return true;
         }
-        *out = global_variables[idx].value;
-        return true;
     }
-    return false;
+
+    FrameStack *frames = proc_get_frame_stack();
+    if (frames && !frame_stack_is_empty(frames))
+    {
+        FrameHeader *frame = frame_current(frames);
+        Binding *binding = ref->kind == VAR_REF_PARAM
+            ? frame_param_at(frame, ref->index, name) : NULL;
+        if (binding)
+        {
+            *out = binding->value;
+            return true;
+        }
+
+        FrameHeader *found = NULL;
+        binding = frame_find_binding_in_chain(frames, name, &found);
+        if (binding)
+        {
+            int slot = found == frame ? frame_param_slot(frame, binding) : -1;
+            ref->kind = slot >= 0 ? VAR_REF_PARAM : VAR_REF_NONE;
+            ref->index = slot >= 0 ? (uint16_t)slot : 0;
+            *out = binding->value;
+            return true;
+        }
+    }
+
+    int idx = find_global(name);
+    *ref = global_ref(idx, name);
+    if (idx < 0 || !global_variables[idx].has_value)
+    {
+        return false;
+    }
+    *out = global_variables[idx].value;
+    return true;
+}
+
+void var_refs_invalidate(void)
+{
+    ref_generation++;
 }
 
 bool var_exists(const char *name)
@@ -319,6 +434,7 @@ void var_erase(const char *name)
         global_variables[idx].active = false;
         global_variables[idx].has_value = false;
         global_hash_rebuild();
+        ref_generation++;
     }
 }
 
@@ -342,6 +458,7 @@ void var_erase_all_globals(bool check_buried)
         }
     }
     global_hash_rebuild();
+    ref_generation++;
 }
 
 // Bury/unbury support
@@ -518,6 +635,50 @@ bool var_is_shadowed_by_local(const char *name)
 }
 
 // Mark all variable values as GC roots
+bool var_image_get(int *cursor, const char **name_out, Value *value_out,
+                   bool *has_value_out, bool *buried_out)
+{
+    while (*cursor < global_count)
+    {
+        const Variable *v = &global_variables[(*cursor)++];
+        if (v->active)
+        {
+            *name_out = v->name;
+            *value_out = v->value;
+            *has_value_out = v->has_value;
+            *buried_out = v->buried;
+            return true;
+        }
+    }
+    return false;
+}
+
+void var_image_begin(void)
+{
+    variables_init();
+}
+
+bool var_image_add(const char *name, Value value, bool has_value, bool buried)
+{
+    if (global_count >= MAX_GLOBAL_VARIABLES)
+        return false;
+    Variable *v = &global_variables[global_count++];
+    v->name = name;
+    v->value = value;
+    v->active = true;
+    v->has_value = has_value;
+    v->buried = buried;
+    v->ref_ok = false;
+    v->ref_generation = 0;
+    return true;
+}
+
+void var_image_end(void)
+{
+    global_hash_rebuild();
+    var_refs_invalidate();
+}
+
 void var_gc_mark_all(void)
 {
     // Mark global variables
@@ -48,6 +48,28 @@ extern "C"
     // Returns false if not found
     bool var_get(const char *name, Value *out);
 
+    // Where a `:name` reference found its variable last time. eval_expr.c
+    // keeps it on the atom memo of the `:name` word (core/atom_memo.h), so
+    // the kinds share the memo's binding-kind values.
+    #define VAR_REF_NONE   0u   // search
+    #define VAR_REF_PARAM  1u   // input slot `index` of the running procedure
+    #define VAR_REF_GLOBAL 2u   // global table entry `index`
+    typedef struct
+    {
+        uint16_t kind;
+        uint16_t index;
+    } VarRef;
+
+    // var_get for a reference that remembers where it found its name. *ref
+    // is tried before the search, and is a hint: it is checked on every read,
+    // and `name` must be the interned atom for it to hit. Updated to where
+    // `name` was found now. Same answer as var_get in every case.
+    bool var_get_ref(const char *name, VarRef *ref, Value *out);
+
+    // A procedure input may now hide a global that a VarRef reads directly.
+    // procedures.c calls this whenever the procedure table changes.
+    void var_refs_invalidate(void);
+
     // Check if variable exists (in scope chain or globals)
     bool var_exists(const char *name);
 
@@ -83,6 +105,15 @@ extern "C"
     // Mark all variable values as GC roots
     void var_gc_mark_all(void);
 
+    // Workspace images (core/workspace_image.c). var_image_get walks the
+    // global slots in order, including names declared without a value;
+    // begin empties the table, add appends, end rebuilds the index.
+    bool var_image_get(int *cursor, const char **name_out, Value *value_out,
+                       bool *has_value_out, bool *buried_out);
+    void var_image_begin(void);
+    bool var_image_add(const char *name, Value value, bool has_value, bool buried);
+    void var_image_end(void);
+
     //==========================================================================
     // Test state management (local to procedure scope)
     //
@@ -0,0 +1,532 @@
+//
+//  Pico Logo
+//  Copyright 2026 Blair Leduc. See LICENSE for details.
+//
+//  Workspace images for .savews and .loadws. See workspace_image.h for the
+//  layout.
+//
+//  Saving walks the body twice, once to count and checksum it and once to
+//  write it, so the header can lead without a seek back. Loading follows
+//  devices/lfs_backup.c: a first pass checks the header and the body's crc
+//  without touching anything, and only then does the second pass replace
+//  the workspace.
+//
+
+#include "workspace_image.h"
+#include "demons.h"
+#include "error.h"
+#include "limits.h"
+#include "memory.h"
+#include "procedures.h"
+#include "profile.h"
+#include "properties.h"
+#include "variables.h"
+#include <string.h>
+
+#define IMAGE_MAGIC "PLWSIMG1"
+#define IMAGE_VERSION 1u
+#define IMAGE_HEADER_LEN 88u
+#define IMAGE_CRC_INIT 0xffffffffu
+
+#define IMAGE_PROC_BURIED 0x01
+#define IMAGE_PROC_STEPPED 0x02
+#define IMAGE_PROC_TRACED 0x04
+
+#define IMAGE_VAR_HAS_VALUE 0x01
+#define IMAGE_VAR_BURIED 0x02
+
+//============================================================================
+// Little-endian and crc helpers
+//============================================================================
+
+static void put_u32(uint8_t *b, uint32_t v)
+{
+    b[0] = (uint8_t)v;
+    b[1] = (uint8_t)(v >> 8);
+    b[2] = (uint8_t)(v >> 16);
+    b[3] = (uint8_t)(v >> 24);
+}
+
+static uint32_t get_u32(const uint8_t *b)
+{
+    return (uint32_t)b[0] | ((uint32_t)b[1] << 8) | ((uint32_t)b[2] << 16) |
+           ((uint32_t)b[3] << 24);
+}
+
+// crc32 (reflected, 0xedb88320) a nibble at a time: a 64-byte table rather
+// than 1 KB, and still quick enough for the whole arena at startup.
+static uint32_t image_crc(uint32_t crc, const void *buf, size_t n)
+{
+    static const uint32_t table[16] = {
+        0x00000000, 0x1db71064, 0x3b6e20c8, 0x26d930ac,
+        0x76dc4190, 0x6b6b51f4, 0x4db26158, 0x5005713c,
+        0xedb88320, 0xf00f9344, 0xd6d6a3e8, 0xcb61b38c,
+        0x9b64c2b0, 0x86d3d2d4, 0xa00ae278, 0xbdbdf21c,
+    };
+    const uint8_t *p = (const uint8_t *)buf;
+    for (size_t i = 0; i < n; i++)
+    {
+        crc = (crc >> 4) ^ table[(crc ^ p[i]) & 0xf];
+        crc = (crc >> 4) ^ table[(crc ^ (p[i] >> 4)) & 0xf];
+    }
+    return crc;
+}
+
+static size_t pad4(size_t n)
+{
+    return (4 - (n & 3)) & 3;
+}
+
+//============================================================================
+// Writing
+//============================================================================
+
+// Where the body goes: with no stream it is only counted and checksummed
+typedef struct
+{
+    LogoStream *out;
+    uint32_t bytes;
+    uint32_t crc;
+} ImageWriter;
+
+static void emit(ImageWriter *w, const void *data, size_t n)
+{
+    w->bytes += (uint32_t)n;
+    w->crc = image_crc(w->crc, data, n);
+    if (w->out != NULL)
+    {
+        logo_stream_write_bytes(w->out, (const char *)data, n);
+    }
+}
+
+// The body, in the order the header describes. False if a name is not an
+// atom, which would leave nothing to rebase it on.
+static bool emit_body(ImageWriter *w, const uint8_t *arena, const MemImageLayout *layout)
+{
+    static const uint8_t zeros[4] = {0};
+    uint8_t rec[12];
+
+    emit(w, arena, layout->atom_bytes);
+    emit(w, arena + LOGO_MEMORY_SIZE - layout->node_bytes, layout->node_bytes);
+
+    for (int handle = 0; handle < LOGO_MAX_BLOBS; handle++)
+    {
+        const char *data;
+        size_t len;
+        if (mem_image_blob(handle, &data, &len))
+        {
+            put_u32(rec, (uint32_t)handle);
+            put_u32(rec + 4, (uint32_t)len);
+            emit(w, rec, 8);
+            emit(w, data, len);
+            emit(w, zeros, pad4(len));
+        }
+    }
+
+    int procs = proc_count(true);
+    for (int i = 0; i < procs; i++)
+    {
+        const UserProcedure *proc = proc_get_by_index(i);
+        Node name = mem_atom_of_ptr(proc->name);
+        if (name == NODE_NIL)
+        {
+            return false;
+        }
+        put_u32(rec, name);
+        put_u32(rec + 4, proc->body);
+        rec[8] = (uint8_t)proc->param_count;
+        rec[9] = (uint8_t)((proc->buried ? IMAGE_PROC_BURIED : 0) |
+                           (proc->stepped ? IMAGE_PROC_STEPPED : 0) |
+                           (proc->traced ? IMAGE_PROC_TRACED : 0));
+        rec[10] = rec[11] = 0;
+        emit(w, rec, 12);
+        for (int p = 0; p < proc->param_count; p++)
+        {
+            Node param = mem_atom_of_ptr(proc->params[p]);
+            if (param == NODE_NIL)
+            {
+                return false;
+            }
+            put_u32(rec, param);
+            emit(w, rec, 4);
+        }
+    }
+
+    int cursor = 0;
+    const char *var_name;
+    Value value;
+    bool has_value, buried;
+    while (var_image_get(&cursor, &var_name, &value, &has_value, &buried))
+    {
+        Node name = mem_atom_of_ptr(var_name);
+        if (name == NODE_NIL)
+        {
+            return false;
+        }
+        uint32_t payload = 0;
+        if (has_value && value.type == VALUE_NUMBER)
+        {
+            memcpy(&payload, &value.as.number, sizeof(payload));
+        }
+        else if (has_value)
+        {
+            payload = value.as.node;
+        }
+        put_u32(rec, name);
+        rec[4] = (uint8_t)((has_value ? IMAGE_VAR_HAS_VALUE : 0) |
+                           (buried ? IMAGE_VAR_BURIED : 0));
+        rec[5] = (uint8_t)(has_value ? value.type : VALUE_NONE);
+        rec[6] = rec[7] = 0;
+        put_u32(rec + 8, payload);
+        emit(w, rec, 12);
+    }
+    return true;
+}
+
+int workspace_image_save(LogoStream *out)
+{
+    MemImageLayout layout;
+    const uint8_t *arena = mem_image_layout(&layout);
+
+    ImageWriter sizing = {.out = NULL, .bytes = 0, .crc = IMAGE_CRC_INIT};
+    if (!emit_body(&sizing, arena, &layout))
+    {
+        return ERR_DISK_TROUBLE;
+    }
+
+    uint32_t blobs = 0;
+    for (int handle = 0; handle < LOGO_MAX_BLOBS; handle++)
+    {
+        const char *data;
+        size_t len;
+        blobs += mem_image_blob(handle, &data, &len) ? 1 : 0;
+    }
+    uint32_t vars = 0;
+    {
+        int cursor = 0;
+        const char *name;
+        Value value;
+        bool has_value, buried;
+        while (var_image_get(&cursor, &name, &value, &has_value, &buried))
+        {
+            vars++;
+        }
+    }
+
+    uint8_t hdr[IMAGE_HEADER_LEN];
+    memcpy(hdr, IMAGE_MAGIC, 8);
+    put_u32(hdr + 8, IMAGE_VERSION);
+    put_u32(hdr + 12, LOGO_MEMORY_SIZE);
+    put_u32(hdr + 16, MAX_PROCEDURES);
+    put_u32(hdr + 20, MAX_GLOBAL_VARIABLES);
+    put_u32(hdr + 24, MAX_PROC_PARAMS);
+    put_u32(hdr + 28, LOGO_MAX_BLOBS);
+    put_u32(hdr + 32, layout.atom_bytes);
+    put_u32(hdr + 36, layout.node_bytes);
+    put_u32(hdr + 40, layout.free_list);
+    put_u32(hdr + 44, layout.free_count);
+    put_u32(hdr + 48, layout.roots[0]);
+    put_u32(hdr + 52, layout.roots[1]);
+    put_u32(hdr + 56, layout.roots[2]);
+    put_u32(hdr + 60, blobs);
+    put_u32(hdr + 64, (uint32_t)proc_count(true));
+    put_u32(hdr + 68, vars);
+    put_u32(hdr + 72, prop_image_list());
+    put_u32(hdr + 76, sizing.bytes);
+    put_u32(hdr + 80, sizing.crc);
+    put_u32(hdr + 84, image_crc(IMAGE_CRC_INIT, hdr, 84));
+
+    logo_stream_write_bytes(out, (const char *)hdr, sizeof(hdr));
+    ImageWriter writer = {.out = out, .bytes = 0, .crc = IMAGE_CRC_INIT};
+    emit_body(&writer, arena, &layout);
+    logo_stream_flush(out);
+
+    if (logo_stream_has_write_error(out) || writer.crc != sizing.crc)
+    {
+        return ERR_DISK_TROUBLE;
+    }
+    return 0;
+}
+
+//============================================================================
+// Reading
+//============================================================================
+
+// The image being read: in place when mapped, else from a stream
+typedef struct
+{
+    const uint8_t *data;
+    size_t len;
+    size_t pos;
+    LogoStream *in;
+} ImageReader;
+
+// The next `n` bytes into `dst`, or skipped when `dst` is NULL. False at the
+// end of the image or on a read error.
+static bool take(ImageReader *r, void *dst, size_t n)
+{
+    if (r->data != NULL)
+    {
+        if (n > r->len - r->pos)
+        {
+            return false;
+        }
+        if (dst != NULL)
+        {
+            memcpy(dst, r->data + r->pos, n);
+        }
+        r->pos += n;
+        return true;
+    }
+
+    uint8_t scratch[64];
+    uint8_t *p = (uint8_t *)dst;
+    while (n > 0)
+    {
+        size_t want = n;
+        char *into = (char *)p;
+        if (p == NULL)
+        {
+            want = n < sizeof(scratch) ? n : sizeof(scratch);
+            into = (char *)scratch;
+        }
+        int got = logo_stream_read_chars(r->in, into, (int)want);
+        if (got <= 0)
+        {
+            return false;
+        }
+        n -= (size_t)got;
+        if (p != NULL)
+        {
+            p += got;
+        }
+    }
+    return true;
+}
+
+// crc32 of the next `n` bytes, consuming them
+static bool take_crc(ImageReader *r, size_t n, uint32_t *crc)
+{
+    if (r->data != NULL)
+    {
+        if (n > r->len - r->pos)
+        {
+            return false;
+        }
+        *crc = image_crc(*crc, r->data + r->pos, n);
+        r->pos += n;
+        return true;
+    }
+
+    uint8_t chunk[256];
+    while (n > 0)
+    {
+        size_t want = n < sizeof(chunk) ? n : sizeof(chunk);
+        if (!take(r, chunk, want))
+        {
+            return false;
+        }
+        *crc = image_crc(*crc, chunk, want);
+        n -= want;
+    }
+    return true;
+}
+
+static bool rewind_reader(ImageReader *r)
+{
+    r->pos = 0;
+    return r->data != NULL || logo_stream_set_read_pos(r->in, 0);
+}
+
+// The interned text of atom `n`, or NULL if `n` is not an atom of the image
+static const char *image_name(Node n)
+{
+    if (NODE_GET_TYPE(n) != NODE_TYPE_WORD ||
+        (NODE_GET_INDEX(n) & (NODE_WORD_BLOB_BIT | NODE_WORD_NUMBER_BIT)))
+    {
+        return NULL;
+    }
+    MemImageLayout layout;
+    mem_image_layout(&layout);
+    if (NODE_GET_INDEX(n) >= layout.atom_bytes)
+    {
+        return NULL;
+    }
+    const char *name = mem_word_ptr(n);
+    return mem_atom_of_ptr(name) == n ? name : NULL;
+}
+
+// The counts and roots the header promises
+typedef struct
+{
+    MemImageLayout layout;
+    uint32_t blobs, procs, vars;
+    Node props;
+} ImageHeader;
+
+// Pass 2: replace the workspace. Returns 0 or the error to report.
+static int restore(ImageReader *r, const ImageHeader *h)
+{
+    uint8_t rec[12];
+
+    uint8_t *arena = mem_image_begin_restore(&h->layout);
+    if (!take(r, arena, h->layout.atom_bytes) ||
+        !take(r, arena + LOGO_MEMORY_SIZE - h->layout.node_bytes, h->layout.node_bytes))
+    {
+        return ERR_DISK_TROUBLE;
+    }
+
+    for (uint32_t i = 0; i < h->blobs; i++)
+    {
+        if (!take(r, rec, 8))
+        {
+            return ERR_DISK_TROUBLE;
+        }
+        uint32_t len = get_u32(rec + 4);
+        char *data = mem_image_restore_blob((int)get_u32(rec), len);
+        if (data == NULL)
+        {
+            return ERR_OUT_OF_SPACE;
+        }
+        if (!take(r, data, len) || !take(r, NULL, pad4(len)))
+        {
+            return ERR_DISK_TROUBLE;
+        }
+    }
+    mem_image_finish_restore();
+
+    proc_image_begin();
+    for (uint32_t i = 0; i < h->procs; i++)
+    {
+        if (!take(r, rec, 12))
+        {
+            return ERR_DISK_TROUBLE;
+        }
+        UserProcedure proc = {0};
+        proc.name = image_name(get_u32(rec));
+        proc.body = get_u32(rec + 4);
+        proc.param_count = rec[8];
+        proc.buried = (rec[9] & IMAGE_PROC_BURIED) != 0;
+        proc.stepped = (rec[9] & IMAGE_PROC_STEPPED) != 0;
+        proc.traced = (rec[9] & IMAGE_PROC_TRACED) != 0;
+        if (proc.name == NULL || proc.param_count > MAX_PROC_PARAMS)
+        {
+            return ERR_FILE_WRONG_TYPE;
+        }
+        for (int p = 0; p < proc.param_count; p++)
+        {
+            if (!take(r, rec, 4))
+            {
+                return ERR_DISK_TROUBLE;
+            }
+            proc.params[p] = image_name(get_u32(rec));
+            if (proc.params[p] == NULL)
+            {
+                return ERR_FILE_WRONG_TYPE;
+            }
+        }
+        if (!proc_image_add(&proc))
+        {
+            return ERR_FILE_WRONG_TYPE;
+        }
+    }
+    proc_image_end();
+
+    var_image_begin();
+    for (uint32_t i = 0; i < h->vars; i++)
+    {
+        if (!take(r, rec, 12))
+        {
+            return ERR_DISK_TROUBLE;
+        }
+        const char *name = image_name(get_u32(rec));
+        bool has_value = (rec[4] & IMAGE_VAR_HAS_VALUE) != 0;
+        Value value = {.type = (ValueType)rec[5]};
+        uint32_t payload = get_u32(rec + 8);
+        if (value.type == VALUE_NUMBER)
+        {
+            memcpy(&value.as.number, &payload, sizeof(payload));
+        }
+        else
+        {
+            value.as.node = payload;
+        }
+        if (name == NULL ||
+            !var_image_add(name, value, has_value, (rec[4] & IMAGE_VAR_BURIED) != 0))
+        {
+            return ERR_FILE_WRONG_TYPE;
+        }
+    }
+    var_image_end();
+
+    prop_image_restore(h->props);
+    return 0;
+}
+
+int workspace_image_load(const uint8_t *data, size_t len, LogoStream *in)
+{
+    ImageReader reader = {.data = data, .len = len, .pos = 0, .in = in};
+    uint8_t hdr[IMAGE_HEADER_LEN];
+
+    // Pass 1: header and body crc, changing nothing
+    if (!take(&reader, hdr, sizeof(hdr)) ||
+        memcmp(hdr, IMAGE_MAGIC, 8) != 0 ||
+        get_u32(hdr + 84) != image_crc(IMAGE_CRC_INIT, hdr, 84) ||
+        get_u32(hdr + 8) != IMAGE_VERSION ||
+        get_u32(hdr + 12) != LOGO_MEMORY_SIZE ||
+        get_u32(hdr + 16) != MAX_PROCEDURES ||
+        get_u32(hdr + 20) != MAX_GLOBAL_VARIABLES ||
+        get_u32(hdr + 24) != MAX_PROC_PARAMS ||
+        get_u32(hdr + 28) != LOGO_MAX_BLOBS)
+    {
+        return ERR_FILE_WRONG_TYPE;
+    }
+
+    ImageHeader h;
+    h.layout.atom_bytes = get_u32(hdr + 32);
+    h.layout.node_bytes = get_u32(hdr + 36);
+    h.layout.free_list = get_u32(hdr + 40);
+    h.layout.free_count = get_u32(hdr + 44);
+    h.layout.roots[0] = get_u32(hdr + 48);
+    h.layout.roots[1] = get_u32(hdr + 52);
+    h.layout.roots[2] = get_u32(hdr + 56);
+    h.blobs = get_u32(hdr + 60);
+    h.procs = get_u32(hdr + 64);
+    h.vars = get_u32(hdr + 68);
+    h.props = get_u32(hdr + 72);
+    if (!mem_image_layout_fits(&h.layout) || h.blobs > LOGO_MAX_BLOBS ||
+        h.procs > MAX_PROCEDURES || h.vars > MAX_GLOBAL_VARIABLES)
+    {
+        return ERR_FILE_WRONG_TYPE;
+    }
+
+    uint32_t crc = IMAGE_CRC_INIT;
+    if (!take_crc(&reader, get_u32(hdr + 76), &crc))
+    {
+        return ERR_FILE_WRONG_TYPE;
+    }
+    if (crc != get_u32(hdr + 80))
+    {
+        return ERR_FILE_WRONG_TYPE;
+    }
+    if (!rewind_reader(&reader) || !take(&reader, NULL, sizeof(hdr)))
+    {
+        return ERR_DISK_TROUBLE;
+    }
+
+    // Pass 2: the point of no return. The demons and the profile rows name
+    // procedures and lists of the workspace being replaced.
+    demons_clear();
+    profile_clear();
+    int err = restore(&reader, &h);
+    if (err != 0)
+    {
+        mem_image_clear();
+        proc_image_begin();
+        proc_image_end();
+        var_image_begin();
+        var_image_end();
+        prop_image_restore(NODE_NIL);
+    }
+    return err;
+}
@@ -0,0 +1,57 @@
+//
+//  Pico Logo
+//  Copyright 2026 Blair Leduc. See LICENSE for details.
+//
+//  Workspace images: the whole workspace -- atom table, node pool, blobs,
+//  procedures, global variables and property lists -- as one binary file
+//  that .loadws puts back with a bulk copy instead of re-reading source.
+//
+//  The arena refers to itself only by atom offset and cell index, so its
+//  used ends are written byte for byte and need no relocation; the tables
+//  outside it hold names as pointers, which go out as atom Nodes and come
+//  back through mem_word_ptr. An image is tied to the build that made it:
+//  the header carries the arena size, the table capacities and the offsets
+//  of the bootstrap atoms, and any mismatch is "File is the wrong type".
+//
+//  Layout (little-endian u32 unless noted):
+//      [0..7]    magic "PLWSIMG1"
+//      [8..27]   version, LOGO_MEMORY_SIZE, MAX_PROCEDURES,
+//                MAX_GLOBAL_VARIABLES, MAX_PROC_PARAMS
+//      [28..31]  LOGO_MAX_BLOBS
+//      [32..59]  MemImageLayout: atom bytes, node bytes, free list head,
+//                free count, the three root atoms
+//      [60..75]  blob, procedure and variable counts; the property lists
+//      [76..83]  body length and its crc32
+//      [84..87]  crc32 of bytes [0..83]
+//      body:     atoms, nodes, then per blob (handle, length, bytes padded
+//                to 4), per procedure (name, body, u8 inputs, u8 flags,
+//                2 pad, an atom per input), per variable (name, u8 flags,
+//                u8 value type, 2 pad, payload)
+//
+
+#pragma once
+
+#include "devices/stream.h"
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+    // Write the workspace to `out`. Collect garbage first so the image holds
+    // only what is reachable. Returns 0, or ERR_DISK_TROUBLE.
+    int workspace_image_save(LogoStream *out);
+
+    // Replace the workspace with an image: the `len` bytes at `data` when the
+    // file is mapped, else read from `in`, positioned at its start. Returns 0;
+    // ERR_FILE_WRONG_TYPE or ERR_DISK_TROUBLE with the workspace untouched
+    // when the file is not a sound image for this build; or, should the
+    // restore itself fail after that, an error with the workspace empty.
+    // Demons and the profile table are cleared either way once it starts.
+    int workspace_image_load(const uint8_t *data, size_t len, LogoStream *in);
+
+#ifdef __cplusplus
+}
+#endif
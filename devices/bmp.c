@@ -0,0 +1,395 @@
+//
+//  Pico Logo
+//  Copyright 2026 Blair Leduc. See LICENSE for details.
+//
+//  8-bit indexed BMP files, streamed. See bmp.h.
+//
+//  RLE8 rows are a sequence of two-byte commands: a count of 1-255 and the
+//  index to repeat, or 0 and an escape -- 0 ends the row, 1 ends the
+//  picture, 2 moves right and up by the next two bytes, and 3-255 is that
+//  many literal indices padded to an even length. The encoder writes runs
+//  of two or more as runs and anything else as literal stretches, which
+//  stop where a run of three begins. The file size in the header is known
+//  before a byte is written by encoding once into a counter.
+//
+
+#include "devices/bmp.h"
+#include <errno.h>
+#include <string.h>
+
+// Bytes buffered between the codec and the stream, each way
+#define BMP_IO_BUFFER 256
+
+#define BMP_PIXELS_PER_METER 2835  // 72 dpi, as other tools write it
+
+//
+//  Writing
+//
+
+typedef struct
+{
+    LogoStream *stream;  // NULL while only counting
+    size_t count;        // Bytes put so far
+    size_t len;
+    uint8_t buf[BMP_IO_BUFFER];
+} BmpWriter;
+
+static void writer_flush(BmpWriter *w)
+{
+    if (w->stream && w->len > 0)
+    {
+        logo_stream_write_bytes(w->stream, (const char *)w->buf, w->len);
+    }
+    w->len = 0;
+}
+
+static void put_bytes(BmpWriter *w, const uint8_t *p, size_t n)
+{
+    w->count += n;
+    if (!w->stream)
+    {
+        return;
+    }
+    while (n > 0)
+    {
+        size_t room = sizeof(w->buf) - w->len;
+        size_t k = n < room ? n : room;
+        memcpy(w->buf + w->len, p, k);
+        w->len += k;
+        p += k;
+        n -= k;
+        if (w->len == sizeof(w->buf))
+        {
+            writer_flush(w);
+        }
+    }
+}
+
+static void put_pair(BmpWriter *w, int a, int b)
+{
+    uint8_t pair[2] = {(uint8_t)a, (uint8_t)b};
+    put_bytes(w, pair, 2);
+}
+
+static void put_u16(uint8_t *p, uint16_t v)
+{
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+}
+
+static void put_u32(uint8_t *p, uint32_t v)
+{
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+    p[2] = (uint8_t)(v >> 16);
+    p[3] = (uint8_t)(v >> 24);
+}
+
+// Bytes in an uncompressed row, padded to a multiple of 4
+static size_t raw_row_size(int width)
+{
+    return ((size_t)width + 3) & ~(size_t)3;
+}
+
+// Does a run of at least three equal indices start at row[i]?
+static bool run3_at(const uint8_t *row, int i, int width)
+{
+    return i + 2 < width && row[i] == row[i + 1] && row[i] == row[i + 2];
+}
+
+static void rle_row(BmpWriter *w, const uint8_t *row, int width)
+{
+    int i = 0;
+    while (i < width)
+    {
+        int run = 1;
+        while (i + run < width && run < 255 && row[i + run] == row[i])
+        {
+            run++;
+        }
+        if (run >= 2)
+        {
+            put_pair(w, run, row[i]);
+            i += run;
+            continue;
+        }
+
+        int j = i + 1;
+        while (j < width && j - i < 255 && !run3_at(row, j, width))
+        {
+            j++;
+        }
+        int n = j - i;
+        if (n < 3)
+        {
+            // Too short for a literal stretch: single-index runs
+            for (int k = i; k < j; k++)
+            {
+                put_pair(w, 1, row[k]);
+            }
+        }
+        else
+        {
+            put_pair(w, 0, n);
+            put_bytes(w, row + i, (size_t)n);
+            if (n & 1)
+            {
+                uint8_t pad = 0;
+                put_bytes(w, &pad, 1);
+            }
+        }
+        i = j;
+    }
+    put_pair(w, 0, 0);  // End of row
+}
+
+// Pixel data, bottom row first, into `w`
+static void put_pixels(BmpWriter *w, const uint8_t *pixels, int width, int height, bool rle)
+{
+    static const uint8_t padding[3] = {0, 0, 0};
+    size_t pad = raw_row_size(width) - (size_t)width;
+
+    for (int y = height - 1; y >= 0; y--)
+    {
+        const uint8_t *row = pixels + (size_t)y * (size_t)width;
+        if (rle)
+        {
+            rle_row(w, row, width);
+        }
+        else
+        {
+            put_bytes(w, row, (size_t)width);
+            put_bytes(w, padding, pad);
+        }
+    }
+    if (rle)
+    {
+        put_pair(w, 0, 1);  // End of picture
+    }
+}
+
+static size_t pixel_data_size(const uint8_t *pixels, int width, int height, bool rle)
+{
+    if (!rle)
+    {
+        return raw_row_size(width) * (size_t)height;
+    }
+    BmpWriter counter = {0};
+    put_pixels(&counter, pixels, width, height, true);
+    return counter.count;
+}
+
+size_t bmp_file_size(const uint8_t *pixels, int width, int height, bool rle)
+{
+    return BMP_PIXEL_DATA_OFFSET + pixel_data_size(pixels, width, height, rle);
+}
+
+int bmp_save(LogoStream *out, const uint8_t *pixels, int width, int height,
+             const uint8_t *palette, bool rle)
+{
+    logo_stream_clear_write_error(out);
+    size_t data_size = pixel_data_size(pixels, width, height, rle);
+
+    uint8_t header[BMP_FILE_HEADER_SIZE + BMP_DIB_HEADER_SIZE] = {0};
+    header[0] = 'B';
+    header[1] = 'M';
+    put_u32(header + 2, (uint32_t)(BMP_PIXEL_DATA_OFFSET + data_size));
+    put_u32(header + 10, BMP_PIXEL_DATA_OFFSET);
+
+    uint8_t *dib = header + BMP_FILE_HEADER_SIZE;
+    put_u32(dib + 0, BMP_DIB_HEADER_SIZE);
+    put_u32(dib + 4, (uint32_t)width);
+    put_u32(dib + 8, (uint32_t)height);
+    put_u16(dib + 12, 1);  // Planes
+    put_u16(dib + 14, 8);  // Bits per pixel
+    put_u32(dib + 16, rle ? BMP_COMPRESSION_RLE8 : BMP_COMPRESSION_RGB);
+    put_u32(dib + 20, (uint32_t)data_size);
+    put_u32(dib + 24, BMP_PIXELS_PER_METER);
+    put_u32(dib + 28, BMP_PIXELS_PER_METER);
+    // Colours used and important colours stay 0: all 256
+
+    BmpWriter w = {.stream = out};
+    put_bytes(&w, header, sizeof(header));
+    put_bytes(&w, palette, BMP_PALETTE_SIZE);
+    put_pixels(&w, pixels, width, height, rle);
+    writer_flush(&w);
+
+    logo_stream_flush(out);
+    return logo_stream_has_write_error(out) ? EIO : 0;
+}
+
+//
+//  Reading
+//
+
+typedef struct
+{
+    LogoStream *stream;
+    int pos;
+    int len;
+    uint8_t buf[BMP_IO_BUFFER];
+} BmpReader;
+
+// The next byte, or -1 at the end of the file
+static int get_byte(BmpReader *r)
+{
+    if (r->pos == r->len)
+    {
+        int n = logo_stream_read_chars(r->stream, (char *)r->buf, (int)sizeof(r->buf));
+        if (n <= 0)
+        {
+            return -1;
+        }
+        r->len = n;
+        r->pos = 0;
+    }
+    return r->buf[r->pos++];
+}
+
+static uint16_t get_u16(const uint8_t *p)
+{
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static uint32_t get_u32(const uint8_t *p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) |
+           ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static int load_raw(LogoStream *in, uint8_t *pixels, int width, int height)
+{
+    char padding[3];
+    int pad = (int)(raw_row_size(width) - (size_t)width);
+
+    for (int y = height - 1; y >= 0; y--)
+    {
+        char *row = (char *)pixels + (size_t)y * (size_t)width;
+        if (logo_stream_read_chars(in, row, width) != width)
+        {
+            return EIO;
+        }
+        if (pad > 0 && logo_stream_read_chars(in, padding, pad) != pad)
+        {
+            return EIO;
+        }
+    }
+    return 0;
+}
+
+// Pixels a delta skips over, like any the file never reaches, are index 0.
+// Commands that run past the right edge are cut off there.
+static int load_rle(LogoStream *in, uint8_t *pixels, int width, int height)
+{
+    BmpReader r = {.stream = in};
+    memset(pixels, 0, (size_t)width * (size_t)height);
+
+    int x = 0;
+    int y = 0;  // Rows up from the bottom
+    while (y < height)
+    {
+        int a = get_byte(&r);
+        int b = get_byte(&r);
+        if (b < 0)
+        {
+            return EIO;
+        }
+        uint8_t *row = pixels + (size_t)(height - 1 - y) * (size_t)width;
+
+        if (a > 0)
+        {
+            int n = a < width - x ? a : width - x;
+            memset(row + x, b, (size_t)n);
+            x += n;
+        }
+        else if (b == 0)
+        {
+            x = 0;
+            y++;
+        }
+        else if (b == 1)
+        {
+            return 0;
+        }
+        else if (b == 2)
+        {
+            int dx = get_byte(&r);
+            int dy = get_byte(&r);
+            if (dy < 0)
+            {
+                return EIO;
+            }
+            x = x + dx < width ? x + dx : width;
+            y += dy;
+        }
+        else
+        {
+            for (int k = 0; k < b; k++)
+            {
+                int c = get_byte(&r);
+                if (c < 0)
+                {
+                    return EIO;
+                }
+                if (x < width)
+                {
+                    row[x++] = (uint8_t)c;
+                }
+            }
+            if ((b & 1) && get_byte(&r) < 0)
+            {
+                return EIO;
+            }
+        }
+    }
+    return 0;
+}
+
+int bmp_load(LogoStream *in, uint8_t *pixels, int width, int height,
+             uint8_t *palette)
+{
+    uint8_t header[BMP_FILE_HEADER_SIZE + BMP_DIB_HEADER_SIZE];
+    if (logo_stream_read_chars(in, (char *)header, (int)sizeof(header)) != (int)sizeof(header))
+    {
+        return EIO;
+    }
+    if (header[0] != 'B' || header[1] != 'M')
+    {
+        return EINVAL;
+    }
+    uint32_t pixel_offset = get_u32(header + 10);
+
+    const uint8_t *dib = header + BMP_FILE_HEADER_SIZE;
+    uint32_t dib_size = get_u32(dib + 0);
+    int32_t file_width = (int32_t)get_u32(dib + 4);
+    int32_t file_height = (int32_t)get_u32(dib + 8);
+    uint16_t bits_per_pixel = get_u16(dib + 14);
+    uint32_t compression = get_u32(dib + 16);
+    uint32_t colours = get_u32(dib + 32);
+
+    if (dib_size < BMP_DIB_HEADER_SIZE || file_width != width || file_height != height ||
+        bits_per_pixel != 8 || colours > 256 ||
+        (compression != BMP_COMPRESSION_RGB && compression != BMP_COMPRESSION_RLE8))
+    {
+        return EINVAL;
+    }
+    if (colours == 0)
+    {
+        colours = 256;
+    }
+
+    // The palette follows the DIB header, whichever version that is
+    int palette_size = (int)colours * 4;
+    if (!logo_stream_set_read_pos(in, (long)(BMP_FILE_HEADER_SIZE + dib_size)) ||
+        logo_stream_read_chars(in, (char *)palette, palette_size) != palette_size)
+    {
+        return EIO;
+    }
+
+    if (!logo_stream_set_read_pos(in, (long)pixel_offset))
+    {
+        return EIO;
+    }
+    return compression == BMP_COMPRESSION_RLE8 ? load_rle(in, pixels, width, height)
+                                               : load_raw(in, pixels, width, height);
+}
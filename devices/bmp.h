@@ -0,0 +1,55 @@
+//
+//  Pico Logo
+//  Copyright 2026 Blair Leduc. See LICENSE for details.
+//
+//  8-bit indexed BMP files, streamed: the codec behind savepic and loadpic,
+//  shared by the PicoCalc screen and the host's mock device.
+//
+//  Pictures are written either uncompressed (BI_RGB) or run-length encoded
+//  (BI_RLE8). A title screen or background is mostly long runs of one
+//  palette index, so RLE8 stores it in a small fraction of the 100 KB an
+//  uncompressed 320x320 picture takes, and reading it back from flash is
+//  that much shorter. Both directions work through a 256-byte buffer on the
+//  stack, whatever the picture's size, and reading accepts either kind.
+//
+
+#pragma once
+
+#include "devices/stream.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#define BMP_FILE_HEADER_SIZE 14   // "BM", file size, reserved, pixel offset
+#define BMP_DIB_HEADER_SIZE 40    // BITMAPINFOHEADER
+#define BMP_PALETTE_SIZE (256 * 4) // 256 entries of blue, green, red, 0
+#define BMP_PIXEL_DATA_OFFSET (BMP_FILE_HEADER_SIZE + BMP_DIB_HEADER_SIZE + BMP_PALETTE_SIZE)
+
+#define BMP_COMPRESSION_RGB 0     // Rows of indices, each padded to 4 bytes
+#define BMP_COMPRESSION_RLE8 1    // Runs and literal stretches per row
+
+    // Write `height` rows of `width` palette indices, top row first, with
+    // `palette` (BMP_PALETTE_SIZE bytes, BGR0 per entry). RLE8 when `rle`.
+    // Returns 0, or EIO if the stream failed a write.
+    int bmp_save(LogoStream *out, const uint8_t *pixels, int width, int height,
+                 const uint8_t *palette, bool rle);
+
+    // Read a picture of exactly `width` x `height` into `pixels`, top row
+    // first, and its palette entries into `palette` (entries past the file's
+    // colour count are left as they were). Returns 0; EINVAL if the file is
+    // not an 8-bit BMP of that size, uncompressed or RLE8; or EIO if it ends
+    // early or cannot be read. `pixels` may be partly written on error.
+    int bmp_load(LogoStream *in, uint8_t *pixels, int width, int height,
+                 uint8_t *palette);
+
+    // The size of the file bmp_save would write for these pixels
+    size_t bmp_file_size(const uint8_t *pixels, int width, int height, bool rle);
+
+#ifdef __cplusplus
+}
+#endif
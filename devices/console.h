@@ -45,7 +45,13 @@ extern "C"
     // Reading or selecting a *different* turtle must not invalidate it —
     // touching? holds two turtles' masks at once, and over?/colourunder
     // read the canvas while holding one.
+    //
+    // serial changes whenever the device rebuilds the mask, so core may keep
+    // a packed copy for collision tests until it does; a device that cannot
+    // tell leaves it 0 and core repacks on every read. Masks are at most
+    // LOGO_RASTER_MAX pixels on a side.
     #define LOGO_RASTER_TRANSPARENT 255
+    #define LOGO_RASTER_MAX 32
 
     typedef struct LogoTurtleRaster
     {
@@ -58,6 +64,7 @@ extern "C"
                              // touching? requires it; over?/colourunder
                              // sense the canvas under the turtle regardless.
         const uint8_t *mask;
+        uint32_t serial;     // New each time the mask is rebuilt; 0 unknown
     } LogoTurtleRaster;
 
     //
@@ -122,6 +129,15 @@ extern "C"
         // Fill enclosed area with current pen color
         void (*fill)(void);
 
+        // Lend fill a larger span queue, or none (NULL, 0). The interpreter
+        // decides, since it owns the aux/PSRAM region. Optional.
+        void (*set_fill_store)(void *store, size_t size);
+
+        // Fill the polygon through `count` vertices (x, y pairs in Logo
+        // coordinates, closed back to the first) with `colour`, even-odd.
+        // Backs the `filled` primitive. Optional.
+        void (*fill_polygon)(const float *xy, int count, uint8_t colour);
+
         // Draw text on the graphics screen at the selected turtle's current
         // position, in the current pen colour, upright and left-to-right.
         // The turtle does not move and its heading is ignored (this is the
@@ -133,11 +149,13 @@ extern "C"
         void (*set_window)(void);   // Turtle can go off-screen
         void (*set_wrap)(void);     // Turtle wraps around
 
-        // Save graphics screen as a BMP to an open stream (caller closes)
+        // Save graphics screen as a BMP to an open stream (caller closes),
+        // run-length encoded (RLE8) when `rle` is true
         // Returns 0 on success, errno on failure
-        int (*gfx_save)(LogoStream *out);
+        int (*gfx_save)(LogoStream *out, bool rle);
 
-        // Load graphics screen from a BMP read from an open stream (caller closes)
+        // Load graphics screen from a BMP, uncompressed or RLE8, read from an
+        // open stream (caller closes)
         // Returns 0 on success, errno on failure (EINVAL = not a usable BMP)
         int (*gfx_load)(LogoStream *in);
 
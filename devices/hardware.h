@@ -89,6 +89,11 @@ extern "C"
         // NULL on devices without a clock; callers then get 0.
         uint32_t (*ticks_ms)(void);
 
+        // Monotonic microsecond clock, wrapping at 2^32 (~71 minutes). Times
+        // the `.profile` profiler's calls, most of which are far shorter than
+        // a millisecond. May be NULL; callers then get ticks_ms * 1000.
+        uint32_t (*ticks_us)(void);
+
         // Get a random 32-bit number
         uint32_t (*random)(void);
 
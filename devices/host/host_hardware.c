@@ -63,6 +63,20 @@ static uint32_t host_hardware_ticks_ms(void)
 #endif
 }
 
+static uint32_t host_hardware_ticks_us(void)
+{
+#ifdef _WIN32
+    LARGE_INTEGER freq, count;
+    QueryPerformanceFrequency(&freq);
+    QueryPerformanceCounter(&count);
+    return (uint32_t)(count.QuadPart * 1000000 / freq.QuadPart);
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)(ts.tv_sec * 1000000u + ts.tv_nsec / 1000u);
+#endif
+}
+
 static uint32_t host_hardware_random(void)
 {
     static bool seeded = false;
@@ -462,6 +476,7 @@ static bool host_network_tcp_can_read(void *handle)
 static LogoHardwareOps host_hardware_ops = {
     .sleep = host_hardware_sleep,
     .ticks_ms = host_hardware_ticks_ms,
+    .ticks_us = host_hardware_ticks_us,
     .random = host_hardware_random,
     .get_battery_level = host_hardware_get_battery_level,
     .power_off = NULL,
@@ -68,12 +68,24 @@ int main(void)
     primitives_set_io(&io);
 
     // Load startup file if it exists (uses default prefix)
-    if (logo_io_file_exists(&io, "startup"))
+    // A workspace image saved by .savews starts quicker than the source it
+    // was made from, so it wins when both are there.
+    const char *startup = NULL;
+    if (logo_io_file_exists(&io, "startup.img"))
+    {
+        startup = ".loadws \"startup.img";
+    }
+    else if (logo_io_file_exists(&io, "startup"))
+    {
+        startup = "load \"startup";
+    }
+    if (startup)
     {
         Lexer startup_lexer;
         Evaluator startup_eval;
-        lexer_init(&startup_lexer, "load \"startup");
+        lexer_init(&startup_lexer, startup);
         eval_init(&startup_eval, &startup_lexer);
+        eval_set_frames(&startup_eval, proc_get_frame_stack());
         Result r = eval_instruction(&startup_eval);
         if (r.status == RESULT_ERROR)
         {
@@ -0,0 +1,134 @@
+//
+//  Pico Logo
+//  Copyright 2026 Blair Leduc. See LICENSE for details.
+//
+//  Present queue for the host: the consumer is a thread, and a mutex and
+//  condition variable stand in for core 1's flag and events. See
+//  devices/present_queue.h.
+//
+
+#include "devices/present_queue.h"
+
+#include <pthread.h>
+#include <stdlib.h>
+
+struct PresentQueue
+{
+    void *frames[2];
+    PresentConsumer consume;
+    void *context;
+    int back;             // Index of the buffer the producer writes
+    int pending;          // Index handed to the consumer, or -1
+    bool stopping;
+    pthread_mutex_t lock;
+    pthread_cond_t changed;
+    pthread_t thread;
+};
+
+static void *consumer_main(void *arg)
+{
+    PresentQueue *q = (PresentQueue *)arg;
+
+    pthread_mutex_lock(&q->lock);
+    for (;;)
+    {
+        while (q->pending < 0 && !q->stopping)
+        {
+            pthread_cond_wait(&q->changed, &q->lock);
+        }
+        if (q->pending < 0)
+        {
+            break;  // Stopping, and nothing left to send
+        }
+
+        void *frame = q->frames[q->pending];
+        pthread_mutex_unlock(&q->lock);
+        q->consume(frame, q->context);
+        pthread_mutex_lock(&q->lock);
+
+        q->pending = -1;
+        pthread_cond_broadcast(&q->changed);
+    }
+    pthread_mutex_unlock(&q->lock);
+    return NULL;
+}
+
+PresentQueue *present_queue_start(void *frames[2], PresentConsumer consume,
+                                  void *context)
+{
+    PresentQueue *q = (PresentQueue *)calloc(1, sizeof(PresentQueue));
+    if (q == NULL)
+    {
+        return NULL;
+    }
+    q->frames[0] = frames[0];
+    q->frames[1] = frames[1];
+    q->consume = consume;
+    q->context = context;
+    q->pending = -1;
+    pthread_mutex_init(&q->lock, NULL);
+    pthread_cond_init(&q->changed, NULL);
+
+    if (pthread_create(&q->thread, NULL, consumer_main, q) != 0)
+    {
+        pthread_cond_destroy(&q->changed);
+        pthread_mutex_destroy(&q->lock);
+        free(q);
+        return NULL;
+    }
+    return q;
+}
+
+void present_queue_stop(PresentQueue *q)
+{
+    if (q == NULL)
+    {
+        return;
+    }
+    pthread_mutex_lock(&q->lock);
+    q->stopping = true;
+    pthread_cond_broadcast(&q->changed);
+    pthread_mutex_unlock(&q->lock);
+
+    pthread_join(q->thread, NULL);
+    pthread_cond_destroy(&q->changed);
+    pthread_mutex_destroy(&q->lock);
+    free(q);
+}
+
+void *present_queue_back(PresentQueue *q)
+{
+    return q->frames[q->back];
+}
+
+void *present_queue_submit(PresentQueue *q)
+{
+    pthread_mutex_lock(&q->lock);
+    while (q->pending >= 0)
+    {
+        pthread_cond_wait(&q->changed, &q->lock);
+    }
+    q->pending = q->back;
+    q->back ^= 1;
+    pthread_cond_broadcast(&q->changed);
+    pthread_mutex_unlock(&q->lock);
+    return q->frames[q->back];
+}
+
+void present_queue_wait_idle(PresentQueue *q)
+{
+    pthread_mutex_lock(&q->lock);
+    while (q->pending >= 0)
+    {
+        pthread_cond_wait(&q->changed, &q->lock);
+    }
+    pthread_mutex_unlock(&q->lock);
+}
+
+bool present_queue_busy(PresentQueue *q)
+{
+    pthread_mutex_lock(&q->lock);
+    bool busy = q->pending >= 0;
+    pthread_mutex_unlock(&q->lock);
+    return busy;
+}
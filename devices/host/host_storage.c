@@ -12,6 +12,8 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <fcntl.h>
+#include <sys/mman.h>
 #include <sys/stat.h>
 #include <sys/statvfs.h>
 #include <unistd.h>
@@ -624,6 +626,39 @@ static bool logo_host_free_blocks(const char *pathname, uint32_t *free_blocks,
     return true;
 }
 
+// Map a regular, non-empty file read-only with mmap
+static bool logo_host_map_file(const char *pathname, const char **data, size_t *len)
+{
+    int fd = open(pathname, O_RDONLY);
+    if (fd < 0)
+    {
+        return false;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode) || st.st_size <= 0)
+    {
+        close(fd);
+        return false;
+    }
+
+    void *p = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd); // The mapping holds its own reference to the file
+    if (p == MAP_FAILED)
+    {
+        return false;
+    }
+    *data = (const char *)p;
+    *len = (size_t)st.st_size;
+    return true;
+}
+
+static void logo_host_unmap_file(const char *pathname, const char *data, size_t len)
+{
+    (void)pathname;
+    munmap((void *)data, len);
+}
+
 static const LogoStorageOps host_storage_ops = {
     .open = logo_host_file_open,
     .file_exists = logo_host_file_exists,
@@ -635,6 +670,8 @@ static const LogoStorageOps host_storage_ops = {
     .file_size = logo_host_file_size,
     .list_directory = logo_host_list_directory,
     .free_blocks = logo_host_free_blocks,
+    .map_file = logo_host_map_file,
+    .unmap_file = logo_host_unmap_file,
     // mount_available left NULL: the host filesystem is always available.
 };
 
@@ -96,6 +96,7 @@ void logo_io_init(LogoIO *io, LogoConsole *console, LogoStorage *storage, LogoHa
     io->open_count = 0;
     io->prefix[0] = '\0';
     io->network_timeout = LOGO_DEFAULT_NETWORK_TIMEOUT;
+    io->mapped[0] = '\0';
 
     for (int i = 0; i < LOGO_MAX_OPEN_FILES; i++)
     {
@@ -145,6 +146,19 @@ uint32_t logo_io_ticks_ms(LogoIO *io)
     return io->hardware->ops->ticks_ms();
 }
 
+uint32_t logo_io_ticks_us(LogoIO *io)
+{
+    if (!io || !io->hardware || !io->hardware->ops)
+    {
+        return 0;
+    }
+    if (io->hardware->ops->ticks_us)
+    {
+        return io->hardware->ops->ticks_us();
+    }
+    return logo_io_ticks_ms(io) * 1000u;
+}
+
 bool logo_io_has_ticks_ms(LogoIO *io)
 {
     return io && io->hardware && io->hardware->ops && io->hardware->ops->ticks_ms;
@@ -566,6 +580,14 @@ char *logo_io_resolve_path(const LogoIO *io, const char *pathname,
 // Forward declaration for network stream creation
 static LogoStream *create_network_stream(LogoIO *io, const char *host, uint16_t port, const char *name);
 
+// True when `full_path` is the file logo_io_map_file has mapped. Its bytes
+// are being read in place, so it is not written, deleted or renamed until
+// logo_io_unmap_file.
+static bool logo_io_is_mapped(const LogoIO *io, const char *full_path)
+{
+    return io->mapped[0] != '\0' && strcmp(io->mapped, full_path) == 0;
+}
+
 LogoStream *logo_io_open(LogoIO *io, const char *target)
 {
     if (!io || !target)
@@ -609,6 +631,10 @@ LogoStream *logo_io_open(LogoIO *io, const char *target)
     {
         return existing;
     }
+    if (logo_io_is_mapped(io, full_path))
+    {
+        return NULL;
+    }
 
     // Check if we have a file opener
     if (!io->storage || !io->storage->ops || !io->storage->ops->open)
@@ -629,6 +655,10 @@ LogoStream *logo_io_open(LogoIO *io, const char *target)
         return NULL;
     }
 
+    // readchar, readlist, load and print to a file then work from memory
+    // rather than seeking the backend per character or per word
+    stream = logo_stream_buffered(stream);
+
     // Find an empty slot
     for (int i = 0; i < LOGO_MAX_OPEN_FILES; i++)
     {
@@ -863,7 +893,7 @@ bool logo_io_is_open(const LogoIO *io, const char *name)
         }
     }
 
-    return false;
+    return logo_io_is_mapped(io, lookup_name);
 }
 
 int logo_io_open_count(const LogoIO *io)
@@ -945,6 +975,10 @@ bool logo_io_file_delete(const LogoIO *io, const char *pathname)
     {
         return false;
     }
+    if (logo_io_is_mapped(io, full_path))
+    {
+        return false;
+    }
 
     return io->storage->ops->file_delete(full_path);
 }
@@ -1005,6 +1039,10 @@ bool logo_io_rename(const LogoIO *io, const char *old_path, const char *new_path
     {
         return false;
     }
+    if (logo_io_is_mapped(io, full_old_path) || logo_io_is_mapped(io, full_new_path))
+    {
+        return false;
+    }
 
     return io->storage->ops->rename(full_old_path, full_new_path);
 }
@@ -1043,9 +1081,9 @@ bool logo_io_copy_file(const LogoIO *io, const char *src_path, const char *dst_p
     {
         return true;
     }
-    if (ops->dir_exists(full_dst))
+    if (ops->dir_exists(full_dst) || logo_io_is_mapped(io, full_dst))
     {
-        return false; // never overwrite a directory with a file
+        return false; // never overwrite a directory, or a file being read in place
     }
     // Replace an existing destination cleanly: without this, open() positions
     // writes at end-of-file and would append / leave a stale tail. If the
@@ -1111,6 +1149,10 @@ bool logo_io_fs_image_restore(const LogoIO *io, LogoStream *in)
     {
         return false;
     }
+    if (io->mapped[0] != '\0')
+    {
+        return false; // would replace the mapped file's blocks
+    }
     return io->storage->ops->fs_image_restore(in);
 }
 
@@ -1160,6 +1202,55 @@ bool logo_io_free_blocks(const LogoIO *io, const char *pathname,
     return io->storage->ops->free_blocks(full_path, free_blocks, block_size);
 }
 
+bool logo_io_cache_stats(const LogoIO *io, const char *pathname,
+                         LogoCacheStats *stats)
+{
+    if (!io || !io->storage || !pathname || !io->storage->ops->cache_stats)
+    {
+        return false;
+    }
+    char resolved[LOGO_STREAM_NAME_MAX];
+    char *full_path = logo_io_resolve_path(io, pathname, resolved, sizeof(resolved));
+    if (!full_path)
+    {
+        return false;
+    }
+    return io->storage->ops->cache_stats(full_path, stats);
+}
+
+bool logo_io_map_file(LogoIO *io, const char *pathname,
+                      const char **data, size_t *len)
+{
+    if (!io || !io->storage || !pathname || !data || !len ||
+        !io->storage->ops->map_file || io->mapped[0] != '\0')
+    {
+        return false;
+    }
+    char resolved[LOGO_STREAM_NAME_MAX];
+    char *full_path = logo_io_resolve_path(io, pathname, resolved, sizeof(resolved));
+    if (!full_path || !io->storage->ops->map_file(full_path, data, len))
+    {
+        return false;
+    }
+    strcpy(io->mapped, full_path);
+    return true;
+}
+
+// Releases the mapping under the path it was made with: the code run while
+// the file was mapped may have changed the prefix since
+void logo_io_unmap_file(LogoIO *io, const char *data, size_t len)
+{
+    if (!io || !io->storage || io->mapped[0] == '\0')
+    {
+        return;
+    }
+    if (data && io->storage->ops->unmap_file)
+    {
+        io->storage->ops->unmap_file(io->mapped, data, len);
+    }
+    io->mapped[0] = '\0';
+}
+
 bool logo_io_mount_available(const LogoIO *io, const char *pathname)
 {
     if (!io || !io->storage || !pathname)
@@ -1293,7 +1384,7 @@ bool logo_io_start_dribble(LogoIO *io, const char *pathname)
     // Resolve the pathname with prefix
     char resolved[LOGO_STREAM_NAME_MAX];
     char *full_path = logo_io_resolve_path(io, pathname, resolved, sizeof(resolved));
-    if (!full_path)
+    if (!full_path || logo_io_is_mapped(io, full_path))
     {
         return false;
     }
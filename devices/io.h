@@ -61,6 +61,11 @@ extern "C"
 
         // Network timeout in milliseconds (0 = no timeout)
         int network_timeout;
+
+        // Resolved path of the file logo_io_map_file has mapped ("" if none).
+        // It counts as open until logo_io_unmap_file, so it cannot change
+        // under a reader that runs Logo code between reads.
+        char mapped[LOGO_STREAM_NAME_MAX];
     } LogoIO;
 
     //
@@ -84,6 +89,10 @@ extern "C"
     // Monotonic millisecond clock since boot (0 if the device has no clock)
     uint32_t logo_io_ticks_ms(LogoIO *io);
 
+    // Monotonic microsecond clock, wrapping at 2^32 us. A device without one
+    // answers from ticks_ms, in whole milliseconds (0 if it has neither).
+    uint32_t logo_io_ticks_us(LogoIO *io);
+
     // Whether the device provides a ticks_ms clock (false: demons poll budget is skipped)
     bool logo_io_has_ticks_ms(LogoIO *io);
 
@@ -244,6 +253,19 @@ extern "C"
     bool logo_io_free_blocks(const LogoIO *io, const char *pathname,
                              uint32_t *free_blocks, uint32_t *block_size);
 
+    // Report the block cache counters of the filesystem backing `pathname`.
+    // Returns false if unavailable or the backend has no block cache.
+    bool logo_io_cache_stats(const LogoIO *io, const char *pathname,
+                             LogoCacheStats *stats);
+
+    // Map the whole file at `pathname` read-only, for reading in place.
+    // Returns false if the storage cannot, or another file is mapped (read it
+    // as a stream instead). Until logo_io_unmap_file the file counts as open:
+    // opening, deleting, renaming, copying over or dribbling to it fails.
+    bool logo_io_map_file(LogoIO *io, const char *pathname,
+                          const char **data, size_t *len);
+    void logo_io_unmap_file(LogoIO *io, const char *data, size_t len);
+
     // Report whether the filesystem backing `pathname` is currently available
     // (e.g. an SD card is present). True when the backend cannot report.
     bool logo_io_mount_available(const LogoIO *io, const char *pathname);
@@ -495,6 +495,36 @@ static bool lfs_storage_fs_image_restore(LogoStream *in)
     return g_lfs != NULL && logo_lfs_restore(g_lfs, in);
 }
 
+// Where the block device's blocks can be read in place, or NULL
+static const uint8_t *g_lfs_memory;
+
+// A file stored in one CTZ block has its data at the start of that block.
+// Larger files interleave each block's skip-list pointers with the data,
+// and small files live inline in their directory's metadata, so neither is
+// one run of bytes: those are read through a stream.
+static bool lfs_storage_map_file(const char *pathname, const char **data, size_t *len)
+{
+    if (!g_lfs || !g_lfs_memory)
+    {
+        return false;
+    }
+
+    lfs_file_t file;
+    if (lfs_file_open(g_lfs, &file, pathname, LFS_O_RDONLY) < 0)
+    {
+        return false;
+    }
+    bool mapped = !(file.flags & LFS_F_INLINE) && file.ctz.size > 0 &&
+                  file.ctz.size <= g_lfs->cfg->block_size;
+    if (mapped)
+    {
+        *data = (const char *)g_lfs_memory + (size_t)file.ctz.head * g_lfs->cfg->block_size;
+        *len = file.ctz.size;
+    }
+    lfs_file_close(g_lfs, &file);
+    return mapped;
+}
+
 static const LogoStorageOps lfs_storage_ops = {
     .open = lfs_storage_open,
     .file_exists = lfs_storage_file_exists,
@@ -509,10 +539,18 @@ static const LogoStorageOps lfs_storage_ops = {
     .mount_available = lfs_storage_mount_available,
     .fs_image_backup = lfs_storage_fs_image_backup,
     .fs_image_restore = lfs_storage_fs_image_restore,
+    .map_file = lfs_storage_map_file,
+    // unmap_file left NULL: a mapping is a pointer into the device.
 };
 
 void logo_lfs_storage_init(LogoStorage *storage, lfs_t *lfs)
 {
     g_lfs = lfs;
+    g_lfs_memory = NULL;
     logo_storage_init(storage, &lfs_storage_ops);
 }
+
+void logo_lfs_storage_set_memory(const void *base)
+{
+    g_lfs_memory = (const uint8_t *)base;
+}
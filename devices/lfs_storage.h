@@ -26,6 +26,12 @@ extern "C"
     // then fail gracefully).
     void logo_lfs_storage_init(LogoStorage *storage, lfs_t *lfs);
 
+    // Tell the storage that block 0 of the block device can be read in place
+    // at `base`, block after block (XIP flash on the device), so map_file can
+    // hand out pointers for files stored in a single block. NULL, the default
+    // after init, turns mapping off.
+    void logo_lfs_storage_set_memory(const void *base);
+
 #ifdef __cplusplus
 }
 #endif
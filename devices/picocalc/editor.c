@@ -2383,9 +2383,14 @@ LogoEditorResult picocalc_editor_edit(char *buffer, size_t buffer_size,
 
     // Main editor loop
     while (true) {
+        // The editor draws straight to the LCD, which the core-1 present
+        // may be using: a save can run Logo code that draws, and demons run
+        // while keyboard_get_key idles. Let any queued frame finish first.
+        screen_gfx_sync();
         // Draw cursor before waiting for key (in case it was erased)
         lcd_draw_cursor();
         char key = keyboard_get_key();
+        screen_gfx_sync();
         // Erase cursor before modifying screen
         lcd_erase_cursor();
         
@@ -70,6 +70,7 @@ static uint32_t current_dir_cluster = 0; // Current directory cluster
 
 // Working buffers
 static uint8_t sector_buffer[FAT32_SECTOR_SIZE] __attribute__((aligned(4)));
+
 static fat32_lfn_entry_t lfn_buffer[MAX_LFN_PART]; // Buffer for long file name entries
 
 // Timer for SD card detection
@@ -84,14 +85,305 @@ static inline uint32_t cluster_to_sector(uint32_t cluster)
     return ((cluster - 2) * boot_sector.sectors_per_cluster) + first_data_sector;
 }
 
+//
+//  Sector cache (see fat32.h)
+//
+//  Slots are looked up by scan: there are few, and a scan is nothing beside an
+//  SD transfer. Each slot carries the tick of its last use; the victim is the
+//  oldest. A new sector goes in the slot after its predecessor's when that is
+//  clean, so sequential writes and read-aheads fill runs of adjacent slots and
+//  reach the card as one multi-block transfer. Slots are keyed by volume
+//  sector and belong to the mount they were filled under. fat32_unmount
+//  writes the dirty ones back if the card is still there, and empties the
+//  cache; the card-detect timer only bumps fat32_generation_counter, which
+//  empties it on its next use, since the timer may fire in the middle of a
+//  lookup.
+//
+
+#define FAT32_CACHE_SECTORS_MAX                                 \
+    (FAT32_CACHE_SECTORS_PSRAM > FAT32_CACHE_SECTORS ? FAT32_CACHE_SECTORS_PSRAM \
+                                                     : FAT32_CACHE_SECTORS)
+
+#define CACHE_VALID (0x01)
+#define CACHE_DIRTY (0x02)
+
+static uint8_t cache_sram[FAT32_CACHE_SECTORS * FAT32_SECTOR_SIZE] __attribute__((aligned(4)));
+static uint8_t *cache_data = cache_sram;
+static uint32_t cache_slots = FAT32_CACHE_SECTORS;
+static uint32_t cache_sector[FAT32_CACHE_SECTORS_MAX];
+static uint32_t cache_used[FAT32_CACHE_SECTORS_MAX];
+static uint8_t cache_state[FAT32_CACHE_SECTORS_MAX];
+static uint32_t cache_clock = 0;
+static uint32_t cache_generation = 0;
+static fat32_cache_stats_t cache_stats;
+
+static inline uint8_t *cache_slot(uint32_t slot)
+{
+    return cache_data + slot * FAT32_SECTOR_SIZE;
+}
+
+// Empty the cache. Dirty slots are lost, and counted.
+static void cache_reset(void)
+{
+    for (uint32_t i = 0; i < cache_slots; i++)
+    {
+        if (cache_state[i] & CACHE_DIRTY)
+        {
+            cache_stats.sectors_dropped++;
+        }
+    }
+    memset(cache_state, 0, sizeof(cache_state));
+    cache_generation = fat32_generation_counter;
+}
+
+// The slot holding `sector`, or -1
+static int cache_find(uint32_t sector)
+{
+    if (cache_generation != fat32_generation_counter)
+    {
+        cache_reset();
+    }
+    for (uint32_t i = 0; i < cache_slots; i++)
+    {
+        if ((cache_state[i] & CACHE_VALID) && cache_sector[i] == sector)
+        {
+            return (int)i;
+        }
+    }
+    return -1;
+}
+
+// Write dirty `slot` with its dirty neighbours that hold the sectors either
+// side of it, in one transfer.
+static fat32_error_t cache_write_run(uint32_t slot)
+{
+    uint32_t first = slot;
+    while (first > 0 && (cache_state[first - 1] & CACHE_DIRTY) &&
+           cache_sector[first - 1] + 1 == cache_sector[first])
+    {
+        first--;
+    }
+    uint32_t last = slot;
+    while (last + 1 < cache_slots && (cache_state[last + 1] & CACHE_DIRTY) &&
+           cache_sector[last + 1] == cache_sector[last] + 1)
+    {
+        last++;
+    }
+
+    uint32_t count = last - first + 1;
+    RETURN_ON_ERROR((fat32_error_t)sd_write_blocks(volume_start_block + cache_sector[first],
+                                                   count, cache_slot(first)));
+    for (uint32_t i = first; i <= last; i++)
+    {
+        cache_state[i] &= (uint8_t)~CACHE_DIRTY;
+    }
+    cache_stats.sectors_written += count;
+    return FAT32_OK;
+}
+
+// The slot to fill with `sector`
+static uint32_t cache_victim(uint32_t sector)
+{
+    int prev = sector > 0 ? cache_find(sector - 1) : -1;
+    if (prev >= 0 && (uint32_t)prev + 1 < cache_slots &&
+        !(cache_state[prev + 1] & CACHE_DIRTY))
+    {
+        return (uint32_t)prev + 1;
+    }
+
+    uint32_t victim = 0;
+    for (uint32_t i = 0; i < cache_slots; i++)
+    {
+        if (!(cache_state[i] & CACHE_VALID))
+        {
+            return i;
+        }
+        if (cache_used[i] < cache_used[victim])
+        {
+            victim = i;
+        }
+    }
+    return victim;
+}
+
+// The first of `count` adjacent slots whose newest is oldest
+static uint32_t cache_window(uint32_t count)
+{
+    uint32_t best = 0;
+    uint32_t best_age = UINT32_MAX;
+    for (uint32_t start = 0; start + count <= cache_slots; start++)
+    {
+        uint32_t newest = 0;
+        for (uint32_t i = start; i < start + count; i++)
+        {
+            if ((cache_state[i] & CACHE_VALID) && cache_used[i] > newest)
+            {
+                newest = cache_used[i];
+            }
+        }
+        if (newest < best_age)
+        {
+            best = start;
+            best_age = newest;
+        }
+    }
+    return best;
+}
+
+// How many sectors to read for a miss on `sector`: more than one only for a
+// data sector whose predecessor is cached, so a stream reads ahead and a
+// scattered reader does not, or for a sector of the first FAT when `scan`
+// says the caller reads the FAT through. (A chain walk keeps its FAT sector
+// hot, so the predecessor test alone would read ahead sectors it reaches only
+// 128 clusters later.) Stops short of any sector already cached, which may be
+// newer than the card.
+static uint32_t cache_read_ahead(uint32_t sector, bool scan)
+{
+    uint32_t fat_end = boot_sector.reserved_sectors + boot_sector.fat_size_32;
+    uint32_t region_end;
+    if (sector > first_data_sector && sector < first_data_sector + data_region_sectors)
+    {
+        region_end = first_data_sector + data_region_sectors;
+    }
+    else if (scan && sector > boot_sector.reserved_sectors && sector < fat_end)
+    {
+        region_end = fat_end;
+    }
+    else
+    {
+        return 1;
+    }
+    if (cache_find(sector - 1) < 0)
+    {
+        return 1;
+    }
+
+    uint32_t limit = FAT32_READ_AHEAD_SECTORS;
+    if (limit > cache_slots / 2)
+    {
+        limit = cache_slots / 2;
+    }
+    if (limit > region_end - sector)
+    {
+        limit = region_end - sector;
+    }
+
+    uint32_t count = 1;
+    while (count < limit && cache_find(sector + count) < 0)
+    {
+        count++;
+    }
+    return count;
+}
+
+// The slot holding `sector`, read from the card on a miss when `fill` is set.
+// Without `fill` a missed slot's bytes are stale: the caller overwrites all
+// of them and marks the slot dirty. The slot is good until the next lookup.
+static fat32_error_t cache_load(uint32_t sector, bool fill, bool scan, uint32_t *slot)
+{
+    int hit = cache_find(sector);
+    if (hit >= 0)
+    {
+        cache_stats.hits++;
+        cache_used[hit] = ++cache_clock;
+        *slot = (uint32_t)hit;
+        return FAT32_OK;
+    }
+    cache_stats.misses++;
+
+    uint32_t count = fill ? cache_read_ahead(sector, scan) : 1;
+    uint32_t first = count > 1 ? cache_window(count) : cache_victim(sector);
+    for (uint32_t i = first; i < first + count; i++)
+    {
+        if (cache_state[i] & CACHE_DIRTY)
+        {
+            RETURN_ON_ERROR(cache_write_run(i));
+        }
+        cache_state[i] = 0;
+    }
+
+    if (fill)
+    {
+        RETURN_ON_ERROR((fat32_error_t)(count > 1
+                                            ? sd_read_blocks(volume_start_block + sector, count, cache_slot(first))
+                                            : sd_read_block(volume_start_block + sector, cache_slot(first))));
+        cache_stats.sectors_read += count;
+    }
+
+    // The sector asked for is the newest; those read ahead queue behind it
+    for (uint32_t i = 0; i < count; i++)
+    {
+        cache_sector[first + i] = sector + i;
+        cache_state[first + i] = CACHE_VALID;
+        cache_used[first + i] = cache_clock + 1 + (count - 1 - i);
+    }
+    cache_clock += count;
+    *slot = first;
+    return FAT32_OK;
+}
+
+static inline fat32_error_t cache_lookup(uint32_t sector, bool fill, uint32_t *slot)
+{
+    return cache_load(sector, fill, false, slot);
+}
+
+static inline void cache_mark_dirty(uint32_t slot)
+{
+    cache_state[slot] |= CACHE_DIRTY;
+}
+
 static inline fat32_error_t read_sector(uint32_t sector, uint8_t *buffer)
 {
-    return sd_read_block(volume_start_block + sector, buffer);
+    uint32_t slot;
+    RETURN_ON_ERROR(cache_lookup(sector, true, &slot));
+    memcpy(buffer, cache_slot(slot), FAT32_SECTOR_SIZE);
+    return FAT32_OK;
 }
 
 static inline fat32_error_t write_sector(uint32_t sector, const uint8_t *buffer)
 {
-    return sd_write_block(volume_start_block + sector, buffer);
+    uint32_t slot;
+    RETURN_ON_ERROR(cache_lookup(sector, false, &slot));
+    memcpy(cache_slot(slot), buffer, FAT32_SECTOR_SIZE);
+    cache_mark_dirty(slot);
+    return FAT32_OK;
+}
+
+fat32_error_t fat32_flush(void)
+{
+    if (cache_generation != fat32_generation_counter)
+    {
+        cache_reset();
+        return FAT32_OK;
+    }
+    for (uint32_t i = 0; i < cache_slots; i++)
+    {
+        if (cache_state[i] & CACHE_DIRTY)
+        {
+            RETURN_ON_ERROR(cache_write_run(i));
+        }
+    }
+    return FAT32_OK;
+}
+
+void fat32_set_cache_memory(uint8_t *memory, uint32_t sectors)
+{
+    if (memory == NULL || sectors == 0)
+    {
+        cache_data = cache_sram;
+        cache_slots = FAT32_CACHE_SECTORS;
+    }
+    else
+    {
+        cache_data = memory;
+        cache_slots = sectors < FAT32_CACHE_SECTORS_MAX ? sectors : FAT32_CACHE_SECTORS_MAX;
+    }
+    cache_reset();
+}
+
+void fat32_get_cache_stats(fat32_cache_stats_t *stats)
+{
+    *stats = cache_stats;
 }
 
 // Returns a FAT date encoding (year-1980 in bits 9-15, month 1-12 in bits 5-8,
@@ -281,6 +573,71 @@ static inline bool is_chain_end_or_invalid(uint32_t cluster)
     return is_eoc_cluster(cluster) || !is_valid_data_cluster(cluster);
 }
 
+//
+//  Free-cluster map (see fat32.h)
+//
+//  A search reads only groups whose bit is set, a FAT sector at a time, so a
+//  full card costs a scan once per mount rather than once per cluster, and a
+//  full volume is known from the map alone.
+//
+
+#define FAT_ENTRIES_PER_SECTOR (FAT32_SECTOR_SIZE / 4)
+
+static uint32_t free_map[FAT32_FREE_MAP_BYTES / 4];
+static uint32_t free_map_group = 1; // FAT sectors per bit
+static uint32_t free_map_bits = 0;
+
+static void free_map_reset(void)
+{
+    uint32_t fat_sectors = (cluster_count + 2 + FAT_ENTRIES_PER_SECTOR - 1) / FAT_ENTRIES_PER_SECTOR;
+    uint32_t capacity = FAT32_FREE_MAP_BYTES * 8;
+    free_map_group = (fat_sectors + capacity - 1) / capacity;
+    free_map_bits = (fat_sectors + free_map_group - 1) / free_map_group;
+
+    memset(free_map, 0, sizeof(free_map));
+    for (uint32_t i = 0; i < free_map_bits; i++)
+    {
+        free_map[i / 32] |= 1u << (i % 32);
+    }
+}
+
+static inline uint32_t free_map_group_of(uint32_t cluster)
+{
+    return cluster / FAT_ENTRIES_PER_SECTOR / free_map_group;
+}
+
+static inline bool free_map_test(uint32_t group)
+{
+    return (free_map[group / 32] >> (group % 32)) & 1u;
+}
+
+static inline void free_map_set(uint32_t group, bool may_be_free)
+{
+    if (may_be_free)
+    {
+        free_map[group / 32] |= 1u << (group % 32);
+    }
+    else
+    {
+        free_map[group / 32] &= ~(1u << (group % 32));
+    }
+}
+
+// The next group at or after `group` whose bit is set, or free_map_bits
+static uint32_t free_map_next(uint32_t group)
+{
+    while (group < free_map_bits)
+    {
+        uint32_t word = free_map[group / 32] >> (group % 32);
+        if (word != 0)
+        {
+            return group + (uint32_t)__builtin_ctz(word);
+        }
+        group = (group / 32 + 1) * 32;
+    }
+    return free_map_bits;
+}
+
 static fat32_error_t read_cluster_fat_entry(uint32_t cluster, uint32_t *value)
 {
     // Only valid data clusters (2 .. cluster_count+1) are accessible
@@ -293,10 +650,10 @@ static fat32_error_t read_cluster_fat_entry(uint32_t cluster, uint32_t *value)
     uint32_t fat_sector = boot_sector.reserved_sectors + (fat_offset / FAT32_SECTOR_SIZE);
     uint32_t entry_offset = fat_offset % FAT32_SECTOR_SIZE;
 
-    // Read the FAT sector
-    RETURN_ON_ERROR(read_sector(fat_sector, sector_buffer));
+    uint32_t slot;
+    RETURN_ON_ERROR(cache_lookup(fat_sector, true, &slot));
 
-    uint32_t entry = *(uint32_t *)(sector_buffer + entry_offset);
+    uint32_t entry = *(uint32_t *)(cache_slot(slot) + entry_offset);
     *value = entry & 0x0FFFFFFF; // Mask out upper 4 bits for FAT32
     return FAT32_OK;
 }
@@ -313,6 +670,11 @@ static fat32_error_t write_cluster_fat_entry(uint32_t cluster, uint32_t value)
     uint32_t fat_sector_offset = fat_offset / FAT32_SECTOR_SIZE;
     uint32_t entry_offset = fat_offset % FAT32_SECTOR_SIZE;
 
+    if ((value & 0x0FFFFFFF) == FAT32_FAT_ENTRY_FREE)
+    {
+        free_map_set(free_map_group_of(cluster), true);
+    }
+
     // Write to all FAT copies to keep them in sync
     for (uint8_t fat_idx = 0; fat_idx < boot_sector.num_fats; fat_idx++)
     {
@@ -320,57 +682,177 @@ static fat32_error_t write_cluster_fat_entry(uint32_t cluster, uint32_t value)
                               ((uint32_t)fat_idx * boot_sector.fat_size_32) +
                               fat_sector_offset;
 
-        // Read the FAT sector
-        RETURN_ON_ERROR(read_sector(fat_sector, sector_buffer));
+        uint32_t slot;
+        RETURN_ON_ERROR(cache_lookup(fat_sector, true, &slot));
 
         // Update the entry, preserving the upper 4 bits
-        *(uint32_t *)(sector_buffer + entry_offset) &= 0xF0000000;
-        *(uint32_t *)(sector_buffer + entry_offset) |= value & 0x0FFFFFFF;
-
-        // Write the modified sector back
-        RETURN_ON_ERROR(write_sector(fat_sector, sector_buffer));
+        uint32_t *entry = (uint32_t *)(cache_slot(slot) + entry_offset);
+        *entry = (*entry & 0xF0000000) | (value & 0x0FFFFFFF);
+        cache_mark_dirty(slot);
     }
 
     return FAT32_OK;
 }
 
-static fat32_error_t get_next_free_cluster(uint32_t *cluster)
+// Search group `group` from cluster `from` for a free cluster, into *found (0
+// if none). With `count` set, count every free cluster from `from` instead of
+// stopping. A search of the whole group refreshes its bit.
+static fat32_error_t free_map_scan(uint32_t group, uint32_t from, uint32_t *found, uint32_t *count)
 {
-    // Valid cluster range: 2 to cluster_count + 1 (inclusive)
-    uint32_t range_end = cluster_count + 2; // exclusive upper bound
+    uint32_t group_start = group * free_map_group * FAT_ENTRIES_PER_SECTOR;
+    uint32_t lo = group_start < 2 ? 2 : group_start;
+    uint32_t hi = group_start + free_map_group * FAT_ENTRIES_PER_SECTOR;
+    if (hi > cluster_count + 2)
+    {
+        hi = cluster_count + 2;
+    }
+    bool whole = from <= lo;
+    if (from > lo)
+    {
+        lo = from;
+    }
 
-    // Clamp hint to valid range
-    uint32_t start = (fsinfo.next_free >= 2 && fsinfo.next_free < range_end)
-                         ? fsinfo.next_free
-                         : 2;
+    *found = 0;
+    uint32_t free_here = 0;
+    uint32_t cluster = lo;
+    while (cluster < hi)
+    {
+        uint32_t slot;
+        RETURN_ON_ERROR(cache_load(boot_sector.reserved_sectors + cluster / FAT_ENTRIES_PER_SECTOR,
+                                   true, true, &slot));
+        const uint32_t *entries = (const uint32_t *)cache_slot(slot);
+        uint32_t sector_end = (cluster / FAT_ENTRIES_PER_SECTOR + 1) * FAT_ENTRIES_PER_SECTOR;
+        if (sector_end > hi)
+        {
+            sector_end = hi;
+        }
+        for (; cluster < sector_end; cluster++)
+        {
+            if ((entries[cluster % FAT_ENTRIES_PER_SECTOR] & 0x0FFFFFFF) == FAT32_FAT_ENTRY_FREE)
+            {
+                if (*found == 0)
+                {
+                    *found = cluster;
+                }
+                free_here++;
+                if (count == NULL)
+                {
+                    return FAT32_OK;
+                }
+            }
+        }
+    }
 
-    // First pass: from start to end of valid range
-    for (uint32_t i = start; i < range_end; i++)
+    if (whole)
+    {
+        free_map_set(group, free_here > 0);
+    }
+    if (count != NULL)
+    {
+        *count += free_here;
+    }
+    return FAT32_OK;
+}
+
+// A free cluster: `near` if it is free (0 for no preference), else the first
+// found from the FSInfo hint on, wrapping once. The hint moves past it.
+static fat32_error_t get_next_free_cluster(uint32_t near, uint32_t *cluster)
+{
+    if (is_valid_data_cluster(near))
     {
         uint32_t value;
-        RETURN_ON_ERROR(read_cluster_fat_entry(i, &value));
+        RETURN_ON_ERROR(read_cluster_fat_entry(near, &value));
         if (value == FAT32_FAT_ENTRY_FREE)
         {
-            *cluster = i;
+            *cluster = near;
+            fsinfo.next_free = near + 1;
             return FAT32_OK;
         }
     }
 
-    // Second pass: wrap from 2 to start (avoids false DISK_FULL)
-    for (uint32_t i = 2; i < start; i++)
+    // Clamp hint to valid range
+    uint32_t start = is_valid_data_cluster(fsinfo.next_free) ? fsinfo.next_free : 2;
+    uint32_t start_group = free_map_group_of(start);
+
+    // From the hint to the end, then from the start of the volume through
+    // the hint's group again, which the first pass searched only part of
+    for (int pass = 0; pass < 2; pass++)
     {
-        uint32_t value;
-        RETURN_ON_ERROR(read_cluster_fat_entry(i, &value));
-        if (value == FAT32_FAT_ENTRY_FREE)
+        uint32_t group = free_map_next(pass == 0 ? start_group : 0);
+        uint32_t last = pass == 0 ? free_map_bits : start_group + 1;
+        for (; group < last; group = free_map_next(group + 1))
         {
-            *cluster = i;
-            return FAT32_OK;
+            uint32_t found;
+            uint32_t from = (pass == 0 && group == start_group) ? start : 0;
+            RETURN_ON_ERROR(free_map_scan(group, from, &found, NULL));
+            if (found != 0)
+            {
+                *cluster = found;
+                fsinfo.next_free = found + 1;
+                return FAT32_OK;
+            }
         }
     }
 
     return FAT32_ERROR_DISK_FULL; // No free clusters found
 }
 
+// The first cluster of `count` free ones in a row, searching at most
+// FAT32_RUN_SEARCH_SECTORS FAT sectors from `from`; 0 if there is none
+// there. A full group is skipped whole and ends any run.
+static fat32_error_t find_free_run(uint32_t from, uint32_t count, uint32_t *run)
+{
+    *run = 0;
+    if (!is_valid_data_cluster(from))
+    {
+        from = is_valid_data_cluster(fsinfo.next_free) ? fsinfo.next_free : 2;
+    }
+
+    uint32_t run_start = 0;
+    uint32_t run_length = 0;
+    uint32_t budget = FAT32_RUN_SEARCH_SECTORS;
+    uint32_t cluster = from;
+    while (budget > 0 && cluster <= cluster_count + 1)
+    {
+        uint32_t group = free_map_group_of(cluster);
+        if (!free_map_test(group))
+        {
+            cluster = (group + 1) * free_map_group * FAT_ENTRIES_PER_SECTOR;
+            run_length = 0;
+            continue;
+        }
+
+        uint32_t slot;
+        RETURN_ON_ERROR(cache_load(boot_sector.reserved_sectors + cluster / FAT_ENTRIES_PER_SECTOR,
+                                   true, true, &slot));
+        const uint32_t *entries = (const uint32_t *)cache_slot(slot);
+        uint32_t sector_end = (cluster / FAT_ENTRIES_PER_SECTOR + 1) * FAT_ENTRIES_PER_SECTOR;
+        if (sector_end > cluster_count + 2)
+        {
+            sector_end = cluster_count + 2;
+        }
+        for (; cluster < sector_end; cluster++)
+        {
+            if ((entries[cluster % FAT_ENTRIES_PER_SECTOR] & 0x0FFFFFFF) != FAT32_FAT_ENTRY_FREE)
+            {
+                run_length = 0;
+                continue;
+            }
+            if (run_length++ == 0)
+            {
+                run_start = cluster;
+            }
+            if (run_length == count)
+            {
+                *run = run_start;
+                return FAT32_OK;
+            }
+        }
+        budget--;
+    }
+    return FAT32_OK;
+}
+
 static fat32_error_t release_cluster_chain(uint32_t start_cluster)
 {
     uint32_t total_clusters = 0;
@@ -417,25 +899,11 @@ static fat32_error_t release_cluster_chain(uint32_t start_cluster)
     return FAT32_OK;
 }
 
-static fat32_error_t find_last_cluster(uint32_t start_cluster, uint32_t count, uint32_t *last_cluster)
+// Allocate a cluster after `last_cluster`, preferring `near` (0 for the one
+// straight after it) so a file's clusters stay in a row.
+static fat32_error_t allocate_and_link_cluster(uint32_t last_cluster, uint32_t near, uint32_t *new_cluster)
 {
-    *last_cluster = start_cluster;
-    for (uint32_t i = 1; i < count; i++)
-    {
-        uint32_t next_cluster;
-        RETURN_ON_ERROR(read_cluster_fat_entry(*last_cluster, &next_cluster));
-        if (is_chain_end_or_invalid(next_cluster))
-        {
-            return FAT32_ERROR_INVALID_POSITION;
-        }
-        *last_cluster = next_cluster;
-    }
-    return FAT32_OK;
-}
-
-static fat32_error_t allocate_and_link_cluster(uint32_t last_cluster, uint32_t *new_cluster)
-{
-    RETURN_ON_ERROR(get_next_free_cluster(new_cluster));
+    RETURN_ON_ERROR(get_next_free_cluster(near != 0 ? near : last_cluster + 1, new_cluster));
     RETURN_ON_ERROR(write_cluster_fat_entry(last_cluster, *new_cluster));
     RETURN_ON_ERROR(write_cluster_fat_entry(*new_cluster, FAT32_FAT_ENTRY_EOC));
 
@@ -448,17 +916,30 @@ static fat32_error_t allocate_and_link_cluster(uint32_t last_cluster, uint32_t *
     return FAT32_OK;
 }
 
-static fat32_error_t clear_cluster(uint32_t cluster)
+// Zero `cluster` but for its sectors [keep_from, keep_to), which the caller
+// is about to overwrite whole.
+static fat32_error_t clear_cluster_except(uint32_t cluster, uint32_t keep_from, uint32_t keep_to)
 {
     uint32_t sector = cluster_to_sector(cluster);
-    memset(sector_buffer, 0, FAT32_SECTOR_SIZE);
     for (uint32_t i = 0; i < boot_sector.sectors_per_cluster; i++)
     {
-        RETURN_ON_ERROR(write_sector(sector + i, sector_buffer));
+        if (i >= keep_from && i < keep_to)
+        {
+            continue;
+        }
+        uint32_t slot;
+        RETURN_ON_ERROR(cache_lookup(sector + i, false, &slot));
+        memset(cache_slot(slot), 0, FAT32_SECTOR_SIZE);
+        cache_mark_dirty(slot);
     }
     return FAT32_OK;
 }
 
+static fat32_error_t clear_cluster(uint32_t cluster)
+{
+    return clear_cluster_except(cluster, 0, 0);
+}
+
 static fat32_error_t seek_to_cluster(uint32_t start_cluster, uint32_t offset, uint32_t *result_cluster)
 {
     uint32_t cluster = start_cluster;
@@ -481,6 +962,25 @@ static fat32_error_t seek_to_cluster(uint32_t start_cluster, uint32_t offset, ui
     return FAT32_OK;
 }
 
+// The cluster holding cluster `index` of `file`, walked from the file's
+// cursor (current_cluster at current_index) when that is at or before
+// `index`, else from its first cluster. Leaves the cursor there, so reading
+// or writing on through a file steps the chain once per cluster in all.
+static fat32_error_t file_cluster_at(fat32_file_t *file, uint32_t index, uint32_t *cluster)
+{
+    uint32_t from = file->start_cluster;
+    uint32_t steps = index;
+    if (file->current_cluster != 0 && file->current_index <= index)
+    {
+        from = file->current_cluster;
+        steps = index - file->current_index;
+    }
+    RETURN_ON_ERROR(seek_to_cluster(from, steps, cluster));
+    file->current_cluster = *cluster;
+    file->current_index = index;
+    return FAT32_OK;
+}
+
 // Maps a directory-relative byte offset to the physical cluster, sector, and
 // byte-in-sector.  Used throughout directory write/delete logic to avoid
 // duplicated, error-prone offset math.
@@ -519,6 +1019,7 @@ fat32_error_t fat32_mount(void)
     }
 
     RETURN_ON_ERROR(sd_card_init());
+    cache_reset();
 
     // Read boot sector
     RETURN_ON_ERROR(sd_read_block(0, sector_buffer));
@@ -596,6 +1097,7 @@ fat32_error_t fat32_mount(void)
     }
 
     current_dir_cluster = boot_sector.root_cluster; // Start at root directory
+    free_map_reset();
 
     // Cache the FSInfo sector.  An invalid or missing FSInfo sector is not
     // fatal — we simply mark free_count and next_free as unknown.
@@ -631,7 +1133,9 @@ fat32_error_t fat32_mount(void)
     return FAT32_OK;
 }
 
-void fat32_unmount(void)
+// Forget the mounted volume. Safe from the card-detect timer: it leaves the
+// sector cache to be emptied on its next use.
+static void fat32_forget_volume(void)
 {
     // Invalidate any open handles: after this, their recorded generation no
     // longer matches, so they will refuse to touch a (possibly different) card.
@@ -648,6 +1152,18 @@ void fat32_unmount(void)
     current_dir_cluster = 0;
 }
 
+void fat32_unmount(void)
+{
+    // What the cache holds for this mount goes to the card if it is still
+    // there. If not, or if the write fails, cache_reset drops it.
+    if (fat32_mounted && sd_card_present())
+    {
+        fat32_flush();
+    }
+    fat32_forget_volume();
+    cache_reset();
+}
+
 bool fat32_is_mounted(void)
 {
     return fat32_mounted;
@@ -701,35 +1217,20 @@ fat32_error_t fat32_get_free_space(uint64_t *free_space)
         return FAT32_OK; // Successfully retrieved free space
     }
 
-    // FSInfo unavailable — count free clusters manually.
-    // Only scan valid data clusters (2 .. cluster_count + 1) to avoid
-    // miscounting reserved FAT entries 0 and 1.
-    uint64_t free_clusters = 0;
-    uint32_t current_fat_sector = 0xFFFFFFFF;
-    for (uint32_t cluster = 2; cluster <= cluster_count + 1; cluster++)
+    // FSInfo unavailable — count free clusters manually, group by group,
+    // which leaves every bit of the free-cluster map exact.
+    uint32_t free_clusters = 0;
+    for (uint32_t group = 0; group < free_map_bits; group++)
     {
-        uint32_t fat_offset = cluster * 4;
-        uint32_t fat_sector = boot_sector.reserved_sectors + (fat_offset / FAT32_SECTOR_SIZE);
-        uint32_t entry_offset = fat_offset % FAT32_SECTOR_SIZE;
-
-        if (fat_sector != current_fat_sector)
-        {
-            RETURN_ON_ERROR(read_sector(fat_sector, sector_buffer));
-            current_fat_sector = fat_sector;
-        }
-
-        uint32_t entry = *(uint32_t *)(sector_buffer + entry_offset) & 0x0FFFFFFF;
-        if (entry == FAT32_FAT_ENTRY_FREE)
-        {
-            free_clusters++;
-        }
+        uint32_t found;
+        RETURN_ON_ERROR(free_map_scan(group, 0, &found, &free_clusters));
     }
 
     // Update FSInfo with the counted value so subsequent calls are fast
-    fsinfo.free_count = (uint32_t)free_clusters;
+    fsinfo.free_count = free_clusters;
     update_fsinfo();
 
-    *free_space = free_clusters * bytes_per_cluster;
+    *free_space = (uint64_t)free_clusters * bytes_per_cluster;
     return FAT32_OK;
 }
 
@@ -1486,7 +1987,7 @@ static fat32_error_t link_entry(fat32_entry_t *entry, const char *path)
             {
                 // Extend directory with a new cluster
                 uint32_t new_dir_cluster = 0;
-                CLOSE_AND_RETURN_ON_ERROR(allocate_and_link_cluster(cluster, &new_dir_cluster));
+                CLOSE_AND_RETURN_ON_ERROR(allocate_and_link_cluster(cluster, 0, &new_dir_cluster));
                 CLOSE_AND_RETURN_ON_ERROR(clear_cluster(new_dir_cluster));
                 cluster = new_dir_cluster;
             }
@@ -1539,7 +2040,7 @@ static fat32_error_t link_entry(fat32_entry_t *entry, const char *path)
     // Regular files start with start_cluster = 0 until the first write.
     if (entry->start_cluster == 0 && (entry->attr & FAT32_ATTR_DIRECTORY))
     {
-        CLOSE_AND_RETURN_ON_ERROR(get_next_free_cluster(&entry->start_cluster));
+        CLOSE_AND_RETURN_ON_ERROR(get_next_free_cluster(0, &entry->start_cluster));
         CLOSE_AND_RETURN_ON_ERROR(write_cluster_fat_entry(entry->start_cluster,
                                                           FAT32_FAT_ENTRY_EOC));
         if (fsinfo.free_count != 0xFFFFFFFF)
@@ -1728,7 +2229,7 @@ fat32_error_t fat32_close(fat32_file_t *file)
     }
 
     memset(file, 0, sizeof(fat32_file_t));
-    return FAT32_OK;
+    return fat32_flush();
 }
 
 fat32_error_t fat32_read(fat32_file_t *file, void *buffer, size_t size, size_t *bytes_read)
@@ -1766,9 +2267,7 @@ fat32_error_t fat32_read(fat32_file_t *file, void *buffer, size_t size, size_t *
 
     // Ensure current_cluster is correct for current file position
     uint32_t cluster = 0;
-    uint32_t cluster_offset = file->position / bytes_per_cluster;
-    RETURN_ON_ERROR(seek_to_cluster(file->start_cluster, cluster_offset, &cluster));
-    file->current_cluster = cluster;
+    RETURN_ON_ERROR(file_cluster_at(file, file->position / bytes_per_cluster, &cluster));
 
     size_t total_read = 0;
     uint8_t *dest = (uint8_t *)buffer;
@@ -1781,7 +2280,8 @@ fat32_error_t fat32_read(fat32_file_t *file, void *buffer, size_t size, size_t *
 
         uint32_t sector = cluster_to_sector(file->current_cluster) + sector_in_cluster;
 
-        RETURN_ON_ERROR(read_sector(sector, sector_buffer));
+        uint32_t slot;
+        RETURN_ON_ERROR(cache_lookup(sector, true, &slot));
 
         size_t bytes_to_copy = FAT32_SECTOR_SIZE - byte_in_sector;
         if (bytes_to_copy > size - total_read)
@@ -1789,7 +2289,7 @@ fat32_error_t fat32_read(fat32_file_t *file, void *buffer, size_t size, size_t *
             bytes_to_copy = size - total_read;
         }
 
-        memcpy(dest + total_read, sector_buffer + byte_in_sector, bytes_to_copy);
+        memcpy(dest + total_read, cache_slot(slot) + byte_in_sector, bytes_to_copy);
         total_read += bytes_to_copy;
         file->position += bytes_to_copy;
 
@@ -1804,6 +2304,7 @@ fat32_error_t fat32_read(fat32_file_t *file, void *buffer, size_t size, size_t *
                 break;
             }
             file->current_cluster = next_cluster;
+            file->current_index++;
         }
     }
 
@@ -1814,6 +2315,22 @@ fat32_error_t fat32_read(fat32_file_t *file, void *buffer, size_t size, size_t *
     return FAT32_OK;
 }
 
+// The sectors [*from, *to) of the file's cluster `index` that a write of
+// bytes [start, end) covers whole
+static void written_sectors(uint32_t index, uint32_t start, uint32_t end,
+                            uint32_t *from, uint32_t *to)
+{
+    uint32_t base = index * bytes_per_cluster;
+    uint32_t lo = start > base ? start - base : 0;
+    uint32_t hi = end - base < bytes_per_cluster ? end - base : bytes_per_cluster;
+    *from = (lo + FAT32_SECTOR_SIZE - 1) / FAT32_SECTOR_SIZE;
+    *to = hi / FAT32_SECTOR_SIZE;
+    if (end <= base || *to < *from)
+    {
+        *to = *from;
+    }
+}
+
 fat32_error_t fat32_write(fat32_file_t *file, const void *buffer, size_t size, size_t *bytes_written)
 {
     if (!file || !file->is_open || !buffer)
@@ -1858,14 +2375,25 @@ fat32_error_t fat32_write(fat32_file_t *file, const void *buffer, size_t size, s
                                     ? 0
                                     : (file->file_size + bytes_per_cluster - 1) / bytes_per_cluster;
 
-    // Allocate clusters as needed
+    // Allocate clusters as needed, in a row when a run of free ones is found
     if (needed_clusters > current_clusters)
     {
+        uint32_t last_cluster = 0;
+        if (file->start_cluster != 0)
+        {
+            RETURN_ON_ERROR(file_cluster_at(file, current_clusters - 1, &last_cluster));
+        }
+        uint32_t run = 0;
+        if (needed_clusters - current_clusters > 1)
+        {
+            RETURN_ON_ERROR(find_free_run(last_cluster + 1, needed_clusters - current_clusters, &run));
+        }
+
         if (file->start_cluster == 0)
         {
             // Empty file — allocate the very first cluster
             uint32_t first_cluster = 0;
-            RETURN_ON_ERROR(get_next_free_cluster(&first_cluster));
+            RETURN_ON_ERROR(get_next_free_cluster(run, &first_cluster));
             RETURN_ON_ERROR(write_cluster_fat_entry(first_cluster, FAT32_FAT_ENTRY_EOC));
             if (fsinfo.free_count != 0xFFFFFFFF)
             {
@@ -1874,24 +2402,29 @@ fat32_error_t fat32_write(fat32_file_t *file, const void *buffer, size_t size, s
             update_fsinfo();
             // Zero the freshly allocated cluster so any unwritten bytes
             // do not leak previous on-disk contents to the caller.
-            RETURN_ON_ERROR(clear_cluster(first_cluster));
+            uint32_t keep_from, keep_to;
+            written_sectors(0, file->position, end_pos, &keep_from, &keep_to);
+            RETURN_ON_ERROR(clear_cluster_except(first_cluster, keep_from, keep_to));
             file->start_cluster   = first_cluster;
             file->current_cluster = first_cluster;
+            file->current_index   = 0;
             current_clusters      = 1;
+            last_cluster          = first_cluster;
+            run                   = 0;
         }
 
         if (current_clusters < needed_clusters)
         {
-            // Extend the existing chain
-            uint32_t last_cluster = 0;
-            RETURN_ON_ERROR(find_last_cluster(file->start_cluster,
-                                              current_clusters, &last_cluster));
+            // Extend the existing chain, from the run's start if it was found
             for (uint32_t i = current_clusters; i < needed_clusters; i++)
             {
                 uint32_t new_cluster = 0;
-                RETURN_ON_ERROR(allocate_and_link_cluster(last_cluster, &new_cluster));
+                RETURN_ON_ERROR(allocate_and_link_cluster(last_cluster, run, &new_cluster));
+                run = 0;
                 // Zero the new cluster (see comment above).
-                RETURN_ON_ERROR(clear_cluster(new_cluster));
+                uint32_t keep_from, keep_to;
+                written_sectors(i, file->position, end_pos, &keep_from, &keep_to);
+                RETURN_ON_ERROR(clear_cluster_except(new_cluster, keep_from, keep_to));
                 last_cluster = new_cluster;
             }
         }
@@ -1913,8 +2446,7 @@ fat32_error_t fat32_write(fat32_file_t *file, const void *buffer, size_t size, s
         if (off_in_cluster != 0 && zero_to > gap_start)
         {
             uint32_t gap_cluster = 0;
-            RETURN_ON_ERROR(seek_to_cluster(file->start_cluster,
-                                            cluster_idx, &gap_cluster));
+            RETURN_ON_ERROR(file_cluster_at(file, cluster_idx, &gap_cluster));
             uint32_t bytes_left = zero_to - gap_start;
             uint32_t cur_off = off_in_cluster;
             while (bytes_left > 0)
@@ -1936,10 +2468,8 @@ fat32_error_t fat32_write(fat32_file_t *file, const void *buffer, size_t size, s
     }
 
     // Seek to the cluster that covers file->position
-    uint32_t cluster_index = file->position / bytes_per_cluster;
-    uint32_t cluster       = 0;
-    RETURN_ON_ERROR(seek_to_cluster(file->start_cluster, cluster_index, &cluster));
-    file->current_cluster = cluster;
+    uint32_t cluster = 0;
+    RETURN_ON_ERROR(file_cluster_at(file, file->position / bytes_per_cluster, &cluster));
 
     // Write data
     size_t total_written = 0;
@@ -1953,16 +2483,17 @@ fat32_error_t fat32_write(fat32_file_t *file, const void *buffer, size_t size, s
         uint32_t byte_in_sector    = offset_in_cluster % FAT32_SECTOR_SIZE;
         uint32_t sector            = cluster_to_sector(cluster) + sector_in_cluster;
 
-        RETURN_ON_ERROR(read_sector(sector, sector_buffer));
-
         size_t bytes_to_write = FAT32_SECTOR_SIZE - byte_in_sector;
         if (bytes_to_write > size - total_written)
         {
             bytes_to_write = size - total_written;
         }
 
-        memcpy(sector_buffer + byte_in_sector, src + total_written, bytes_to_write);
-        RETURN_ON_ERROR(write_sector(sector, sector_buffer));
+        // A whole sector is overwritten, so it need not be read first
+        uint32_t slot;
+        RETURN_ON_ERROR(cache_lookup(sector, bytes_to_write < FAT32_SECTOR_SIZE, &slot));
+        memcpy(cache_slot(slot) + byte_in_sector, src + total_written, bytes_to_write);
+        cache_mark_dirty(slot);
 
         total_written += bytes_to_write;
         pos_in_file   += bytes_to_write;
@@ -1978,6 +2509,7 @@ fat32_error_t fat32_write(fat32_file_t *file, const void *buffer, size_t size, s
             }
             cluster               = next_cluster;
             file->current_cluster = cluster;
+            file->current_index++;
         }
     }
 
@@ -2059,7 +2591,8 @@ fat32_error_t fat32_delete(const char *path)
     {
         return mount_status;
     }
-    return delete_entry(path);
+    RETURN_ON_ERROR(delete_entry(path));
+    return fat32_flush();
 }
 
 fat32_error_t fat32_rename(const char *old_path, const char *new_path)
@@ -2126,7 +2659,7 @@ fat32_error_t fat32_rename(const char *old_path, const char *new_path)
     // Only remove the old entry after the new one is safely written
     RETURN_ON_ERROR(unlink_entry(&entry));
 
-    return FAT32_OK;
+    return fat32_flush();
 }
 
 //
@@ -2574,7 +3107,7 @@ static bool on_sd_card_detect(repeating_timer_t *rt)
 
     if (!sd_card_present() && fat32_is_mounted())
     {
-        fat32_unmount();                    // Unmount if card is not present
+        fat32_forget_volume();              // Unmount if card is not present
         mount_status = FAT32_ERROR_NO_CARD; // Update status
     }
 
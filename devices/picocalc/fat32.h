@@ -11,12 +11,37 @@
 #include <stdbool.h>
 #include <stdint.h>
 
+#include "core/limits.h"
+
 // FAT32 constants
 #define FAT32_SECTOR_SIZE (SD_BLOCK_SIZE) // Standard sector size
 #define FAT32_MAX_FILENAME_LEN (255)
 #define FAT32_MAX_PATH_LEN (260)
 #define MAX_LFN_PART (20) // Maximum number of LFN parts (13 UTF-16 chars each)
 
+// Sector cache. Every sector the driver touches goes through an LRU cache of
+// FAT32_CACHE_SECTORS slots in SRAM, or FAT32_CACHE_SECTORS_PSRAM slots when
+// the board hands it a buffer with fat32_set_cache_memory() (both sized in
+// core/limits.h). Writes stay in the cache until the slot is evicted, the file
+// is closed, or fat32_flush() runs; a run of consecutive dirty sectors goes
+// out as one multi-block write. A miss in the data region just after a cached
+// sector reads up to FAT32_READ_AHEAD_SECTORS (at most half the slots) in one
+// multi-block read.
+#ifndef FAT32_READ_AHEAD_SECTORS
+#define FAT32_READ_AHEAD_SECTORS (8)
+#endif
+
+// Free-cluster map. One bit per group of FAT sectors, set while the group may
+// hold a free cluster: all set at mount, cleared when a search finds a group
+// full, set again when a cluster in it is freed. FAT32_FREE_MAP_BYTES bits
+// (core/limits.h) give one sector per bit up to 32 GB of 32 KB clusters;
+// larger volumes group sectors. A multi-cluster write looks for a run of free
+// clusters in at most FAT32_RUN_SEARCH_SECTORS FAT sectors before taking them
+// one at a time.
+#ifndef FAT32_RUN_SEARCH_SECTORS
+#define FAT32_RUN_SEARCH_SECTORS (64)
+#endif
+
 // File attributes
 #define FAT32_ATTR_READ_ONLY (0x01)
 #define FAT32_ATTR_HIDDEN (0x02)
@@ -70,7 +95,8 @@ typedef struct
     bool dirty;                // Set when file_size or start_cluster changed
     uint8_t attributes;
     uint32_t start_cluster;
-    uint32_t current_cluster;
+    uint32_t current_cluster;  // Cursor: the cluster at current_index
+    uint32_t current_index;    // Its index in the chain, from 0
     uint32_t file_size;
     uint32_t position;
     uint32_t dir_entry_sector; // Sector containing the directory entry
@@ -179,6 +205,18 @@ typedef struct
     uint16_t name3[2];   // Last 2 characters (UTF-16)
 } __attribute__((packed)) fat32_lfn_entry_t;
 
+// Sector cache counters since boot: lookups served from the cache and not,
+// sectors moved to and from the card by the cache, and dirty sectors an
+// unmount could not write back because the card was gone.
+typedef struct
+{
+    uint32_t hits;
+    uint32_t misses;
+    uint32_t sectors_read;
+    uint32_t sectors_written;
+    uint32_t sectors_dropped;
+} fat32_cache_stats_t;
+
 // File system functions
 bool fat32_is_ready(void);
 fat32_error_t fat32_mount(void);
@@ -196,6 +234,16 @@ fat32_error_t fat32_get_total_space(uint64_t *total_space);
 fat32_error_t fat32_get_volume_name(char *name, size_t name_len);
 uint32_t fat32_get_cluster_size(void);
 
+// Write every dirty cached sector to the card. fat32_close, fat32_delete,
+// fat32_rename and fat32_unmount flush; a removed card loses what was not
+// flushed.
+fat32_error_t fat32_flush(void);
+
+// Back the sector cache with `sectors` slots at `memory` (e.g. PSRAM), at most
+// FAT32_CACHE_SECTORS_PSRAM. Call before the first mount; the cache is emptied.
+void fat32_set_cache_memory(uint8_t *memory, uint32_t sectors);
+void fat32_get_cache_stats(fat32_cache_stats_t *stats);
+
 // File operations
 fat32_error_t fat32_open(fat32_file_t *file, const char *path);
 fat32_error_t fat32_create(fat32_file_t *file, const char *path);
@@ -343,7 +343,9 @@ char keyboard_get_key()
         // Update screen saver (checks idle time, cycles palette if active)
         screensaver_update();
         // Blink the cursor here, in thread context; the blink timer only
-        // sets a flag (the LCD must never be drawn from an IRQ).
+        // sets a flag (the LCD must never be drawn from an IRQ). A frame
+        // may still be going out over the same SPI, so let it finish.
+        screen_gfx_sync();
         lcd_cursor_blink();
         // Poll `when` demons and advance autonomous turtles while we idle at
         // the prompt, so they stay live as the user types.
@@ -23,6 +23,7 @@
 #include "devices/picocalc/picocalc_flash.h"
 #include "devices/picocalc/picocalc_lfs.h"
 #include "devices/picocalc/sdcard.h"
+#include "devices/picocalc/fat32.h"
 #include "core/memory.h"
 #include "core/lexer.h"
 #include "core/eval.h"
@@ -197,6 +198,15 @@ int main(void)
 
     static LogoStorage lfs_root_storage;
     logo_lfs_storage_init(&lfs_root_storage, picocalc_lfs());
+    // The region is XIP-mapped: `load` reads a one-block file straight from it
+    logo_lfs_storage_set_memory((const void *)(XIP_BASE + PICOCALC_FLASH_LFS_OFFSET));
+
+    // The SD sector cache takes its larger size from PSRAM when there is one
+    uint8_t *sd_cache = (uint8_t *)mem_region_alloc(FAT32_CACHE_SECTORS_PSRAM * FAT32_SECTOR_SIZE);
+    if (sd_cache != NULL)
+    {
+        fat32_set_cache_memory(sd_cache, FAT32_CACHE_SECTORS_PSRAM);
+    }
 
     LogoStorage *sd_storage = logo_picocalc_storage_create();
     if (!sd_storage)
@@ -219,12 +229,24 @@ int main(void)
     primitives_set_io(&io);
 
     // Load the startup file from the root filesystem if present.
-    if (lfs_ok && logo_io_file_exists(&io, "startup"))
+    // A workspace image saved by .savews starts quicker than the source it
+    // was made from, so it wins when both are there.
+    const char *startup = NULL;
+    if (lfs_ok && logo_io_file_exists(&io, "startup.img"))
+    {
+        startup = ".loadws \"startup.img";
+    }
+    else if (lfs_ok && logo_io_file_exists(&io, "startup"))
+    {
+        startup = "load \"startup";
+    }
+    if (startup)
     {
         Lexer startup_lexer;
         Evaluator startup_eval;
-        lexer_init(&startup_lexer, "load \"startup");
+        lexer_init(&startup_lexer, startup);
         eval_init(&startup_eval, &startup_lexer);
+        eval_set_frames(&startup_eval, proc_get_frame_stack());
         Result r = eval_instruction(&startup_eval);
         if (r.status == RESULT_ERROR)
         {
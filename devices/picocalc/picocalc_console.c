@@ -65,6 +65,7 @@ typedef struct
     uint8_t raster_mag;     // magnification it was built at
     uint8_t raster_rot;     // rotation style it was built with
     bool raster_flipped;    // built mirrored (flip style facing west)
+    uint32_t raster_serial; // Changes on every rebuild (LogoTurtleRaster)
     float speed;            // Autonomous speed, turtle steps/second (setspeed)
     uint8_t anim_first;     // Animation frame range (setanim)
     uint8_t anim_last;
@@ -628,7 +629,15 @@ static void turtle_update_raster(void)
         }
     }
 
+    // Never 0, which tells core the mask is of unknown age
+    static uint32_t serial_next = 0;
+    if (++serial_next == 0)
+    {
+        serial_next = 1;
+    }
+
     cur->raster_valid = true;
+    cur->raster_serial = serial_next;
     cur->raster_shape = cur->shape;
     cur->raster_angle = cur->angle;
     cur->raster_mag = cur->mag;
@@ -1036,6 +1045,31 @@ static void turtle_fill(void)
     screen_gfx_update();
 }
 
+// Fill the polygon traced inside a `filled` block. Vertices arrive in Logo
+// coordinates and are converted to screen coordinates as turtle_dot does.
+static void turtle_fill_polygon(const float *xy, int count, uint8_t colour)
+{
+    float *screen_xy = (float *)malloc((size_t)count * 2 * sizeof(float));
+    if (screen_xy == NULL)
+    {
+        return;
+    }
+    for (int i = 0; i < count; i++)
+    {
+        screen_xy[i * 2] = xy[i * 2] + SCREEN_WIDTH / 2;
+        screen_xy[i * 2 + 1] = -xy[i * 2 + 1] + SCREEN_HEIGHT / 2;
+    }
+    screen_gfx_polygon(screen_xy, count, colour);
+    free(screen_xy);
+
+    screen_gfx_update();
+}
+
+static void turtle_set_fill_store(void *store, size_t size)
+{
+    screen_gfx_set_fill_store(store, size);
+}
+
 // Draw text on the graphics screen at the turtle's position, in the current
 // pen colour, upright and left-to-right. The text starts at the turtle's x
 // and is centred vertically on the turtle's y. The turtle does not move
@@ -1046,9 +1080,9 @@ static void turtle_draw_text(const char *text)
     screen_gfx_update();
 }
 
-static int turtle_gfx_save(LogoStream *out)
+static int turtle_gfx_save(LogoStream *out, bool rle)
 {
-    return screen_gfx_save(out);
+    return screen_gfx_save(out, rle);
 }
 
 static int turtle_gfx_load(LogoStream *in)
@@ -1358,6 +1392,7 @@ static bool turtle_get_raster(LogoTurtleRaster *out)
     out->indexed = sprite.indexed;
     out->visible = turtle_should_draw();
     out->mask = sprite.mask;
+    out->serial = cur->raster_serial;
     return true;
 }
 
@@ -1473,6 +1508,8 @@ static const LogoConsoleTurtle picocalc_turtle_ops = {
     .dot = turtle_dot,
     .dot_at = turtle_dot_at,
     .fill = turtle_fill,
+    .set_fill_store = turtle_set_fill_store,
+    .fill_polygon = turtle_fill_polygon,
     .draw_text = turtle_draw_text,
     .set_fence = turtle_set_fence,
     .set_window = turtle_set_window,
@@ -23,6 +23,7 @@
 //
 
 #include "devices/picocalc/picocalc_flash.h"
+#include "devices/picocalc/screen.h"
 
 #include "pico/stdlib.h"
 #include "hardware/flash.h"
@@ -89,6 +90,9 @@ bool picocalc_flash_erase(uint32_t offset, size_t len)
     {
         return false;
     }
+    // Core 1 may be sending a frame from flash-resident code; XIP goes
+    // down for the operation, so wait for it to park in RAM first.
+    screen_gfx_sync();
     for (size_t o = 0; o < len; o += PICOCALC_FLASH_SECTOR_SIZE)
     {
         flash_erase_one_sector(PICOCALC_FLASH_LFS_OFFSET + offset + o);
@@ -108,6 +112,7 @@ bool picocalc_flash_program(uint32_t offset, const void *src, size_t len)
     {
         return false;
     }
+    screen_gfx_sync();  // See picocalc_flash_erase
     const uint8_t *p = (const uint8_t *)src;
     for (size_t o = 0; o < len; o += PICOCALC_FLASH_PAGE_SIZE)
     {
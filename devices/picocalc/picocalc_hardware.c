@@ -112,6 +112,11 @@ static uint32_t picocalc_ticks_ms(void)
     return to_ms_since_boot(get_absolute_time());
 }
 
+static uint32_t picocalc_ticks_us(void)
+{
+    return time_us_32();
+}
+
 static uint32_t picocalc_random(void)
 {
     return get_rand_32();
@@ -2193,6 +2198,7 @@ static void *picocalc_network_tcp_accept(void *listener, char *remote_ip, size_t
 static LogoHardwareOps picocalc_hardware_ops = {
     .sleep = picocalc_sleep,
     .ticks_ms = picocalc_ticks_ms,
+    .ticks_us = picocalc_ticks_us,
     .random = picocalc_random,
     .get_battery_level = picocalc_get_battery_level,
     .get_temperature = picocalc_get_temperature,
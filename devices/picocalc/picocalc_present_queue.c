@@ -0,0 +1,121 @@
+//
+//  Pico Logo
+//  Copyright 2026 Blair Leduc. See LICENSE for details.
+//
+//  Present queue on the RP2350: core 1 is the consumer. See
+//  devices/present_queue.h.
+//
+//  The handshake is one word, `pending`, written by each core in turn:
+//  core 0 sets it to the buffer it hands over, core 1 clears it when the
+//  frame is sent, and each raises an event (SEV) for the other, which waits
+//  in WFE. No SDK lock is used: core 1's idle loop lives in RAM and touches
+//  nothing in flash, so core 0 may erase or program flash whenever core 1
+//  is idle -- picocalc_flash.c waits for that first.
+//
+//  Core 1 runs on the SDK's own core-1 stack in SCRATCH_X, so the queue
+//  costs no heap.
+//
+
+#include "devices/present_queue.h"
+
+#include <stddef.h>
+
+#include "pico/multicore.h"
+#include "hardware/sync.h"
+
+struct PresentQueue
+{
+    void *frames[2];
+    PresentConsumer consume;
+    void *context;
+    int back;               // Index of the buffer core 0 writes
+    volatile int pending;   // Index handed to core 1, or -1
+};
+
+// There is one core 1, so there is one queue
+static PresentQueue g_queue;
+static bool g_started = false;
+
+static void __not_in_flash_func(core1_main)(void)
+{
+    PresentQueue *q = &g_queue;
+    for (;;)
+    {
+        while (q->pending < 0)
+        {
+            __wfe();
+        }
+        __dmb();
+        q->consume(q->frames[q->pending], q->context);
+        __dmb();
+        q->pending = -1;
+        __sev();
+    }
+}
+
+// Wait in RAM for core 1 to hand its buffer back
+static inline void __not_in_flash_func(wait_for_core1)(PresentQueue *q)
+{
+    while (q->pending >= 0)
+    {
+        __wfe();
+    }
+    __dmb();
+}
+
+PresentQueue *present_queue_start(void *frames[2], PresentConsumer consume,
+                                  void *context)
+{
+    if (g_started)
+    {
+        return NULL;
+    }
+    g_queue.frames[0] = frames[0];
+    g_queue.frames[1] = frames[1];
+    g_queue.consume = consume;
+    g_queue.context = context;
+    g_queue.back = 0;
+    g_queue.pending = -1;
+    __dmb();
+
+    multicore_launch_core1(core1_main);
+    g_started = true;
+    return &g_queue;
+}
+
+void present_queue_stop(PresentQueue *q)
+{
+    if (q == NULL || !g_started)
+    {
+        return;
+    }
+    wait_for_core1(q);
+    multicore_reset_core1();
+    g_started = false;
+}
+
+void *present_queue_back(PresentQueue *q)
+{
+    return q->frames[q->back];
+}
+
+void *present_queue_submit(PresentQueue *q)
+{
+    wait_for_core1(q);
+    __dmb();  // The frame is written before core 1 can see it handed over
+    q->pending = q->back;
+    __dmb();
+    __sev();
+    q->back ^= 1;
+    return q->frames[q->back];
+}
+
+void present_queue_wait_idle(PresentQueue *q)
+{
+    wait_for_core1(q);
+}
+
+bool present_queue_busy(PresentQueue *q)
+{
+    return q->pending >= 0;
+}
@@ -214,8 +214,16 @@ static void picocalc_file_write(LogoStream *stream, const char *text)
 
 static void picocalc_file_flush(LogoStream *stream)
 {
-    // No-op for FAT32 files
-    (void)stream;
+    if (!stream || !stream->context)
+    {
+        return;
+    }
+
+    FileContext *ctx = (FileContext *)stream->context;
+    if (ctx->file && !file_context_stale(ctx) && fat32_flush() != FAT32_OK)
+    {
+        stream->write_error = true;
+    }
 }
 
 static long picocalc_file_get_read_pos(LogoStream *stream)
@@ -697,6 +705,18 @@ static bool logo_picocalc_free_blocks(const char *pathname, uint32_t *free_block
     return true;
 }
 
+static bool logo_picocalc_cache_stats(const char *pathname, LogoCacheStats *stats)
+{
+    (void)pathname;
+    fat32_cache_stats_t counts;
+    fat32_get_cache_stats(&counts);
+    stats->hits = counts.hits;
+    stats->misses = counts.misses;
+    stats->sectors_read = counts.sectors_read;
+    stats->sectors_written = counts.sectors_written;
+    return true;
+}
+
 static bool logo_picocalc_mount_available(const char *pathname)
 {
     (void)pathname;
@@ -715,6 +735,7 @@ static const LogoStorageOps picocalc_storage_ops = {
     .list_directory = logo_picocalc_list_directory,
     .free_blocks = logo_picocalc_free_blocks,
     .mount_available = logo_picocalc_mount_available,
+    .cache_stats = logo_picocalc_cache_stats,
 };
 
 
@@ -10,6 +10,7 @@
 //
 
 #include <errno.h>
+#include <limits.h>
 #include <math.h>
 #include <string.h>
 
@@ -20,7 +21,10 @@
 #include "devices/font.h"
 #include "devices/logo-font.h"
 #include "devices/console.h"
+#include "devices/bmp.h"
+#include "devices/present_queue.h"
 #include "lcd.h"
+#include "core/limits.h"
 
 // The dirty-tile tracker is compiled for a fixed 320x320 screen.
 _Static_assert(DIRTY_TILES_WIDTH == SCREEN_WIDTH &&
@@ -68,9 +72,73 @@ static bool gfx_refresh_auto = true;
 // mask pixels as it is streamed to the LCD. Lower ids render on top.
 static ScreenSprite sprites[SCREEN_MAX_SPRITES];
 
+// Each sprite's mask as runs of opaque pixels, built when the sprite is set,
+// so a composited row copies or fills whole runs instead of testing every
+// mask pixel. A mask taller than LOGO_SPRITE_SPAN_ROWS, or with more runs
+// than LOGO_SPRITE_SPANS, is composed pixel by pixel instead (core/limits.h).
+
+typedef struct {
+    uint8_t start;          // First opaque column
+    uint8_t len;            // Opaque pixels from there
+} SpriteSpan;
+
+typedef struct {
+    bool valid;
+    uint16_t row_first[LOGO_SPRITE_SPAN_ROWS + 1];   // Spans of mask row r: [row_first[r], row_first[r+1])
+    SpriteSpan span[LOGO_SPRITE_SPANS];
+} SpriteSpans;
+
+static SpriteSpans sprite_spans[SCREEN_MAX_SPRITES];
+
+// Which sprites cover each screen row, one bit per id, rebuilt at the next
+// blit after a sprite or the boundary mode changes. Rows no sprite covers
+// are sent as the canvas alone.
+_Static_assert(SCREEN_MAX_SPRITES <= 8, "a row bin holds one bit per sprite");
+static uint8_t sprite_rows[SCREEN_HEIGHT];
+static bool sprite_rows_stale = true;
+
 // Scratch row for compositing (canvas segment + sprite overlay).
 static uint8_t compose_buf[SCREEN_WIDTH];
 
+// Asynchronous present (SCREEN_PRESENT_ASYNC, set by the LOGO_PRESENT_ON_CORE1
+// build option). The interpreter composes each dirty row into a present
+// frame -- the canvas and sprites as they are at that moment -- and hands
+// whole frames to the present queue, whose consumer sends them while the
+// interpreter runs on. Composing costs about what copying the canvas would,
+// so the consumer is given finished rows and needs no sprite state of its
+// own. A frame holds SCREEN_PRESENT_BYTES of rows; a bigger update goes out
+// as several, the interpreter composing one while the other is sent.
+#ifndef SCREEN_PRESENT_ASYNC
+#define SCREEN_PRESENT_ASYNC 0
+#endif
+
+#if SCREEN_PRESENT_ASYNC
+
+#ifndef SCREEN_PRESENT_BYTES
+#define SCREEN_PRESENT_BYTES 4096
+#endif
+#define SCREEN_PRESENT_WINDOWS 32
+
+_Static_assert(SCREEN_PRESENT_BYTES >= SCREEN_WIDTH,
+               "a present frame must hold at least one full row");
+
+typedef struct {
+    uint16_t x, y, width, height;
+} PresentWindow;
+
+typedef struct {
+    int windows;
+    size_t used;                                    // Bytes of pixels[] filled
+    PresentWindow window[SCREEN_PRESENT_WINDOWS];   // Rows follow in this order
+    uint8_t pixels[SCREEN_PRESENT_BYTES];
+} PresentFrame;
+
+static PresentFrame present_frames[2];
+static PresentQueue *present_queue = NULL;
+static bool present_queue_unavailable = false;
+
+#endif
+
 // 60 Hz rate limiter: minimum microseconds between LCD blits.
 // screen_gfx_update() skips the blit if called again within this interval.
 // screen_gfx_flush() always blits regardless.
@@ -151,6 +219,7 @@ static int clip_and_round(float value, int max)
 void screen_gfx_set_boundary_mode(ScreenBoundaryMode mode)
 {
     screen_boundary_mode = mode;
+    sprite_rows_stale = true;   // Wrapping moves the rows a sprite covers
 }
 
 // Get the current graphics boundary mode
@@ -257,6 +326,7 @@ void screen_set_mode(uint8_t mode)
     {
         return; // No change
     }
+    screen_gfx_sync();
 
     if (mode == SCREEN_MODE_TXT || mode == SCREEN_MODE_GFX || mode == SCREEN_MODE_SPLIT)
     {
@@ -309,6 +379,7 @@ void screen_set_mode(uint8_t mode)
 // that the buffers and hardware are already consistent for the new mode.
 void screen_set_mode_no_update(uint8_t mode)
 {
+    screen_gfx_sync();
     if (mode == SCREEN_MODE_TXT || mode == SCREEN_MODE_GFX || mode == SCREEN_MODE_SPLIT)
     {
         screen_mode = mode;
@@ -373,8 +444,50 @@ static void sprite_mark(const ScreenSprite *s)
     dirty_tiles_mark_rect_wrap(&gfx_tiles, s->x, s->y, s->w, s->h);
 }
 
+// Break sprite id's mask into runs of opaque pixels, or mark it to be
+// composed pixel by pixel when the runs do not fit.
+static void sprite_spans_build(int id)
+{
+    const ScreenSprite *s = &sprites[id];
+    SpriteSpans *spans = &sprite_spans[id];
+
+    spans->valid = false;
+    if (!s->visible || s->h > LOGO_SPRITE_SPAN_ROWS)
+        return;
+
+    int n = 0;
+    for (int r = 0; r < s->h; r++)
+    {
+        const uint8_t *mask_row = &s->mask[r * s->w];
+        spans->row_first[r] = (uint16_t)n;
+        int c = 0;
+        while (c < s->w)
+        {
+            uint8_t px = mask_row[c];
+            if (s->indexed ? (px == SCREEN_SPRITE_TRANSPARENT) : (px == 0))
+            {
+                c++;
+                continue;
+            }
+            int start = c;
+            while (c < s->w && (s->indexed ? (mask_row[c] != SCREEN_SPRITE_TRANSPARENT)
+                                           : (mask_row[c] != 0)))
+                c++;
+            if (n == LOGO_SPRITE_SPANS)
+                return;
+            spans->span[n].start = (uint8_t)start;
+            spans->span[n].len = (uint8_t)(c - start);
+            n++;
+        }
+    }
+    spans->row_first[s->h] = (uint16_t)n;
+    spans->valid = true;
+}
+
 // Place (or move/restyle) a sprite. Marks both the old and new locations
 // dirty so the next present erases the old image and draws the new one.
+// The mask is read into runs here: a caller that changes the mask's bytes
+// sets the sprite again.
 void screen_sprite_set(uint8_t id, const ScreenSprite *sprite)
 {
     if (id >= SCREEN_MAX_SPRITES)
@@ -385,6 +498,8 @@ void screen_sprite_set(uint8_t id, const ScreenSprite *sprite)
         sprite_mark(&sprites[id]);
     }
     sprites[id] = *sprite;
+    sprite_spans_build(id);
+    sprite_rows_stale = true;
     if (sprites[id].visible)
     {
         sprite_mark(&sprites[id]);
@@ -399,22 +514,128 @@ void screen_sprite_hide(uint8_t id)
 
     sprite_mark(&sprites[id]);
     sprites[id].visible = false;
+    sprite_spans[id].valid = false;
+    sprite_rows_stale = true;
 }
 
-// Build one output row: the canvas segment [x0..x1] of row y with all
-// visible sprites overlaid. Higher ids first so lower ids end up on top.
-static void compose_row(int y, int x0, int x1)
+// Fill sprite_rows from the visible sprites
+static void sprite_rows_build(void)
 {
-    memcpy(compose_buf, &gfx_buffer[y * SCREEN_WIDTH + x0], (size_t)(x1 - x0 + 1));
-
     bool wrap = (screen_boundary_mode == SCREEN_BOUNDARY_WRAP);
 
-    for (int id = SCREEN_MAX_SPRITES - 1; id >= 0; id--)
+    memset(sprite_rows, 0, sizeof(sprite_rows));
+    for (int id = 0; id < SCREEN_MAX_SPRITES; id++)
     {
         const ScreenSprite *s = &sprites[id];
         if (!s->visible)
             continue;
 
+        for (int r = 0; r < s->h; r++)
+        {
+            int py = s->y + r;
+            if (wrap)
+            {
+                py %= SCREEN_HEIGHT;
+                if (py < 0) py += SCREEN_HEIGHT;
+            }
+            else if (py < 0 || py >= SCREEN_HEIGHT)
+            {
+                continue;
+            }
+            sprite_rows[py] |= (uint8_t)(1u << id);
+        }
+    }
+    sprite_rows_stale = false;
+}
+
+// Overlay `n` sprite pixels whose first lands at screen column sx, clipped
+// to the segment [x0..x1] held in `out`: copied from `src` (indexed) or
+// filled with the sprite's colour (mono).
+static void compose_run(uint8_t *out, const ScreenSprite *s, const uint8_t *src,
+                        int sx, int n, int x0, int x1)
+{
+    int a = sx > x0 ? sx : x0;
+    int b = sx + n - 1 < x1 ? sx + n - 1 : x1;
+    if (a > b)
+        return;
+
+    if (s->indexed)
+        memcpy(&out[a - x0], src + (a - sx), (size_t)(b - a + 1));
+    else
+        memset(&out[a - x0], s->colour, (size_t)(b - a + 1));
+}
+
+// Overlay mask row dy of sprite id, run by run
+static void compose_sprite_spans(uint8_t *out, int id, int dy, bool wrap, int x0, int x1)
+{
+    const ScreenSprite *s = &sprites[id];
+    const SpriteSpans *spans = &sprite_spans[id];
+    const uint8_t *mask_row = &s->mask[dy * s->w];
+
+    for (int k = spans->row_first[dy]; k < spans->row_first[dy + 1]; k++)
+    {
+        const uint8_t *src = mask_row + spans->span[k].start;
+        int sx = s->x + spans->span[k].start;
+        int n = spans->span[k].len;
+        if (!wrap)
+        {
+            compose_run(out, s, src, sx, n, x0, x1);
+            continue;
+        }
+
+        // A run is narrower than the screen, so it wraps at most once
+        sx %= SCREEN_WIDTH;
+        if (sx < 0) sx += SCREEN_WIDTH;
+        int head = SCREEN_WIDTH - sx;
+        if (head > n) head = n;
+        compose_run(out, s, src, sx, head, x0, x1);
+        if (head < n)
+            compose_run(out, s, src + head, 0, n - head, x0, x1);
+    }
+}
+
+// Overlay mask row dy of sprite id, testing each pixel
+static void compose_sprite_pixels(uint8_t *out, int id, int dy, bool wrap, int x0, int x1)
+{
+    const ScreenSprite *s = &sprites[id];
+    const uint8_t *mask_row = &s->mask[dy * s->w];
+
+    for (int c = 0; c < s->w; c++)
+    {
+        uint8_t px = mask_row[c];
+        if (s->indexed ? (px == SCREEN_SPRITE_TRANSPARENT) : (px == 0))
+            continue;
+        int sx = s->x + c;
+        if (wrap)
+        {
+            sx %= SCREEN_WIDTH;
+            if (sx < 0) sx += SCREEN_WIDTH;
+        }
+        if (sx < x0 || sx > x1)
+            continue;
+        out[sx - x0] = s->indexed ? px : s->colour;
+    }
+}
+
+// Build one output row into `out`: the canvas segment [x0..x1] of row y
+// with the sprites binned to that row overlaid. Higher ids first so lower
+// ids end up on top. sprite_rows must be current.
+static void compose_row(uint8_t *out, int y, int x0, int x1)
+{
+    memcpy(out, &gfx_buffer[y * SCREEN_WIDTH + x0], (size_t)(x1 - x0 + 1));
+
+    uint8_t bins = sprite_rows[y];
+    if (bins == 0)
+        return;
+
+    bool wrap = (screen_boundary_mode == SCREEN_BOUNDARY_WRAP);
+
+    for (int id = SCREEN_MAX_SPRITES - 1; id >= 0; id--)
+    {
+        if (!(bins & (1u << id)))
+            continue;
+        const ScreenSprite *s = &sprites[id];
+
         // Which sprite row lands on screen row y?
         int dy = y - s->y;
         if (wrap)
@@ -425,22 +646,10 @@ static void compose_row(int y, int x0, int x1)
         if (dy < 0 || dy >= s->h)
             continue;
 
-        const uint8_t *mask_row = &s->mask[dy * s->w];
-        for (int c = 0; c < s->w; c++)
-        {
-            uint8_t px = mask_row[c];
-            if (s->indexed ? (px == SCREEN_SPRITE_TRANSPARENT) : (px == 0))
-                continue;
-            int sx = s->x + c;
-            if (wrap)
-            {
-                sx %= SCREEN_WIDTH;
-                if (sx < 0) sx += SCREEN_WIDTH;
-            }
-            if (sx < x0 || sx > x1)
-                continue;
-            compose_buf[sx - x0] = s->indexed ? px : s->colour;
-        }
+        if (sprite_spans[id].valid)
+            compose_sprite_spans(out, id, dy, wrap, x0, x1);
+        else
+            compose_sprite_pixels(out, id, dy, wrap, x0, x1);
     }
 }
 
@@ -567,6 +776,7 @@ void screen_gfx_clear(void)
         // Automatic mode: fill the panel directly. That costs less than
         // composing the whole canvas back through the blit pipeline, and
         // buffer and LCD are then in sync — so reset the dirty state.
+        screen_gfx_sync();
         if (screen_mode == SCREEN_MODE_GFX)
         {
             lcd_clear_screen(GFX_DEFAULT_BACKGROUND); // Clear the LCD screen in graphics mode
@@ -721,6 +931,186 @@ void screen_gfx_reverse_point(float x, float y)
     screen_gfx_mark_dirty_rect(pixel_x, pixel_y, pixel_x, pixel_y);
 }
 
+// Fill pixels x0..x1 of row y (already on the screen) and mark them dirty.
+// In reverse mode each pixel is toggled between the background and `colour`.
+static void gfx_run(int y, int x0, int x1, uint8_t colour, bool reverse)
+{
+    uint8_t *p = &gfx_buffer[y * SCREEN_WIDTH + x0];
+    if (reverse)
+    {
+        for (int x = x0; x <= x1; x++, p++)
+        {
+            *p = (*p == GFX_DEFAULT_BACKGROUND) ? colour : GFX_DEFAULT_BACKGROUND;
+        }
+    }
+    else
+    {
+        memset(p, colour, (size_t)(x1 - x0 + 1));
+    }
+    screen_gfx_mark_dirty_rect(x0, y, x1, y);
+}
+
+// Fill the horizontal span x0..x1 of row y, honouring the boundary mode:
+// clipped to the screen in WINDOW/FENCE, wrapped in WRAP (a span crossing
+// the right edge continues from the left; one as wide as the screen fills
+// the row once).
+static void gfx_span(int y, int x0, int x1, uint8_t colour, bool reverse)
+{
+    if (screen_boundary_mode == SCREEN_BOUNDARY_WINDOW || screen_boundary_mode == SCREEN_BOUNDARY_FENCE)
+    {
+        if (y < 0 || y >= SCREEN_HEIGHT)
+        {
+            return;
+        }
+        if (x0 < 0) x0 = 0;
+        if (x1 >= SCREEN_WIDTH) x1 = SCREEN_WIDTH - 1;
+        if (x0 <= x1)
+        {
+            gfx_run(y, x0, x1, colour, reverse);
+        }
+        return;
+    }
+
+    y = ((y % SCREEN_HEIGHT) + SCREEN_HEIGHT) % SCREEN_HEIGHT;
+    int length = x1 - x0 + 1;
+    if (length >= SCREEN_WIDTH)
+    {
+        gfx_run(y, 0, SCREEN_WIDTH - 1, colour, reverse);
+        return;
+    }
+    x0 = ((x0 % SCREEN_WIDTH) + SCREEN_WIDTH) % SCREEN_WIDTH;
+    x1 = x0 + length - 1;
+    if (x1 < SCREEN_WIDTH)
+    {
+        gfx_run(y, x0, x1, colour, reverse);
+    }
+    else
+    {
+        gfx_run(y, x0, SCREEN_WIDTH - 1, colour, reverse);
+        gfx_run(y, 0, x1 - SCREEN_WIDTH, colour, reverse);
+    }
+}
+
+// A thick line is the union of a disc of diameter `width` centred on every
+// point of the Bresenham path from (ix1, iy1) to (ix2, iy2) -- round caps
+// and joins, solid at every angle. Rather than stamping those discs, which
+// writes each pixel up to width^2 times, it is drawn a row at a time: the
+// discs' union on any row is one contiguous span (path points are at most a
+// pixel apart), so each row is a single run, written once.
+//
+// The walk runs in "path rows" t = 0..|dy|, counted from iy1 in the line's
+// y direction, recording each path row's x-range. Screen row T is final
+// once path row T + e is, where e is the disc's half-extent, so only the
+// last 2e+1 path rows are kept.
+static void gfx_thick_line(int ix1, int iy1, int ix2, int iy2, uint8_t colour, bool reverse, int width)
+{
+    if (width > SCREEN_LINE_MAX_WIDTH)
+    {
+        width = SCREEN_LINE_MAX_WIDTH;
+    }
+    const float radius = width * 0.5f;
+    const int e = (int)radius;
+    const int rows = 2 * e + 1;
+
+    // half[k]: the disc's half-width k rows from its centre
+    int half[SCREEN_LINE_MAX_WIDTH / 2 + 1];
+    for (int k = 0; k <= e; k++)
+    {
+        int ox = e;
+        while (ox > 0 && (float)(ox * ox + k * k) > radius * radius)
+        {
+            ox--;
+        }
+        half[k] = ox;
+    }
+
+    // The last `rows` path rows' x-ranges, indexed by t % rows
+    int path_lo[SCREEN_LINE_MAX_WIDTH + 1];
+    int path_hi[SCREEN_LINE_MAX_WIDTH + 1];
+
+    int dx = ix2 - ix1;
+    int dy = iy2 - iy1;
+    int sx = (dx > 0) ? 1 : (dx < 0) ? -1 : 0;
+    int sy = (dy > 0) ? 1 : (dy < 0) ? -1 : 0;
+    int ydir = sy ? sy : 1;
+    dx = (dx < 0) ? -dx : dx;
+    dy = (dy < 0) ? -dy : dy;
+
+    // Emit screen row T (in path-row units): the union of the discs centred
+    // on path rows T-e..T+e, of which rows 0..last have been walked.
+    #define EMIT_ROW(T, last) do { \
+        int _lo = INT_MAX, _hi = INT_MIN; \
+        for (int _k = -e; _k <= e; _k++) { \
+            int _t = (T) + _k; \
+            if (_t < 0 || _t > (last)) continue; \
+            int _h = half[_k < 0 ? -_k : _k]; \
+            if (path_lo[_t % rows] - _h < _lo) _lo = path_lo[_t % rows] - _h; \
+            if (path_hi[_t % rows] + _h > _hi) _hi = path_hi[_t % rows] + _h; \
+        } \
+        if (_lo <= _hi) gfx_span(iy1 + (T) * ydir, _lo, _hi, colour, reverse); \
+    } while (0)
+
+    int t = 0;
+    int lo = ix1, hi = ix1;
+    #define VISIT(px, py) do { \
+        int _pt = ((py) - iy1) * ydir; \
+        if (_pt != t) { \
+            path_lo[t % rows] = lo; \
+            path_hi[t % rows] = hi; \
+            EMIT_ROW(t - e, t); \
+            t = _pt; \
+            lo = hi = (px); \
+        } else { \
+            if ((px) < lo) lo = (px); \
+            if ((px) > hi) hi = (px); \
+        } \
+    } while (0)
+
+    int x = ix1;
+    int y = iy1;
+    if (dx >= dy)
+    {
+        int err = 2 * dy - dx;
+        for (int i = 0; i <= dx; ++i)
+        {
+            VISIT(x, y);
+            if (err > 0)
+            {
+                y += sy;
+                err -= 2 * dx;
+            }
+            err += 2 * dy;
+            x += sx;
+        }
+    }
+    else
+    {
+        int err = 2 * dx - dy;
+        for (int i = 0; i <= dy; ++i)
+        {
+            VISIT(x, y);
+            if (err > 0)
+            {
+                x += sx;
+                err -= 2 * dy;
+            }
+            err += 2 * dx;
+            y += sy;
+        }
+    }
+
+    // The last path row, then the rows below it that waited on it
+    path_lo[t % rows] = lo;
+    path_hi[t % rows] = hi;
+    for (int row = t - e; row <= t + e; row++)
+    {
+        EMIT_ROW(row, t);
+    }
+
+    #undef VISIT
+    #undef EMIT_ROW
+}
+
 // Draw a line in the graphics buffer using Bresenham's algorithm
 // This is a true integer-only Bresenham implementation for efficiency on the Pico
 void screen_gfx_line(float x1, float y1, float x2, float y2, uint8_t colour, bool reverse, int width)
@@ -731,6 +1121,12 @@ void screen_gfx_line(float x1, float y1, float x2, float y2, uint8_t colour, boo
     int ix2 = (int)(x2 + 0.5f);
     int iy2 = (int)(y2 + 0.5f);
 
+    if (width > 1)
+    {
+        gfx_thick_line(ix1, iy1, ix2, iy2, colour, reverse, width);
+        return;
+    }
+
     int dx = ix2 - ix1;
     int dy = iy2 - iy1;
 
@@ -779,31 +1175,13 @@ void screen_gfx_line(float x1, float y1, float x2, float y2, uint8_t colour, boo
         if (plot_y > mark_y1) mark_y1 = plot_y; \
     } while(0)
 
-    // Stamp the pen at a line point: a single pixel for a width-1 pen, or a
-    // filled disc of diameter `width` centred on the point otherwise. Because
-    // consecutive line points are one pixel apart and the disc includes the
-    // 4-neighbours for any width >= 2, the stamps always overlap and the
-    // stroke is solid at every angle, with round caps and joins for free.
-    const float pen_radius = width * 0.5f;
-    const int pen_extent = (int)pen_radius;
-    #define STAMP(cx, cy) do { \
-        if (width <= 1) { \
-            PLOT_PIXEL((cx), (cy)); \
-        } else { \
-            for (int _oy = -pen_extent; _oy <= pen_extent; ++_oy) \
-                for (int _ox = -pen_extent; _ox <= pen_extent; ++_ox) \
-                    if ((float)(_ox * _ox + _oy * _oy) <= pen_radius * pen_radius) \
-                        PLOT_PIXEL((cx) + _ox, (cy) + _oy); \
-        } \
-    } while(0)
-
     if (dx >= dy)
     {
         // X is the driving axis
         int err = 2 * dy - dx;
         for (int i = 0; i <= dx; ++i)
         {
-            STAMP(x, y);
+            PLOT_PIXEL(x, y);
             if (err > 0)
             {
                 y += sy;
@@ -819,7 +1197,7 @@ void screen_gfx_line(float x1, float y1, float x2, float y2, uint8_t colour, boo
         int err = 2 * dx - dy;
         for (int i = 0; i <= dy; ++i)
         {
-            STAMP(x, y);
+            PLOT_PIXEL(x, y);
             if (err > 0)
             {
                 x += sx;
@@ -830,7 +1208,6 @@ void screen_gfx_line(float x1, float y1, float x2, float y2, uint8_t colour, boo
         }
     }
 
-    #undef STAMP
     #undef PLOT_PIXEL
 
     if (mark_x1 >= 0)
@@ -839,142 +1216,561 @@ void screen_gfx_line(float x1, float y1, float x2, float y2, uint8_t colour, boo
     }
 }
 
-// Flood fill using scanline algorithm
-// Uses the colour as both boundary and fill colour (as per Logo spec)
-// Fill starts at (x, y) and fills all pixels that are NOT the boundary colour
-void screen_gfx_fill(float x, float y, uint8_t colour)
+// Fill a polygon, even-odd, in screen coordinates: `count` x, y pairs,
+// closed back to the first. A pixel is filled when its centre is inside.
+// Each row is scanned once: the edges crossing it are found, sorted, and
+// the pixels between each pair are written as one run, so every pixel is
+// written once and only the rows' spans are marked dirty. The polygon is
+// clipped to the screen in every boundary mode.
+void screen_gfx_polygon(const float *xy, int count, uint8_t colour)
 {
-    // Convert to pixel coordinates
-    int start_x = (int)(x + 0.5f);
-    int start_y = (int)(y + 0.5f);
-
-    // Bounds check
-    if (start_x < 0 || start_x >= SCREEN_WIDTH || 
-        start_y < 0 || start_y >= SCREEN_HEIGHT)
+    if (count < 3)
     {
         return;
     }
 
-    // The fill colour is the same as the boundary colour
-    uint8_t boundary_colour = colour;
+    float y_min = xy[1], y_max = xy[1];
+    for (int i = 1; i < count; i++)
+    {
+        if (xy[i * 2 + 1] < y_min) y_min = xy[i * 2 + 1];
+        if (xy[i * 2 + 1] > y_max) y_max = xy[i * 2 + 1];
+    }
+    int row0 = (int)ceilf(y_min);
+    int row1 = (int)floorf(y_max);
+    if (row0 < 0) row0 = 0;
+    if (row1 >= SCREEN_HEIGHT) row1 = SCREEN_HEIGHT - 1;
 
-    // Check if starting point is already the boundary colour - nothing to fill
-    if (gfx_buffer[start_y * SCREEN_WIDTH + start_x] == boundary_colour)
+    int cross[SCREEN_POLYGON_CROSSINGS];
+    for (int y = row0; y <= row1; y++)
     {
-        return;
+        const float fy = (float)y;
+        int n = 0;
+        for (int i = 0; i < count && n < SCREEN_POLYGON_CROSSINGS; i++)
+        {
+            const float *a = &xy[i * 2];
+            const float *b = &xy[((i + 1) % count) * 2];
+            // Half-open in y, so a vertex on the row is counted once
+            if ((a[1] <= fy) == (b[1] <= fy))
+            {
+                continue;
+            }
+            float x = a[0] + (fy - a[1]) * (b[0] - a[0]) / (b[1] - a[1]);
+            // The first pixel whose centre is at or right of the crossing
+            int c = (int)ceilf(x);
+
+            // Insert in order
+            int j = n++;
+            while (j > 0 && cross[j - 1] > c)
+            {
+                cross[j] = cross[j - 1];
+                j--;
+            }
+            cross[j] = c;
+        }
+
+        for (int k = 0; k + 1 < n; k += 2)
+        {
+            int x0 = cross[k];
+            int x1 = cross[k + 1] - 1;
+            if (x0 < 0) x0 = 0;
+            if (x1 >= SCREEN_WIDTH) x1 = SCREEN_WIDTH - 1;
+            if (x0 <= x1)
+            {
+                gfx_run(y, x0, x1, colour, false);
+            }
+        }
+    }
+}
+
+//
+//  Flood fill
+//
+//  A span fill: a popped span (a row segment reached from the row above or
+//  below) is scanned for runs of fillable pixels, each run is widened to its
+//  full width and written with one memset, and only the parts of it that
+//  the parent row could not have seen are pushed again. Runs are found a
+//  word at a time, four pixels to a compare.
+//
+//  The colour is both the fill and the boundary (as per Logo spec), so a
+//  filled pixel looks exactly like a wall, and a span dropped from a full
+//  queue could never be found again. The fill therefore starts by writing
+//  the colour directly and logging each run it fills in the free end of the
+//  queue. If pending spans and log meet, it switches to a marker -- a
+//  palette index the canvas does not use -- rewrites the logged runs with
+//  it, and carries on; from then on a dropped span is recovered by sweeps
+//  that pick up every fillable run touching the marker, and the marker is
+//  recoloured at the end. Most fills never leave the first mode and pay
+//  nothing for the guarantee; a shape too complex for the queue completes,
+//  only more slowly.
+//
+
+static FillSpan fill_stack_sram[FILL_STACK_SIZE];
+static FillSpan *fill_stack = fill_stack_sram;
+static int fill_stack_size = FILL_STACK_SIZE;
+
+static struct
+{
+    uint8_t stop;       // The boundary colour
+    uint8_t mark;       // What runs are filled with: the colour, or a marker
+    int sp;             // Pending spans, from the bottom of the queue
+    int logged;         // Filled runs, from the top; -1 once not logging
+    bool dropped;       // A span was lost to a full queue
+    int x0, x1, y0, y1; // Extent the fill has touched
+    ScreenFillStats stats;
+} fill;
+
+// Lend the fill a larger queue (PSRAM), or take it back (NULL, 0). A store
+// no larger than the SRAM queue is ignored.
+void screen_gfx_set_fill_store(void *store, size_t size)
+{
+    if (store != NULL && size / sizeof(FillSpan) > FILL_STACK_SIZE)
+    {
+        fill_stack = (FillSpan *)store;
+        fill_stack_size = (int)(size / sizeof(FillSpan));
     }
+    else
+    {
+        fill_stack = fill_stack_sram;
+        fill_stack_size = FILL_STACK_SIZE;
+    }
+}
 
-    static FillSpan stack[FILL_STACK_SIZE];
-    int stack_ptr = 0;
+void screen_gfx_fill_stats(ScreenFillStats *stats)
+{
+    *stats = fill.stats;
+}
 
-    // Find the initial span containing the start point
-    int left = start_x;
-    int right = start_x;
-    uint8_t *row = &gfx_buffer[start_y * SCREEN_WIDTH];
+// Word accesses a memset or memchr of n bytes makes
+#define FILL_WORDS(n) ((uint32_t)((n) + 3) / 4)
 
-    // Extend left
-    while (left > 0 && row[left - 1] != boundary_colour)
+static void fill_push(int y, int x_left, int x_right, int dir)
+{
+    if (y < 0 || y >= SCREEN_HEIGHT)
+    {
+        return;
+    }
+    if (fill.sp + (fill.logged > 0 ? fill.logged : 0) == fill_stack_size)
     {
-        left--;
+        fill.dropped = true;
+        return;
+    }
+    FillSpan *s = &fill_stack[fill.sp++];
+    s->y = (int16_t)y;
+    s->x_left = (int16_t)x_left;
+    s->x_right = (int16_t)x_right;
+    s->dir = (int8_t)dir;
+    fill.stats.spans++;
+}
+
+// Pick a palette index the canvas does not use, trying the top of the
+// palette first (below the background); false if every index is in use.
+static bool fill_pick_mark(void)
+{
+    for (int i = 0; i < 256; i++)
+    {
+        uint8_t m = (uint8_t)(GFX_DEFAULT_BACKGROUND - 1 - i);
+        if (m == fill.stop)
+        {
+            continue;
+        }
+        fill.stats.accesses += FILL_WORDS(sizeof(gfx_buffer));
+        if (memchr(gfx_buffer, m, sizeof(gfx_buffer)) == NULL)
+        {
+            fill.mark = m;
+            return true;
+        }
     }
-    // Extend right
-    while (right < SCREEN_WIDTH - 1 && row[right + 1] != boundary_colour)
+    return false;
+}
+
+// The queue is full of pending spans and logged runs: rewrite the logged
+// runs with a marker and stop logging. With every palette index on the
+// canvas there is no marker, and the fill goes on in the colour, dropping
+// what does not fit.
+static void fill_switch_to_marker(void)
+{
+    if (fill_pick_mark())
     {
-        right++;
+        for (int i = 0; i < fill.logged; i++)
+        {
+            const FillSpan *run = &fill_stack[fill_stack_size - 1 - i];
+            memset(&gfx_buffer[run->y * SCREEN_WIDTH + run->x_left], fill.mark,
+                   (size_t)(run->x_right - run->x_left + 1));
+            fill.stats.accesses += FILL_WORDS(run->x_right - run->x_left + 1);
+        }
+        fill.stats.marker = true;
     }
+    fill.logged = -1;
+}
 
-    // Fill the initial span
-    for (int i = left; i <= right; i++)
+// Non-zero when any byte of w is zero
+#define WORD_HAS_ZERO(w) (((w) - 0x01010101u) & ~(w) & 0x80808080u)
+
+// Does the 4-pixel word hold a wall (the boundary colour or the marker)?
+static inline bool fill_word_stops(uint32_t w)
+{
+    uint32_t s = w ^ (fill.stop * 0x01010101u);
+    uint32_t m = w ^ (fill.mark * 0x01010101u);
+    return WORD_HAS_ZERO(s) || WORD_HAS_ZERO(m);
+}
+
+static inline bool fill_stops(uint8_t p)
+{
+    return p == fill.stop || p == fill.mark;
+}
+
+// First x >= from at which row holds a wall, or SCREEN_WIDTH
+static int fill_run_right(const uint8_t *row, int from)
+{
+    int x = from;
+    while (x < SCREEN_WIDTH && (x & 3) != 0)
     {
-        row[i] = colour;
+        fill.stats.accesses++;
+        if (fill_stops(row[x]))
+        {
+            return x;
+        }
+        x++;
     }
-    screen_gfx_mark_dirty_rect(left, start_y, right, start_y);
+    while (x + 4 <= SCREEN_WIDTH)
+    {
+        uint32_t w;
+        memcpy(&w, row + x, sizeof(w));
+        fill.stats.accesses++;
+        if (fill_word_stops(w))
+        {
+            break;
+        }
+        x += 4;
+    }
+    while (x < SCREEN_WIDTH && !fill_stops(row[x]))
+    {
+        x++;
+    }
+    return x;
+}
 
-    // Push spans above and below to process
-    if (start_y > 0)
+// Smallest x <= from with row[x..from] all fillable (row[from] is fillable)
+static int fill_run_left(const uint8_t *row, int from)
+{
+    int x = from;
+    while (x > 0 && (x & 3) != 0)
     {
-        PUSH_SPAN(start_y - 1, left, right, -1);
+        fill.stats.accesses++;
+        if (fill_stops(row[x - 1]))
+        {
+            return x;
+        }
+        x--;
+    }
+    while (x >= 4)
+    {
+        uint32_t w;
+        memcpy(&w, row + x - 4, sizeof(w));
+        fill.stats.accesses++;
+        if (fill_word_stops(w))
+        {
+            break;
+        }
+        x -= 4;
     }
-    if (start_y < SCREEN_HEIGHT - 1)
+    while (x > 0 && !fill_stops(row[x - 1]))
     {
-        PUSH_SPAN(start_y + 1, left, right, 1);
+        x--;
     }
+    return x;
+}
 
-    // Process the stack
-    while (stack_ptr > 0)
+// Fill one run, logging it while the fill is still in the colour. Called
+// with room for the log entry and the three spans that follow it.
+static void fill_run(uint8_t *row, int y, int left, int right)
+{
+    memset(row + left, fill.mark, (size_t)(right - left + 1));
+    screen_gfx_mark_dirty_rect(left, y, right, y);
+    fill.stats.accesses += FILL_WORDS(right - left + 1);
+    fill.stats.pixels_filled += (uint32_t)(right - left + 1);
+    if (left < fill.x0) fill.x0 = left;
+    if (right > fill.x1) fill.x1 = right;
+    if (y < fill.y0) fill.y0 = y;
+    if (y > fill.y1) fill.y1 = y;
+
+    if (fill.logged >= 0)
+    {
+        FillSpan *run = &fill_stack[fill_stack_size - 1 - fill.logged++];
+        run->y = (int16_t)y;
+        run->x_left = (int16_t)left;
+        run->x_right = (int16_t)right;
+    }
+}
+
+// Make room to fill a run and push what follows it: switch to the marker
+// when a logging fill would otherwise lose a span
+static void fill_make_room(void)
+{
+    if (fill.logged >= 0 && fill.sp + fill.logged + 4 > fill_stack_size)
     {
-        // Pop a span
-        stack_ptr--;
-        int y = stack[stack_ptr].y;
-        int x_left = stack[stack_ptr].x_left;
-        int x_right = stack[stack_ptr].x_right;
-        int dir = stack[stack_ptr].dir;
+        fill_switch_to_marker();
+    }
+}
 
-        row = &gfx_buffer[y * SCREEN_WIDTH];
+// Work the queue until it is empty
+static void fill_drain(void)
+{
+    while (fill.sp > 0)
+    {
+        FillSpan span = fill_stack[--fill.sp];
+        int y = span.y;
+        uint8_t *row = &gfx_buffer[y * SCREEN_WIDTH];
 
-        // Scan the row from x_left to x_right, finding and filling spans
-        int x = x_left;
-        while (x <= x_right)
+        int x = span.x_left;
+        while (x <= span.x_right)
         {
-            // Skip boundary pixels
-            while (x <= x_right && row[x] == boundary_colour)
+            // Skip walls
+            fill.stats.accesses++;
+            if (fill_stops(row[x]))
             {
                 x++;
-            }
-            if (x > x_right)
-            {
-                break;
+                continue;
             }
 
-            // Found a fillable pixel, extend to find the full span
-            int span_left = x;
+            // A fillable pixel: widen it to the whole run
+            int left = fill_run_left(row, x);
+            int right = fill_run_right(row, x) - 1;
+            fill_make_room();
+            fill_run(row, y, left, right);
 
-            // Extend left beyond the parent span if possible
-            while (span_left > 0 && row[span_left - 1] != boundary_colour)
+            // Onward in the same direction, and back the way the span came
+            // only where the run reaches past its parent
+            fill_push(y + span.dir, left, right, span.dir);
+            if (left < span.x_left)
             {
-                span_left--;
+                fill_push(y - span.dir, left, span.x_left - 1, -span.dir);
             }
-
-            // Find right edge
-            while (x < SCREEN_WIDTH && row[x] != boundary_colour)
+            if (right > span.x_right)
             {
-                x++;
+                fill_push(y - span.dir, span.x_right + 1, right, -span.dir);
             }
-            int span_right = x - 1;
+            x = right + 2;  // right + 1 is a wall
+        }
+    }
+}
 
-            // Fill this span
-            for (int i = span_left; i <= span_right; i++)
+// Does row y hold the marker anywhere in [left, right]?
+static bool fill_row_marked(int y, int left, int right)
+{
+    if (y < 0 || y >= SCREEN_HEIGHT)
+    {
+        return false;
+    }
+    fill.stats.accesses += FILL_WORDS(right - left + 1);
+    return memchr(&gfx_buffer[y * SCREEN_WIDTH + left], fill.mark, (size_t)(right - left + 1)) != NULL;
+}
+
+// After an overflow: fill every fillable run that touches the marker from
+// above or below, working the queue from each, until a sweep finds nothing
+// more was dropped.
+static void fill_sweep(void)
+{
+    while (fill.dropped)
+    {
+        fill.dropped = false;
+        fill.stats.sweeps++;
+        for (int y = 0; y < SCREEN_HEIGHT; y++)
+        {
+            uint8_t *row = &gfx_buffer[y * SCREEN_WIDTH];
+            int x = 0;
+            while (x < SCREEN_WIDTH)
             {
-                row[i] = colour;
+                fill.stats.accesses++;
+                if (fill_stops(row[x]))
+                {
+                    x++;
+                    continue;
+                }
+                int right = fill_run_right(row, x) - 1;
+                if (fill_row_marked(y - 1, x, right) || fill_row_marked(y + 1, x, right))
+                {
+                    fill_run(row, y, x, right);
+                    fill_push(y - 1, x, right, -1);
+                    fill_push(y + 1, x, right, 1);
+                    fill_drain();
+                }
+                x = right + 2;
             }
-            screen_gfx_mark_dirty_rect(span_left, y, span_right, y);
+        }
+    }
+}
 
-            // Push span in same direction
-            int next_y = y + dir;
-            if (next_y >= 0 && next_y < SCREEN_HEIGHT)
+// Recolour the marker, a word at a time where a word is all marker. Only
+// the extent the fill touched can hold it.
+static void fill_recolour(uint8_t colour)
+{
+    const uint32_t mark4 = fill.mark * 0x01010101u;
+    const uint32_t colour4 = colour * 0x01010101u;
+    int x0 = fill.x0 & ~3;
+    for (int y = fill.y0; y <= fill.y1; y++)
+    {
+        uint8_t *row = &gfx_buffer[y * SCREEN_WIDTH];
+        for (int x = x0; x <= fill.x1; x += 4)
+        {
+            uint32_t w;
+            memcpy(&w, row + x, sizeof(w));
+            fill.stats.accesses++;
+            if (w == mark4)
             {
-                PUSH_SPAN(next_y, span_left, span_right, dir);
+                memcpy(row + x, &colour4, sizeof(colour4));
+                fill.stats.accesses++;
             }
-
-            // Push span in opposite direction if we extended beyond parent
-            int prev_y = y - dir;
-            if (prev_y >= 0 && prev_y < SCREEN_HEIGHT)
+            else if (WORD_HAS_ZERO(w ^ mark4))
             {
-                // Push for the left extension
-                if (span_left < x_left)
+                for (int i = 0; i < 4; i++)
                 {
-                    PUSH_SPAN(prev_y, span_left, x_left - 1, -dir);
-                }
-                // Push for the right extension
-                if (span_right > x_right)
-                {
-                    PUSH_SPAN(prev_y, x_right + 1, span_right, -dir);
+                    if (row[x + i] == fill.mark)
+                    {
+                        row[x + i] = colour;
+                        fill.stats.accesses++;
+                    }
                 }
             }
         }
     }
 }
 
+// Fill the region around (x, y) bounded by `colour` with `colour`
+void screen_gfx_fill(float x, float y, uint8_t colour)
+{
+    // Convert to pixel coordinates
+    int start_x = (int)(x + 0.5f);
+    int start_y = (int)(y + 0.5f);
+
+    memset(&fill.stats, 0, sizeof(fill.stats));
+
+    // Bounds check
+    if (start_x < 0 || start_x >= SCREEN_WIDTH ||
+        start_y < 0 || start_y >= SCREEN_HEIGHT)
+    {
+        return;
+    }
+
+    // Check if starting point is already the boundary colour - nothing to fill
+    fill.stats.accesses++;
+    if (gfx_buffer[start_y * SCREEN_WIDTH + start_x] == colour)
+    {
+        return;
+    }
+
+    fill.stop = colour;
+    fill.mark = colour;
+    fill.sp = 0;
+    fill.logged = 0;
+    fill.dropped = false;
+    fill.x0 = SCREEN_WIDTH;
+    fill.x1 = -1;
+    fill.y0 = SCREEN_HEIGHT;
+    fill.y1 = -1;
+
+    uint8_t *row = &gfx_buffer[start_y * SCREEN_WIDTH];
+    int left = fill_run_left(row, start_x);
+    int right = fill_run_right(row, start_x) - 1;
+    fill_run(row, start_y, left, right);
+    fill_push(start_y - 1, left, right, -1);
+    fill_push(start_y + 1, left, right, 1);
+    fill_drain();
+
+    if (fill.mark != colour)
+    {
+        fill_sweep();
+        fill_recolour(colour);
+    }
+}
+
+#undef WORD_HAS_ZERO
+#undef FILL_WORDS
+
+#if SCREEN_PRESENT_ASYNC
+
+// Present queue consumer: send a frame's windows in order
+static void present_frame_send(void *frame, void *context)
+{
+    (void)context;
+    const PresentFrame *f = (const PresentFrame *)frame;
+    const uint8_t *row = f->pixels;
+
+    for (int i = 0; i < f->windows; i++)
+    {
+        const PresentWindow *w = &f->window[i];
+        lcd_blit_begin(w->x, w->y, w->width, w->height);
+        for (int r = 0; r < w->height; r++)
+        {
+            lcd_blit_row(row);
+            row += w->width;
+        }
+        lcd_blit_end();
+    }
+}
+
+// The present queue, started on first use. NULL if it could not be, in
+// which case frames are sent synchronously.
+static PresentQueue *screen_present_queue(void)
+{
+    if (present_queue == NULL && !present_queue_unavailable)
+    {
+        void *frames[2] = { &present_frames[0], &present_frames[1] };
+        present_queue = present_queue_start(frames, present_frame_send, NULL);
+        present_queue_unavailable = (present_queue == NULL);
+    }
+    return present_queue;
+}
+
+// Compose row y's segment [x0..x1] onto the end of the frame, opening a new
+// window unless it continues the last one. Submits the frame and starts the
+// next when it is full. Returns the frame being filled.
+static PresentFrame *present_frame_add_row(PresentQueue *q, PresentFrame *f,
+                                           int y, int x0, int x1)
+{
+    uint16_t width = (uint16_t)(x1 - x0 + 1);
+    PresentWindow *w = f->windows > 0 ? &f->window[f->windows - 1] : NULL;
+    bool continues = w != NULL && w->x == x0 && w->width == width &&
+                     w->y + w->height == y;
+
+    if (f->used + width > SCREEN_PRESENT_BYTES ||
+        (!continues && f->windows == SCREEN_PRESENT_WINDOWS))
+    {
+        f = (PresentFrame *)present_queue_submit(q);
+        f->windows = 0;
+        f->used = 0;
+        continues = false;
+    }
+    if (!continues)
+    {
+        w = &f->window[f->windows++];
+        w->x = (uint16_t)x0;
+        w->y = (uint16_t)y;
+        w->width = width;
+        w->height = 0;
+    }
+
+    compose_row(&f->pixels[f->used], y, x0, x1);
+    f->used += width;
+    w->height++;
+    return f;
+}
+
+#endif
+
+// Wait until every frame handed to the present queue has reached the LCD.
+// Anything that talks to the LCD other than the present path calls this
+// first. A no-op when presenting synchronously.
+void screen_gfx_sync(void)
+{
+#if SCREEN_PRESENT_ASYNC
+    if (present_queue != NULL)
+    {
+        present_queue_wait_idle(present_queue);
+    }
+#endif
+}
+
 // Internal: blit the dirty tiles to the LCD unconditionally.
 // Each dirty tile-row span is composited (canvas + sprites) row by row
 // into the DMA-fed blit pipeline. Resets dirty state and records the
@@ -996,9 +1792,43 @@ static void screen_gfx_blit_dirty(void)
     int limit = (screen_mode == SCREEN_MODE_SPLIT) ? SCREEN_SPLIT_GFX_HEIGHT
                                                    : SCREEN_HEIGHT;
 
+    if (sprite_rows_stale)
+    {
+        sprite_rows_build();
+    }
+
     int row_iter = 0;
     int x0, y0, x1, y1;
     bool sent = false;
+
+#if SCREEN_PRESENT_ASYNC
+    PresentQueue *q = screen_present_queue();
+    if (q != NULL)
+    {
+        // Compose into present frames; the queue's consumer sends them
+        PresentFrame *f = (PresentFrame *)present_queue_back(q);
+        f->windows = 0;
+        f->used = 0;
+        while (dirty_tiles_next_span(&snapshot, &row_iter, &x0, &y0, &x1, &y1))
+        {
+            if (y0 >= limit)
+                break;
+            if (y1 >= limit)
+                y1 = limit - 1;
+            for (int y = y0; y <= y1; y++)
+            {
+                f = present_frame_add_row(q, f, y, x0, x1);
+            }
+        }
+        if (f->windows > 0)
+        {
+            present_queue_submit(q);
+            last_blit_time_us = time_us_64();
+        }
+        return;
+    }
+#endif
+
     while (dirty_tiles_next_span(&snapshot, &row_iter, &x0, &y0, &x1, &y1))
     {
         if (y0 >= limit)
@@ -1010,7 +1840,7 @@ static void screen_gfx_blit_dirty(void)
                        (uint16_t)(x1 - x0 + 1), (uint16_t)(y1 - y0 + 1));
         for (int y = y0; y <= y1; y++)
         {
-            compose_row(y, x0, x1);
+            compose_row(compose_buf, y, x0, x1);
             lcd_blit_row(compose_buf);
         }
         lcd_blit_end();
@@ -1084,190 +1914,62 @@ bool screen_gfx_get_refresh_auto(void)
     return gfx_refresh_auto;
 }
 
-int screen_gfx_save(LogoStream *out)
+// The LCD palette as BMP entries: blue, green, red, 0
+static void palette_to_bmp(uint8_t *entries)
 {
-    // Save the current graphics buffer to an 8-bit indexed color BMP file.
-    // The caller opened the stream (via the storage router) and closes it.
-    logo_stream_clear_write_error(out);
-
-    // --- BMP FILE HEADER ---
-    uint8_t file_header[BMP_FILE_HEADER_SIZE] = {
-        'B', 'M', // Signature
-        BMP_FILE_SIZE & 0xFF,
-        (BMP_FILE_SIZE >> 8) & 0xFF,
-        (BMP_FILE_SIZE >> 16) & 0xFF,
-        (BMP_FILE_SIZE >> 24) & 0xFF,
-        0, 0, // Reserved1
-        0, 0, // Reserved2
-        BMP_PIXEL_DATA_OFFSET & 0xFF,
-        (BMP_PIXEL_DATA_OFFSET >> 8) & 0xFF,
-        (BMP_PIXEL_DATA_OFFSET >> 16) & 0xFF,
-        (BMP_PIXEL_DATA_OFFSET >> 24) & 0xFF};
-    logo_stream_write_bytes(out, (const char *)file_header, BMP_FILE_HEADER_SIZE);
-
-    // --- DIB HEADER (BITMAPINFOHEADER) ---
-    uint8_t dib_header[BMP_DIB_HEADER_SIZE] = {0};
-    dib_header[0] = BMP_DIB_HEADER_SIZE; // Header size
-    dib_header[4] = (SCREEN_WIDTH) & 0xFF;
-    dib_header[5] = (SCREEN_WIDTH >> 8) & 0xFF;
-    dib_header[6] = (SCREEN_WIDTH >> 16) & 0xFF;
-    dib_header[7] = (SCREEN_WIDTH >> 24) & 0xFF;
-    dib_header[8] = (SCREEN_HEIGHT) & 0xFF;
-    dib_header[9] = (SCREEN_HEIGHT >> 8) & 0xFF;
-    dib_header[10] = (SCREEN_HEIGHT >> 16) & 0xFF;
-    dib_header[11] = (SCREEN_HEIGHT >> 24) & 0xFF;
-    dib_header[12] = BMP_COLOUR_PLANES;     // Planes
-    dib_header[14] = BMP_COLOR_DEPTH;       // Bits per pixel
-    dib_header[16] = BMP_COMPRESSION;       // Compression (0 = none)
-    dib_header[20] = BMP_PIXEL_DATA_SIZE & 0xFF;
-    dib_header[21] = (BMP_PIXEL_DATA_SIZE >> 8) & 0xFF;
-    dib_header[22] = (BMP_PIXEL_DATA_SIZE >> 16) & 0xFF;
-    dib_header[23] = (BMP_PIXEL_DATA_SIZE >> 24) & 0xFF;
-    dib_header[24] = (BMP_PIXELS_PER_METER & 0xFF);
-    dib_header[25] = (BMP_PIXELS_PER_METER >> 8) & 0xFF;
-    dib_header[28] = (BMP_PIXELS_PER_METER & 0xFF);
-    dib_header[29] = (BMP_PIXELS_PER_METER >> 8) & 0xFF;
-#define BMP_DIB_COLORS_USED_OFFSET        32  /* DIB header byte offset: Colors used */
-#define BMP_DIB_IMPORTANT_COLORS_OFFSET   36  /* DIB header byte offset: Important colors */
-    dib_header[BMP_DIB_COLORS_USED_OFFSET] = 0;      // Colors used (0 = all)
-    dib_header[BMP_DIB_IMPORTANT_COLORS_OFFSET] = 0; // Important colors (0 = all)
-
-    logo_stream_write_bytes(out, (const char *)dib_header, BMP_DIB_HEADER_SIZE);
-
-    // --- COLOR PALETTE (256 entries, BGRA format) ---
-    // Convert RGB565 palette to BGRA
     for (int i = 0; i < 256; i++)
     {
         uint16_t rgb565 = lcd_get_palette_value(i);
-        
+
         // Extract RGB565 components (5-6-5 bits)
         uint8_t r5 = (rgb565 >> 11) & 0x1F;
         uint8_t g6 = (rgb565 >> 5) & 0x3F;
         uint8_t b5 = rgb565 & 0x1F;
-        
+
         // Convert to 8-bit RGB (expand to full range)
-        uint8_t r8 = (r5 * 255 + 15) / 31;
-        uint8_t g8 = (g6 * 255 + 31) / 63;
-        uint8_t b8 = (b5 * 255 + 15) / 31;
-        
-        // Write as BGRA
-        uint8_t palette_entry[4] = {b8, g8, r8, 0};
-        logo_stream_write_bytes(out, (const char *)palette_entry, 4);
-    }
-
-    // --- PIXEL DATA (bottom-up, with row padding) ---
-    // BMP rows must be padded to 4-byte boundaries
-    uint8_t padding[3] = {0, 0, 0};
-    int padding_bytes = (4 - (SCREEN_WIDTH % 4)) % 4;
-    
-    for (int y = SCREEN_HEIGHT - 1; y >= 0; y--)
-    {
-        logo_stream_write_bytes(out, (const char *)(gfx_buffer + y * SCREEN_WIDTH), SCREEN_WIDTH);
-        if (padding_bytes > 0)
-        {
-            logo_stream_write_bytes(out, (const char *)padding, padding_bytes);
-        }
+        entries[i * 4 + 0] = (b5 * 255 + 15) / 31;
+        entries[i * 4 + 1] = (g6 * 255 + 31) / 63;
+        entries[i * 4 + 2] = (r5 * 255 + 15) / 31;
+        entries[i * 4 + 3] = 0;
     }
+}
 
-    logo_stream_flush(out);
-    return logo_stream_has_write_error(out) ? EIO : 0;
+int screen_gfx_save(LogoStream *out, bool rle)
+{
+    // Save the current graphics buffer as an 8-bit indexed colour BMP.
+    // The caller opened the stream (via the storage router) and closes it.
+    uint8_t palette[BMP_PALETTE_SIZE];
+    palette_to_bmp(palette);
+    return bmp_save(out, gfx_buffer, SCREEN_WIDTH, SCREEN_HEIGHT, palette, rle);
 }
 
 int screen_gfx_load(LogoStream *in)
 {
-    // Load an 8-bit indexed color BMP file into the graphics buffer and
-    // palette. The caller opened the stream (via the storage router) and
-    // closes it.
-
-    // --- READ AND VALIDATE BMP FILE HEADER ---
-    uint8_t file_header[BMP_FILE_HEADER_SIZE];
-    if (logo_stream_read_chars(in, (char *)file_header, BMP_FILE_HEADER_SIZE) != BMP_FILE_HEADER_SIZE)
-    {
-        return EIO;
-    }
+    // Load an 8-bit indexed colour BMP, uncompressed or RLE8, into the
+    // graphics buffer and palette. The caller opened the stream (via the
+    // storage router) and closes it.
+    uint8_t palette[BMP_PALETTE_SIZE];
+    palette_to_bmp(palette);  // Entries the file leaves out keep their colour
 
-    // Check signature
-    if (file_header[0] != 'B' || file_header[1] != 'M')
+    int err = bmp_load(in, gfx_buffer, SCREEN_WIDTH, SCREEN_HEIGHT, palette);
+    if (err == 0)
     {
-        return EINVAL;
-    }
-
-    // Get pixel data offset
-    uint32_t pixel_offset = file_header[10] | (file_header[11] << 8) | 
-                           (file_header[12] << 16) | (file_header[13] << 24);
-
-    // --- READ AND VALIDATE DIB HEADER ---
-    uint8_t dib_header[BMP_DIB_HEADER_SIZE];
-    if (logo_stream_read_chars(in, (char *)dib_header, BMP_DIB_HEADER_SIZE) != BMP_DIB_HEADER_SIZE)
-    {
-        return EIO;
-    }
-
-    // Extract image properties
-    int32_t width = dib_header[4] | (dib_header[5] << 8) | 
-                    (dib_header[6] << 16) | (dib_header[7] << 24);
-    int32_t height = dib_header[8] | (dib_header[9] << 8) | 
-                     (dib_header[10] << 16) | (dib_header[11] << 24);
-    uint16_t bits_per_pixel = dib_header[14] | (dib_header[15] << 8);
-
-    // Validate dimensions and format
-    if (width != SCREEN_WIDTH || height != SCREEN_HEIGHT || bits_per_pixel != 8)
-    {
-        return EINVAL;
-    }
-
-    // --- READ COLOR PALETTE ---
-    uint8_t palette_data[256 * 4];
-    if (logo_stream_read_chars(in, (char *)palette_data, 256 * 4) != 256 * 4)
-    {
-        return EIO;
-    }
-
-    // Convert BGRA palette to RGB565 and update the LCD palette
-    for (int i = 0; i < 256; i++)
-    {
-        uint8_t b = palette_data[i * 4 + 0];
-        uint8_t g = palette_data[i * 4 + 1];
-        uint8_t r = palette_data[i * 4 + 2];
-        
-        // Convert 8-bit RGB to RGB565
-        uint16_t r5 = (r * 31 + 127) / 255;
-        uint16_t g6 = (g * 63 + 127) / 255;
-        uint16_t b5 = (b * 31 + 127) / 255;
-        uint16_t rgb565 = (r5 << 11) | (g6 << 5) | b5;
-        
-        lcd_set_palette_value(i, rgb565);
-    }
-
-    // --- READ PIXEL DATA ---
-    // Seek to pixel data offset
-    if (!logo_stream_set_read_pos(in, (long)pixel_offset))
-    {
-        return EIO;
-    }
-
-    // Calculate row padding
-    int padding_bytes = (4 - (SCREEN_WIDTH % 4)) % 4;
-    uint8_t padding[3];
-
-    // Read pixel data (bottom-up)
-    for (int y = SCREEN_HEIGHT - 1; y >= 0; y--)
-    {
-        if (logo_stream_read_chars(in, (char *)(gfx_buffer + y * SCREEN_WIDTH), SCREEN_WIDTH) != SCREEN_WIDTH)
-        {
-            return EIO;
-        }
-        if (padding_bytes > 0)
+        // Convert BGR0 entries to RGB565 and update the LCD palette
+        for (int i = 0; i < 256; i++)
         {
-            if (logo_stream_read_chars(in, (char *)padding, padding_bytes) != padding_bytes)
-            {
-                return EIO;
-            }
+            uint8_t b = palette[i * 4 + 0];
+            uint8_t g = palette[i * 4 + 1];
+            uint8_t r = palette[i * 4 + 2];
+
+            uint16_t r5 = (r * 31 + 127) / 255;
+            uint16_t g6 = (g * 63 + 127) / 255;
+            uint16_t b5 = (b * 31 + 127) / 255;
+            lcd_set_palette_value(i, (r5 << 11) | (g6 << 5) | b5);
         }
     }
 
-    screen_gfx_mark_all_dirty();  // Entire buffer was replaced
-    return 0;
+    screen_gfx_mark_all_dirty();  // The buffer may have been written either way
+    return err;
 }
 
 //
@@ -1286,6 +1988,7 @@ uint16_t *screen_txt_frame()
 // Clear the text buffer
 void screen_txt_clear(void)
 {
+    screen_gfx_sync();
     text_row = 0;                                 // Reset the text row to the top
     uint16_t space = TXT_PACK(foreground, background, ' ');
     for (int i = 0; i < SCREEN_COLUMNS * SCREEN_ROWS; i++)
@@ -1312,6 +2015,7 @@ void screen_txt_clear(void)
 // Update the text display
 void screen_txt_set_cursor(uint8_t column, uint8_t row)
 {
+    screen_gfx_sync();
     cursor_column = column < MAX_COLUMN ? column : MAX_COLUMN; // Ensure column is within bounds
     cursor_row = row < SCREEN_ROWS ? row : SCREEN_ROWS - 1;    // Ensure row is within bounds
 
@@ -1338,6 +2042,7 @@ void screen_txt_get_cursor(uint8_t *column, uint8_t *row)
 // Enable or disable the cursor in text mode
 void screen_txt_enable_cursor(bool cursor_on)
 {
+    screen_gfx_sync();
     if (screen_txt_map_location(NULL, NULL))
     {
         cursor_enabled = cursor_on;   // Set the cursor visibility state
@@ -1354,6 +2059,7 @@ void screen_txt_enable_cursor(bool cursor_on)
 // Draw the cursor at the current position
 void screen_txt_draw_cursor(void)
 {
+    screen_gfx_sync();
     uint8_t column, row;
     if (screen_txt_map_location(&column, &row))
     {
@@ -1367,6 +2073,7 @@ void screen_txt_draw_cursor(void)
 // Erase the cursor at the current position
 void screen_txt_erase_cursor(void)
 {
+    screen_gfx_sync();
     uint8_t column, row;
     if (screen_txt_map_location(&column, &row))
     {
@@ -1381,6 +2088,7 @@ void screen_txt_erase_cursor(void)
 // Returns true if the screen scrolled up
 bool screen_txt_putc(uint8_t c)
 {
+    screen_gfx_sync();
     bool scrolled = false;
     if (c == '\n' || c == '\r')
     {
@@ -1614,6 +2322,7 @@ void screen_txt_update(void)
 {
     if (!txt_dirty_any)
         return;  // Nothing changed since last update
+    screen_gfx_sync();
 
     bool saved_cursor = lcd_cursor_enabled(); // Save the current cursor state
     lcd_enable_cursor(false);                  // Disable the cursor while updating
@@ -51,23 +51,21 @@ typedef enum {
     SCREEN_BOUNDARY_WRAP     // Wrap coordinates around edges (default)
 } ScreenBoundaryMode;
 
-// BMP definitions (8-bit indexed color)
-#define BMP_FILE_HEADER_SIZE (14)                                                                           // Size of the BMP file header in bytes
-#define BMP_DIB_HEADER_SIZE (40)                                                                            // Size of the DIB header in bytes
-#define BMP_PALETTE_SIZE (256 * 4)                                                                          // 256 colors, 4 bytes each (BGRA)
-#define BMP_BYTES_PER_PIXEL (1)                                                                             // Bytes per pixel for 8-bit indexed
-#define BMP_ROW_SIZE (((SCREEN_WIDTH * BMP_BYTES_PER_PIXEL + 3) / 4) * 4)                                   // Size of a row in bytes (padded to 4-byte boundary)
-#define BMP_PIXEL_DATA_SIZE (BMP_ROW_SIZE * SCREEN_HEIGHT)                                                  // Size of the pixel data in bytes
-#define BMP_COLOR_DEPTH (8)                                                                                 // Color depth in bits per pixel
-#define BMP_COMPRESSION (0)                                                                                 // Compression type (BI_RGB, no compression)
-#define BMP_COLOUR_PLANES (1)                                                                               // Number of color planes
-#define BMP_PIXELS_PER_METER (2835)                                                                         // Pixels per meter for X and Y (default)
-#define BMP_PIXEL_DATA_OFFSET (BMP_FILE_HEADER_SIZE + BMP_DIB_HEADER_SIZE + BMP_PALETTE_SIZE)               // Offset to pixel data
-#define BMP_FILE_SIZE (BMP_FILE_HEADER_SIZE + BMP_DIB_HEADER_SIZE + BMP_PALETTE_SIZE + BMP_PIXEL_DATA_SIZE) // Total file size
-
-// Scanline fill algorithm with a fixed-size stack
-// Each stack entry stores a scanline segment to process
-// Stack size of 1024 handles most reasonable shapes on a 320x320 screen
+// Widest pen screen_gfx_line draws; wider requests are drawn at this width.
+// Matches MAX_PEN_SIZE in core/limits.h.
+#define SCREEN_LINE_MAX_WIDTH 32
+
+// Most edges screen_gfx_polygon counts crossing one row; crossings past this
+// on a row are ignored. A row of a 320-pixel screen crossed this often is
+// noise, not a shape.
+#define SCREEN_POLYGON_CROSSINGS 64
+
+// Flood fill queue. The fill pushes each span it still has to look past
+// (a row segment and the direction it was reached from) and coalesces spans
+// into whole runs as it scans; while the queue has room it also logs the
+// runs it filled (see screen_gfx_fill). A board with PSRAM lends a larger
+// queue (screen_gfx_set_fill_store). Running out of room costs time, not
+// correctness.
 #define FILL_STACK_SIZE 1024
 typedef struct {
     int16_t y;       // Y coordinate of the scanline
@@ -76,16 +74,14 @@ typedef struct {
     int8_t dir;      // Direction: 1 = down, -1 = up
 } FillSpan;
 
-// Helper macro to push a span onto the stack
-#define PUSH_SPAN(Y, XL, XR, D) do { \
-    if (stack_ptr < FILL_STACK_SIZE) { \
-        stack[stack_ptr].y = (Y); \
-        stack[stack_ptr].x_left = (XL); \
-        stack[stack_ptr].x_right = (XR); \
-        stack[stack_ptr].dir = (D); \
-        stack_ptr++; \
-    } \
-} while(0)
+// What the last screen_gfx_fill did, for the fill benchmark
+typedef struct {
+    uint32_t accesses;       // Canvas loads and stores; a word counts once
+    uint32_t pixels_filled;  // Pixels the fill changed
+    uint32_t spans;          // Spans pushed on the queue
+    uint32_t sweeps;         // Recovery sweeps after the queue overflowed
+    bool marker;             // The queue filled and the fill used a marker
+} ScreenFillStats;
 
 // Function prototypes
 
@@ -103,8 +99,11 @@ ScreenBoundaryMode screen_gfx_get_boundary_mode(void);
 void screen_gfx_set_point(float x, float y, uint8_t colour);
 uint8_t screen_gfx_get_point(float x, float y);
 void screen_gfx_line(float x1, float y1, float x2, float y2, uint8_t colour, bool reverse, int width);
+void screen_gfx_polygon(const float *xy, int count, uint8_t colour);
 void screen_gfx_text(int x, int y, const char *s, uint8_t colour);
 void screen_gfx_fill(float x, float y, uint8_t colour);
+void screen_gfx_set_fill_store(void *store, size_t size);
+void screen_gfx_fill_stats(ScreenFillStats *stats);
 void screen_gfx_update(void);
 
 // Dirty-region tracking. Callers that write directly to screen_gfx_frame()
@@ -126,6 +125,12 @@ void screen_gfx_flush(void);
 // rate limiter. Backs the Logo refresh primitive.
 void screen_gfx_present(void);
 
+// Wait until presented frames have reached the LCD. With the present queue
+// on core 1 (LOGO_PRESENT_ON_CORE1) a present returns before its frame is
+// sent, so code that drives the LCD, or flash, any other way calls this
+// first. A no-op otherwise.
+void screen_gfx_sync(void);
+
 // Refresh policy: automatic (default) presents as drawing happens;
 // manual accumulates until screen_gfx_present(). Switching back to
 // automatic presents anything pending.
@@ -165,7 +170,10 @@ void screen_gfx_snap(int x0, int y0, int w, int h, uint8_t *out, bool opaque);
 // Write `count` palette indices into the canvas from screen pixel (x, y),
 // left to right, clipped to the screen (the tile baker: stampmap/stamptile).
 void screen_gfx_write_row(int x, int y, const uint8_t *pixels, int count);
-int screen_gfx_save(LogoStream *out);
+
+// The canvas and palette as an 8-bit BMP, RLE8 when `rle` (devices/bmp.h).
+// Loading takes either kind. Both return 0 or an errno.
+int screen_gfx_save(LogoStream *out, bool rle);
 int screen_gfx_load(LogoStream *in);
 
 // Text functions
@@ -110,6 +110,12 @@ static uint8_t sd_send_command(uint8_t cmd, uint32_t arg)
     sd_cs_select();
     sd_spi_write_buf(packet, 6);
 
+    // CMD12 is answered after a stuff byte, which may look like a response
+    if (cmd == SD_CMD12)
+    {
+        sd_spi_write_read(0xFF);
+    }
+
     // Wait for response (R1) - but with timeout
     response = 0xFF;
     do
@@ -251,30 +257,156 @@ sd_error_t sd_write_block(uint32_t block, const uint8_t *buffer)
     return err;
 }
 
-sd_error_t sd_read_blocks(uint32_t start_block, uint32_t num_blocks, uint8_t *buffer)
+#ifdef PICOCALC_SD_MULTI_BLOCK
+// CMD18: the card streams blocks, each behind its own data token, until
+// CMD12 stops it.
+static sd_error_t sd_read_blocks_once(uint32_t start_block, uint32_t num_blocks, uint8_t *buffer)
+{
+    uint32_t addr = is_sdhc ? start_block : start_block * SD_BLOCK_SIZE;
+    uint8_t response = sd_send_command(SD_CMD18, addr);
+    if (response != 0)
+    {
+        sd_cs_deselect();
+        return SD_ERROR_READ_FAILED;
+    }
+
+    sd_error_t result = SD_OK;
+    for (uint32_t i = 0; i < num_blocks && result == SD_OK; i++)
+    {
+        uint32_t timeout = 100000;
+        do
+        {
+            response = sd_spi_write_read(0xFF);
+            timeout--;
+        } while (response != SD_DATA_START_BLOCK && timeout > 0);
+
+        if (timeout == 0)
+        {
+            result = SD_ERROR_READ_FAILED;
+            break;
+        }
+
+        sd_spi_read_buf(buffer + i * SD_BLOCK_SIZE, SD_BLOCK_SIZE);
+
+        // Read CRC (ignore it)
+        sd_spi_write_read(0xFF);
+        sd_spi_write_read(0xFF);
+    }
+
+    // Stop the stream whether or not it finished
+    response = sd_send_command(SD_CMD12, 0);
+    sd_wait_ready();
+    sd_cs_deselect();
+    if (response != 0)
+    {
+        return SD_ERROR_READ_FAILED;
+    }
+    return result;
+}
+
+// CMD25: each block goes behind the multi-block token and is acknowledged
+// before the next; a stop token ends the run.
+static sd_error_t sd_write_blocks_once(uint32_t start_block, uint32_t num_blocks, const uint8_t *buffer)
 {
+    uint32_t addr = is_sdhc ? start_block : start_block * SD_BLOCK_SIZE;
+    uint8_t response = sd_send_command(SD_CMD25, addr);
+    if (response != 0)
+    {
+        sd_cs_deselect();
+        return SD_ERROR_WRITE_FAILED;
+    }
+
+    sd_error_t result = SD_OK;
     for (uint32_t i = 0; i < num_blocks; i++)
     {
-        sd_error_t result = sd_read_block(start_block + i, buffer + (i * SD_BLOCK_SIZE));
-        if (result != SD_OK)
+        if (!sd_wait_ready())
+        {
+            result = SD_ERROR_WRITE_FAILED;
+            break;
+        }
+
+        sd_spi_write_read(SD_DATA_START_BLOCK_MULT);
+        sd_spi_write_buf(buffer + i * SD_BLOCK_SIZE, SD_BLOCK_SIZE);
+
+        // Send dummy CRC
+        sd_spi_write_read(0xFF);
+        sd_spi_write_read(0xFF);
+
+        if ((sd_spi_write_read(0xFF) & 0x1F) != 0x05)
         {
-            return result;
+            result = SD_ERROR_WRITE_FAILED;
+            break;
         }
     }
+
+    // The stop token is sent even after a rejected block so the card leaves
+    // the write state
+    sd_wait_ready();
+    sd_spi_write_read(SD_DATA_STOP_MULT);
+    sd_spi_write_read(0xFF);
+    if (!sd_wait_ready())
+    {
+        result = SD_ERROR_WRITE_FAILED;
+    }
+    sd_cs_deselect();
+    return result;
+}
+#endif
+
+// A failed run is retried whole: both commands are idempotent, like their
+// single-block forms. CMD18 and CMD25 have not yet been run against a card,
+// so unless the build sets PICOCALC_SD_MULTI_BLOCK a run moves one block at
+// a time.
+sd_error_t sd_read_blocks(uint32_t start_block, uint32_t num_blocks, uint8_t *buffer)
+{
+#ifndef PICOCALC_SD_MULTI_BLOCK
+    for (uint32_t i = 0; i < num_blocks; i++)
+    {
+        sd_error_t err = sd_read_block(start_block + i, buffer + i * SD_BLOCK_SIZE);
+        if (err != SD_OK) return err;
+    }
     return SD_OK;
+#else
+    if (num_blocks == 1)
+    {
+        return sd_read_block(start_block, buffer);
+    }
+
+    sd_error_t err = SD_ERROR_READ_FAILED;
+    for (int attempt = 0; attempt < SD_IO_RETRIES; attempt++)
+    {
+        err = sd_read_blocks_once(start_block, num_blocks, buffer);
+        if (err == SD_OK) return SD_OK;
+        sd_recover();
+    }
+    return err;
+#endif
 }
 
 sd_error_t sd_write_blocks(uint32_t start_block, uint32_t num_blocks, const uint8_t *buffer)
 {
+#ifndef PICOCALC_SD_MULTI_BLOCK
     for (uint32_t i = 0; i < num_blocks; i++)
     {
-        sd_error_t result = sd_write_block(start_block + i, buffer + (i * SD_BLOCK_SIZE));
-        if (result != SD_OK)
-        {
-            return result;
-        }
+        sd_error_t err = sd_write_block(start_block + i, buffer + i * SD_BLOCK_SIZE);
+        if (err != SD_OK) return err;
     }
     return SD_OK;
+#else
+    if (num_blocks == 1)
+    {
+        return sd_write_block(start_block, buffer);
+    }
+
+    sd_error_t err = SD_ERROR_WRITE_FAILED;
+    for (int attempt = 0; attempt < SD_IO_RETRIES; attempt++)
+    {
+        err = sd_write_blocks_once(start_block, num_blocks, buffer);
+        if (err == SD_OK) return SD_OK;
+        sd_recover();
+    }
+    return err;
+#endif
 }
 
 //
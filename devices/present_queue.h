@@ -0,0 +1,60 @@
+//
+//  Pico Logo
+//  Copyright 2026 Blair Leduc. See LICENSE for details.
+//
+//  Present queue: hands finished frames from the interpreter (the producer)
+//  to a consumer that sends them to the display, so the next frame's body
+//  runs while the last one is still on the wire.
+//
+//  The queue owns two frame buffers of the caller's making. The producer
+//  writes the back buffer and submits it; submit waits only while the
+//  consumer still holds the other one, then hands the back buffer over and
+//  makes the other the new back. A frame therefore costs max(body, send)
+//  rather than body + send, and the producer never writes a buffer the
+//  consumer is reading.
+//
+//  One consumer per platform: a core-1 loop on the RP2350
+//  (devices/picocalc/picocalc_present_queue.c) and a thread on the host
+//  (devices/host/host_present_queue.c), so the overlap can be measured
+//  without hardware.
+//
+
+#pragma once
+
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+    typedef struct PresentQueue PresentQueue;
+
+    // Send one frame. Runs on the consumer, never on the producer.
+    typedef void (*PresentConsumer)(void *frame, void *context);
+
+    // Start the consumer over frames[0] and frames[1]. Returns NULL if it
+    // cannot be started; the caller then presents synchronously.
+    PresentQueue *present_queue_start(void *frames[2], PresentConsumer consume,
+                                      void *context);
+
+    // Wait for every submitted frame, then stop the consumer.
+    void present_queue_stop(PresentQueue *queue);
+
+    // The buffer the producer may write now.
+    void *present_queue_back(PresentQueue *queue);
+
+    // Hand the back buffer to the consumer and return the new back buffer.
+    // Waits only while the consumer still holds the previous frame.
+    void *present_queue_submit(PresentQueue *queue);
+
+    // Wait until the consumer has sent every submitted frame. Anything else
+    // that talks to the display calls this first.
+    void present_queue_wait_idle(PresentQueue *queue);
+
+    // True while a submitted frame is still being sent.
+    bool present_queue_busy(PresentQueue *queue);
+
+#ifdef __cplusplus
+}
+#endif
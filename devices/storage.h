@@ -36,6 +36,17 @@ extern "C"
     //
     typedef bool (*LogoDirCallback)(const char *name, LogoEntryType type, void *user_data);
 
+    //
+    // Block cache counters, for a backend that caches its device's sectors
+    //
+    typedef struct LogoCacheStats
+    {
+        uint32_t hits;            // Lookups served from the cache
+        uint32_t misses;          // Lookups that went to the device
+        uint32_t sectors_read;    // Sectors the cache read, read-ahead included
+        uint32_t sectors_written; // Sectors the cache wrote back
+    } LogoCacheStats;
+
     //
     // LogoStorage interface
     // Platform-specific implementation should be provided to logo_io_init()
@@ -102,6 +113,23 @@ extern "C"
         // restore is unsupported on this backend.
         bool (*fs_image_restore)(LogoStream *in);
 
+        // Report the block cache counters of the filesystem backing
+        // `pathname`, counted since boot. Returns false if the volume is
+        // unavailable. Optional: NULL means the backend has no block cache.
+        bool (*cache_stats)(const char *pathname, LogoCacheStats *stats);
+
+        // Give read-only access to the whole of the file at `pathname` in
+        // place: `*data` points at its `*len` bytes, which are not
+        // NUL-terminated. Returns false when the file cannot be mapped (the
+        // caller then reads it through a stream). The bytes stay valid until
+        // unmap_file, provided the file is not written, deleted or renamed
+        // meanwhile. Optional: NULL means files are only read as streams.
+        bool (*map_file)(const char *pathname, const char **data, size_t *len);
+
+        // Release a mapping made by map_file. Optional: NULL means a mapping
+        // holds nothing to release.
+        void (*unmap_file)(const char *pathname, const char *data, size_t len);
+
     } LogoStorageOps;
 
     typedef struct LogoStorage
@@ -217,6 +217,38 @@ static bool router_free_blocks(const char *pathname, uint32_t *free_blocks,
     return ops->free_blocks(sub ? sub : pathname, free_blocks, block_size);
 }
 
+static bool router_cache_stats(const char *pathname, LogoCacheStats *stats)
+{
+    const char *sub = sd_subpath(pathname);
+    const LogoStorageOps *ops = sub ? g_sd_ops : g_root_ops;
+    if (!ops->cache_stats)
+    {
+        return false;
+    }
+    return ops->cache_stats(sub ? sub : pathname, stats);
+}
+
+static bool router_map_file(const char *pathname, const char **data, size_t *len)
+{
+    const char *sub = sd_subpath(pathname);
+    const LogoStorageOps *ops = sub ? g_sd_ops : g_root_ops;
+    if (!ops->map_file)
+    {
+        return false;
+    }
+    return ops->map_file(sub ? sub : pathname, data, len);
+}
+
+static void router_unmap_file(const char *pathname, const char *data, size_t len)
+{
+    const char *sub = sd_subpath(pathname);
+    const LogoStorageOps *ops = sub ? g_sd_ops : g_root_ops;
+    if (ops->unmap_file)
+    {
+        ops->unmap_file(sub ? sub : pathname, data, len);
+    }
+}
+
 static bool router_mount_available(const char *pathname)
 {
     const char *sub = sd_subpath(pathname);
@@ -262,6 +294,9 @@ static const LogoStorageOps router_ops = {
     .is_external = router_is_external,
     .fs_image_backup = router_fs_image_backup,
     .fs_image_restore = router_fs_image_restore,
+    .cache_stats = router_cache_stats,
+    .map_file = router_map_file,
+    .unmap_file = router_unmap_file,
 };
 
 void logo_storage_router_init(LogoStorage *router,
@@ -9,6 +9,27 @@
 
 #include <string.h>
 
+//
+// Buffered stream: a read buffer over the stream's read position and a
+// write buffer over its write position, in front of a seekable backend.
+// The backend's read position is always read_base + read_len and its write
+// position always write_base.
+//
+typedef struct BufferedStream
+{
+    LogoStream stream;      // First, so callers free() it as a LogoStream
+    LogoStream *inner;
+    long read_base;         // File position of read_buf[0]
+    int read_len;           // Bytes in read_buf
+    int read_off;           // Next byte to read from read_buf
+    long write_base;        // File position of write_buf[0]
+    int write_len;          // Bytes in write_buf
+    char read_buf[LOGO_STREAM_BUFFER_SIZE];
+    char write_buf[LOGO_STREAM_BUFFER_SIZE];
+} BufferedStream;
+
+static const LogoStreamOps buffered_ops;
+
 //
 // Stream initialization
 //
@@ -50,6 +71,16 @@ int logo_stream_read_char(LogoStream *stream)
         return -1;
     }
 
+    // A buffered stream with data in hand needs no call through the table
+    if (stream->ops == &buffered_ops)
+    {
+        BufferedStream *b = (BufferedStream *)stream;
+        if (b->read_off < b->read_len)
+        {
+            return (unsigned char)b->read_buf[b->read_off++];
+        }
+    }
+
     return stream->ops->read_char(stream);
 }
 
@@ -65,6 +96,17 @@ int logo_stream_read_chars(LogoStream *stream, char *buffer, int count)
         return 0;
     }
 
+    if (stream->ops == &buffered_ops)
+    {
+        BufferedStream *b = (BufferedStream *)stream;
+        if (b->read_len - b->read_off >= count)
+        {
+            memcpy(buffer, b->read_buf + b->read_off, (size_t)count);
+            b->read_off += count;
+            return count;
+        }
+    }
+
     return stream->ops->read_chars(stream, buffer, count);
 }
 
@@ -273,3 +315,315 @@ void logo_stream_close(LogoStream *stream)
 
     stream->is_open = false;
 }
+
+//
+// Buffered stream
+//
+
+// Move the backend's write-error flags onto the wrapper, where callers look
+static void buffered_take_errors(BufferedStream *b)
+{
+    if (b->inner->write_error)
+    {
+        b->stream.write_error = true;
+        b->stream.disk_full |= b->inner->disk_full;
+        logo_stream_clear_write_error(b->inner);
+    }
+}
+
+// Forget the read buffer, leaving the backend at the logical read position
+static void buffered_drop_reads(BufferedStream *b)
+{
+    long pos = b->read_base + b->read_off;
+    if (b->read_len > 0)
+    {
+        logo_stream_set_read_pos(b->inner, pos);
+    }
+    b->read_base = pos;
+    b->read_len = 0;
+    b->read_off = 0;
+}
+
+// Write out the write buffer
+static void buffered_drain(BufferedStream *b)
+{
+    if (b->write_len == 0)
+    {
+        return;
+    }
+
+    logo_stream_write_bytes(b->inner, b->write_buf, (size_t)b->write_len);
+    b->write_len = 0;
+    b->write_base = logo_stream_get_write_pos(b->inner);
+    buffered_take_errors(b);
+}
+
+// Refill the read buffer from the backend. False at end of file or on error.
+static bool buffered_fill(BufferedStream *b)
+{
+    buffered_drain(b);
+    b->read_base += b->read_len;
+    b->read_len = 0;
+    b->read_off = 0;
+    int n = logo_stream_read_chars(b->inner, b->read_buf, LOGO_STREAM_BUFFER_SIZE);
+    if (n <= 0)
+    {
+        return false;
+    }
+    b->read_len = n;
+    return true;
+}
+
+static int buffered_read_char(LogoStream *stream)
+{
+    BufferedStream *b = (BufferedStream *)stream->context;
+    if (b->read_off == b->read_len && !buffered_fill(b))
+    {
+        return -1;
+    }
+    return (unsigned char)b->read_buf[b->read_off++];
+}
+
+static int buffered_read_chars(LogoStream *stream, char *buffer, int count)
+{
+    BufferedStream *b = (BufferedStream *)stream->context;
+    int total = 0;
+    while (total < count)
+    {
+        int avail = b->read_len - b->read_off;
+        if (avail > 0)
+        {
+            int n = avail < count - total ? avail : count - total;
+            memcpy(buffer + total, b->read_buf + b->read_off, (size_t)n);
+            b->read_off += n;
+            total += n;
+            continue;
+        }
+
+        // A request of a buffer or more goes straight to the caller's memory
+        if (count - total >= LOGO_STREAM_BUFFER_SIZE)
+        {
+            buffered_drain(b);
+            b->read_base += b->read_len;
+            b->read_len = 0;
+            b->read_off = 0;
+            int n = logo_stream_read_chars(b->inner, buffer + total, count - total);
+            if (n <= 0)
+            {
+                return total > 0 ? total : n;
+            }
+            b->read_base += n;
+            total += n;
+            continue;
+        }
+
+        if (!buffered_fill(b))
+        {
+            break;
+        }
+    }
+    return total;
+}
+
+static int buffered_read_line(LogoStream *stream, char *buffer, size_t size)
+{
+    BufferedStream *b = (BufferedStream *)stream->context;
+    size_t total = 0;
+    bool line_ended = false;
+    while (total < size - 1 && !line_ended)
+    {
+        if (b->read_off == b->read_len && !buffered_fill(b))
+        {
+            break;
+        }
+        const char *p = b->read_buf + b->read_off;
+        const char *end = b->read_buf + b->read_len;
+        size_t room = size - 1 - total;
+        if ((size_t)(end - p) > room)
+        {
+            end = p + room;
+        }
+        while (p < end)
+        {
+            char c = *p++;
+            if (c == '\n' || c == '\r')
+            {
+                line_ended = true;
+                break;
+            }
+            buffer[total++] = c;
+        }
+        b->read_off = (int)(p - b->read_buf);
+    }
+    buffer[total] = '\0';
+    // -1 only at end of file, not for an empty line
+    return (total > 0 || line_ended) ? (int)total : -1;
+}
+
+static bool buffered_can_read(LogoStream *stream)
+{
+    BufferedStream *b = (BufferedStream *)stream->context;
+    if (b->read_off < b->read_len)
+    {
+        return true;
+    }
+    buffered_drain(b);
+    return logo_stream_can_read(b->inner);
+}
+
+static void buffered_write_bytes(LogoStream *stream, const char *buffer, size_t len)
+{
+    BufferedStream *b = (BufferedStream *)stream->context;
+
+    // Bytes written over the read buffer's span make it stale; the next
+    // read drains the writes and refills
+    long pos = b->write_base + b->write_len;
+    if (pos < b->read_base + b->read_len && pos + (long)len > b->read_base)
+    {
+        buffered_drop_reads(b);
+    }
+
+    while (len > 0)
+    {
+        size_t n = (size_t)(LOGO_STREAM_BUFFER_SIZE - b->write_len);
+        if (n > len)
+        {
+            n = len;
+        }
+        memcpy(b->write_buf + b->write_len, buffer, n);
+        b->write_len += (int)n;
+        buffer += n;
+        len -= n;
+        if (b->write_len == LOGO_STREAM_BUFFER_SIZE)
+        {
+            buffered_drain(b);
+        }
+    }
+}
+
+static void buffered_write(LogoStream *stream, const char *text)
+{
+    buffered_write_bytes(stream, text, strlen(text));
+}
+
+static void buffered_flush(LogoStream *stream)
+{
+    BufferedStream *b = (BufferedStream *)stream->context;
+    buffered_drain(b);
+    logo_stream_flush(b->inner);
+    buffered_take_errors(b);
+}
+
+static long buffered_get_read_pos(LogoStream *stream)
+{
+    BufferedStream *b = (BufferedStream *)stream->context;
+    return b->read_base + b->read_off;
+}
+
+static bool buffered_set_read_pos(LogoStream *stream, long pos)
+{
+    BufferedStream *b = (BufferedStream *)stream->context;
+    if (pos >= b->read_base && pos <= b->read_base + b->read_len)
+    {
+        b->read_off = (int)(pos - b->read_base);
+        return true;
+    }
+
+    // The backend checks the position against a length that must include
+    // anything still buffered
+    buffered_drain(b);
+    if (!logo_stream_set_read_pos(b->inner, pos))
+    {
+        return false;
+    }
+    b->read_base = pos;
+    b->read_len = 0;
+    b->read_off = 0;
+    return true;
+}
+
+static long buffered_get_write_pos(LogoStream *stream)
+{
+    BufferedStream *b = (BufferedStream *)stream->context;
+    return b->write_base + b->write_len;
+}
+
+static bool buffered_set_write_pos(LogoStream *stream, long pos)
+{
+    BufferedStream *b = (BufferedStream *)stream->context;
+    buffered_drain(b);
+    if (!logo_stream_set_write_pos(b->inner, pos))
+    {
+        return false;
+    }
+    b->write_base = pos;
+    return true;
+}
+
+static long buffered_get_length(LogoStream *stream)
+{
+    BufferedStream *b = (BufferedStream *)stream->context;
+    buffered_drain(b);
+    return logo_stream_get_length(b->inner);
+}
+
+static void buffered_close(LogoStream *stream)
+{
+    BufferedStream *b = (BufferedStream *)stream->context;
+    buffered_drain(b);
+    logo_stream_close(b->inner);
+    free(b->inner);
+    b->inner = NULL;
+    stream->is_open = false;
+}
+
+static const LogoStreamOps buffered_ops = {
+    .read_char = buffered_read_char,
+    .read_chars = buffered_read_chars,
+    .read_line = buffered_read_line,
+    .can_read = buffered_can_read,
+    .write = buffered_write,
+    .write_bytes = buffered_write_bytes,
+    .flush = buffered_flush,
+    .get_read_pos = buffered_get_read_pos,
+    .set_read_pos = buffered_set_read_pos,
+    .get_write_pos = buffered_get_write_pos,
+    .set_write_pos = buffered_set_write_pos,
+    .get_length = buffered_get_length,
+    .close = buffered_close,
+};
+
+LogoStream *logo_stream_buffered(LogoStream *inner)
+{
+    if (!inner || !inner->is_open || !inner->ops)
+    {
+        return inner;
+    }
+
+    const LogoStreamOps *ops = inner->ops;
+    if (!ops->read_chars || !ops->write_bytes || !ops->get_read_pos ||
+        !ops->set_read_pos || !ops->get_write_pos || !ops->set_write_pos)
+    {
+        return inner;
+    }
+    long read_pos = logo_stream_get_read_pos(inner);
+    long write_pos = logo_stream_get_write_pos(inner);
+    if (read_pos < 0 || write_pos < 0)
+    {
+        return inner;
+    }
+
+    BufferedStream *b = (BufferedStream *)malloc(sizeof(BufferedStream));
+    if (!b)
+    {
+        return inner;
+    }
+    logo_stream_init(&b->stream, inner->type, &buffered_ops, b, inner->name);
+    b->inner = inner;
+    b->read_base = read_pos;
+    b->read_len = 0;
+    b->read_off = 0;
+    b->write_base = write_pos;
+    b->write_len = 0;
+    return &b->stream;
+}
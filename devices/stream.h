@@ -21,6 +21,12 @@ extern "C"
     // Maximum length of a stream name (pathname or device name)
     #define LOGO_STREAM_NAME_MAX 64
 
+    // Bytes in each of a buffered stream's read and write buffers. One
+    // allocation per open file holds both, so eight open files cost 8 KB.
+    #ifndef LOGO_STREAM_BUFFER_SIZE
+    #define LOGO_STREAM_BUFFER_SIZE 512
+    #endif
+
     // Special return values for read operations
     #define LOGO_STREAM_EOF        (-1)   // End of file or error
     #define LOGO_STREAM_INTERRUPTED (-2)  // User pressed BRK key
@@ -125,6 +131,17 @@ extern "C"
     void logo_stream_init(LogoStream *stream, LogoStreamType type,
                           const LogoStreamOps *ops, void *context, const char *name);
 
+    // Wrap a heap-allocated seekable stream in a buffered one, so that
+    // reading a character, a line or a short run of bytes is a copy from
+    // memory, and writes reach the backend in runs of up to
+    // LOGO_STREAM_BUFFER_SIZE bytes. The buffers follow the stream's separate
+    // read and write positions; buffered writes go out on flush, on close,
+    // before any read that needs the backend, and before a seek or a length.
+    // The wrapper owns `inner`: closing it closes `inner`, and freeing the
+    // wrapper after close frees both. Returns `inner` unchanged if it is not
+    // seekable or the buffers cannot be allocated.
+    LogoStream *logo_stream_buffered(LogoStream *inner);
+
 #ifdef __cplusplus
 }
 #endif
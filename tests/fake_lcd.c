@@ -9,6 +9,7 @@
 
 #include "fake_lcd.h"
 #include "lcd.h"
+#include "screen.h"
 
 static uint8_t panel[WIDTH * HEIGHT];
 static uint16_t palette[256];
@@ -20,8 +21,11 @@ static uint64_t clock_us;
 // Open blit window (lcd_blit_begin .. lcd_blit_end)
 static int win_x, win_y, win_w, win_rows;
 
+// Reads and the reset wait for frames still being sent (see fake_lcd.h)
+
 void fake_lcd_reset(void)
 {
+    screen_gfx_sync();
     memset(panel, FAKE_LCD_UNWRITTEN, sizeof(panel));
     clear_count = 0;
     rectangle_count = 0;
@@ -32,6 +36,7 @@ void fake_lcd_reset(void)
 
 uint8_t fake_lcd_panel_point(int x, int y)
 {
+    screen_gfx_sync();
     if (x < 0 || x >= WIDTH || y < 0 || y >= HEIGHT)
     {
         return FAKE_LCD_UNWRITTEN;
@@ -39,9 +44,9 @@ uint8_t fake_lcd_panel_point(int x, int y)
     return panel[y * WIDTH + x];
 }
 
-int fake_lcd_clear_count(void) { return clear_count; }
-int fake_lcd_rectangle_count(void) { return rectangle_count; }
-int fake_lcd_blit_row_count(void) { return blit_row_count; }
+int fake_lcd_clear_count(void) { screen_gfx_sync(); return clear_count; }
+int fake_lcd_rectangle_count(void) { screen_gfx_sync(); return rectangle_count; }
+int fake_lcd_blit_row_count(void) { screen_gfx_sync(); return blit_row_count; }
 
 void fake_lcd_advance_us(uint64_t us) { clock_us += us; }
 
@@ -7,7 +7,9 @@
 //  write landed on: the canvas, or the panel.
 //
 //  The "panel" is what the LCD is showing. Only lcd_clear_screen,
-//  lcd_solid_rectangle and the row-fed blit put pixels there.
+//  lcd_solid_rectangle and the row-fed blit put pixels there. Reading it
+//  back first waits for any frame the present queue is still sending, so a
+//  test sees the same panel whether presents are synchronous or not.
 //
 
 #pragma once
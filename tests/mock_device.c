@@ -6,6 +6,7 @@
 //
 
 #include "mock_device.h"
+#include "devices/bmp.h"
 #include <string.h>
 #include <math.h>
 #include <stdio.h>
@@ -378,6 +379,17 @@ static void mock_turtle_fill(void)
     record_command(MOCK_CMD_FILL);
 }
 
+static void mock_turtle_fill_polygon(const float *xy, int count, uint8_t colour)
+{
+    record_command(MOCK_CMD_FILL_POLYGON);
+
+    MockPolygon *p = &mock_state.graphics.polygon;
+    p->count = count < MOCK_MAX_POLYGON_VERTICES ? count : MOCK_MAX_POLYGON_VERTICES;
+    memcpy(p->xy, xy, (size_t)p->count * 2 * sizeof(float));
+    p->colour = colour;
+    mock_state.graphics.polygon_count++;
+}
+
 static void mock_turtle_set_fence(void)
 {
     mock_state.turtle.boundary_mode = MOCK_BOUNDARY_FENCE;
@@ -396,17 +408,38 @@ static void mock_turtle_set_wrap(void)
     record_command(MOCK_CMD_SET_WRAP);
 }
 
-static int mock_turtle_gfx_save(LogoStream *out)
+// The mock palette as BMP entries: blue, green, red, 0
+static void mock_palette_to_bmp(uint8_t *entries)
+{
+    for (int i = 0; i < 256; i++)
+    {
+        entries[i * 4 + 0] = mock_state.palette.b[i];
+        entries[i * 4 + 1] = mock_state.palette.g[i];
+        entries[i * 4 + 2] = mock_state.palette.r[i];
+        entries[i * 4 + 3] = 0;
+    }
+}
+
+static int mock_turtle_gfx_save(LogoStream *out, bool rle)
 {
     // Track the call
     mock_state.gfx_io.gfx_save_call_count++;
+    mock_state.gfx_io.last_save_rle = rle;
     if (out)
     {
         strncpy(mock_state.gfx_io.last_save_filename, out->name,
                 sizeof(mock_state.gfx_io.last_save_filename) - 1);
         mock_state.gfx_io.last_save_filename[sizeof(mock_state.gfx_io.last_save_filename) - 1] = '\0';
     }
-    return mock_state.gfx_io.gfx_save_result;
+    if (mock_state.gfx_io.gfx_save_result != 0 || !mock_state.gfx_io.codec)
+    {
+        return mock_state.gfx_io.gfx_save_result;
+    }
+
+    uint8_t palette[BMP_PALETTE_SIZE];
+    mock_palette_to_bmp(palette);
+    return bmp_save(out, mock_state.sensing.canvas, MOCK_SCREEN_WIDTH_PX,
+                    MOCK_SCREEN_HEIGHT_PX, palette, rle);
 }
 
 static int mock_turtle_gfx_load(LogoStream *in)
@@ -419,7 +452,25 @@ static int mock_turtle_gfx_load(LogoStream *in)
                 sizeof(mock_state.gfx_io.last_load_filename) - 1);
         mock_state.gfx_io.last_load_filename[sizeof(mock_state.gfx_io.last_load_filename) - 1] = '\0';
     }
-    return mock_state.gfx_io.gfx_load_result;
+    if (mock_state.gfx_io.gfx_load_result != 0 || !mock_state.gfx_io.codec)
+    {
+        return mock_state.gfx_io.gfx_load_result;
+    }
+
+    uint8_t palette[BMP_PALETTE_SIZE];
+    mock_palette_to_bmp(palette);
+    int err = bmp_load(in, mock_state.sensing.canvas, MOCK_SCREEN_WIDTH_PX,
+                       MOCK_SCREEN_HEIGHT_PX, palette);
+    if (err == 0)
+    {
+        for (int i = 0; i < 256; i++)
+        {
+            mock_state.palette.b[i] = palette[i * 4 + 0];
+            mock_state.palette.g[i] = palette[i * 4 + 1];
+            mock_state.palette.r[i] = palette[i * 4 + 2];
+        }
+    }
+    return err;
 }
 
 static void mock_turtle_set_palette(uint8_t slot, uint8_t r, uint8_t g, uint8_t b)
@@ -552,6 +603,7 @@ static bool mock_turtle_get_raster(LogoTurtleRaster *out)
     out->indexed = r->indexed;
     out->visible = r->visible;
     out->mask = r->mask;
+    out->serial = r->serial;
     return true;
 }
 
@@ -704,6 +756,7 @@ static const LogoConsoleTurtle mock_turtle_ops = {
     .dot = mock_turtle_dot,
     .dot_at = mock_turtle_dot_at,
     .fill = mock_turtle_fill,
+    .fill_polygon = mock_turtle_fill_polygon,
     .draw_text = mock_turtle_draw_text,
     .set_fence = mock_turtle_set_fence,
     .set_window = mock_turtle_set_window,
@@ -1220,6 +1273,8 @@ void mock_device_reset(void)
     mock_state.gfx_io.gfx_load_call_count = 0;
     mock_state.gfx_io.gfx_save_result = 0;  // Default to success
     mock_state.gfx_io.gfx_load_result = 0;  // Default to success
+    mock_state.gfx_io.last_save_rle = false;
+    mock_state.gfx_io.codec = false;
     
     // Clear I/O buffers
     mock_output_buffer[0] = '\0';
@@ -1440,6 +1495,14 @@ void mock_device_set_raster(uint8_t n, const LogoTurtleRaster *raster)
     r->indexed = raster->indexed;
     r->visible = raster->visible;
     memcpy(r->mask, raster->mask, (size_t)raster->w * raster->h);
+
+    // A restaged raster is a rebuilt one, so core must repack it
+    static uint32_t serial_next = 0;
+    if (++serial_next == 0)
+    {
+        serial_next = 1;
+    }
+    r->serial = serial_next;
 }
 
 void mock_device_set_canvas_point(int x, int y, uint8_t index)
@@ -1546,12 +1609,27 @@ const MockStamp *mock_device_get_stamp(int index)
     return &mock_state.graphics.stamps[index];
 }
 
+int mock_device_polygon_count(void)
+{
+    return mock_state.graphics.polygon_count;
+}
+
+const MockPolygon *mock_device_last_polygon(void)
+{
+    if (mock_state.graphics.polygon_count == 0)
+    {
+        return NULL;
+    }
+    return &mock_state.graphics.polygon;
+}
+
 void mock_device_clear_graphics(void)
 {
     mock_state.graphics.cleared = false;
     mock_state.graphics.dot_count = 0;
     mock_state.graphics.line_count = 0;
     mock_state.graphics.stamp_count = 0;
+    mock_state.graphics.polygon_count = 0;
 }
 
 bool mock_device_verify_position(float x, float y, float tolerance)
@@ -1659,6 +1737,16 @@ int mock_device_get_gfx_load_call_count(void)
     return mock_state.gfx_io.gfx_load_call_count;
 }
 
+bool mock_device_get_last_gfx_save_rle(void)
+{
+    return mock_state.gfx_io.last_save_rle;
+}
+
+void mock_device_set_gfx_codec(bool on)
+{
+    mock_state.gfx_io.codec = on;
+}
+
 //
 // Palette helpers for testing
 //
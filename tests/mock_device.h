@@ -70,6 +70,7 @@ extern "C"
         MOCK_CMD_CLEAR_GRAPHICS,
         MOCK_CMD_DOT,
         MOCK_CMD_FILL,
+        MOCK_CMD_FILL_POLYGON,
         // Boundary modes
         MOCK_CMD_SET_FENCE,
         MOCK_CMD_SET_WINDOW,
@@ -158,6 +159,18 @@ extern "C"
     //
     #define MOCK_MAX_STAMPS 2048
 
+    //
+    // Mock polygon record: the last polygon `filled` handed to the device.
+    //
+    #define MOCK_MAX_POLYGON_VERTICES 256
+
+    typedef struct MockPolygon
+    {
+        float xy[MOCK_MAX_POLYGON_VERTICES * 2];
+        int count;
+        uint8_t colour;
+    } MockPolygon;
+
     //
     // Mock line segment for tracking drawn lines
     //
@@ -224,6 +237,7 @@ extern "C"
         uint8_t w, h;       // Mask dimensions
         bool indexed;       // Mask bytes are palette slots (255 transparent)
         bool visible;       // Currently rendered
+        uint32_t serial;    // Bumped each time a test stages a raster
         uint8_t mask[MOCK_RASTER_MAX * MOCK_RASTER_MAX];
     } MockRaster;
 
@@ -329,6 +343,8 @@ extern "C"
             int line_count;
             MockStamp stamps[MOCK_MAX_STAMPS];  // Recorded stamps
             int stamp_count;
+            MockPolygon polygon;             // Last filled polygon
+            int polygon_count;
         } graphics;
 
         // Command history
@@ -347,6 +363,8 @@ extern "C"
             int gfx_load_call_count;         // Number of times gfx_load was called
             int gfx_save_result;             // Result to return from gfx_save (0 = success)
             int gfx_load_result;             // Result to return from gfx_load (0 = success)
+            bool last_save_rle;              // `rle` passed to the last gfx_save
+            bool codec;                      // Encode/decode the canvas (devices/bmp.h)
         } gfx_io;
 
         // Palette tracking
@@ -515,6 +533,8 @@ extern "C"
     const MockLine *mock_device_get_line(int index);
     int mock_device_stamp_count(void);
     const MockStamp *mock_device_get_stamp(int index);
+    int mock_device_polygon_count(void);
+    const MockPolygon *mock_device_last_polygon(void);
     void mock_device_clear_graphics(void);
 
     // Verify helpers for tests
@@ -535,6 +555,12 @@ extern "C"
     const char *mock_device_get_last_gfx_load_filename(void);
     int mock_device_get_gfx_save_call_count(void);
     int mock_device_get_gfx_load_call_count(void);
+    bool mock_device_get_last_gfx_save_rle(void);
+
+    // Off by default, so gfx_save writes nothing and gfx_load takes any file.
+    // On, gfx_save writes the sensing canvas and palette as a BMP through
+    // devices/bmp.c and gfx_load reads one back into them.
+    void mock_device_set_gfx_codec(bool on);
 
     // Palette helpers for testing
     bool mock_device_verify_palette(uint8_t slot, uint8_t r, uint8_t g, uint8_t b);
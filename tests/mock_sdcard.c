@@ -13,6 +13,8 @@ static bool      g_present      = false;
 static bool      g_initialised  = false;
 static uint32_t  g_read_count   = 0;
 static uint32_t  g_write_count  = 0;
+static uint32_t  g_read_commands  = 0;
+static uint32_t  g_write_commands = 0;
 
 void mock_sd_init(uint32_t total_blocks)
 {
@@ -23,6 +25,8 @@ void mock_sd_init(uint32_t total_blocks)
     g_initialised = false;
     g_read_count = 0;
     g_write_count = 0;
+    g_read_commands = 0;
+    g_write_commands = 0;
 }
 
 void mock_sd_destroy(void)
@@ -65,7 +69,15 @@ uint8_t *mock_sd_block_ptr(uint32_t block)
 
 uint32_t mock_sd_read_count(void)  { return g_read_count; }
 uint32_t mock_sd_write_count(void) { return g_write_count; }
-void     mock_sd_reset_stats(void) { g_read_count = 0; g_write_count = 0; }
+uint32_t mock_sd_read_commands(void)  { return g_read_commands; }
+uint32_t mock_sd_write_commands(void) { return g_write_commands; }
+void     mock_sd_reset_stats(void)
+{
+    g_read_count = 0;
+    g_write_count = 0;
+    g_read_commands = 0;
+    g_write_commands = 0;
+}
 
 //
 // sd_* API implementations consumed by fat32.c
@@ -84,44 +96,38 @@ void sd_init(void) { /* nothing to do on host */ }
 
 bool sd_is_sdhc(void) { return true; }
 
-sd_error_t sd_read_block(uint32_t block, uint8_t *buffer)
+sd_error_t sd_read_blocks(uint32_t start_block, uint32_t num_blocks, uint8_t *buffer)
 {
     if (!g_present)        return SD_ERROR_NO_CARD;
     if (!g_image)          return SD_ERROR_INIT_FAILED;
-    if (block >= g_total_blocks) return SD_ERROR_READ_FAILED;
-    memcpy(buffer, g_image + (size_t)block * SD_BLOCK_SIZE, SD_BLOCK_SIZE);
-    g_read_count++;
+    if (start_block >= g_total_blocks || num_blocks > g_total_blocks - start_block)
+        return SD_ERROR_READ_FAILED;
+    memcpy(buffer, g_image + (size_t)start_block * SD_BLOCK_SIZE, (size_t)num_blocks * SD_BLOCK_SIZE);
+    g_read_count += num_blocks;
+    g_read_commands++;
     return SD_OK;
 }
 
-sd_error_t sd_write_block(uint32_t block, const uint8_t *buffer)
+sd_error_t sd_write_blocks(uint32_t start_block, uint32_t num_blocks, const uint8_t *buffer)
 {
     if (!g_present)        return SD_ERROR_NO_CARD;
     if (!g_image)          return SD_ERROR_INIT_FAILED;
-    if (block >= g_total_blocks) return SD_ERROR_WRITE_FAILED;
-    memcpy(g_image + (size_t)block * SD_BLOCK_SIZE, buffer, SD_BLOCK_SIZE);
-    g_write_count++;
+    if (start_block >= g_total_blocks || num_blocks > g_total_blocks - start_block)
+        return SD_ERROR_WRITE_FAILED;
+    memcpy(g_image + (size_t)start_block * SD_BLOCK_SIZE, buffer, (size_t)num_blocks * SD_BLOCK_SIZE);
+    g_write_count += num_blocks;
+    g_write_commands++;
     return SD_OK;
 }
 
-sd_error_t sd_read_blocks(uint32_t start_block, uint32_t num_blocks, uint8_t *buffer)
+sd_error_t sd_read_block(uint32_t block, uint8_t *buffer)
 {
-    for (uint32_t i = 0; i < num_blocks; i++)
-    {
-        sd_error_t r = sd_read_block(start_block + i, buffer + (size_t)i * SD_BLOCK_SIZE);
-        if (r != SD_OK) return r;
-    }
-    return SD_OK;
+    return sd_read_blocks(block, 1, buffer);
 }
 
-sd_error_t sd_write_blocks(uint32_t start_block, uint32_t num_blocks, const uint8_t *buffer)
+sd_error_t sd_write_block(uint32_t block, const uint8_t *buffer)
 {
-    for (uint32_t i = 0; i < num_blocks; i++)
-    {
-        sd_error_t r = sd_write_block(start_block + i, buffer + (size_t)i * SD_BLOCK_SIZE);
-        if (r != SD_OK) return r;
-    }
-    return SD_OK;
+    return sd_write_blocks(block, 1, buffer);
 }
 
 const char *sd_error_string(sd_error_t error)
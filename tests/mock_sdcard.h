@@ -38,3 +38,8 @@ uint8_t *mock_sd_block_ptr(uint32_t block);
 uint32_t mock_sd_read_count(void);
 uint32_t mock_sd_write_count(void);
 void     mock_sd_reset_stats(void);
+
+// Commands issued: a multi-block transfer counts once, however many blocks
+// it moves.  Reset with the block counts.
+uint32_t mock_sd_read_commands(void);
+uint32_t mock_sd_write_commands(void);
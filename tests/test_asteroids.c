@@ -780,6 +780,10 @@ void test_every_rock_is_drawn_with_a_one_pixel_pen(void)
 // has to be able to be wrong for a frame and still recover. So measure the
 // spend on the EXPENSIVE frame -- a saucer up, shots in the air, rocks
 // splitting -- and require the floor to clear it by 8x.
+//
+// Since lists hold numbers as number nodes (2026-10-15) a stored coordinate
+// mints no atom, so the spend measured here can be zero. The floor is kept:
+// a word-minting change to the game would bring the spend straight back.
 void test_the_reclaim_floor_clears_what_a_busy_frame_spends(void)
 {
     setup_with(12);
@@ -795,7 +799,7 @@ void test_the_reclaim_floor_clears_what_a_busy_frame_spends(void)
         run("play.frame");
     }
     size_t after = mem_free_atoms();
-    TEST_ASSERT_TRUE_MESSAGE(after < before, "a busy frame spent no word space at all");
+    TEST_ASSERT_TRUE_MESSAGE(after <= before, "a busy frame gave word space back");
 
     float spend = (before - after) / (float)frames;
     float floor = num(":atom.floor");
@@ -824,7 +828,7 @@ void test_the_frame_loop_survives_a_squeezed_workspace(void)
     run("make \"ballast []");
     while (mem_free_atoms() > room / 10)
     {
-        if (run_string("repeat 100 [make \"ballast fput (random 100000) :ballast]").status
+        if (run_string("repeat 100 [make \"ballast fput word \"r random 100000 :ballast]").status
             == RESULT_ERROR)
             break;
     }
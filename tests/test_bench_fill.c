@@ -0,0 +1,242 @@
+//
+//  Pico Logo
+//  Copyright 2026 Blair Leduc. See LICENSE for details.
+//
+//  Flood fill benchmark and regression guard. Runs screen_gfx_fill
+//  (devices/picocalc/screen.c, compiled on the host against fake_lcd.c) and
+//  the pixel-at-a-time fill it replaced over the same canvases, and compares
+//  canvas accesses (loads and stores; a word counts once) per pixel filled --
+//  a count, not a time, so the guard does not move with the machine. Times
+//  are printed for the record; the host test build is unoptimised.
+//
+//  The old fill dropped spans once its 1024-entry stack was full, leaving
+//  the shape partly filled; its BENCH line says how many pixels it missed.
+//
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include "unity.h"
+#include "fake_lcd.h"
+#include "screen.h"
+
+#define WALL (12)
+
+// Canvas accesses per pixel filled by the new fill. Set at ~2x the measured
+// ratios, which are printed; the old fill's are printed beside them.
+#define BOUND_OPEN_ACCESSES     1.0     // measured 0.50 (old fill 2.00)
+#define BOUND_LATTICE_ACCESSES  9.0     // measured 4.43 (old fill 3.41)
+
+void setUp(void)
+{
+    screen_gfx_set_refresh_auto(false);
+    screen_gfx_set_boundary_mode(SCREEN_BOUNDARY_WRAP);
+    screen_set_mode(SCREEN_MODE_GFX);
+    screen_gfx_clear();
+    fake_lcd_reset();
+}
+
+void tearDown(void)
+{
+    screen_gfx_set_refresh_auto(true);
+    screen_set_mode(SCREEN_MODE_TXT);
+}
+
+static double now_us(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e6 + (double)ts.tv_nsec / 1e3;
+}
+
+//
+// The fill this replaced: a 1024-span stack, one pixel per compare, spans
+// dropped when the stack is full. Counts every canvas byte it reads.
+//
+
+typedef struct
+{
+    int16_t y, x_left, x_right;
+    int8_t dir;
+} LegacySpan;
+
+static uint32_t legacy_accesses;
+
+static uint32_t legacy_fill(uint8_t *canvas, int start_x, int start_y, uint8_t colour)
+{
+    static LegacySpan stack[1024];
+    int sp = 0;
+    uint32_t filled = 0;
+    legacy_accesses = 0;
+
+    #define READ(p) (legacy_accesses++, (p))
+    #define PUSH(Y, L, R, D) do { \
+        if (sp < 1024) { stack[sp].y = (int16_t)(Y); stack[sp].x_left = (int16_t)(L); \
+                         stack[sp].x_right = (int16_t)(R); stack[sp].dir = (int8_t)(D); sp++; } \
+    } while (0)
+
+    uint8_t *row = &canvas[start_y * SCREEN_WIDTH];
+    if (READ(row[start_x]) == colour)
+    {
+        return 0;
+    }
+    int left = start_x, right = start_x;
+    while (left > 0 && READ(row[left - 1]) != colour) left--;
+    while (right < SCREEN_WIDTH - 1 && READ(row[right + 1]) != colour) right++;
+    for (int i = left; i <= right; i++) row[i] = colour;
+    filled += (uint32_t)(right - left + 1);
+    legacy_accesses += (uint32_t)(right - left + 1);
+    if (start_y > 0) PUSH(start_y - 1, left, right, -1);
+    if (start_y < SCREEN_HEIGHT - 1) PUSH(start_y + 1, left, right, 1);
+
+    while (sp > 0)
+    {
+        LegacySpan s = stack[--sp];
+        row = &canvas[s.y * SCREEN_WIDTH];
+        int x = s.x_left;
+        while (x <= s.x_right)
+        {
+            while (x <= s.x_right && READ(row[x]) == colour) x++;
+            if (x > s.x_right) break;
+            int span_left = x;
+            while (span_left > 0 && READ(row[span_left - 1]) != colour) span_left--;
+            while (x < SCREEN_WIDTH && READ(row[x]) != colour) x++;
+            int span_right = x - 1;
+            for (int i = span_left; i <= span_right; i++) row[i] = colour;
+            filled += (uint32_t)(span_right - span_left + 1);
+            legacy_accesses += (uint32_t)(span_right - span_left + 1);
+            int next_y = s.y + s.dir;
+            if (next_y >= 0 && next_y < SCREEN_HEIGHT) PUSH(next_y, span_left, span_right, s.dir);
+            int prev_y = s.y - s.dir;
+            if (prev_y >= 0 && prev_y < SCREEN_HEIGHT)
+            {
+                if (span_left < s.x_left) PUSH(prev_y, span_left, s.x_left - 1, -s.dir);
+                if (span_right > s.x_right) PUSH(prev_y, s.x_right + 1, span_right, -s.dir);
+            }
+        }
+    }
+    #undef PUSH
+    #undef READ
+    return filled;
+}
+
+//
+// Canvases
+//
+
+static void canvas_open(uint8_t *canvas)
+{
+    (void)canvas;
+}
+
+// A ring: the fill is the disc inside it
+static void canvas_ring(uint8_t *canvas)
+{
+    for (int y = 0; y < SCREEN_HEIGHT; y++)
+    {
+        for (int x = 0; x < SCREEN_WIDTH; x++)
+        {
+            int dx = x - 160, dy = y - 160;
+            int d2 = dx * dx + dy * dy;
+            if (d2 >= 140 * 140 && d2 <= 142 * 142)
+            {
+                canvas[y * SCREEN_WIDTH + x] = WALL;
+            }
+        }
+    }
+}
+
+// Random walls, 30% of the pixels, clear where the fill starts
+static void canvas_noise(uint8_t *canvas)
+{
+    uint32_t seed = 99;
+    for (int i = 0; i < SCREEN_WIDTH * SCREEN_HEIGHT; i++)
+    {
+        seed = seed * 1103515245u + 12345u;
+        if ((seed >> 16) % 100 < 30)
+        {
+            canvas[i] = WALL;
+        }
+    }
+    canvas[160 * SCREEN_WIDTH + 160] = GFX_DEFAULT_BACKGROUND;
+}
+
+// A wall at every odd (x, y): the most spans pending at once
+static void canvas_lattice(uint8_t *canvas)
+{
+    for (int y = 1; y < SCREEN_HEIGHT; y += 2)
+    {
+        for (int x = 1; x < SCREEN_WIDTH; x += 2)
+        {
+            canvas[y * SCREEN_WIDTH + x] = WALL;
+        }
+    }
+}
+
+static void bench_canvas(const char *name, void (*draw)(uint8_t *), double bound)
+{
+    static uint8_t original[SCREEN_WIDTH * SCREEN_HEIGHT];
+    uint8_t *canvas = screen_gfx_frame();
+
+    screen_gfx_clear();
+    draw(canvas);
+    memcpy(original, canvas, sizeof(original));
+
+    double t0 = now_us();
+    uint32_t legacy_filled = legacy_fill(canvas, 160, 160, WALL);
+    double legacy_us = now_us() - t0;
+
+    memcpy(canvas, original, sizeof(original));
+    t0 = now_us();
+    screen_gfx_fill(160.0f, 160.0f, WALL);
+    double fill_us = now_us() - t0;
+    ScreenFillStats stats;
+    screen_gfx_fill_stats(&stats);
+
+    double ratio = (double)stats.accesses / (double)stats.pixels_filled;
+    printf("BENCH fill.%-8s new %6u px %5.2f acc/px %s %3u sweeps %6.0f us | "
+           "old %6u px %5.2f acc/px %6.0f us, missed %u\n",
+           name, stats.pixels_filled, ratio, stats.marker ? "marker" : "direct",
+           stats.sweeps, fill_us, legacy_filled,
+           (double)legacy_accesses / (double)legacy_filled, legacy_us,
+           stats.pixels_filled - legacy_filled);
+
+    // The old fill never finds more than the new one
+    TEST_ASSERT_TRUE(legacy_filled <= stats.pixels_filled);
+    if (bound > 0.0)
+    {
+        TEST_ASSERT_TRUE_MESSAGE(ratio < bound, "fill makes too many canvas accesses per pixel");
+    }
+}
+
+void test_bench_fill_open_screen(void)
+{
+    bench_canvas("open", canvas_open, BOUND_OPEN_ACCESSES);
+}
+
+void test_bench_fill_ring(void)
+{
+    bench_canvas("ring", canvas_ring, BOUND_OPEN_ACCESSES);
+}
+
+// Reported only: its ratio is dominated by where the noise happens to fall
+void test_bench_fill_noise(void)
+{
+    bench_canvas("noise", canvas_noise, 0.0);
+}
+
+void test_bench_fill_lattice(void)
+{
+    bench_canvas("lattice", canvas_lattice, BOUND_LATTICE_ACCESSES);
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_bench_fill_open_screen);
+    RUN_TEST(test_bench_fill_ring);
+    RUN_TEST(test_bench_fill_noise);
+    RUN_TEST(test_bench_fill_lattice);
+    return UNITY_END();
+}
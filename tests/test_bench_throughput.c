@@ -20,10 +20,14 @@
 #include "test_scaffold.h"
 #include "core/repl.h"
 #include "core/error.h"
+#include "core/limits.h"
+#include "core/token_source.h"
+#include "devices/present_queue.h"
 #include <stdarg.h>
 #include <stdio.h>
 #include <string.h>
 #include <time.h>
+#include <unistd.h>
 
 #ifndef TRAILS_SOURCE
 #error "TRAILS_SOURCE must be defined"
@@ -48,6 +52,7 @@
 #define BOUND_CHECKRUN_FRAME_X_CAL 1.8e6   // M2 baseline x587k
 #define BOUND_GALAXIAN_FRAME_X_CAL 2.0e5   // baseline x66k (2026-08-06)
 #define BOUND_INVADERS_FRAME_X_CAL 1.3e5   // baseline x41k (2026-08-06)
+#define BOUND_PRESENT_OVERLAP      0.8     // queued / synchronous; 0.5 is full overlap
 
 void setUp(void)
 {
@@ -251,6 +256,25 @@ static double frame_storage_cells(int frames)
     return (double)(before.value.as.number - after.value.as.number) / frames;
 }
 
+// Share of the body lines a frame runs that run from compiled ops rather
+// than walking their lists, and how many lines a frame evicts from the code
+// arena, which is what recompiles. They are what a board-sized arena
+// (LOGO_CODE_OPS) is measured by: the host and tests presets build one
+// every shipped frame fits in.
+static double frame_compiled_share(int frames, double *evicted)
+{
+    uint32_t compiled, walked, evicted_before;
+    uint32_t compiled_after, walked_after, evicted_after;
+    token_source_code_stats(&compiled, &walked, &evicted_before);
+    char code[64];
+    snprintf(code, sizeof(code), "repeat %d [play.frame]", frames);
+    time_code_ms(code);
+    token_source_code_stats(&compiled_after, &walked_after, &evicted_after);
+    *evicted = (double)(evicted_after - evicted_before) / frames;
+    double runs = (double)(compiled_after - compiled) + (double)(walked_after - walked);
+    return runs > 0 ? 100.0 * (compiled_after - compiled) / runs : 0.0;
+}
+
 // Time `frames` play.frames after `setup` and report ms per frame.
 static double time_game_frames_ms(const char *setup, int frames)
 {
@@ -274,6 +298,10 @@ void test_bench_trails_play_frame(void)
 
     bench_line("BENCH trails.frame     %8.3f ms/frame  x%.1fk cal\n",
            ms, ms * 1e6 / cal / 1e3);
+    double evicted;
+    double share = frame_compiled_share(100, &evicted);
+    bench_line("BENCH trails.code      %3.0f%% of lines compiled, %.1f evicted/frame (%d ops, %d runs)\n",
+           share, evicted, LOGO_CODE_OPS, LOGO_CODE_RUNS);
     TEST_ASSERT_TRUE_MESSAGE(ms * 1e6 / cal < BOUND_TRAILS_FRAME_X_CAL,
                              "Turtle Trails play.frame regressed vs calibration");
 
@@ -303,6 +331,10 @@ void test_bench_galaxian_play_frame(void)
 
     bench_line("BENCH galaxian.frame   %8.3f ms/frame  x%.1fk cal  %.2f cells/frame\n",
            ms, ms * 1e6 / cal / 1e3, frame_storage_cells(200));
+    double evicted;
+    double share = frame_compiled_share(50, &evicted);
+    bench_line("BENCH galaxian.code    %3.0f%% of lines compiled, %.1f evicted/frame\n",
+           share, evicted);
     TEST_ASSERT_TRUE_MESSAGE(ms * 1e6 / cal < BOUND_GALAXIAN_FRAME_X_CAL,
                              "Galaxian play.frame regressed vs calibration");
 }
@@ -317,6 +349,10 @@ void test_bench_invaders_play_frame(void)
 
     bench_line("BENCH invaders.frame   %8.3f ms/frame  x%.1fk cal  %.2f cells/frame\n",
            ms, ms * 1e6 / cal / 1e3, frame_storage_cells(200));
+    double evicted;
+    double share = frame_compiled_share(50, &evicted);
+    bench_line("BENCH invaders.code    %3.0f%% of lines compiled, %.1f evicted/frame\n",
+           share, evicted);
     TEST_ASSERT_TRUE_MESSAGE(ms * 1e6 / cal < BOUND_INVADERS_FRAME_X_CAL,
                              "Space Invaders play.frame regressed vs calibration");
 }
@@ -333,9 +369,13 @@ void test_bench_expr_shapes(void)
         "[]", "[ignore 1]", "[ignore :x]", "[ignore sum 1 1]",
         "[ignore (1 + 1)]", "[ignore (:x + :x)]", "[ignore (sum 1 1)]",
         "[make \"x 1]", "[make \"x (:x + 1)]", "[make \"x :x + 1]",
+        "[make \"p list :x / 3 :x]", "[ignore (first :p) + (last :p)]",
+        "[ignore bench.p4 1 2 3 4]", "[ignore bench.p8 1 2 3 4 5 6 7 8]",
     };
     const int iters = 200000;
     run_string("make \"x 1");
+    proc_define_from_text("to bench.p4 :a :b :c :d\noutput :d + :c + :d + :b\nend");
+    proc_define_from_text("to bench.p8 :left :right :top :bottom :speed :heading :colour :sprite\nlocal \"tmp make \"tmp 1\noutput :sprite + :colour + :heading + :sprite\nend");
 
     double bare = 0, paren = 0, bare_make = 0;
     for (unsigned i = 0; i < sizeof(shape) / sizeof(*shape); i++)
@@ -378,6 +418,74 @@ void test_p10m0_script_runs(void)
     TEST_ASSERT_NOT_NULL_MESSAGE(strstr(output_buffer, "full ws"), output_buffer);
 }
 
+//==========================================================================
+// Present overlap: a frame's body against a fake consumer's spin
+//==========================================================================
+
+// A fake consumer, not the LCD send: it spins as long as a frame body, the
+// case where the overlap pays most (a full-screen send on the board is
+// ~21 ms, the same order as a game frame). What this times is the queue's
+// handshake and the host thread's overlap, not the board's SPI or core 1.
+static double present_send_ms;
+
+static void present_spin(void *frame, void *context)
+{
+    (void)frame;
+    (void)context;
+    double until = now_ms() + present_send_ms;
+    while (now_ms() < until)
+    {
+    }
+}
+
+// Space Invaders' frames presented synchronously (body + spin) and through
+// the present queue on the host's consumer thread (max(body, spin)). A
+// "frame" here is ten play.frames, so a body is long against a thread's
+// wake-up. The ratio is the record; the guard needs a second CPU to
+// overlap onto.
+#define PRESENT_BODY "repeat 10 [play.frame]"
+
+void test_bench_present_overlap(void)
+{
+    const int n = 20;
+    load_game(INVADERS_SOURCE);
+    time_game_frames_ms(
+        "init.game make \"score 0 make \"lives 3 make \"level 1 setup.level "
+        "setrefresh \"manual", 10);
+    present_send_ms = time_code_ms(PRESENT_BODY);
+
+    double t0 = now_ms();
+    for (int i = 0; i < n; i++)
+    {
+        run_string(PRESENT_BODY);
+        present_spin(NULL, NULL);
+    }
+    double sync_ms = (now_ms() - t0) / n;
+
+    static int frame_buffers[2];
+    void *buffers[2] = { &frame_buffers[0], &frame_buffers[1] };
+    PresentQueue *q = present_queue_start(buffers, present_spin, NULL);
+    TEST_ASSERT_NOT_NULL(q);
+    t0 = now_ms();
+    for (int i = 0; i < n; i++)
+    {
+        run_string(PRESENT_BODY);
+        present_queue_submit(q);
+    }
+    present_queue_wait_idle(q);
+    double queued_ms = (now_ms() - t0) / n;
+    present_queue_stop(q);
+
+    bench_line("BENCH present.overlap  %8.3f ms/frame queued, %.3f synchronous (x%.2f), fake spin consumer %.3f\n",
+           queued_ms, sync_ms, queued_ms / sync_ms, present_send_ms);
+    if (sysconf(_SC_NPROCESSORS_ONLN) < 2)
+    {
+        TEST_IGNORE_MESSAGE("one CPU: nothing for the send to overlap with");
+    }
+    TEST_ASSERT_TRUE_MESSAGE(queued_ms / sync_ms < BOUND_PRESENT_OVERLAP,
+                             "queued presents did not overlap the frame body");
+}
+
 int main(void)
 {
     // One file per run, not an ever-growing log: the last run is the record.
@@ -393,6 +501,7 @@ int main(void)
     RUN_TEST(test_bench_trails_play_frame);
     RUN_TEST(test_bench_galaxian_play_frame);
     RUN_TEST(test_bench_invaders_play_frame);
+    RUN_TEST(test_bench_present_overlap);
     RUN_TEST(test_p10m0_script_runs);
     return UNITY_END();
 }
@@ -399,6 +399,443 @@ static void test_multi_cluster_seek_and_overwrite(void)
     free(payload);
 }
 
+//
+// Cluster cursor: a file remembers the cluster it last used, and FAT sectors
+// are cached, so reading a 1 MB file (2,048 one-sector clusters) through in
+// 512 B calls reads each data sector once and each FAT sector about once,
+// where walking the chain from the start on every call read ~2 million.
+//
+
+static uint8_t cursor_byte(uint32_t i)
+{
+    return (uint8_t)((i * 7u) ^ (i >> 9));
+}
+
+static void test_sequential_read_steps_the_chain_once(void)
+{
+    TEST_ASSERT_EQUAL_INT(FAT32_OK, fat32_mount());
+
+    enum { N = 1024 * 1024, CHUNK = 4096 };
+    uint8_t buf[CHUNK];
+    fat32_file_t f;
+    size_t n;
+    TEST_ASSERT_EQUAL_INT(FAT32_OK, fat32_create(&f, "mega.bin"));
+    for (uint32_t at = 0; at < N; at += CHUNK)
+    {
+        for (uint32_t i = 0; i < CHUNK; i++) buf[i] = cursor_byte(at + i);
+        TEST_ASSERT_EQUAL_INT(FAT32_OK, fat32_write(&f, buf, CHUNK, &n));
+        TEST_ASSERT_EQUAL_UINT(CHUNK, n);
+    }
+    fat32_close(&f);
+
+    TEST_ASSERT_EQUAL_INT(FAT32_OK, fat32_open(&f, "mega.bin"));
+    mock_sd_reset_stats();
+    for (uint32_t at = 0; at < N; at += FAT32_SECTOR_SIZE)
+    {
+        TEST_ASSERT_EQUAL_INT(FAT32_OK, fat32_read(&f, buf, FAT32_SECTOR_SIZE, &n));
+        TEST_ASSERT_EQUAL_UINT(FAT32_SECTOR_SIZE, n);
+        TEST_ASSERT_EQUAL_HEX8(cursor_byte(at), buf[0]);
+        TEST_ASSERT_EQUAL_HEX8(cursor_byte(at + 511), buf[511]);
+    }
+    uint32_t data_sectors = N / FAT32_SECTOR_SIZE;
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(data_sectors + data_sectors / 128 + 2,
+                                     mock_sd_read_count());
+    fat32_close(&f);
+}
+
+static void test_random_read_walks_from_the_cursor(void)
+{
+    TEST_ASSERT_EQUAL_INT(FAT32_OK, fat32_mount());
+
+    enum { N = 64 * 1024 };
+    uint8_t *payload = (uint8_t *)malloc(N);
+    TEST_ASSERT_NOT_NULL(payload);
+    for (uint32_t i = 0; i < N; i++) payload[i] = cursor_byte(i);
+    fat32_file_t f;
+    size_t n;
+    TEST_ASSERT_EQUAL_INT(FAT32_OK, fat32_create(&f, "rand.bin"));
+    TEST_ASSERT_EQUAL_INT(FAT32_OK, fat32_write(&f, payload, N, &n));
+    fat32_close(&f);
+    free(payload);
+
+    // One byte at a time, as picocalc_file_read_char does: seek, then read.
+    // Forward steps within a cluster cost the data sector alone.
+    TEST_ASSERT_EQUAL_INT(FAT32_OK, fat32_open(&f, "rand.bin"));
+    uint8_t c;
+    TEST_ASSERT_EQUAL_INT(FAT32_OK, fat32_seek(&f, 40000));
+    TEST_ASSERT_EQUAL_INT(FAT32_OK, fat32_read(&f, &c, 1, &n));
+    TEST_ASSERT_EQUAL_HEX8(cursor_byte(40000), c);
+    mock_sd_reset_stats();
+    for (uint32_t at = 40001; at < 40100; at++)
+    {
+        TEST_ASSERT_EQUAL_INT(FAT32_OK, fat32_seek(&f, at));
+        TEST_ASSERT_EQUAL_INT(FAT32_OK, fat32_read(&f, &c, 1, &n));
+        TEST_ASSERT_EQUAL_HEX8(cursor_byte(at), c);
+    }
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(99 + 1, mock_sd_read_count());
+
+    // Going back walks from the first cluster, a FAT sector per 128 clusters.
+    TEST_ASSERT_EQUAL_INT(FAT32_OK, fat32_seek(&f, 100));
+    TEST_ASSERT_EQUAL_INT(FAT32_OK, fat32_read(&f, &c, 1, &n));
+    TEST_ASSERT_EQUAL_HEX8(cursor_byte(100), c);
+    TEST_ASSERT_EQUAL_INT(FAT32_OK, fat32_seek(&f, N - 1));
+    TEST_ASSERT_EQUAL_INT(FAT32_OK, fat32_read(&f, &c, 1, &n));
+    TEST_ASSERT_EQUAL_HEX8(cursor_byte(N - 1), c);
+    fat32_close(&f);
+}
+
+//
+// Sector cache: lookups that hit, writes held until close, read-ahead and
+// write runs as multi-block transfers.  Clusters of 8 sectors give the
+// read-ahead room; the image stays sparse.
+//
+
+static void write_cursor_file(const char *name, uint32_t size)
+{
+    uint8_t *payload = (uint8_t *)malloc(size);
+    TEST_ASSERT_NOT_NULL(payload);
+    for (uint32_t i = 0; i < size; i++) payload[i] = cursor_byte(i);
+    fat32_file_t f;
+    size_t n;
+    TEST_ASSERT_EQUAL_INT(FAT32_OK, fat32_create(&f, name));
+    TEST_ASSERT_EQUAL_INT(FAT32_OK, fat32_write(&f, payload, size, &n));
+    TEST_ASSERT_EQUAL_INT(FAT32_OK, fat32_close(&f));
+    free(payload);
+}
+
+static void test_cache_serves_a_reread_from_memory(void)
+{
+    TEST_ASSERT_EQUAL_INT(FAT32_OK, fat32_mount());
+    write_cursor_file("twice.bin", 1024);
+
+    fat32_file_t f;
+    size_t n;
+    uint8_t buf[1024];
+    TEST_ASSERT_EQUAL_INT(FAT32_OK, fat32_open(&f, "twice.bin"));
+    TEST_ASSERT_EQUAL_INT(FAT32_OK, fat32_read(&f, buf, sizeof(buf), &n));
+
+    fat32_cache_stats_t before, after;
+    fat32_get_cache_stats(&before);
+    mock_sd_reset_stats();
+    TEST_ASSERT_EQUAL_INT(FAT32_OK, fat32_seek(&f, 0));
+    TEST_ASSERT_EQUAL_INT(FAT32_OK, fat32_read(&f, buf, sizeof(buf), &n));
+    fat32_get_cache_stats(&after);
+
+    TEST_ASSERT_EQUAL_UINT32(0, mock_sd_read_count());
+    TEST_ASSERT_EQUAL_UINT32(before.misses, after.misses);
+    TEST_ASSERT_TRUE(after.hits > before.hits);
+    TEST_ASSERT_EQUAL_HEX8(cursor_byte(1023), buf[1023]);
+    fat32_close(&f);
+}
+
+static void test_writes_stay_cached_until_close(void)
+{
+    TEST_ASSERT_EQUAL_INT(FAT32_OK, fat32_mount());
+
+    fat32_file_t f;
+    size_t n;
+    TEST_ASSERT_EQUAL_INT(FAT32_OK, fat32_create(&f, "held.txt"));
+    mock_sd_reset_stats();
+    for (int i = 0; i < 100; i++)
+    {
+        TEST_ASSERT_EQUAL_INT(FAT32_OK, fat32_write(&f, "ab", 2, &n));
+    }
+    TEST_ASSERT_EQUAL_UINT32(0, mock_sd_write_count());
+
+    // The data sector, its FAT entry in both FATs, the directory entry and
+    // FSInfo, once each
+    TEST_ASSERT_EQUAL_INT(FAT32_OK, fat32_close(&f));
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(5, mock_sd_write_count());
+
+    fat32_unmount();
+    TEST_ASSERT_EQUAL_INT(FAT32_OK, fat32_open(&f, "held.txt"));
+    TEST_ASSERT_EQUAL_UINT32(200, fat32_size(&f));
+    char buf[200];
+    TEST_ASSERT_EQUAL_INT(FAT32_OK, fat32_read(&f, buf, sizeof(buf), &n));
+    TEST_ASSERT_EQUAL_UINT(200, n);
+    TEST_ASSERT_EQUAL_MEMORY("abab", buf + 196, 4);
+    fat32_close(&f);
+}
+
+static void test_flush_writes_without_closing(void)
+{
+    TEST_ASSERT_EQUAL_INT(FAT32_OK, fat32_mount());
+
+    fat32_file_t f;
+    size_t n;
+    TEST_ASSERT_EQUAL_INT(FAT32_OK, fat32_create(&f, "open.txt"));
+    TEST_ASSERT_EQUAL_INT(FAT32_OK, fat32_write(&f, "kept", 4, &n));
+    TEST_ASSERT_EQUAL_INT(FAT32_OK, fat32_flush());
+    TEST_ASSERT_EQUAL_INT(FAT32_OK, fat32_write(&f, "lost", 4, &n));
+
+    // The card is pulled: only what was flushed survives, and what was not
+    // is dropped, not left for the next card
+    fat32_cache_stats_t before, after;
+    fat32_get_cache_stats(&before);
+    mock_sd_reset_stats();
+    mock_sd_set_present(false);
+    fat32_unmount();
+    fat32_get_cache_stats(&after);
+    TEST_ASSERT_GREATER_THAN_UINT32(before.sectors_dropped, after.sectors_dropped);
+    mock_sd_set_present(true);
+    TEST_ASSERT_EQUAL_INT(FAT32_OK, fat32_flush());
+    TEST_ASSERT_EQUAL_UINT32(0, mock_sd_write_count());
+
+    fat32_file_t g;
+    char buf[8];
+    TEST_ASSERT_EQUAL_INT(FAT32_OK, fat32_open(&g, "open.txt"));
+    TEST_ASSERT_EQUAL_UINT32(4, fat32_size(&g));
+    TEST_ASSERT_EQUAL_INT(FAT32_OK, fat32_read(&g, buf, sizeof(buf), &n));
+    TEST_ASSERT_EQUAL_MEMORY("kept", buf, 4);
+    fat32_close(&g);
+}
+
+static void test_unmount_writes_back_while_the_card_is_in(void)
+{
+    TEST_ASSERT_EQUAL_INT(FAT32_OK, fat32_mount());
+
+    fat32_file_t f;
+    size_t n;
+    TEST_ASSERT_EQUAL_INT(FAT32_OK, fat32_create(&f, "late.txt"));
+    TEST_ASSERT_EQUAL_INT(FAT32_OK, fat32_write(&f, "late", 4, &n));
+    TEST_ASSERT_EQUAL_INT(FAT32_OK, fat32_close(&f));
+    TEST_ASSERT_EQUAL_INT(FAT32_OK, fat32_open(&f, "late.txt"));
+    TEST_ASSERT_EQUAL_INT(FAT32_OK, fat32_write(&f, "L", 1, &n));
+
+    fat32_cache_stats_t before, after;
+    fat32_get_cache_stats(&before);
+    mock_sd_reset_stats();
+    fat32_unmount();
+    fat32_get_cache_stats(&after);
+    TEST_ASSERT_GREATER_THAN_UINT32(0, mock_sd_write_count());
+    TEST_ASSERT_EQUAL_UINT32(before.sectors_dropped, after.sectors_dropped);
+
+    char buf[4];
+    TEST_ASSERT_EQUAL_INT(FAT32_OK, fat32_open(&f, "late.txt"));
+    TEST_ASSERT_EQUAL_INT(FAT32_OK, fat32_read(&f, buf, sizeof(buf), &n));
+    TEST_ASSERT_EQUAL_MEMORY("Late", buf, 4);
+    fat32_close(&f);
+}
+
+// Read `name` 512 B at a time from a fresh mount; returns the read commands
+static uint32_t read_cursor_file_by_sector(const char *name, uint32_t size)
+{
+    fat32_unmount();
+    TEST_ASSERT_EQUAL_INT(FAT32_OK, fat32_mount());
+    fat32_file_t f;
+    size_t n;
+    uint8_t buf[FAT32_SECTOR_SIZE];
+    TEST_ASSERT_EQUAL_INT(FAT32_OK, fat32_open(&f, name));
+    mock_sd_reset_stats();
+    for (uint32_t at = 0; at < size; at += FAT32_SECTOR_SIZE)
+    {
+        TEST_ASSERT_EQUAL_INT(FAT32_OK, fat32_read(&f, buf, sizeof(buf), &n));
+        TEST_ASSERT_EQUAL_UINT(FAT32_SECTOR_SIZE, n);
+        TEST_ASSERT_EQUAL_HEX8(cursor_byte(at), buf[0]);
+        TEST_ASSERT_EQUAL_HEX8(cursor_byte(at + 511), buf[511]);
+    }
+    fat32_close(&f);
+    return mock_sd_read_commands();
+}
+
+static void test_sequential_read_reads_ahead(void)
+{
+    fat32_image_format_superfloppy(65525, 8);
+    fat32_unmount();
+    TEST_ASSERT_EQUAL_INT(FAT32_OK, fat32_mount());
+    enum { N = 32 * 1024 };
+    write_cursor_file("stream.bin", N);
+
+    // 64 data sectors: once the first is cached the rest come 4 at a time
+    // (half the 8 slots), with the FAT and directory sectors between
+    uint32_t commands = read_cursor_file_by_sector("stream.bin", N);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(N / FAT32_SECTOR_SIZE / 2, commands);
+    // The last read-ahead may run past the end of the file
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(N / FAT32_SECTOR_SIZE + FAT32_CACHE_SECTORS,
+                                     mock_sd_read_count());
+}
+
+static void test_larger_cache_reads_further_ahead(void)
+{
+    fat32_image_format_superfloppy(65525, 8);
+    fat32_unmount();
+    uint8_t *memory = (uint8_t *)malloc(FAT32_CACHE_SECTORS_PSRAM * FAT32_SECTOR_SIZE);
+    TEST_ASSERT_NOT_NULL(memory);
+    fat32_set_cache_memory(memory, FAT32_CACHE_SECTORS_PSRAM);
+
+    TEST_ASSERT_EQUAL_INT(FAT32_OK, fat32_mount());
+    enum { N = 32 * 1024 };
+    write_cursor_file("wide.bin", N);
+    uint32_t commands = read_cursor_file_by_sector("wide.bin", N);
+
+    fat32_set_cache_memory(NULL, 0);
+    free(memory);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(N / FAT32_SECTOR_SIZE / 4, commands);
+}
+
+static void test_sequential_write_goes_out_in_runs(void)
+{
+    fat32_image_format_superfloppy(65525, 8);
+    fat32_unmount();
+    TEST_ASSERT_EQUAL_INT(FAT32_OK, fat32_mount());
+
+    enum { N = 32 * 1024 };
+    mock_sd_reset_stats();
+    write_cursor_file("runs.bin", N);
+
+    // Sectors the write covers are not zeroed first, so each goes out once
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(N / FAT32_SECTOR_SIZE + 8, mock_sd_write_count());
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(mock_sd_write_count() / 2, mock_sd_write_commands());
+
+    fat32_unmount();
+    fat32_file_t f;
+    size_t n;
+    uint8_t buf[N];
+    TEST_ASSERT_EQUAL_INT(FAT32_OK, fat32_open(&f, "runs.bin"));
+    TEST_ASSERT_EQUAL_INT(FAT32_OK, fat32_read(&f, buf, sizeof(buf), &n));
+    TEST_ASSERT_EQUAL_UINT(N, n);
+    for (uint32_t i = 0; i < N; i++)
+    {
+        TEST_ASSERT_EQUAL_HEX8(cursor_byte(i), buf[i]);
+    }
+    fat32_close(&f);
+}
+
+//
+// Free-cluster map: a search skips groups of FAT sectors known to be full,
+// the FSInfo hint moves past each allocation, and a multi-cluster write
+// takes a run of free clusters.  FSInfo lives in sector 1; FAT0 starts at
+// sector 32 with 128 entries a sector.
+//
+
+static void poke_fsinfo(uint32_t free_count, uint32_t next_free)
+{
+    fat32_fsinfo_t *fsi = (fat32_fsinfo_t *)mock_sd_block_ptr(1);
+    TEST_ASSERT_NOT_NULL(fsi);
+    fsi->free_count = free_count;
+    fsi->next_free = next_free;
+}
+
+// Mark clusters [2, end) used in FAT0, a whole sector at a time
+static void fill_fat_to(uint32_t end)
+{
+    for (uint32_t sector = 0; sector * 128 < end; sector++)
+    {
+        uint32_t *entries = (uint32_t *)mock_sd_block_ptr(32 + sector);
+        for (uint32_t i = 0; i < 128 && sector * 128 + i < end; i++)
+        {
+            if (sector * 128 + i >= 2) entries[i] = 0x0FFFFFFF;
+        }
+    }
+}
+
+static void test_allocation_on_a_nearly_full_volume_scans_once(void)
+{
+    enum { USED = 60000, WRITES = 200 };
+    fill_fat_to(USED);
+    poke_fsinfo(0xFFFFFFFF, 2);
+    TEST_ASSERT_EQUAL_INT(FAT32_OK, fat32_mount());
+
+    // One write per cluster, each allocating, as a program saving a
+    // picture does.  Searching from the hint each time read every full
+    // FAT sector again for every cluster.
+    fat32_file_t f;
+    size_t n;
+    uint8_t buf[FAT32_SECTOR_SIZE];
+    memset(buf, 0x3C, sizeof(buf));
+    TEST_ASSERT_EQUAL_INT(FAT32_OK, fat32_create(&f, "late.bin"));
+    mock_sd_reset_stats();
+    for (int i = 0; i < WRITES; i++)
+    {
+        TEST_ASSERT_EQUAL_INT(FAT32_OK, fat32_write(&f, buf, sizeof(buf), &n));
+    }
+    TEST_ASSERT_EQUAL_INT(FAT32_OK, fat32_close(&f));
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(USED / 128 + WRITES / 8, mock_sd_read_count());
+
+    uint64_t free_bytes = 0;
+    TEST_ASSERT_EQUAL_INT(FAT32_OK, fat32_get_free_space(&free_bytes));
+    TEST_ASSERT_EQUAL_UINT64((uint64_t)(65525 + 2 - USED - WRITES) * 512, free_bytes);
+}
+
+static void test_full_volume_is_known_full_from_the_map(void)
+{
+    fill_fat_to(65525 + 2);
+    poke_fsinfo(0xFFFFFFFF, 0xFFFFFFFF);
+    TEST_ASSERT_EQUAL_INT(FAT32_OK, fat32_mount());
+
+    fat32_file_t f;
+    size_t n;
+    TEST_ASSERT_EQUAL_INT(FAT32_OK, fat32_create(&f, "none.bin"));
+    TEST_ASSERT_EQUAL_INT(FAT32_ERROR_DISK_FULL, fat32_write(&f, "x", 1, &n));
+
+    // The first search found every group full; the next reads nothing
+    mock_sd_reset_stats();
+    TEST_ASSERT_EQUAL_INT(FAT32_ERROR_DISK_FULL, fat32_write(&f, "x", 1, &n));
+    TEST_ASSERT_EQUAL_UINT32(0, mock_sd_read_count());
+    fat32_close(&f);
+
+    uint64_t free_bytes = 1;
+    TEST_ASSERT_EQUAL_INT(FAT32_OK, fat32_get_free_space(&free_bytes));
+    TEST_ASSERT_EQUAL_UINT64(0, free_bytes);
+}
+
+static void test_freed_cluster_is_found_again(void)
+{
+    TEST_ASSERT_EQUAL_INT(FAT32_OK, fat32_mount());
+    write_cursor_file("gone.bin", 1024);
+    fat32_file_t f;
+    TEST_ASSERT_EQUAL_INT(FAT32_OK, fat32_open(&f, "gone.bin"));
+    uint32_t first = f.start_cluster;
+    fat32_close(&f);
+
+    // Fill the rest, so the only free clusters are the ones deleted
+    fat32_unmount();
+    fill_fat_to(65525 + 2);
+    uint32_t *entries = (uint32_t *)mock_sd_block_ptr(32 + first / 128);
+    entries[first % 128] = 0x0FFFFFFF;  // gone.bin's two clusters, still linked
+    entries[(first + 1) % 128] = 0x0FFFFFFF;
+    poke_fsinfo(0xFFFFFFFF, 0xFFFFFFFF);
+    TEST_ASSERT_EQUAL_INT(FAT32_OK, fat32_mount());
+
+    size_t n;
+    TEST_ASSERT_EQUAL_INT(FAT32_OK, fat32_create(&f, "full.bin"));
+    TEST_ASSERT_EQUAL_INT(FAT32_ERROR_DISK_FULL, fat32_write(&f, "x", 1, &n));
+    fat32_close(&f);
+
+    // Deleting sets the group's bit again
+    TEST_ASSERT_EQUAL_INT(FAT32_OK, fat32_delete("gone.bin"));
+    TEST_ASSERT_EQUAL_INT(FAT32_OK, fat32_open(&f, "full.bin"));
+    TEST_ASSERT_EQUAL_INT(FAT32_OK, fat32_write(&f, "x", 1, &n));
+    TEST_ASSERT_EQUAL_UINT32(first, f.start_cluster);
+    fat32_close(&f);
+}
+
+static void test_multi_cluster_write_takes_a_run(void)
+{
+    TEST_ASSERT_EQUAL_INT(FAT32_OK, fat32_mount());
+
+    // A two-cluster hole at the hint, which a cluster-at-a-time allocator
+    // would fill first and then jump past "b.bin"
+    write_cursor_file("a.bin", 1024);
+    write_cursor_file("b.bin", 1024);
+    TEST_ASSERT_EQUAL_INT(FAT32_OK, fat32_delete("a.bin"));
+
+    enum { N = 8 * 1024 };
+    write_cursor_file("c.bin", N);
+    fat32_file_t f;
+    TEST_ASSERT_EQUAL_INT(FAT32_OK, fat32_open(&f, "c.bin"));
+    uint32_t cluster = f.start_cluster;
+    fat32_close(&f);
+
+    for (uint32_t i = 1; i < N / FAT32_SECTOR_SIZE; i++)
+    {
+        const uint32_t *entries = (const uint32_t *)mock_sd_block_ptr(32 + cluster / 128);
+        uint32_t next = entries[cluster % 128] & 0x0FFFFFFF;
+        TEST_ASSERT_EQUAL_UINT32(cluster + 1, next);
+        cluster = next;
+    }
+}
+
 //
 // Directory growth: a 1-sector root cluster holds 16 32-byte slots.  Each
 // LFN-bearing file consumes 3-4 slots, so creating ~10 files forces the
@@ -641,6 +1078,19 @@ int main(void)
     RUN_TEST(test_volume_label_preserved);
     RUN_TEST(test_multi_cluster_file_roundtrip);
     RUN_TEST(test_multi_cluster_seek_and_overwrite);
+    RUN_TEST(test_sequential_read_steps_the_chain_once);
+    RUN_TEST(test_random_read_walks_from_the_cursor);
+    RUN_TEST(test_cache_serves_a_reread_from_memory);
+    RUN_TEST(test_writes_stay_cached_until_close);
+    RUN_TEST(test_flush_writes_without_closing);
+    RUN_TEST(test_unmount_writes_back_while_the_card_is_in);
+    RUN_TEST(test_sequential_read_reads_ahead);
+    RUN_TEST(test_larger_cache_reads_further_ahead);
+    RUN_TEST(test_sequential_write_goes_out_in_runs);
+    RUN_TEST(test_allocation_on_a_nearly_full_volume_scans_once);
+    RUN_TEST(test_full_volume_is_known_full_from_the_map);
+    RUN_TEST(test_freed_cluster_is_found_again);
+    RUN_TEST(test_multi_cluster_write_takes_a_run);
     RUN_TEST(test_directory_grows_across_clusters);
     RUN_TEST(test_delete_releases_chain);
     RUN_TEST(test_fsinfo_free_count_tracks_alloc_free);
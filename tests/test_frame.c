@@ -321,6 +321,35 @@ void test_find_binding_in_chain(void)
     TEST_ASSERT_TRUE(frame_current(&stack) != found_frame);
 }
 
+void test_param_at_reads_the_slot_that_binds_the_name(void)
+{
+    test_proc.distinct_params = true;
+    Value args[3] = {value_number(10), value_number(20), value_number(30)};
+    frame_push(&stack, &test_proc, args, 3);
+    FrameHeader *frame = frame_current(&stack);
+
+    Binding *binding = frame_param_at(frame, 1, test_param_names[1]);
+    TEST_ASSERT_NOT_NULL(binding);
+    TEST_ASSERT_EQUAL_FLOAT(20.0f, binding->value.as.number);
+    TEST_ASSERT_EQUAL(1, frame_param_slot(frame, binding));
+
+    TEST_ASSERT_NULL(frame_param_at(frame, 0, test_param_names[1]));  // other name
+    TEST_ASSERT_NULL(frame_param_at(frame, 3, test_param_names[1]));  // past the inputs
+    TEST_ASSERT_NULL(frame_param_at(frame, -1, test_param_names[1]));
+
+    // A local is never a slot.
+    frame_add_local(&stack, "w", value_number(1));
+    TEST_ASSERT_EQUAL(-1, frame_param_slot(frame, frame_find_binding(frame, "w")));
+}
+
+void test_param_at_refuses_repeated_inputs(void)
+{
+    test_proc.distinct_params = false;
+    Value args[3] = {value_number(10), value_number(20), value_number(30)};
+    frame_push(&stack, &test_proc, args, 3);
+    TEST_ASSERT_NULL(frame_param_at(frame_current(&stack), 1, test_param_names[1]));
+}
+
 void test_set_binding(void)
 {
     Value args[3] = {value_number(10), value_number(20), value_number(30)};
@@ -956,6 +985,8 @@ int main(void)
     RUN_TEST(test_find_binding_case_insensitive);
     RUN_TEST(test_find_binding_not_found);
     RUN_TEST(test_find_binding_in_chain);
+    RUN_TEST(test_param_at_reads_the_slot_that_binds_the_name);
+    RUN_TEST(test_param_at_refuses_repeated_inputs);
     RUN_TEST(test_set_binding);
 
     // Local variable tests
@@ -80,6 +80,7 @@ void screensaver_init(void) {}
 void screensaver_update(void) {}
 bool screensaver_on_key_press(void) { return false; }
 void screen_gfx_flush(void) {}
+void screen_gfx_sync(void) {}
 
 static int mode_key_switches = 0;
 bool screen_handle_mode_key(int key_code) { (void)key_code; mode_key_switches++; return true; }
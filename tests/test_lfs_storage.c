@@ -276,6 +276,53 @@ static void test_open_directory_as_file_fails(void)
     TEST_ASSERT_NULL(storage.ops->open("/adir"));
 }
 
+//============================================================================
+// In-place mapping
+//============================================================================
+
+// Write `len` bytes of a repeating pattern
+static void write_pattern(const char *path, size_t len)
+{
+    static char text[BS * 2 + 1];
+    for (size_t i = 0; i < len; i++)
+    {
+        text[i] = (char)('a' + i % 23);
+    }
+    text[len] = '\0';
+    write_file(path, text);
+}
+
+static void test_map_file_points_into_a_single_block(void)
+{
+    write_pattern("/game.lgo", 3000);
+
+    const char *data = NULL;
+    size_t len = 0;
+    TEST_ASSERT_FALSE(storage.ops->map_file("/game.lgo", &data, &len));
+
+    logo_lfs_storage_set_memory(ram);
+    TEST_ASSERT_TRUE(storage.ops->map_file("/game.lgo", &data, &len));
+    TEST_ASSERT_EQUAL_UINT(3000, len);
+    TEST_ASSERT_TRUE(data >= (const char *)ram && data + len <= (const char *)ram + sizeof(ram));
+    for (size_t i = 0; i < len; i++)
+    {
+        TEST_ASSERT_EQUAL_CHAR('a' + i % 23, data[i]);
+    }
+}
+
+static void test_map_file_declines_inline_and_multi_block_files(void)
+{
+    logo_lfs_storage_set_memory(ram);
+    write_file("/small.txt", "Hello, Logo!");
+    write_pattern("/large.lgo", BS + 100);
+
+    const char *data;
+    size_t len;
+    TEST_ASSERT_FALSE(storage.ops->map_file("/small.txt", &data, &len));
+    TEST_ASSERT_FALSE(storage.ops->map_file("/large.lgo", &data, &len));
+    TEST_ASSERT_FALSE(storage.ops->map_file("/missing.lgo", &data, &len));
+}
+
 int main(void)
 {
     UNITY_BEGIN();
@@ -289,5 +336,7 @@ int main(void)
     RUN_TEST(test_dir_delete_nonempty_fails);
     RUN_TEST(test_list_directory_and_filter);
     RUN_TEST(test_open_directory_as_file_fails);
+    RUN_TEST(test_map_file_points_into_a_single_block);
+    RUN_TEST(test_map_file_declines_inline_and_multi_block_files);
     return UNITY_END();
 }
@@ -0,0 +1,143 @@
+//
+//  Pico Logo
+//  Copyright 2026 Blair Leduc. See LICENSE for details.
+//
+//  logo-bench core (tools/logo_bench_lib.c): percentiles, a measured run of a
+//  small program, its failures, and the JSON report.
+//
+
+#include "test_scaffold.h"
+#include "logo_bench.h"
+#include <stdio.h>
+#include <string.h>
+
+#ifndef LOGO_BENCH_SOURCE
+#error "LOGO_BENCH_SOURCE must be defined"
+#endif
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+static LogoBenchConfig step_config(void)
+{
+    LogoBenchConfig config = {
+        .source = LOGO_BENCH_SOURCE,
+        .setup = NULL,
+        .run = "bench.step",
+        .warmup = 2,
+        .iterations = 20,
+    };
+    return config;
+}
+
+void test_percentile_is_nearest_rank(void)
+{
+    double samples[100];
+    for (int i = 0; i < 100; i++)
+        samples[i] = i + 1;
+
+    TEST_ASSERT_EQUAL_FLOAT(1.0f, (float)logo_bench_percentile(samples, 100, 0.0));
+    TEST_ASSERT_EQUAL_FLOAT(50.0f, (float)logo_bench_percentile(samples, 100, 50.0));
+    TEST_ASSERT_EQUAL_FLOAT(95.0f, (float)logo_bench_percentile(samples, 100, 95.0));
+    TEST_ASSERT_EQUAL_FLOAT(99.0f, (float)logo_bench_percentile(samples, 100, 99.0));
+    TEST_ASSERT_EQUAL_FLOAT(100.0f, (float)logo_bench_percentile(samples, 100, 100.0));
+    TEST_ASSERT_EQUAL_FLOAT(1.0f, (float)logo_bench_percentile(samples, 1, 99.0));
+}
+
+void test_measure_runs_warmup_and_timed_runs(void)
+{
+    LogoBenchConfig config = step_config();
+    LogoBenchResult result;
+    char err[256] = "";
+
+    TEST_ASSERT_TRUE_MESSAGE(logo_bench_measure(&config, &result, err, sizeof(err)), err);
+    TEST_ASSERT_EQUAL_INT(20, result.iterations);
+
+    Value total;
+    TEST_ASSERT_TRUE(var_get("bench.total", &total));
+    TEST_ASSERT_EQUAL_FLOAT(22.0f, total.as.number);
+
+    TEST_ASSERT_TRUE(result.min_us <= result.median_us);
+    TEST_ASSERT_TRUE(result.median_us <= result.p95_us);
+    TEST_ASSERT_TRUE(result.p95_us <= result.p99_us);
+    TEST_ASSERT_TRUE(result.p99_us <= result.max_us);
+}
+
+void test_measure_counts_allocations_per_run(void)
+{
+    LogoBenchConfig config = step_config();
+    LogoBenchResult result;
+    char err[256] = "";
+
+    TEST_ASSERT_TRUE_MESSAGE(logo_bench_measure(&config, &result, err, sizeof(err)), err);
+
+    // Each run conses a two-member list of a small integer and a known word
+    TEST_ASSERT_EQUAL_FLOAT(2.0f, (float)result.cells);
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, (float)result.atoms);
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, (float)result.blobs);
+}
+
+void test_measure_reports_a_failing_run(void)
+{
+    LogoBenchConfig config = step_config();
+    config.run = "bench.fails";
+    LogoBenchResult result;
+    char err[256] = "";
+
+    TEST_ASSERT_FALSE(logo_bench_measure(&config, &result, err, sizeof(err)));
+    TEST_ASSERT_NOT_NULL(strstr(err, "bench.fails"));
+}
+
+void test_measure_reports_a_missing_file(void)
+{
+    LogoBenchConfig config = step_config();
+    config.source = "no/such/file.logo";
+    LogoBenchResult result;
+    char err[256] = "";
+
+    TEST_ASSERT_FALSE(logo_bench_measure(&config, &result, err, sizeof(err)));
+    TEST_ASSERT_NOT_NULL(strstr(err, "cannot open"));
+}
+
+void test_json_report_is_one_object(void)
+{
+    LogoBenchConfig config = step_config();
+    config.setup = "make \"bench.total 100";
+    LogoBenchResult result;
+    char err[256] = "";
+    TEST_ASSERT_TRUE_MESSAGE(logo_bench_measure(&config, &result, err, sizeof(err)), err);
+
+    FILE *f = tmpfile();
+    TEST_ASSERT_NOT_NULL(f);
+    logo_bench_write_json(f, &config, &result);
+    char buf[1024];
+    rewind(f);
+    size_t n = fread(buf, 1, sizeof(buf) - 1, f);
+    fclose(f);
+    buf[n] = '\0';
+
+    TEST_ASSERT_EQUAL_CHAR('{', buf[0]);
+    TEST_ASSERT_EQUAL_STRING("}\n", buf + n - 2);
+    TEST_ASSERT_NOT_NULL(strstr(buf, "\"setup\": \"make \\\"bench.total 100\""));
+    TEST_ASSERT_NOT_NULL(strstr(buf, "\"run\": \"bench.step\""));
+    TEST_ASSERT_NOT_NULL(strstr(buf, "\"iterations\": 20"));
+    TEST_ASSERT_NOT_NULL(strstr(buf, "\"p99\": "));
+    TEST_ASSERT_NOT_NULL(strstr(buf, "\"cells\": 2.000"));
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_percentile_is_nearest_rank);
+    RUN_TEST(test_measure_runs_warmup_and_timed_runs);
+    RUN_TEST(test_measure_counts_allocations_per_run);
+    RUN_TEST(test_measure_reports_a_failing_run);
+    RUN_TEST(test_measure_reports_a_missing_file);
+    RUN_TEST(test_json_report_is_one_object);
+    return UNITY_END();
+}
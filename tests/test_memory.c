@@ -8,6 +8,8 @@
 #include "unity.h"
 #include "core/memory.h"
 
+#include <math.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <string.h>
 
@@ -462,6 +464,89 @@ void test_negative_number_as_atom(void)
     TEST_ASSERT_TRUE(mem_word_eq(num, "-45.67", 6));
 }
 
+//============================================================================
+// Number Node Tests
+//============================================================================
+
+void test_number_node_keeps_every_bit(void)
+{
+    float third = 1.0f / 3.0f;
+    Node num = mem_number(third);
+    TEST_ASSERT_TRUE(mem_is_number(num));
+    TEST_ASSERT_TRUE(mem_is_word(num));
+    TEST_ASSERT_FALSE(mem_is_list(num));
+
+    Node list = mem_cons(num, NODE_NIL);
+    Node car = mem_car(list);
+    TEST_ASSERT_TRUE(mem_is_number(car));
+    TEST_ASSERT_TRUE(mem_number_value(car) == third);  // exactly, not to 6 digits
+}
+
+void test_number_node_uses_one_cell_and_no_atom(void)
+{
+    size_t nodes = mem_free_nodes();
+    size_t atoms = mem_free_atoms();
+    mem_number(2.5f);
+    TEST_ASSERT_EQUAL(nodes - 1, mem_free_nodes());
+    TEST_ASSERT_EQUAL(atoms, mem_free_atoms());
+}
+
+void test_small_integer_needs_no_cell(void)
+{
+    size_t nodes = mem_free_nodes();
+    float values[] = {0.0f, 1.0f, -1.0f, 4095.0f, -4096.0f};
+    for (size_t i = 0; i < sizeof(values) / sizeof(values[0]); i++)
+    {
+        Node list = mem_cons(mem_number(values[i]), NODE_NIL);
+        TEST_ASSERT_TRUE(mem_is_number(mem_car(list)));
+        TEST_ASSERT_EQUAL_FLOAT(values[i], mem_number_value(mem_car(list)));
+    }
+    TEST_ASSERT_EQUAL(nodes - 5, mem_free_nodes());  // just the five conses
+
+    // One past either end, and -0, are boxed.
+    mem_number(4096.0f);
+    mem_number(-4097.0f);
+    Node negative_zero = mem_number(-0.0f);
+    TEST_ASSERT_EQUAL(nodes - 8, mem_free_nodes());
+    TEST_ASSERT_TRUE(signbit(mem_number_value(negative_zero)));
+}
+
+void test_number_node_reads_as_its_text(void)
+{
+    Node num = mem_number(1.0f / 3.0f);
+    TEST_ASSERT_EQUAL_STRING("0.333333", mem_word_ptr(num));
+    TEST_ASSERT_EQUAL(8, mem_word_len(num));
+    TEST_ASSERT_TRUE(mem_word_eq(num, "0.333333", 8));
+    TEST_ASSERT_TRUE(mem_words_equal(num, mem_atom_cstr("0.333333")));
+    TEST_ASSERT_TRUE(mem_words_equal(num, mem_number(1.0f / 3.0f)));
+    TEST_ASSERT_FALSE(mem_words_equal(num, mem_number(0.5f)));
+}
+
+void test_number_node_text_without_atom_space(void)
+{
+    // Fill the atom table; the text still reads from a static buffer.
+    Node num = mem_number(-12.5f);
+    char name[8];
+    for (unsigned i = 0; !mem_is_nil(mem_atom(name, (size_t)snprintf(name, sizeof(name), "w%u", i))); i++)
+        ;
+    TEST_ASSERT_EQUAL_STRING("-12.5", mem_word_ptr(num));
+    TEST_ASSERT_EQUAL(5, mem_word_len(num));
+}
+
+void test_number_nodes_stop_at_encodable_cells(void)
+{
+    // Cells past what a cell half can address as a number are left for
+    // lists, so mem_number gives out before mem_cons does.
+    size_t boxed = 0;
+    while (!mem_is_nil(mem_number((float)boxed + 0.5f)))
+        boxed++;
+    TEST_ASSERT_LESS_OR_EQUAL(16384, boxed);
+    if (mem_total_nodes() > boxed)
+    {
+        TEST_ASSERT_FALSE(mem_is_nil(mem_cons(NODE_NIL, NODE_NIL)));
+    }
+}
+
 //============================================================================
 // Cons/List Tests
 //============================================================================
@@ -732,6 +817,21 @@ void test_gc_preserves_rooted_atoms_in_cells(void)
     TEST_ASSERT_TRUE(mem_word_eq(mem_cdr(list), "cdrword", 7));
 }
 
+void test_gc_keeps_rooted_numbers_and_frees_the_rest(void)
+{
+    Node list = mem_cons(mem_number(0.1f), NODE_NIL);
+    mem_number(0.2f);  // unreachable
+    size_t free_before = mem_free_nodes();
+
+    mem_gc(&list, 1);
+
+    TEST_ASSERT_EQUAL(1, mem_free_nodes() - free_before);
+    TEST_ASSERT_EQUAL_FLOAT(0.1f, mem_number_value(mem_car(list)));
+    Node other = mem_cons(mem_number(0.3f), NODE_NIL);
+    TEST_ASSERT_EQUAL_FLOAT(0.1f, mem_number_value(mem_car(list)));
+    TEST_ASSERT_EQUAL_FLOAT(0.3f, mem_number_value(mem_car(other)));
+}
+
 void test_gc_preserves_atom_pointer_root(void)
 {
     Node word = mem_atom("name", 4);
@@ -1243,6 +1343,174 @@ void test_cons_returns_nil_not_crash_on_full(void)
     }
 }
 
+// The allocators never collect on their own; they raise a request that the
+// evaluator answers at a safe point. A failure always raises it.
+void test_failed_cons_requests_a_collection(void)
+{
+    mem_set_gc_headroom(0);
+    TEST_ASSERT_FALSE(mem_gc_requested());
+    size_t failures = mem_alloc_failures();
+
+    while (!mem_is_nil(mem_cons(NODE_NIL, NODE_NIL)))
+    {
+    }
+    TEST_ASSERT_TRUE(mem_gc_requested());
+    TEST_ASSERT_EQUAL(failures + 1, mem_alloc_failures());
+
+    size_t collections = mem_gc_count();
+    mem_gc(NULL, 0);
+    TEST_ASSERT_FALSE(mem_gc_requested());
+    TEST_ASSERT_EQUAL(collections + 1, mem_gc_count());
+}
+
+// With headroom, the request comes before exhaustion rather than at it.
+void test_headroom_requests_a_collection_before_exhaustion(void)
+{
+    mem_set_gc_headroom(4096);
+    while (!mem_gc_requested())
+    {
+        TEST_ASSERT_FALSE(mem_is_nil(mem_cons(NODE_NIL, NODE_NIL)));
+    }
+    TEST_ASSERT_TRUE(mem_free_nodes() > 0);
+}
+
+// A collection that cannot restore the headroom stops asking until the next
+// one, or a nearly full workspace would collect on every primitive call.
+void test_headroom_disarms_when_a_collection_cannot_restore_it(void)
+{
+    mem_set_gc_headroom(4096);
+    Node keep = NODE_NIL;
+    while (!mem_gc_requested())
+        keep = mem_cons(NODE_NIL, keep);
+    // Everything is live: the collection frees nothing.
+    for (int i = 0; i < 100; i++)
+        keep = mem_cons(NODE_NIL, keep);
+    mem_gc(&keep, 1);
+    TEST_ASSERT_FALSE(mem_gc_requested());
+
+    keep = mem_cons(NODE_NIL, keep);
+    TEST_ASSERT_FALSE(mem_is_nil(keep));
+    TEST_ASSERT_FALSE(mem_gc_requested());
+}
+
+// Run an incremental cycle to completion in small steps over `roots`.
+static void run_incremental_cycle(Node *roots, size_t count)
+{
+    mem_gc_begin_incremental();
+    for (size_t i = 0; i < count; i++)
+        mem_gc_mark(roots[i]);
+    while (!mem_gc_mark_step(4))
+    {
+    }
+    for (size_t i = 0; i < count; i++)
+        mem_gc_mark(roots[i]);
+    mem_gc_finish_marking();
+    while (!mem_gc_sweep_step(16))
+    {
+    }
+}
+
+// Overwrite freed cells so a wrongly freed list shows up as changed content.
+static void churn_cells(int count)
+{
+    Node junk = mem_atom("junk", 4);
+    for (int i = 0; i < count; i++)
+        mem_cons(junk, NODE_NIL);
+}
+
+void test_incremental_cycle_frees_garbage_and_keeps_roots(void)
+{
+    Node word = mem_atom("keep", 4);
+    Node keep = NODE_NIL;
+    for (int i = 0; i < 200; i++)
+        keep = mem_cons(word, keep);
+    for (int i = 0; i < 300; i++)
+        mem_cons(word, NODE_NIL);
+
+    size_t collections = mem_gc_count();
+    size_t before = mem_free_nodes();
+    run_incremental_cycle(&keep, 1);
+    TEST_ASSERT_EQUAL(MEM_GC_IDLE, mem_gc_phase());
+    TEST_ASSERT_EQUAL(collections + 1, mem_gc_count());
+    TEST_ASSERT_EQUAL(before + 300, mem_free_nodes());
+
+    churn_cells(400);
+    int length = 0;
+    for (Node n = keep; !mem_is_nil(n); n = mem_cdr(n), length++)
+        TEST_ASSERT_TRUE(mem_word_eq(mem_car(n), "keep", 4));
+    TEST_ASSERT_EQUAL(200, length);
+}
+
+// The case the write barrier exists for: between steps the program moves the
+// only reference to a white list from a grey cell into a black one.
+void test_write_barrier_keeps_a_reference_moved_into_a_black_cell(void)
+{
+    Node word = mem_atom("keep", 4);
+    Node white = mem_cons(word, mem_cons(word, mem_cons(word, NODE_NIL)));
+    Node black = mem_cons(NODE_NIL, NODE_NIL);
+    Node grey = mem_cons(white, NODE_NIL);
+    Node roots[2] = {black, NODE_NIL};
+
+    mem_gc_begin_incremental();
+    mem_gc_mark(black);
+    TEST_ASSERT_TRUE(mem_gc_mark_step(SIZE_MAX));
+
+    mem_set_car(black, white);
+    mem_set_car(grey, NODE_NIL);
+
+    TEST_ASSERT_TRUE(mem_gc_mark_step(SIZE_MAX));
+    mem_gc_mark(roots[0]);
+    mem_gc_finish_marking();
+    while (!mem_gc_sweep_step(16))
+    {
+    }
+
+    churn_cells(100);
+    Node moved = mem_car(black);
+    TEST_ASSERT_TRUE(mem_word_eq(mem_car(moved), "keep", 4));
+    TEST_ASSERT_TRUE(mem_word_eq(mem_car(mem_cdr(mem_cdr(moved))), "keep", 4));
+}
+
+// Cells and words made while marking are allocated black, so a new list only
+// reachable from a root added after the first root pass still survives.
+void test_allocations_during_marking_survive_the_cycle(void)
+{
+    Node root = mem_cons(NODE_NIL, NODE_NIL);
+    mem_gc_begin_incremental();
+    mem_gc_mark(root);
+    mem_gc_mark_step(1);
+
+    Node fresh = mem_cons(mem_atom("fresh", 5), NODE_NIL);
+    mem_set_cdr(root, fresh);
+    while (!mem_gc_mark_step(4))
+    {
+    }
+    mem_gc_mark(root);
+    mem_gc_finish_marking();
+    while (!mem_gc_sweep_step(16))
+    {
+    }
+
+    churn_cells(100);
+    TEST_ASSERT_TRUE(mem_word_eq(mem_car(mem_cdr(root)), "fresh", 5));
+}
+
+// A full collection abandons a cycle in flight instead of trusting its marks.
+void test_full_collection_cancels_an_incremental_cycle(void)
+{
+    Node word = mem_atom("keep", 4);
+    Node keep = mem_cons(word, mem_cons(word, NODE_NIL));
+    mem_cons(word, NODE_NIL);
+
+    mem_gc_begin_incremental();
+    mem_gc_mark(keep);
+    mem_gc(&keep, 1);
+    TEST_ASSERT_EQUAL(MEM_GC_IDLE, mem_gc_phase());
+
+    churn_cells(100);
+    TEST_ASSERT_TRUE(mem_word_eq(mem_car(mem_cdr(keep)), "keep", 4));
+}
+
 void test_cons_rejects_word_with_offset_too_large(void)
 {
     // Words referenced from cons cells are encoded with the high bit (0x8000)
@@ -1338,6 +1606,12 @@ int main(void)
     RUN_TEST(test_empty_word);
     RUN_TEST(test_number_as_atom);
     RUN_TEST(test_negative_number_as_atom);
+    RUN_TEST(test_number_node_keeps_every_bit);
+    RUN_TEST(test_number_node_uses_one_cell_and_no_atom);
+    RUN_TEST(test_small_integer_needs_no_cell);
+    RUN_TEST(test_number_node_reads_as_its_text);
+    RUN_TEST(test_number_node_text_without_atom_space);
+    RUN_TEST(test_number_nodes_stop_at_encodable_cells);
 
     // Cons/Lists
     RUN_TEST(test_list_append_builds_list);
@@ -1363,6 +1637,7 @@ int main(void)
     RUN_TEST(test_gc_frees_unreachable);
     RUN_TEST(test_gc_reclaims_unreachable_atoms);
     RUN_TEST(test_gc_preserves_rooted_atoms_in_cells);
+    RUN_TEST(test_gc_keeps_rooted_numbers_and_frees_the_rest);
     RUN_TEST(test_gc_preserves_atom_pointer_root);
     RUN_TEST(test_interning_ignores_atom_mark_bits);
     RUN_TEST(test_gc_recovers_exhausted_atom_space);
@@ -1397,6 +1672,13 @@ int main(void)
     RUN_TEST(test_large_atoms_exhaust_space);
     RUN_TEST(test_interleaved_atom_node_exhaustion);
     RUN_TEST(test_cons_returns_nil_not_crash_on_full);
+    RUN_TEST(test_failed_cons_requests_a_collection);
+    RUN_TEST(test_headroom_requests_a_collection_before_exhaustion);
+    RUN_TEST(test_headroom_disarms_when_a_collection_cannot_restore_it);
+    RUN_TEST(test_incremental_cycle_frees_garbage_and_keeps_roots);
+    RUN_TEST(test_write_barrier_keeps_a_reference_moved_into_a_black_cell);
+    RUN_TEST(test_allocations_during_marking_survive_the_cycle);
+    RUN_TEST(test_full_collection_cancels_an_incremental_cycle);
     RUN_TEST(test_cons_rejects_word_with_offset_too_large);
     RUN_TEST(test_atom_returns_nil_not_crash_when_full);
 
@@ -34,6 +34,15 @@ typedef struct MockFile
 // Mock file storage
 static MockFile mock_files[MOCK_MAX_FILES];
 
+// In-place mapping for tests of `load`: off unless a test turns it on
+static bool mock_fs_mappable = false;
+static int mock_fs_maps = 0;
+static int mock_fs_unmaps = 0;
+
+// Backend write calls, and a full disk that fails every write
+static int mock_fs_writes = 0;
+static bool mock_fs_full = false;
+
 // Mock file stream context
 typedef struct MockFileContext
 {
@@ -100,6 +109,13 @@ static void mock_file_write(LogoStream *stream, const char *text)
     MockFileContext *ctx = (MockFileContext *)stream->context;
     if (!ctx || !ctx->file)
         return;
+    mock_fs_writes++;
+    if (mock_fs_full)
+    {
+        stream->write_error = true;
+        stream->disk_full = true;
+        return;
+    }
     
     size_t len = strlen(text);
     for (size_t i = 0; i < len && ctx->write_pos < MOCK_FILE_SIZE - 1; i++)
@@ -119,8 +135,15 @@ static void mock_file_write_bytes(LogoStream *stream, const char *buffer, size_t
     MockFileContext *ctx = (MockFileContext *)stream->context;
     if (!ctx || !ctx->file)
         return;
+    mock_fs_writes++;
+    if (mock_fs_full)
+    {
+        stream->write_error = true;
+        stream->disk_full = true;
+        return;
+    }
 
-    for (size_t i = 0; i < len && ctx->write_pos < MOCK_FILE_SIZE; i++)
+    for (size_t i = 0; i < len && ctx->write_pos < MOCK_FILE_SIZE - 1; i++)
     {
         ctx->file->data[ctx->write_pos++] = buffer[i];
     }
@@ -128,6 +151,8 @@ static void mock_file_write_bytes(LogoStream *stream, const char *buffer, size_t
     {
         ctx->file->size = ctx->write_pos;
     }
+    // Text tests read data as a C string; files open buffered write this way
+    ctx->file->data[ctx->file->size] = '\0';
 }
 
 static void mock_file_flush(LogoStream *stream)
@@ -287,6 +312,11 @@ static void mock_fs_reset(void)
         mock_files[i].data[0] = '\0';
         mock_files[i].size = 0;
     }
+    mock_fs_mappable = false;
+    mock_fs_maps = 0;
+    mock_fs_unmaps = 0;
+    mock_fs_writes = 0;
+    mock_fs_full = false;
 }
 
 // Mock file opener - creates file if it doesn't exist (matches new storage API)
@@ -423,6 +453,34 @@ static bool mock_storage_free_blocks(const char *pathname, uint32_t *free_blocks
     return true;
 }
 
+// Fixed block cache counters for tests of `.sdcache`.
+static bool mock_storage_cache_stats(const char *pathname, LogoCacheStats *stats)
+{
+    (void)pathname;
+    stats->hits = 40;
+    stats->misses = 2;
+    stats->sectors_read = 9;
+    stats->sectors_written = 3;
+    return true;
+}
+
+static bool mock_storage_map_file(const char *pathname, const char **data, size_t *len)
+{
+    MockFile *file = mock_fs_get_file(pathname, false);
+    if (!mock_fs_mappable || !file || file->is_directory)
+        return false;
+    mock_fs_maps++;
+    *data = file->data;
+    *len = file->size;
+    return true;
+}
+
+static void mock_storage_unmap_file(const char *pathname, const char *data, size_t len)
+{
+    (void)pathname; (void)data; (void)len;
+    mock_fs_unmaps++;
+}
+
 static LogoStorageOps mock_storage_ops = {
     .open = mock_storage_open,
     .file_exists = mock_storage_file_exists,
@@ -434,6 +492,9 @@ static LogoStorageOps mock_storage_ops = {
     .file_size = mock_storage_file_size,
     .list_directory = mock_storage_list_directory,
     .free_blocks = mock_storage_free_blocks,
+    .cache_stats = mock_storage_cache_stats,
+    .map_file = mock_storage_map_file,
+    .unmap_file = mock_storage_unmap_file,
 };
 
 static LogoStorage mock_storage;
@@ -0,0 +1,174 @@
+//
+//  Pico Logo
+//  Copyright 2026 Blair Leduc. See LICENSE for details.
+//
+//  Tests for the present queue (devices/present_queue.h) on the host's
+//  consumer thread: frames arrive in order and once each, submit returns
+//  while the consumer is still sending, and the producer is never handed
+//  the buffer the consumer holds.
+//
+
+#include <pthread.h>
+#include <string.h>
+
+#include "unity.h"
+#include "devices/present_queue.h"
+
+typedef struct
+{
+    int seq;
+} Frame;
+
+static Frame frames[2];
+static PresentQueue *queue;
+
+// What the consumer saw, and a gate a test can hold it at
+static int sent[64];
+static int sent_count;
+static const Frame *holding;
+static bool gate_closed;
+static pthread_mutex_t gate_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t gate_changed = PTHREAD_COND_INITIALIZER;
+
+static void consume(void *frame, void *context)
+{
+    (void)context;
+    const Frame *f = (const Frame *)frame;
+
+    pthread_mutex_lock(&gate_lock);
+    holding = f;
+    pthread_cond_broadcast(&gate_changed);
+    while (gate_closed)
+    {
+        pthread_cond_wait(&gate_changed, &gate_lock);
+    }
+    sent[sent_count++] = f->seq;
+    holding = NULL;
+    pthread_mutex_unlock(&gate_lock);
+}
+
+static void close_gate(void)
+{
+    pthread_mutex_lock(&gate_lock);
+    gate_closed = true;
+    pthread_mutex_unlock(&gate_lock);
+}
+
+static void open_gate(void)
+{
+    pthread_mutex_lock(&gate_lock);
+    gate_closed = false;
+    pthread_cond_broadcast(&gate_changed);
+    pthread_mutex_unlock(&gate_lock);
+}
+
+// Wait until the consumer has picked up a frame and is at the gate
+static const Frame *wait_for_consumer(void)
+{
+    pthread_mutex_lock(&gate_lock);
+    while (holding == NULL)
+    {
+        pthread_cond_wait(&gate_changed, &gate_lock);
+    }
+    const Frame *f = holding;
+    pthread_mutex_unlock(&gate_lock);
+    return f;
+}
+
+void setUp(void)
+{
+    memset(frames, 0, sizeof(frames));
+    sent_count = 0;
+    holding = NULL;
+    gate_closed = false;
+    void *buffers[2] = { &frames[0], &frames[1] };
+    queue = present_queue_start(buffers, consume, NULL);
+    TEST_ASSERT_NOT_NULL(queue);
+}
+
+void tearDown(void)
+{
+    open_gate();
+    present_queue_stop(queue);
+}
+
+void test_frames_arrive_in_order_once_each(void)
+{
+    Frame *f = (Frame *)present_queue_back(queue);
+    for (int i = 1; i <= 40; i++)
+    {
+        f->seq = i;
+        f = (Frame *)present_queue_submit(queue);
+    }
+    present_queue_wait_idle(queue);
+
+    TEST_ASSERT_EQUAL_INT(40, sent_count);
+    for (int i = 0; i < 40; i++)
+    {
+        TEST_ASSERT_EQUAL_INT(i + 1, sent[i]);
+    }
+    TEST_ASSERT_FALSE(present_queue_busy(queue));
+}
+
+void test_submit_returns_while_the_frame_is_being_sent(void)
+{
+    close_gate();
+    Frame *f = (Frame *)present_queue_back(queue);
+    f->seq = 1;
+    Frame *next = (Frame *)present_queue_submit(queue);
+
+    // The producer is back while the consumer still holds frame 1
+    const Frame *held = wait_for_consumer();
+    TEST_ASSERT_TRUE(present_queue_busy(queue));
+    TEST_ASSERT_EQUAL_INT(1, held->seq);
+    TEST_ASSERT_EQUAL_INT(0, sent_count);
+
+    // ... and is writing the other buffer
+    TEST_ASSERT_TRUE(next != held);
+    TEST_ASSERT_TRUE(present_queue_back(queue) == next);
+
+    open_gate();
+    present_queue_wait_idle(queue);
+    TEST_ASSERT_EQUAL_INT(1, sent_count);
+}
+
+void test_back_buffer_is_never_the_one_being_sent(void)
+{
+    Frame *f = (Frame *)present_queue_back(queue);
+    for (int i = 1; i <= 10; i++)
+    {
+        close_gate();
+        f->seq = i;
+        f = (Frame *)present_queue_submit(queue);
+        const Frame *held = wait_for_consumer();
+        TEST_ASSERT_TRUE(held != f);
+        TEST_ASSERT_EQUAL_INT(i, held->seq);
+        open_gate();
+        present_queue_wait_idle(queue);  // Before the gate closes again
+    }
+    TEST_ASSERT_EQUAL_INT(10, sent_count);
+}
+
+void test_stop_sends_the_last_frame(void)
+{
+    Frame *f = (Frame *)present_queue_back(queue);
+    f->seq = 7;
+    present_queue_submit(queue);
+    present_queue_stop(queue);
+    TEST_ASSERT_EQUAL_INT(1, sent_count);
+    TEST_ASSERT_EQUAL_INT(7, sent[0]);
+
+    // tearDown stops whatever setUp started
+    void *buffers[2] = { &frames[0], &frames[1] };
+    queue = present_queue_start(buffers, consume, NULL);
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_frames_arrive_in_order_once_each);
+    RUN_TEST(test_submit_returns_while_the_frame_is_being_sent);
+    RUN_TEST(test_back_buffer_is_never_the_one_being_sent);
+    RUN_TEST(test_stop_sends_the_last_frame);
+    return UNITY_END();
+}
@@ -4,6 +4,7 @@
 //
 
 #include "test_scaffold.h"
+#include "core/profile.h"
 #include <stdlib.h>
 #include <string.h>
 
@@ -14,6 +15,7 @@ void setUp(void)
 
 void tearDown(void)
 {
+    profile_stop();
     test_scaffold_tearDown();
 }
 
@@ -305,6 +307,140 @@ void test_step_shows_each_line_before_execution(void)
     TEST_ASSERT_TRUE(strstr(output_buffer, "second\n") != NULL);
 }
 
+//==========================================================================
+// Profiler Tests (.profile, .profile.report)
+//==========================================================================
+
+// The report row for `name`, or false if it has none
+static bool find_profile_row(const char *name, ProfileRow *out)
+{
+    int cursor = -1;
+    while (profile_next(&cursor, out))
+    {
+        if (strcmp(out->name, name) == 0)
+            return true;
+    }
+    return false;
+}
+
+void test_profile_counts_procedure_and_primitive_calls(void)
+{
+    const char *params[] = {};
+    define_proc("pr.twice", params, 0, "print 1 print 2");
+
+    run_string(".profile \"true repeat 3 [pr.twice] .profile \"false");
+
+    ProfileRow row;
+    TEST_ASSERT_TRUE(find_profile_row("pr.twice", &row));
+    TEST_ASSERT_EQUAL_UINT32(3, row.calls);
+    TEST_ASSERT_TRUE(find_profile_row("print", &row));
+    TEST_ASSERT_EQUAL_UINT32(6, row.calls);
+    TEST_ASSERT_TRUE(find_profile_row("repeat", &row));
+    TEST_ASSERT_EQUAL_UINT32(1, row.calls);
+}
+
+void test_profile_counts_tail_calls(void)
+{
+    const char *params[] = {"n"};
+    define_proc("countdown", params, 1, "if :n = 0 [stop] countdown :n - 1");
+
+    run_string(".profile \"true countdown 5 .profile \"false");
+
+    ProfileRow row;
+    TEST_ASSERT_TRUE(find_profile_row("countdown", &row));
+    TEST_ASSERT_EQUAL_UINT32(6, row.calls);
+}
+
+void test_profile_times_inclusive_and_exclusive(void)
+{
+    static const int outer = 0, inner = 0;
+
+    set_mock_ticks(0);
+    TEST_ASSERT_TRUE(profile_start(primitives_get_io()));
+    profile_enter(&outer, "outer");
+    set_mock_ticks(2);
+    profile_enter(&inner, "inner");
+    set_mock_ticks(7);
+    profile_exit(&inner);
+    set_mock_ticks(8);
+    profile_exit(&outer);
+
+    // Most exclusive time first
+    ProfileRow row;
+    int cursor = -1;
+    TEST_ASSERT_TRUE(profile_next(&cursor, &row));
+    TEST_ASSERT_EQUAL_STRING("inner", row.name);
+    TEST_ASSERT_EQUAL_UINT32(5000, row.total_us);
+    TEST_ASSERT_EQUAL_UINT32(5000, row.self_us);
+    TEST_ASSERT_TRUE(profile_next(&cursor, &row));
+    TEST_ASSERT_EQUAL_STRING("outer", row.name);
+    TEST_ASSERT_EQUAL_UINT32(8000, row.total_us);
+    TEST_ASSERT_EQUAL_UINT32(3000, row.self_us);
+    TEST_ASSERT_FALSE(profile_next(&cursor, &row));
+}
+
+void test_profile_counts_recursion_once_in_inclusive_time(void)
+{
+    static const int proc = 0;
+
+    set_mock_ticks(0);
+    TEST_ASSERT_TRUE(profile_start(primitives_get_io()));
+    profile_enter(&proc, "proc");
+    set_mock_ticks(1);
+    profile_enter(&proc, "proc");
+    set_mock_ticks(3);
+    profile_exit(&proc);
+    set_mock_ticks(4);
+    profile_exit(&proc);
+
+    ProfileRow row;
+    TEST_ASSERT_TRUE(find_profile_row("proc", &row));
+    TEST_ASSERT_EQUAL_UINT32(2, row.calls);
+    TEST_ASSERT_EQUAL_UINT32(4000, row.total_us);
+    TEST_ASSERT_EQUAL_UINT32(4000, row.self_us);
+}
+
+void test_profile_exit_ends_unwound_calls(void)
+{
+    static const int outer = 0, inner = 0;
+
+    set_mock_ticks(0);
+    TEST_ASSERT_TRUE(profile_start(primitives_get_io()));
+    profile_enter(&outer, "outer");
+    set_mock_ticks(1);
+    profile_enter(&inner, "inner");
+    set_mock_ticks(4);
+    profile_exit(&outer);
+
+    ProfileRow row;
+    TEST_ASSERT_TRUE(find_profile_row("inner", &row));
+    TEST_ASSERT_EQUAL_UINT32(3000, row.total_us);
+    TEST_ASSERT_TRUE(find_profile_row("outer", &row));
+    TEST_ASSERT_EQUAL_UINT32(4000, row.total_us);
+    TEST_ASSERT_EQUAL_UINT32(1000, row.self_us);
+}
+
+void test_profile_report_outputs_rows(void)
+{
+    const char *params[] = {};
+    define_proc("pr.twice", params, 0, "print 1 print 2");
+
+    run_string(".profile \"true pr.twice .profile \"false");
+    reset_output();
+    run_string("show first .profile.report");
+
+    // The clock stands still, so calls decide the order
+    TEST_ASSERT_EQUAL_STRING("[print 2 0 0]\n", output_buffer);
+}
+
+void test_profile_rejects_non_boolean(void)
+{
+    Result r = run_string(".profile \"maybe");
+    TEST_ASSERT_EQUAL(RESULT_ERROR, r.status);
+    TEST_ASSERT_EQUAL(ERR_NOT_BOOL, result_get_error_code(r));
+    TEST_ASSERT_FALSE(profile_running);
+}
+
 int main(void)
 {
     UNITY_BEGIN();
@@ -328,6 +464,13 @@ int main(void)
     RUN_TEST(test_step_pauses_execution);
     RUN_TEST(test_step_multiline_procedure);
     RUN_TEST(test_step_shows_each_line_before_execution);
+    RUN_TEST(test_profile_counts_procedure_and_primitive_calls);
+    RUN_TEST(test_profile_counts_tail_calls);
+    RUN_TEST(test_profile_times_inclusive_and_exclusive);
+    RUN_TEST(test_profile_counts_recursion_once_in_inclusive_time);
+    RUN_TEST(test_profile_exit_ends_unwound_calls);
+    RUN_TEST(test_profile_report_outputs_rows);
+    RUN_TEST(test_profile_rejects_non_boolean);
 
     return UNITY_END();
 }
@@ -7,6 +7,7 @@
 
 #include "test_scaffold.h"
 #include "core/error.h"
+#include "core/limits.h"
 #include <string.h>
 #include <stdio.h>
 
@@ -66,6 +67,18 @@ void test_user_interrupt_stops_repeat(void)
     TEST_ASSERT_EQUAL_STRING("1\n1\n1\n", output_buffer);
 }
 
+void test_user_interrupt_is_polled_every_few_instructions(void)
+{
+    // A new evaluator polls at its first instruction, then once every
+    // LOGO_POLL_INSTRUCTIONS instructions
+    run_string("make \"n 0");
+    mock_interrupt_checks = 0;
+    Result r = run_string("repeat 64 [make \"n :n + 1]");
+    TEST_ASSERT_EQUAL(RESULT_NONE, r.status);
+    TEST_ASSERT_TRUE(mock_interrupt_checks >= 1);
+    TEST_ASSERT_TRUE(mock_interrupt_checks <= 64 / LOGO_POLL_INSTRUCTIONS + 2);
+}
+
 void test_pause_request_triggers_pause_in_procedure(void)
 {
     // Define a procedure that will be paused by F9
@@ -508,6 +521,7 @@ int main(void)
     // User interrupt
     RUN_TEST(test_user_interrupt_stops_evaluation);
     RUN_TEST(test_user_interrupt_stops_repeat);
+    RUN_TEST(test_user_interrupt_is_polled_every_few_instructions);
 
     // F9 pause request
     RUN_TEST(test_pause_request_triggers_pause_in_procedure);
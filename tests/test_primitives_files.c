@@ -163,6 +163,52 @@ void test_setwrite_unopened_file_error(void)
     TEST_ASSERT_EQUAL(RESULT_ERROR, r.status);
 }
 
+void test_print_to_file_leaves_writes_buffered(void)
+{
+    run_string("open \"output.txt");
+    run_string("setwrite \"output.txt");
+
+    // 100 lines of 6 bytes fill the 512-byte buffer once
+    Result r = run_string("repeat 100 [print \"hello]");
+    TEST_ASSERT_EQUAL(RESULT_NONE, r.status);
+    TEST_ASSERT_EQUAL_INT(1, mock_fs_writes);
+
+    r = run_string("setwrite []");
+    TEST_ASSERT_EQUAL(RESULT_NONE, r.status);
+    TEST_ASSERT_EQUAL_INT(2, mock_fs_writes);
+
+    MockFile *file = mock_fs_get_file("output.txt", false);
+    TEST_ASSERT_NOT_NULL(file);
+    TEST_ASSERT_EQUAL_size_t(600, file->size);
+}
+
+void test_close_reports_disk_full_from_buffered_prints(void)
+{
+    run_string("open \"output.txt");
+    run_string("setwrite \"output.txt");
+    mock_fs_full = true;
+
+    Result r = run_string("print \"hello");
+    TEST_ASSERT_EQUAL(RESULT_NONE, r.status);
+
+    r = run_string("close \"output.txt");
+    TEST_ASSERT_EQUAL(RESULT_ERROR, r.status);
+    TEST_ASSERT_EQUAL(ERR_DISK_FULL, result_get_error_code(r));
+    TEST_ASSERT_FALSE(logo_io_is_open(&mock_io, "output.txt"));
+}
+
+void test_setwrite_reports_disk_full_from_buffered_prints(void)
+{
+    run_string("open \"output.txt");
+    run_string("setwrite \"output.txt");
+    mock_fs_full = true;
+    run_string("print \"hello");
+
+    Result r = run_string("setwrite []");
+    TEST_ASSERT_EQUAL(ERR_DISK_FULL, result_get_error_code(r));
+    TEST_ASSERT_TRUE(logo_io_writer_is_screen(&mock_io));
+}
+
 //==========================================================================
 // Allopen Tests
 //==========================================================================
@@ -285,6 +331,7 @@ void test_setwritepos(void)
     run_string("setwrite \"pos.txt");
     run_string("setwritepos 6");
     run_string("type \"WORLD");
+    run_string("setwrite []");
     
     MockFile *file = mock_fs_get_file("pos.txt", false);
     TEST_ASSERT_EQUAL_STRING("hello WORLD", file->data);
@@ -682,6 +729,9 @@ int main(void)
     RUN_TEST(test_setwrite_to_file);
     RUN_TEST(test_setwrite_back_to_screen);
     RUN_TEST(test_setwrite_unopened_file_error);
+    RUN_TEST(test_print_to_file_leaves_writes_buffered);
+    RUN_TEST(test_close_reports_disk_full_from_buffered_prints);
+    RUN_TEST(test_setwrite_reports_disk_full_from_buffered_prints);
     
     // Allopen tests
     RUN_TEST(test_allopen_empty);
@@ -277,6 +277,22 @@ void test_free_with_pathname(void)
     TEST_ASSERT_EQUAL_STRING("100", mem_word_ptr(mem_car(list)));
 }
 
+void test_sdcache_reports_counters(void)
+{
+    Result r = eval_string(".sdcache");
+    TEST_ASSERT_EQUAL(RESULT_OK, r.status);
+    TEST_ASSERT_TRUE(value_is_list(r.value));
+    Node list = value_to_node(r.value);
+    TEST_ASSERT_EQUAL_STRING("40", mem_word_ptr(mem_car(list)));
+    list = mem_cdr(list);
+    TEST_ASSERT_EQUAL_STRING("2", mem_word_ptr(mem_car(list)));
+    list = mem_cdr(list);
+    TEST_ASSERT_EQUAL_STRING("9", mem_word_ptr(mem_car(list)));
+    list = mem_cdr(list);
+    TEST_ASSERT_EQUAL_STRING("3", mem_word_ptr(mem_car(list)));
+    TEST_ASSERT_TRUE(mem_is_nil(mem_cdr(list)));
+}
+
 void test_setprefix_and_prefix(void)
 {
     // Create the directory first
@@ -492,6 +508,7 @@ int main(void)
     RUN_TEST(test_rename_file);
     RUN_TEST(test_free_reports_blocks);
     RUN_TEST(test_free_with_pathname);
+    RUN_TEST(test_sdcache_reports_counters);
     RUN_TEST(test_setprefix_and_prefix);
     RUN_TEST(test_sp_alias_sets_prefix);
     RUN_TEST(test_setprefix_nonexistent_directory);
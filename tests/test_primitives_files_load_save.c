@@ -6,6 +6,7 @@
 //
 
 #include "test_mock_fs.h"
+#include "devices/bmp.h"
 #include <errno.h>
 #include <stdlib.h>
 #include <stdio.h>
@@ -114,6 +115,28 @@ void test_loadpic_loads_file(void)
     tearDown_with_turtle();
 }
 
+void test_loadpic_replaces_a_stamped_board(void)
+{
+    setUp_with_turtle();
+    mock_fs_create_file("picture.bmp", "BMP data");
+    TEST_ASSERT_EQUAL(RESULT_NONE, run_string("newtiles 8 newmap 2 2 settile 1 1 1").status);
+    TEST_ASSERT_EQUAL(RESULT_NONE, run_string("stampmap animtile 1 [1 2] 100").status);
+
+    // While the board is up, each frame re-bakes the cell (slots 1 and 2
+    // are empty, so it paints background)
+    mock_device_paint_canvas(0, 0, 8, 8, 42);
+    tiles_tick(100);
+    TEST_ASSERT_EQUAL_UINT8(0, mock_device_get_canvas_point(0, 0));
+
+    TEST_ASSERT_EQUAL(RESULT_NONE, run_string("loadpic \"picture.bmp").status);
+    mock_device_paint_canvas(0, 0, 8, 8, 42);               // the picture
+    tiles_tick(100);
+    TEST_ASSERT_EQUAL_UINT8(42, mock_device_get_canvas_point(0, 0));
+    TEST_ASSERT_EQUAL_UINT8(42, mock_device_get_canvas_point(7, 7));
+
+    tearDown_with_turtle();
+}
+
 void test_loadpic_file_not_found_error(void)
 {
     setUp_with_turtle();
@@ -202,6 +225,160 @@ void test_loadpic_with_prefix(void)
     tearDown_with_turtle();
 }
 
+// A title-screen sort of picture: a background, bands, a box, and a
+// patch of one-pixel detail that RLE8 has to store literally
+static void paint_title_screen(void)
+{
+    mock_device_paint_canvas(0, 0, 320, 320, 1);
+    for (int band = 0; band < 8; band++)
+    {
+        mock_device_paint_canvas(0, 200 + band * 8, 320, 4, (uint8_t)(20 + band));
+    }
+    mock_device_paint_canvas(40, 40, 240, 100, 4);
+    for (int y = 60; y < 76; y++)
+    {
+        for (int x = 60; x < 124; x++)
+        {
+            mock_device_set_canvas_point(x, y, (uint8_t)((x * 7 + y * 3) % 5 + 9));
+        }
+    }
+}
+
+static uint8_t saved_canvas[320 * 320];
+
+static void snapshot_canvas(uint8_t *out)
+{
+    for (int y = 0; y < 320; y++)
+    {
+        for (int x = 0; x < 320; x++)
+        {
+            out[y * 320 + x] = mock_device_get_canvas_point(x, y);
+        }
+    }
+}
+
+void test_savepic_rle_round_trips_canvas_and_palette(void)
+{
+    setUp_with_turtle();
+    mock_device_set_gfx_codec(true);
+    paint_title_screen();
+    TEST_ASSERT_EQUAL(RESULT_NONE, run_string("setpalette 4 [200 100 50]").status);
+    snapshot_canvas(saved_canvas);
+
+    Result r = run_string("savepic \"title.rle");
+    TEST_ASSERT_EQUAL(RESULT_NONE, r.status);
+    TEST_ASSERT_TRUE(mock_device_get_last_gfx_save_rle());
+
+    // A small fraction of the uncompressed picture, header and all
+    MockFile *file = mock_fs_get_file("title.rle", false);
+    TEST_ASSERT_NOT_NULL(file);
+    size_t raw_size = bmp_file_size(saved_canvas, 320, 320, false);
+    TEST_ASSERT_EQUAL_UINT32(bmp_file_size(saved_canvas, 320, 320, true), file->size);
+    TEST_ASSERT_TRUE(file->size * 4 < raw_size);
+    TEST_ASSERT_EQUAL_UINT8(BMP_COMPRESSION_RLE8, (uint8_t)file->data[30]);
+
+    // Scribble over both, then read them back
+    mock_device_paint_canvas(0, 0, 320, 320, 0);
+    TEST_ASSERT_EQUAL(RESULT_NONE, run_string("setpalette 4 [0 0 0]").status);
+    r = run_string("loadpic \"title.rle");
+    TEST_ASSERT_EQUAL(RESULT_NONE, r.status);
+
+    static uint8_t loaded[320 * 320];
+    snapshot_canvas(loaded);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(saved_canvas, loaded, sizeof(loaded));
+    TEST_ASSERT_TRUE(mock_device_verify_palette(4, 200, 100, 50));
+
+    tearDown_with_turtle();
+}
+
+void test_savepic_bmp_name_is_not_compressed(void)
+{
+    setUp_with_turtle();
+
+    Result r = run_string("savepic \"shot.BMP");
+    TEST_ASSERT_EQUAL(RESULT_NONE, r.status);
+    TEST_ASSERT_FALSE(mock_device_get_last_gfx_save_rle());
+
+    r = run_string("savepic \"shot.RLE");
+    TEST_ASSERT_EQUAL(RESULT_NONE, r.status);
+    TEST_ASSERT_TRUE(mock_device_get_last_gfx_save_rle());
+
+    tearDown_with_turtle();
+}
+
+// An RLE8 file from another tool: a two-colour palette, an odd literal
+// stretch, a delta and no end of row before the end of the picture
+void test_loadpic_reads_rle8_escapes(void)
+{
+    setUp_with_turtle();
+    mock_device_set_gfx_codec(true);
+    mock_device_paint_canvas(0, 0, 320, 320, 3);
+
+    static const uint8_t pixels[] = {
+        0, 3, 5, 6, 7, 0,  // Literal 5 6 7, padded
+        4, 8,              // Four 8s
+        0, 2, 5, 1,        // Right 5, up a row
+        2, 9,              // Two 9s
+        0, 1,              // End of picture
+    };
+    uint8_t file[BMP_FILE_HEADER_SIZE + BMP_DIB_HEADER_SIZE + 8 + sizeof(pixels)] = {0};
+    uint32_t offset = BMP_FILE_HEADER_SIZE + BMP_DIB_HEADER_SIZE + 8;
+    file[0] = 'B';
+    file[1] = 'M';
+    file[2] = (uint8_t)sizeof(file);
+    file[10] = (uint8_t)offset;
+    uint8_t *dib = file + BMP_FILE_HEADER_SIZE;
+    dib[0] = BMP_DIB_HEADER_SIZE;
+    dib[4] = 320 & 0xFF;
+    dib[5] = 320 >> 8;
+    dib[8] = 320 & 0xFF;
+    dib[9] = 320 >> 8;
+    dib[12] = 1;
+    dib[14] = 8;
+    dib[16] = BMP_COMPRESSION_RLE8;
+    dib[32] = 2;                        // Two colours
+    uint8_t *palette = dib + BMP_DIB_HEADER_SIZE;
+    palette[4 + 2] = 255;               // Entry 1 is red
+    memcpy(file + offset, pixels, sizeof(pixels));
+    mock_fs_create_file_bytes("other.bmp", (const char *)file, sizeof(file));
+
+    Result r = run_string("loadpic \"other.bmp");
+    TEST_ASSERT_EQUAL(RESULT_NONE, r.status);
+
+    // The bottom row, then the one above it
+    static const uint8_t bottom[] = {5, 6, 7, 8, 8, 8, 8, 0};
+    for (int x = 0; x < (int)sizeof(bottom); x++)
+    {
+        TEST_ASSERT_EQUAL_UINT8(bottom[x], mock_device_get_canvas_point(x, 319));
+    }
+    TEST_ASSERT_EQUAL_UINT8(0, mock_device_get_canvas_point(11, 318));
+    TEST_ASSERT_EQUAL_UINT8(9, mock_device_get_canvas_point(12, 318));
+    TEST_ASSERT_EQUAL_UINT8(9, mock_device_get_canvas_point(13, 318));
+    TEST_ASSERT_EQUAL_UINT8(0, mock_device_get_canvas_point(14, 318));
+    TEST_ASSERT_EQUAL_UINT8(0, mock_device_get_canvas_point(0, 0));
+    TEST_ASSERT_TRUE(mock_device_verify_palette(1, 255, 0, 0));
+
+    tearDown_with_turtle();
+}
+
+void test_loadpic_rejects_other_compression(void)
+{
+    setUp_with_turtle();
+    mock_device_set_gfx_codec(true);
+    mock_device_paint_canvas(0, 0, 320, 320, 2);
+
+    Result r = run_string("savepic \"a.rle");
+    TEST_ASSERT_EQUAL(RESULT_NONE, r.status);
+    MockFile *file = mock_fs_get_file("a.rle", false);
+    file->data[BMP_FILE_HEADER_SIZE + 16] = 2;  // BI_RLE4
+
+    r = run_string("loadpic \"a.rle");
+    TEST_ASSERT_EQUAL(RESULT_ERROR, r.status);
+    TEST_ASSERT_EQUAL(ERR_FILE_WRONG_TYPE, result_get_error_code(r));
+
+    tearDown_with_turtle();
+}
+
 //==========================================================================
 // Load/Save Tests
 //==========================================================================
@@ -261,6 +438,18 @@ void test_load_defines_one_line_procedures(void)
 }
 
 // `end` inside a list is an ordinary word, not a terminator.
+void test_load_definition_without_end_is_an_error(void)
+{
+    mock_fs_create_file("cut.logo", "make \"a 1\nto half :n\noutput :n / 2\n");
+
+    Result r = run_string("load \"cut.logo");
+    TEST_ASSERT_EQUAL(RESULT_ERROR, r.status);
+    TEST_ASSERT_EQUAL(ERR_END_OF_DATA, result_get_error_code(r));
+    TEST_ASSERT_FALSE(proc_exists("half"));
+    Value a;
+    TEST_ASSERT_TRUE(var_get("a", &a));
+}
+
 void test_load_end_inside_list_does_not_close_definition(void)
 {
     mock_fs_create_file("endword.logo", "to f  make \"w [the end]  end\nf\n");
@@ -661,11 +850,11 @@ void test_load_with_prefix(void)
     TEST_ASSERT_EQUAL_FLOAT(42.0, val.as.number);
 }
 
-void test_load_oversize_procedure_reports_error(void)
+void test_load_defines_a_procedure_larger_than_the_old_buffer(void)
 {
-    // Build a procedure body with enough lines that the accumulated text
-    // exceeds the load buffer (LOAD_MAX_PROC = 4096). Each line is 60 bytes
-    // plus newline; 100 such lines is ~6.1 KB, well over the limit.
+    // 100 lines of about 60 bytes: some 6 KB of body, past the 4 KB text
+    // buffer load used to copy a definition into. The body is built
+    // straight into lists now, so only the node pool bounds it.
     char *content = malloc(8192);
     TEST_ASSERT_NOT_NULL(content);
 
@@ -676,17 +865,131 @@ void test_load_oversize_procedure_reports_error(void)
         pos += snprintf(content + pos, 8192 - pos,
                         "make \"line%d \"this_line_is_about_sixty_chars_long_padding_xx\n", i);
     }
-    pos += snprintf(content + pos, 8192 - pos, "end\n");
+    pos += snprintf(content + pos, 8192 - pos, "end\nbigproc\n");
 
     mock_fs_create_file("big.logo", content);
     free(content);
 
     Result r = run_string("load \"big.logo");
+    TEST_ASSERT_EQUAL(RESULT_NONE, r.status);
+    TEST_ASSERT_TRUE(proc_exists("bigproc"));
+
+    Value val;
+    TEST_ASSERT_TRUE(var_get("line99", &val));
+    TEST_ASSERT_EQUAL_STRING("this_line_is_about_sixty_chars_long_padding_xx",
+                             mem_word_ptr(val.as.node));
+}
+
+void test_load_runs_an_instruction_whose_list_spans_lines(void)
+{
+    mock_fs_create_file("span.logo",
+                        "make \"colours [red\ngreen\n  blue]\nmake \"n count :colours\n");
+
+    Result r = run_string("load \"span.logo");
+    TEST_ASSERT_EQUAL(RESULT_NONE, r.status);
+
+    Value val;
+    TEST_ASSERT_TRUE(var_get("n", &val));
+    TEST_ASSERT_EQUAL_FLOAT(3.0, val.as.number);
+}
+
+void test_load_report_counts_the_last_load(void)
+{
+    const char *text = "to twice :n\noutput :n * 2\nend\nmake \"a twice 2 make \"b 3\n";
+    mock_fs_create_file("count.logo", text);
+
+    Result r = run_string("load \"count.logo");
+    TEST_ASSERT_EQUAL(RESULT_NONE, r.status);
+
+    r = run_string("make \"report .load.report");
+    TEST_ASSERT_EQUAL(RESULT_NONE, r.status);
+    Value report;
+    TEST_ASSERT_TRUE(var_get("report", &report));
+    TEST_ASSERT_TRUE(value_is_list(report));
+
+    // [bytes microseconds atoms cells procedures instructions]
+    float figures[6];
+    Node n = report.as.node;
+    for (int i = 0; i < 6; i++)
+    {
+        TEST_ASSERT_FALSE(mem_is_nil(n));
+        TEST_ASSERT_TRUE(value_to_number(value_of_element(mem_car(n)), &figures[i]));
+        n = mem_cdr(n);
+    }
+    TEST_ASSERT_TRUE(mem_is_nil(n));
+
+    TEST_ASSERT_EQUAL_FLOAT((float)strlen(text), figures[0]);
+    TEST_ASSERT_TRUE(figures[3] > 0);               // The body's cells
+    TEST_ASSERT_EQUAL_FLOAT(1.0f, figures[4]);      // twice
+    TEST_ASSERT_EQUAL_FLOAT(2.0f, figures[5]);      // Both makes
+}
+
+void test_load_reads_a_mapped_file_in_place(void)
+{
+    // No newline at the end: the last line still runs
+    mock_fs_create_file("mapped.logo",
+                        "to double :n\r\noutput :n * 2\r\nend\r\nmake \"x double 21");
+    mock_fs_mappable = true;
+
+    Result r = run_string("load \"mapped.logo");
+    TEST_ASSERT_EQUAL(RESULT_NONE, r.status);
+    TEST_ASSERT_TRUE(proc_exists("double"));
+    Value x;
+    TEST_ASSERT_TRUE(var_get("x", &x));
+    TEST_ASSERT_EQUAL_FLOAT(42.0f, x.as.number);
+
+    TEST_ASSERT_EQUAL_INT(1, mock_fs_maps);
+    TEST_ASSERT_EQUAL_INT(1, mock_fs_unmaps);
+    TEST_ASSERT_EQUAL_INT(0, logo_io_open_count(&mock_io));
+}
+
+void test_load_of_a_file_that_erases_itself_stops_with_the_file_intact(void)
+{
+    const char *text = "make \"a 1\nerasefile \"self.logo\nmake \"b 2\n";
+    mock_fs_create_file("self.logo", text);
+    mock_fs_mappable = true;
+
+    Result r = run_string("load \"self.logo");
     TEST_ASSERT_EQUAL(RESULT_ERROR, r.status);
-    TEST_ASSERT_EQUAL(ERR_OUT_OF_SPACE, result_get_error_code(r));
+    TEST_ASSERT_EQUAL(ERR_FILE_ALREADY_OPEN, result_get_error_code(r));
+    Value v;
+    TEST_ASSERT_TRUE(var_get("a", &v));
+    TEST_ASSERT_FALSE(var_get("b", &v));
+    TEST_ASSERT_EQUAL_STRING(text, mock_fs_get_file("self.logo", false)->data);
+    TEST_ASSERT_EQUAL_INT(1, mock_fs_unmaps);
+
+    // Unmapped once load returns
+    TEST_ASSERT_EQUAL(RESULT_NONE, run_string("erasefile \"self.logo").status);
+}
 
-    // The truncated procedure must NOT have been defined.
-    TEST_ASSERT_FALSE(proc_exists("bigproc"));
+void test_load_of_a_file_that_rewrites_itself_stops_with_the_file_intact(void)
+{
+    const char *text = "make \"a 1\nopen \"self.logo\nsetwrite \"self.logo\n"
+                       "print \"gone\nclose \"self.logo\nmake \"b 2\n";
+    mock_fs_create_file("self.logo", text);
+    mock_fs_mappable = true;
+
+    Result r = run_string("load \"self.logo");
+    TEST_ASSERT_EQUAL(ERR_FILE_ALREADY_OPEN, result_get_error_code(r));
+    Value v;
+    TEST_ASSERT_FALSE(var_get("b", &v));
+    TEST_ASSERT_EQUAL_STRING(text, mock_fs_get_file("self.logo", false)->data);
+    TEST_ASSERT_TRUE(logo_io_writer_is_screen(&mock_io));
+    TEST_ASSERT_EQUAL_INT(0, logo_io_open_count(&mock_io));
+}
+
+void test_load_reads_an_open_file_through_its_stream(void)
+{
+    mock_fs_create_file("open.logo", "make \"y 7\n");
+    mock_fs_mappable = true;
+    run_string("open \"open.logo");
+
+    Result r = run_string("load \"open.logo");
+    TEST_ASSERT_EQUAL(RESULT_NONE, r.status);
+    Value y;
+    TEST_ASSERT_TRUE(var_get("y", &y));
+    TEST_ASSERT_EQUAL_FLOAT(7.0f, y.as.number);
+    TEST_ASSERT_EQUAL_INT(0, mock_fs_maps);
 }
 
 void test_save_with_prefix(void)
@@ -751,6 +1054,147 @@ void test_save_load_preserves_empty_list(void)
         "Empty list should be preserved through save/load roundtrip");
 }
 
+//==========================================================================
+// Workspace Image Tests
+//==========================================================================
+
+static void make_image_workspace(void)
+{
+    proc_define_from_text("to double :n\noutput :n * 2\nend\n");
+    proc_define_from_text("to hidden\nmake \"hid 1\nend\n");
+    run_string("bury \"hidden");
+    run_string("make \"x 21");
+    run_string("make \"colors [red [green blue]]");
+    run_string("pprop \"fido \"breed \"terrier");
+}
+
+void test_savews_loadws_round_trip(void)
+{
+    make_image_workspace();
+    Result r = run_string(".savews \"game.img");
+    TEST_ASSERT_EQUAL(RESULT_NONE, r.status);
+
+    run_string("erall");
+    run_string("erase \"hidden");
+    TEST_ASSERT_FALSE(proc_exists("double"));
+
+    r = run_string(".loadws \"game.img");
+    TEST_ASSERT_EQUAL(RESULT_NONE, r.status);
+
+    TEST_ASSERT_TRUE(proc_exists("double"));
+    TEST_ASSERT_TRUE(proc_find("hidden")->buried);
+    TEST_ASSERT_FALSE(proc_find("double")->buried);
+
+    r = run_string("make \"y double :x");
+    TEST_ASSERT_EQUAL(RESULT_NONE, r.status);
+    Value y;
+    TEST_ASSERT_TRUE(var_get("y", &y));
+    TEST_ASSERT_EQUAL_FLOAT(42.0f, y.as.number);
+
+    reset_output();
+    run_string("print :colors print gprop \"fido \"breed");
+    TEST_ASSERT_EQUAL_STRING("red [green blue]\nterrier\n", output_buffer);
+
+    // The restored atom table still interns: a new word finds the old atom
+    r = run_string("make \"same equalp \"terrier gprop \"fido \"breed");
+    Value same;
+    TEST_ASSERT_TRUE(var_get("same", &same));
+    TEST_ASSERT_TRUE(value_is_word(same));
+    TEST_ASSERT_EQUAL_STRING("true", mem_word_ptr(same.as.node));
+}
+
+void test_loadws_replaces_the_workspace(void)
+{
+    run_string("make \"kept 1");
+    run_string(".savews \"base.img");
+    run_string("make \"later 2");
+    proc_define_from_text("to later\nend\n");
+
+    Result r = run_string(".loadws \"base.img");
+    TEST_ASSERT_EQUAL(RESULT_NONE, r.status);
+    TEST_ASSERT_TRUE(var_exists("kept"));
+    TEST_ASSERT_FALSE(var_exists("later"));
+    TEST_ASSERT_FALSE(proc_exists("later"));
+}
+
+void test_loadws_runs_startup(void)
+{
+    run_string("make \"startup [make \"ran_startup 1]");
+    run_string(".savews \"start.img");
+    TEST_ASSERT_FALSE(var_exists("ran_startup"));
+
+    Result r = run_string(".loadws \"start.img");
+    TEST_ASSERT_EQUAL(RESULT_NONE, r.status);
+    Value val;
+    TEST_ASSERT_TRUE(var_get("ran_startup", &val));
+    TEST_ASSERT_EQUAL_FLOAT(1.0f, val.as.number);
+}
+
+void test_loadws_reads_a_mapped_file_in_place(void)
+{
+    make_image_workspace();
+    run_string(".savews \"mapped.img");
+    run_string("erall");
+    mock_fs_mappable = true;
+
+    Result r = run_string(".loadws \"mapped.img");
+    TEST_ASSERT_EQUAL(RESULT_NONE, r.status);
+    TEST_ASSERT_TRUE(proc_exists("double"));
+    TEST_ASSERT_EQUAL_INT(1, mock_fs_maps);
+    TEST_ASSERT_EQUAL_INT(1, mock_fs_unmaps);
+    TEST_ASSERT_EQUAL_INT(0, logo_io_open_count(&mock_io));
+}
+
+void test_loadws_rejects_a_damaged_image_and_keeps_the_workspace(void)
+{
+    run_string("make \"x 1");
+    run_string(".savews \"bad.img");
+    MockFile *file = mock_fs_get_file("bad.img", false);
+    TEST_ASSERT_NOT_NULL(file);
+    file->data[file->size - 1] ^= 0x5a;  // Inside the body: only the crc sees it
+
+    mock_fs_create_file("source.logo", "make \"x 2\n");
+    run_string("make \"x 3");
+
+    Result r = run_string(".loadws \"bad.img");
+    TEST_ASSERT_EQUAL(RESULT_ERROR, r.status);
+    TEST_ASSERT_EQUAL(ERR_FILE_WRONG_TYPE, result_get_error_code(r));
+    r = run_string(".loadws \"source.logo");
+    TEST_ASSERT_EQUAL(ERR_FILE_WRONG_TYPE, result_get_error_code(r));
+
+    Value x;
+    TEST_ASSERT_TRUE(var_get("x", &x));
+    TEST_ASSERT_EQUAL_FLOAT(3.0f, x.as.number);
+}
+
+void test_loadws_only_at_top_level(void)
+{
+    run_string(".savews \"top.img");
+    proc_define_from_text("to reload\n.loadws \"top.img\nend\n");
+    run_string("make \"x 5");
+
+    Result r = run_string("reload");
+    TEST_ASSERT_EQUAL(RESULT_ERROR, r.status);
+    TEST_ASSERT_EQUAL(ERR_CANT_USE_PROCEDURE, result_get_error_code(r));
+    r = run_string("run [.loadws \"top.img]");
+    TEST_ASSERT_EQUAL(ERR_CANT_USE_PROCEDURE, result_get_error_code(r));
+    TEST_ASSERT_TRUE(var_exists("x"));
+}
+
+void test_savews_file_exists_error(void)
+{
+    mock_fs_create_file("exists.img", "");
+    Result r = run_string(".savews \"exists.img");
+    TEST_ASSERT_EQUAL(RESULT_ERROR, r.status);
+    TEST_ASSERT_EQUAL(ERR_FILE_EXISTS, result_get_error_code(r));
+}
+
+void test_loadws_file_not_found(void)
+{
+    Result r = run_string(".loadws \"missing.img");
+    TEST_ASSERT_EQUAL(ERR_FILE_NOT_FOUND, result_get_error_code(r));
+}
+
 //==========================================================================
 // Pofile Tests
 //==========================================================================
@@ -833,16 +1277,22 @@ int main(void)
     RUN_TEST(test_savepic_disk_trouble_error);
     RUN_TEST(test_savepic_invalid_input_error);
     RUN_TEST(test_loadpic_loads_file);
+    RUN_TEST(test_loadpic_replaces_a_stamped_board);
     RUN_TEST(test_loadpic_file_not_found_error);
     RUN_TEST(test_loadpic_wrong_type_error);
     RUN_TEST(test_loadpic_invalid_input_error);
     RUN_TEST(test_savepic_with_prefix);
     RUN_TEST(test_loadpic_with_prefix);
+    RUN_TEST(test_savepic_rle_round_trips_canvas_and_palette);
+    RUN_TEST(test_savepic_bmp_name_is_not_compressed);
+    RUN_TEST(test_loadpic_reads_rle8_escapes);
+    RUN_TEST(test_loadpic_rejects_other_compression);
 
     // Load/Save tests
     RUN_TEST(test_load_executes_file);
     RUN_TEST(test_load_defines_procedure);
     RUN_TEST(test_load_defines_one_line_procedures);
+    RUN_TEST(test_load_definition_without_end_is_an_error);
     RUN_TEST(test_load_end_inside_list_does_not_close_definition);
     RUN_TEST(test_load_calls_procedure_defined_in_same_file);
     RUN_TEST(test_load_calls_nested_procedures);
@@ -871,11 +1321,25 @@ int main(void)
 
     // Prefix handling tests (load/save)
     RUN_TEST(test_load_with_prefix);
-    RUN_TEST(test_load_oversize_procedure_reports_error);
+    RUN_TEST(test_load_defines_a_procedure_larger_than_the_old_buffer);
+    RUN_TEST(test_load_runs_an_instruction_whose_list_spans_lines);
+    RUN_TEST(test_load_report_counts_the_last_load);
+    RUN_TEST(test_load_reads_a_mapped_file_in_place);
+    RUN_TEST(test_load_of_a_file_that_erases_itself_stops_with_the_file_intact);
+    RUN_TEST(test_load_of_a_file_that_rewrites_itself_stops_with_the_file_intact);
+    RUN_TEST(test_load_reads_an_open_file_through_its_stream);
     RUN_TEST(test_save_with_prefix);
     RUN_TEST(test_save_load_preserves_empty_list);
 
     // Pofile tests
+    RUN_TEST(test_savews_loadws_round_trip);
+    RUN_TEST(test_loadws_replaces_the_workspace);
+    RUN_TEST(test_loadws_runs_startup);
+    RUN_TEST(test_loadws_reads_a_mapped_file_in_place);
+    RUN_TEST(test_loadws_rejects_a_damaged_image_and_keeps_the_workspace);
+    RUN_TEST(test_loadws_only_at_top_level);
+    RUN_TEST(test_savews_file_exists_error);
+    RUN_TEST(test_loadws_file_not_found);
     RUN_TEST(test_pofile_prints_file_contents);
     RUN_TEST(test_pofile_empty_file);
     RUN_TEST(test_pofile_file_not_found);
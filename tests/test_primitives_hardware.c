@@ -541,7 +541,11 @@ void test_battery_out_of_nodes_errors(void)
     // surface ERR_OUT_OF_SPACE rather than return a truncated list.
     set_mock_battery(50, false);
 
+    // Keep the chain rooted, or the automatic collection before the call
+    // would free it and the pool would not be exhausted at all.
     Node chain = NODE_NIL;
+    MemGcRootScope scope;
+    mem_gc_roots_push(&scope, &chain, 1);
     for (;;)
     {
         Node c = mem_cons(NODE_NIL, chain);
@@ -553,6 +557,7 @@ void test_battery_out_of_nodes_errors(void)
     }
 
     Result r = eval_string("hw.battery");
+    mem_gc_roots_pop(&scope);
     TEST_ASSERT_EQUAL(RESULT_ERROR, r.status);
     TEST_ASSERT_EQUAL(ERR_OUT_OF_SPACE, result_get_error_code(r));
 }
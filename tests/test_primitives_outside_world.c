@@ -666,6 +666,33 @@ void test_readlist_with_deeply_nested_list(void)
     TEST_ASSERT_EQUAL_STRING("d", mem_word_ptr(d));
 }
 
+// readlist has taken its line from the input before it can run out of space,
+// so a full arena must not lose that line - neither to an error nor to a
+// second run that reads the next one.  The primitive is called directly, as
+// parsing a typed line would itself hit the full arena first.
+void test_readlist_keeps_its_line_when_the_arena_is_full(void)
+{
+    set_mock_input("first line here\nsecond line\n");
+    Lexer lexer;
+    Evaluator eval;
+    lexer_init(&lexer, "");
+    eval_init(&eval, &lexer);
+    eval_set_frames(&eval, proc_get_frame_stack());
+
+    // Garbage that nothing has asked to collect yet
+    mem_set_gc_headroom(0);
+    while (mem_free_nodes() > 0)
+        mem_cons(NODE_NIL, NODE_NIL);
+
+    Result r = eval_call_primitive(&eval, primitive_find("readlist"), 0, NULL);
+    TEST_ASSERT_EQUAL(RESULT_OK, r.status);
+    Node list = r.value.as.node;
+    TEST_ASSERT_EQUAL_STRING("first", mem_word_ptr(mem_car(list)));
+    TEST_ASSERT_EQUAL_STRING("line", mem_word_ptr(mem_car(mem_cdr(list))));
+    TEST_ASSERT_EQUAL_STRING("here", mem_word_ptr(mem_car(mem_cdr(mem_cdr(list)))));
+    TEST_ASSERT_TRUE(mem_is_nil(mem_cdr(mem_cdr(mem_cdr(list)))));
+}
+
 //==========================================================================
 // Main
 //==========================================================================
@@ -742,5 +769,6 @@ int main(void)
     RUN_TEST(test_readlist_with_numbers);
     RUN_TEST(test_readlist_with_nested_list);
     RUN_TEST(test_readlist_with_deeply_nested_list);
+    RUN_TEST(test_readlist_keeps_its_line_when_the_arena_is_full);
     return UNITY_END();
 }
@@ -2374,6 +2374,87 @@ void test_binding_cache_repeated_call_is_the_same_procedure(void)
     TEST_ASSERT_EQUAL_STRING("3\n", output_buffer);
 }
 
+//==========================================================================
+// Compiled procedure code: the body list stays the source of truth
+//==========================================================================
+
+void test_compiled_body_sees_setfirst_through_text(void)
+{
+    // `text` shares the body's cells, so `.setfirst` on what it outputs edits
+    // the running procedure. Its lines have compiled by the third call, and
+    // the edit must still win over the ops.
+    run_string("define \"cc.step [[] [print 1 + 1] [print \"a]]");
+    run_string("repeat 3 [cc.step]");
+    run_string(".setfirst butfirst item 2 text \"cc.step 5");
+    run_string(".setfirst item 3 text \"cc.step \"show");
+    reset_output();
+    run_string("cc.step");
+    TEST_ASSERT_EQUAL_STRING("6\na\n", output_buffer);
+}
+
+void test_compiled_body_replaced_by_redefinition(void)
+{
+    run_string("define \"cc.say [[] [print \"old]]");
+    run_string("repeat 3 [cc.say]");
+    run_string("define \"cc.say [[] [print \"new]]");
+    reset_output();
+    run_string("repeat 2 [cc.say]");
+    TEST_ASSERT_EQUAL_STRING("new\nnew\n", output_buffer);
+}
+
+void test_compiled_body_folds_literal_arithmetic(void)
+{
+    // The folded line gives what the walked one did, precedence and all,
+    // and a division by zero still fails when it runs.
+    run_string("define \"cc.fold [[] [print 360 / 8 * 2 + 1 - 2 * 3]]");
+    run_string("define \"cc.zero [[] [print 1 / 0]]");
+    reset_output();
+    run_string("repeat 3 [cc.fold]");
+    TEST_ASSERT_EQUAL_STRING("85\n85\n85\n", output_buffer);
+    run_string("catch \"error [cc.zero] catch \"error [cc.zero]");
+    Result r = run_string("cc.zero");
+    TEST_ASSERT_EQUAL(RESULT_ERROR, r.status);
+    TEST_ASSERT_EQUAL(ERR_DIVIDE_BY_ZERO, result_get_error_code(r));
+}
+
+//==========================================================================
+// Parameter slots: `:name` remembers its slot but stays dynamically scoped
+//==========================================================================
+
+void test_param_slot_follows_each_procedure(void)
+{
+    // `:y` is slot 1 in ps.a and slot 0 in ps.b; the one atom serves both.
+    run_string("define \"ps.a [[x y] [output :y]]");
+    run_string("define \"ps.b [[y x] [output :y]]");
+    reset_output();
+    run_string("repeat 3 [print ps.a 1 2 print ps.b 3 4]");
+    TEST_ASSERT_EQUAL_STRING("2\n3\n2\n3\n2\n3\n", output_buffer);
+}
+
+void test_param_slot_falls_back_to_dynamic_scope(void)
+{
+    // ps.inner has no inputs, so its `:y` is ps.outer's, and a list run by
+    // ps.runner sees ps.runner's `y` even though it was written in ps.caller,
+    // where `:y` was last read from slot 1.
+    run_string("define \"ps.inner [[] [output :y]]");
+    run_string("define \"ps.outer [[y] [output ps.inner]]");
+    run_string("define \"ps.runner [[y list] [output run :list]]");
+    run_string("define \"ps.caller [[x y] [output (list :y ps.runner 9 [:y])]]");
+    reset_output();
+    run_string("repeat 2 [print ps.outer 5 print ps.caller 1 2]");
+    TEST_ASSERT_EQUAL_STRING("5\n2 9\n5\n2 9\n", output_buffer);
+}
+
+void test_param_slot_keeps_first_of_repeated_input(void)
+{
+    // With an input repeated in another case the first binding wins every
+    // lookup, slot cache or not.
+    run_string("define \"ps.dup [[x X] [output :X]]");
+    reset_output();
+    run_string("repeat 2 [print ps.dup 1 2]");
+    TEST_ASSERT_EQUAL_STRING("1\n1\n", output_buffer);
+}
+
 //==========================================================================
 // B32: a body longer than 255 lines re-runs statements
 //==========================================================================
@@ -2429,6 +2510,14 @@ int main(void)
     RUN_TEST(test_binding_cache_learns_an_alias_made_by_copydef);
     RUN_TEST(test_binding_cache_repeated_call_is_the_same_procedure);
 
+    // Compiled procedure code
+    RUN_TEST(test_compiled_body_sees_setfirst_through_text);
+    RUN_TEST(test_compiled_body_replaced_by_redefinition);
+    RUN_TEST(test_compiled_body_folds_literal_arithmetic);
+    RUN_TEST(test_param_slot_follows_each_procedure);
+    RUN_TEST(test_param_slot_falls_back_to_dynamic_scope);
+    RUN_TEST(test_param_slot_keeps_first_of_repeated_input);
+
     RUN_TEST(test_simple_procedure_no_args);
     RUN_TEST(test_procedure_with_one_arg);
     RUN_TEST(test_procedure_with_two_args);
@@ -267,27 +267,38 @@ void test_remprop_requires_word_for_property(void)
     TEST_ASSERT_EQUAL(ERR_DOESNT_LIKE_INPUT, result_get_error_code(r));
 }
 
-// pprop of a numeric value must error, not silently store NIL, when the
-// atom table is too full to intern the formatted number. The name/property
-// words are interned first so only the value conversion fails.
-void test_pprop_number_out_of_atoms_errors(void)
+// pprop of a numeric value needs no atom space: the value is stored as a
+// number node, not as its formatted word. The name/property words are
+// interned first so only the value would have needed the table.
+void test_pprop_number_out_of_atoms_succeeds(void)
 {
     mem_atom_cstr("k");
     mem_atom_cstr("p");
 
+    // The filler words stay reachable, or the automatic collection before
+    // pprop would free them and the table would not be full.
+    Node filler = NODE_NIL;
+    MemGcRootScope scope;
+    mem_gc_roots_push(&scope, &filler, 1);
     char buf[16];
     for (int i = 0;; i++)
     {
         int len = snprintf(buf, sizeof(buf), "a%d", i);
-        if (mem_is_nil(mem_atom(buf, (size_t)len)))
+        Node atom = mem_atom(buf, (size_t)len);
+        if (mem_is_nil(atom))
         {
             break;
         }
+        filler = mem_cons(atom, filler);
     }
 
     Result r = eval_string("pprop \"k \"p 123456");
-    TEST_ASSERT_EQUAL(RESULT_ERROR, r.status);
-    TEST_ASSERT_EQUAL(ERR_OUT_OF_SPACE, result_get_error_code(r));
+    TEST_ASSERT_NOT_EQUAL(RESULT_ERROR, r.status);
+    r = eval_string("gprop \"k \"p");
+    mem_gc_roots_pop(&scope);
+    TEST_ASSERT_EQUAL(RESULT_OK, r.status);
+    TEST_ASSERT_EQUAL(VALUE_NUMBER, r.value.type);
+    TEST_ASSERT_EQUAL_FLOAT(123456.0f, r.value.as.number);
 }
 
 // Case insensitivity tests
@@ -344,7 +355,7 @@ int main(void)
     RUN_TEST(test_property_names_are_case_insensitive);
 
     // Out-of-space handling
-    RUN_TEST(test_pprop_number_out_of_atoms_errors);
+    RUN_TEST(test_pprop_number_out_of_atoms_succeeds);
     
     return UNITY_END();
 }
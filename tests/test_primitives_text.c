@@ -7,6 +7,7 @@
 
 #include "test_scaffold.h"
 #include "mock_device.h"
+#include <stdint.h>
 #include <string.h>
 
 void setUp(void)
@@ -588,6 +589,30 @@ void test_sync_presents_frame(void)
     TEST_ASSERT_EQUAL(before + 1, state->refresh_now_count);
 }
 
+// sync spends the frame's slack on an incremental collection. It needs a
+// clock to have any slack, so this one test wires up the mock hardware; the
+// mock clock does not advance, so a whole cycle fits in one call.
+void test_sync_collects_in_the_idle_slack(void)
+{
+    test_scaffold_tearDown();
+    test_scaffold_setUp_with_device_and_hardware();
+
+    run_string("make \"keep [important data]");
+    run_string("repeat 50 [make \"junk (list 1 2 3 4 5 6 7 8)]");
+    mem_set_gc_idle_start(SIZE_MAX);
+    size_t collections = mem_gc_count();
+
+    run_string("(setrefresh \"sync 30)");
+    run_string("sync");
+    TEST_ASSERT_EQUAL(collections + 1, mem_gc_count());
+    TEST_ASSERT_EQUAL(MEM_GC_IDLE, mem_gc_phase());
+
+    run_string("repeat 50 [make \"junk (list 9 9 9 9 9 9 9 9)]");
+    Result r = eval_string("last :keep");
+    TEST_ASSERT_EQUAL(RESULT_OK, r.status);
+    TEST_ASSERT_EQUAL_STRING("data", value_to_string(r.value));
+}
+
 void test_setrefresh_auto_leaves_sync_mode(void)
 {
     run_string("(setrefresh \"sync 30)");
@@ -683,6 +708,7 @@ int main(void)
     RUN_TEST(test_setrefresh_sync_accepts_rate);
     RUN_TEST(test_setrefresh_sync_rejects_bad_rate);
     RUN_TEST(test_sync_presents_frame);
+    RUN_TEST(test_sync_collects_in_the_idle_slack);
     RUN_TEST(test_setrefresh_auto_leaves_sync_mode);
     RUN_TEST(test_cs_restores_from_sync);
 
@@ -15,6 +15,9 @@
 #include "test_scaffold.h"
 #include "mock_device.h"
 #include "core/error.h"
+#include "core/limits.h"
+#include "core/primitives.h"
+#include "core/tilemap.h"
 
 //==========================================================================
 // Test setup/teardown
@@ -357,6 +360,323 @@ void test_newtiles_empties_the_bank_so_cells_render_as_background(void)
     assert_canvas_block(0, 0, 8, 8, 0);
 }
 
+//==========================================================================
+// Bulk updates and animation
+//==========================================================================
+
+void test_settiles_writes_a_block_of_rows(void)
+{
+    TEST_ASSERT_EQUAL(RESULT_NONE, run_string("newmap 4 3").status);
+    TEST_ASSERT_EQUAL(RESULT_NONE, run_string("settiles 2 1 [[1 2 3] [4 5]]").status);
+
+    TEST_ASSERT_EQUAL_FLOAT(1.0f, eval_string("tile 2 1").value.as.number);
+    TEST_ASSERT_EQUAL_FLOAT(3.0f, eval_string("tile 4 1").value.as.number);
+    TEST_ASSERT_EQUAL_FLOAT(5.0f, eval_string("tile 3 2").value.as.number);
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, eval_string("tile 4 2").value.as.number);  // short row
+
+    // A list of numbers is one row
+    TEST_ASSERT_EQUAL(RESULT_NONE, run_string("settiles 1 3 [7 8]").status);
+    TEST_ASSERT_EQUAL_FLOAT(8.0f, eval_string("tile 2 3").value.as.number);
+}
+
+void test_settiles_checks_the_whole_block_before_writing(void)
+{
+    TEST_ASSERT_EQUAL(RESULT_NONE, run_string("newmap 4 3").status);
+
+    Result r = run_string("settiles 1 1 [[1 2] [3 256]]");
+    TEST_ASSERT_EQUAL(RESULT_ERROR, r.status);
+    TEST_ASSERT_EQUAL(ERR_DOESNT_LIKE_INPUT, result_get_error_code(r));
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, eval_string("tile 1 1").value.as.number);
+
+    r = run_string("settiles 3 1 [1 2 3]");                 // one too wide
+    TEST_ASSERT_EQUAL(RESULT_ERROR, r.status);
+    r = run_string("settiles 1 3 [[1] [2]]");               // one too tall
+    TEST_ASSERT_EQUAL(RESULT_ERROR, r.status);
+    r = run_string("settiles 1 1 [[1] 2]");                 // rows mixed with numbers
+    TEST_ASSERT_EQUAL(RESULT_ERROR, r.status);
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, eval_string("tile 3 1").value.as.number);
+}
+
+void test_filltiles_and_copytiles_check_their_rectangles(void)
+{
+    TEST_ASSERT_EQUAL(RESULT_NONE, run_string("newmap 4 3").status);
+    TEST_ASSERT_EQUAL(RESULT_NONE, run_string("filltiles 1 1 2 2 6").status);
+    TEST_ASSERT_EQUAL_FLOAT(6.0f, eval_string("tile 2 2").value.as.number);
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, eval_string("tile 3 2").value.as.number);
+
+    TEST_ASSERT_EQUAL(RESULT_NONE, run_string("copytiles 1 1 2 2 3 2").status);
+    TEST_ASSERT_EQUAL_FLOAT(6.0f, eval_string("tile 4 3").value.as.number);
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, eval_string("tile 4 1").value.as.number);
+
+    Result r = run_string("filltiles 3 1 3 1 6");           // one too wide
+    TEST_ASSERT_EQUAL(RESULT_ERROR, r.status);
+    TEST_ASSERT_EQUAL(ERR_DOESNT_LIKE_INPUT, result_get_error_code(r));
+    r = run_string("copytiles 1 1 2 2 4 1");                // lands off the edge
+    TEST_ASSERT_EQUAL(RESULT_ERROR, r.status);
+    r = run_string("filltiles 1 1 1 1 256");
+    TEST_ASSERT_EQUAL(RESULT_ERROR, r.status);
+}
+
+void test_shifttiles_wraps_the_map_around(void)
+{
+    TEST_ASSERT_EQUAL(RESULT_NONE, run_string("newmap 3 1").status);
+    TEST_ASSERT_EQUAL(RESULT_NONE, run_string("settiles 1 1 [1 2 3]").status);
+
+    TEST_ASSERT_EQUAL(RESULT_NONE, run_string("shifttiles -1 0").status);
+    TEST_ASSERT_EQUAL_FLOAT(2.0f, eval_string("tile 1 1").value.as.number);
+    TEST_ASSERT_EQUAL_FLOAT(1.0f, eval_string("tile 3 1").value.as.number);
+
+    TEST_ASSERT_EQUAL(RESULT_NONE, run_string("setlayer 2").status);
+    TEST_ASSERT_EQUAL(RESULT_ERROR, run_string("shifttiles 1 0").status);  // no map here
+}
+
+void test_bulk_updates_rebake_only_their_cells_once_stamped(void)
+{
+    TEST_ASSERT_EQUAL(RESULT_NONE, run_string("newtiles 8").status);
+    capture_tile(1, 7);
+    TEST_ASSERT_EQUAL(RESULT_NONE, run_string("newmap 4 4").status);
+
+    // Before stampmap the board is not on the canvas, so nothing is painted
+    TEST_ASSERT_EQUAL(RESULT_NONE, run_string("filltiles 1 1 1 1 1").status);
+    assert_canvas_block(0, 0, 8, 8, 0);
+
+    TEST_ASSERT_EQUAL(RESULT_NONE, run_string("stampmap").status);
+    mock_device_paint_canvas(16, 0, 8, 8, 42);              // a cell left alone
+
+    TEST_ASSERT_EQUAL(RESULT_NONE, run_string("filltiles 2 1 1 2 1").status);
+    assert_baked_tile(8, 0, 7);
+    assert_baked_tile(8, 8, 7);
+    assert_canvas_block(16, 0, 8, 8, 42);
+
+    TEST_ASSERT_EQUAL(RESULT_NONE, run_string("settiles 3 2 [1]").status);
+    assert_baked_tile(16, 8, 7);
+    assert_canvas_block(16, 0, 8, 8, 42);
+
+    // A cleared screen is no longer the board
+    TEST_ASSERT_EQUAL(RESULT_NONE, run_string("cs").status);
+    TEST_ASSERT_EQUAL(RESULT_NONE, run_string("filltiles 4 4 1 1 1").status);
+    assert_canvas_block(24, 24, 8, 8, 0);
+}
+
+void test_stamptile_repaints_a_cell_cut_by_the_viewport_edge(void)
+{
+    TEST_ASSERT_EQUAL(RESULT_NONE, run_string("newtiles 8").status);
+    capture_tile(1, 7);
+    TEST_ASSERT_EQUAL(RESULT_NONE, run_string("newmap 4 4").status);
+    TEST_ASSERT_EQUAL(RESULT_NONE, run_string("setscroll 4 0").status);
+    TEST_ASSERT_EQUAL(RESULT_NONE, run_string("settile 1 1 1").status);
+
+    // Cell (1,1) starts 4 px left of the screen: its right half is on it
+    TEST_ASSERT_EQUAL(RESULT_NONE, run_string("stamptile 1 1").status);
+    TEST_ASSERT_EQUAL_UINT8(TILE_MARK_BR, mock_device_get_canvas_point(3, 7));
+    TEST_ASSERT_EQUAL_UINT8(7, mock_device_get_canvas_point(0, 0));
+}
+
+void test_animtile_rebakes_the_cells_that_show_the_slot(void)
+{
+    TEST_ASSERT_EQUAL(RESULT_NONE, run_string("newtiles 8").status);
+    capture_tile(1, 7);
+    capture_tile(2, 9);
+    capture_tile(3, 11);
+    TEST_ASSERT_EQUAL(RESULT_NONE, run_string("newmap 4 4").status);
+    TEST_ASSERT_EQUAL(RESULT_NONE, run_string("settiles 1 1 [1 3 1]").status);
+    TEST_ASSERT_EQUAL(RESULT_NONE, run_string("stampmap").status);
+
+    TEST_ASSERT_EQUAL(RESULT_NONE, run_string("animtile 1 [1 2] 100").status);
+    tiles_tick(50);
+    assert_baked_tile(0, 0, 7);
+
+    mock_device_paint_canvas(8, 0, 8, 8, 42);               // the slot 3 cell
+    tiles_tick(50);
+    assert_baked_tile(0, 0, 9);
+    assert_baked_tile(16, 0, 9);
+    assert_canvas_block(8, 0, 8, 8, 42);                    // untouched
+
+    // The map still says 1
+    TEST_ASSERT_EQUAL_FLOAT(1.0f, eval_string("tile 1 1").value.as.number);
+
+    // Stopping shows the slot itself again, at once
+    TEST_ASSERT_EQUAL(RESULT_NONE, run_string("animtile 1 [] 0").status);
+    assert_baked_tile(0, 0, 7);
+}
+
+void test_clean_wipes_the_board_so_animations_stop_rebaking(void)
+{
+    TEST_ASSERT_EQUAL(RESULT_NONE, run_string("newtiles 8").status);
+    capture_tile(1, 7);
+    capture_tile(2, 9);
+    TEST_ASSERT_EQUAL(RESULT_NONE, run_string("newmap 2 2").status);
+    TEST_ASSERT_EQUAL(RESULT_NONE, run_string("settile 1 1 1").status);
+    TEST_ASSERT_EQUAL(RESULT_NONE, run_string("stampmap").status);
+    TEST_ASSERT_EQUAL(RESULT_NONE, run_string("animtile 1 [1 2] 100").status);
+
+    TEST_ASSERT_EQUAL(RESULT_NONE, run_string("clean").status);
+    mock_device_paint_canvas(0, 0, 8, 8, 42);               // drawn after clean
+    tiles_tick(100);
+    assert_canvas_block(0, 0, 8, 8, 42);
+}
+
+void test_board_goes_stale_when_the_scroll_or_viewport_moves(void)
+{
+    TEST_ASSERT_EQUAL(RESULT_NONE, run_string("newtiles 8").status);
+    capture_tile(1, 7);
+    TEST_ASSERT_EQUAL(RESULT_NONE, run_string("newmap 4 4").status);
+    TEST_ASSERT_EQUAL(RESULT_NONE, run_string("stampmap").status);
+
+    // Setting the scroll it already has keeps the board
+    TEST_ASSERT_EQUAL(RESULT_NONE, run_string("setscroll 0 0").status);
+    TEST_ASSERT_EQUAL(RESULT_NONE, run_string("filltiles 1 1 1 1 1").status);
+    assert_baked_tile(0, 0, 7);
+
+    TEST_ASSERT_EQUAL(RESULT_NONE, run_string("setscroll 8 0").status);
+    mock_device_paint_canvas(0, 0, 16, 16, 42);
+    TEST_ASSERT_EQUAL(RESULT_NONE, run_string("filltiles 1 1 2 2 1").status);
+    assert_canvas_block(0, 0, 16, 16, 42);
+
+    TEST_ASSERT_EQUAL(RESULT_NONE, run_string("stampmap").status);
+    tilemap_set_viewport(8, 8, 0, 0);
+    mock_device_paint_canvas(0, 0, 32, 32, 42);
+    TEST_ASSERT_EQUAL(RESULT_NONE, run_string("filltiles 3 3 2 2 1").status);
+    assert_canvas_block(0, 0, 32, 32, 42);
+
+    // newmap and newtiles drop a fresh stamp too
+    tilemap_set_viewport(0, 0, 0, 0);
+    TEST_ASSERT_EQUAL(RESULT_NONE, run_string("stampmap").status);
+    TEST_ASSERT_EQUAL(RESULT_NONE, run_string("newmap 4 4").status);
+    mock_device_paint_canvas(0, 0, 8, 8, 42);
+    TEST_ASSERT_EQUAL(RESULT_NONE, run_string("filltiles 1 1 1 1 1").status);
+    assert_canvas_block(0, 0, 8, 8, 42);
+
+    TEST_ASSERT_EQUAL(RESULT_NONE, run_string("stampmap").status);
+    TEST_ASSERT_EQUAL(RESULT_NONE, run_string("newtiles 8").status);
+    mock_device_paint_canvas(0, 0, 8, 8, 42);
+    TEST_ASSERT_EQUAL(RESULT_NONE, run_string("filltiles 1 1 1 1 0").status);
+    assert_canvas_block(0, 0, 8, 8, 42);
+}
+
+void test_animtile_checks_its_inputs(void)
+{
+    TEST_ASSERT_EQUAL(RESULT_NONE, run_string("newtiles 8").status);
+
+    Result r = run_string("animtile 0 [1 2] 100");
+    TEST_ASSERT_EQUAL(RESULT_ERROR, r.status);
+    TEST_ASSERT_EQUAL(ERR_DOESNT_LIKE_INPUT, result_get_error_code(r));
+
+    r = run_string("animtile 1 [1 2 3 4 5 6 7 8 9] 100");
+    TEST_ASSERT_EQUAL(RESULT_ERROR, r.status);
+    r = run_string("animtile 1 [1 x] 100");
+    TEST_ASSERT_EQUAL(RESULT_ERROR, r.status);
+    r = run_string("animtile 1 [1 2] -1");
+    TEST_ASSERT_EQUAL(RESULT_ERROR, r.status);
+
+    for (int slot = 1; slot <= TILEMAP_ANIMS; slot++)
+    {
+        char cmd[40];
+        snprintf(cmd, sizeof(cmd), "animtile %d [1 2] 100", slot);
+        TEST_ASSERT_EQUAL(RESULT_NONE, run_string(cmd).status);
+    }
+    r = run_string("animtile 17 [1 2] 100");
+    TEST_ASSERT_EQUAL(RESULT_ERROR, r.status);
+    TEST_ASSERT_EQUAL(ERR_OUT_OF_SPACE, result_get_error_code(r));
+}
+
+//==========================================================================
+// Layers and scroll
+//==========================================================================
+
+void test_setlayer_picks_one_of_the_layers(void)
+{
+    Result r = eval_string("layer");
+    TEST_ASSERT_EQUAL(RESULT_OK, r.status);
+    TEST_ASSERT_EQUAL_FLOAT(1.0f, r.value.as.number);
+
+    TEST_ASSERT_EQUAL(RESULT_NONE, run_string("setlayer 3").status);
+    r = eval_string("layer");
+    TEST_ASSERT_EQUAL_FLOAT(3.0f, r.value.as.number);
+
+    r = run_string("setlayer 0");
+    TEST_ASSERT_EQUAL(RESULT_ERROR, r.status);
+    TEST_ASSERT_EQUAL(ERR_DOESNT_LIKE_INPUT, result_get_error_code(r));
+
+    r = run_string("setlayer 5");
+    TEST_ASSERT_EQUAL(RESULT_ERROR, r.status);
+}
+
+void test_each_layer_has_its_own_map(void)
+{
+    TEST_ASSERT_EQUAL(RESULT_NONE, run_string("newmap 4 3").status);
+    TEST_ASSERT_EQUAL(RESULT_NONE, run_string("settile 1 1 7").status);
+
+    // Layer 2 has no map until it is given one.
+    TEST_ASSERT_EQUAL(RESULT_NONE, run_string("setlayer 2").status);
+    TEST_ASSERT_EQUAL(RESULT_ERROR, eval_string("tile 1 1").status);
+
+    TEST_ASSERT_EQUAL(RESULT_NONE, run_string("newmap 2 2").status);
+    TEST_ASSERT_EQUAL(RESULT_NONE, run_string("settile 1 1 9").status);
+
+    TEST_ASSERT_EQUAL(RESULT_NONE, run_string("setlayer 1").status);
+    Result r = eval_string("tile 1 1");
+    TEST_ASSERT_EQUAL_FLOAT(7.0f, r.value.as.number);
+}
+
+void test_setscroll_is_per_layer_and_floors(void)
+{
+    TEST_ASSERT_EQUAL(RESULT_NONE, run_string("setscroll 2.7 -3.5").status);
+    mock_device_clear_output();
+    TEST_ASSERT_EQUAL(RESULT_NONE, run_string("show scroll").status);
+    TEST_ASSERT_EQUAL_STRING("[2 -4]\n", mock_device_get_output());
+
+    TEST_ASSERT_EQUAL(RESULT_NONE, run_string("setlayer 2").status);
+    mock_device_clear_output();
+    TEST_ASSERT_EQUAL(RESULT_NONE, run_string("show scroll").status);
+    TEST_ASSERT_EQUAL_STRING("[0 0]\n", mock_device_get_output());
+
+    Result r = run_string("setscroll \"x 0");
+    TEST_ASSERT_EQUAL(RESULT_ERROR, r.status);
+    TEST_ASSERT_EQUAL(ERR_DOESNT_LIKE_INPUT, result_get_error_code(r));
+}
+
+void test_settransparent_takes_a_colour_or_minus_one(void)
+{
+    Result r = eval_string("transparent");
+    TEST_ASSERT_EQUAL(RESULT_OK, r.status);
+    TEST_ASSERT_EQUAL_FLOAT(-1.0f, r.value.as.number);
+
+    TEST_ASSERT_EQUAL(RESULT_NONE, run_string("settransparent 255").status);
+    r = eval_string("transparent");
+    TEST_ASSERT_EQUAL_FLOAT(255.0f, r.value.as.number);
+
+    TEST_ASSERT_EQUAL(RESULT_NONE, run_string("settransparent -1").status);
+    r = eval_string("transparent");
+    TEST_ASSERT_EQUAL_FLOAT(-1.0f, r.value.as.number);
+
+    r = run_string("settransparent 256");
+    TEST_ASSERT_EQUAL(RESULT_ERROR, r.status);
+    TEST_ASSERT_EQUAL(ERR_DOESNT_LIKE_INPUT, result_get_error_code(r));
+}
+
+void test_stampmap_composites_an_overlay_over_the_base(void)
+{
+    TEST_ASSERT_EQUAL(RESULT_NONE, run_string("newtiles 8").status);
+    capture_tile(1, 7);
+    TEST_ASSERT_EQUAL(RESULT_NONE, run_string("newmap 2 2").status);
+    TEST_ASSERT_EQUAL(RESULT_NONE, run_string("settile 1 1 1").status);
+
+    // The overlay's tile is all see-through but its two marks.
+    capture_tile(2, 9);
+    TEST_ASSERT_EQUAL(RESULT_NONE, run_string("setlayer 2").status);
+    TEST_ASSERT_EQUAL(RESULT_NONE, run_string("newmap 2 2").status);
+    TEST_ASSERT_EQUAL(RESULT_NONE, run_string("settile 1 1 2").status);
+    TEST_ASSERT_EQUAL(RESULT_NONE, run_string("settransparent 9").status);
+
+    TEST_ASSERT_EQUAL(RESULT_NONE, run_string("stampmap").status);
+
+    // The marks come from the overlay, the rest shows the base tile, and
+    // cells empty on both layers are background.
+    assert_baked_tile(0, 0, 7);
+    assert_canvas_block(8, 0, 8, 8, 0);
+}
+
 int main(void)
 {
     UNITY_BEGIN();
@@ -384,5 +704,22 @@ int main(void)
     RUN_TEST(test_bank_and_map_survive_clearscreen);
     RUN_TEST(test_newtiles_empties_the_bank_so_cells_render_as_background);
 
+    RUN_TEST(test_settiles_writes_a_block_of_rows);
+    RUN_TEST(test_settiles_checks_the_whole_block_before_writing);
+    RUN_TEST(test_filltiles_and_copytiles_check_their_rectangles);
+    RUN_TEST(test_shifttiles_wraps_the_map_around);
+    RUN_TEST(test_bulk_updates_rebake_only_their_cells_once_stamped);
+    RUN_TEST(test_stamptile_repaints_a_cell_cut_by_the_viewport_edge);
+    RUN_TEST(test_animtile_rebakes_the_cells_that_show_the_slot);
+    RUN_TEST(test_clean_wipes_the_board_so_animations_stop_rebaking);
+    RUN_TEST(test_board_goes_stale_when_the_scroll_or_viewport_moves);
+    RUN_TEST(test_animtile_checks_its_inputs);
+
+    RUN_TEST(test_setlayer_picks_one_of_the_layers);
+    RUN_TEST(test_each_layer_has_its_own_map);
+    RUN_TEST(test_setscroll_is_per_layer_and_floors);
+    RUN_TEST(test_settransparent_takes_a_colour_or_minus_one);
+    RUN_TEST(test_stampmap_composites_an_overlay_over_the_base);
+
     return UNITY_END();
 }
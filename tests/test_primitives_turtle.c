@@ -751,6 +751,81 @@ void test_fill_command(void)
     TEST_ASSERT_EQUAL(MOCK_CMD_FILL, cmd->type);
 }
 
+void test_filled_fills_the_traced_polygon(void)
+{
+    Result r = run_string("filled 4 [repeat 3 [fd 50 rt 120]]");
+    TEST_ASSERT_EQUAL(RESULT_NONE, r.status);
+
+    TEST_ASSERT_EQUAL_INT(1, mock_device_polygon_count());
+    const MockPolygon *p = mock_device_last_polygon();
+    TEST_ASSERT_EQUAL_INT(4, p->count);  // The start and three moves
+    TEST_ASSERT_EQUAL_UINT8(4, p->colour);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 0.0f, p->xy[0]);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 0.0f, p->xy[1]);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 0.0f, p->xy[2]);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 50.0f, p->xy[3]);
+}
+
+void test_filled_records_every_kind_of_move(void)
+{
+    Result r = run_string("filled 1 [setpos [10 10] setx 20 sety 30 bk 5 home]");
+    TEST_ASSERT_EQUAL(RESULT_NONE, r.status);
+
+    const MockPolygon *p = mock_device_last_polygon();
+    TEST_ASSERT_NOT_NULL(p);
+    const float expected[] = { 0, 0, 10, 10, 20, 10, 20, 30, 20, 25, 0, 0 };
+    TEST_ASSERT_EQUAL_INT(6, p->count);
+    for (int i = 0; i < 12; i++)
+    {
+        TEST_ASSERT_FLOAT_WITHIN(0.01f, expected[i], p->xy[i]);
+    }
+}
+
+void test_filled_needs_three_vertices(void)
+{
+    Result r = run_string("filled 4 [fd 50]");
+    TEST_ASSERT_EQUAL(RESULT_NONE, r.status);
+    TEST_ASSERT_EQUAL_INT(0, mock_device_polygon_count());
+}
+
+void test_filled_does_not_fill_after_an_error(void)
+{
+    Result r = run_string("filled 4 [fd 50 rt 90 fd 50 nosuchproc]");
+    TEST_ASSERT_EQUAL(RESULT_ERROR, r.status);
+    TEST_ASSERT_EQUAL_INT(0, mock_device_polygon_count());
+
+    // The next block starts afresh
+    r = run_string("filled 5 [fd 10 rt 90 fd 10]");
+    TEST_ASSERT_EQUAL(RESULT_NONE, r.status);
+    TEST_ASSERT_EQUAL_INT(3, mock_device_last_polygon()->count);
+}
+
+void test_filled_blocks_nest(void)
+{
+    Result r = run_string("filled 1 [fd 10 filled 2 [rt 90 fd 10 rt 90 fd 10]]");
+    TEST_ASSERT_EQUAL(RESULT_NONE, r.status);
+
+    // The inner block fills first; the outer path runs through it
+    TEST_ASSERT_EQUAL_INT(2, mock_device_polygon_count());
+    const MockPolygon *p = mock_device_last_polygon();
+    TEST_ASSERT_EQUAL_UINT8(1, p->colour);
+    TEST_ASSERT_EQUAL_INT(5, p->count);
+}
+
+void test_filled_outside_a_block_records_nothing(void)
+{
+    run_string("filled 3 [fd 10 rt 90 fd 10]");
+    run_string("fd 20 rt 90 fd 20");
+    TEST_ASSERT_EQUAL_INT(1, mock_device_polygon_count());
+    TEST_ASSERT_EQUAL_INT(3, mock_device_last_polygon()->count);
+}
+
+void test_filled_requires_a_list(void)
+{
+    Result r = run_string("filled 4 \"fd");
+    TEST_ASSERT_EQUAL(RESULT_ERROR, r.status);
+}
+
 void test_dot_requires_list(void)
 {
     Result r = run_string("dot 50");
@@ -1070,7 +1145,7 @@ void test_primitives_are_registered(void)
         "setpc", "pencolor", "pc", "setbg", "background", "bg",
         "hideturtle", "ht", "showturtle", "st", "shown?", "shownp",
         "clearscreen", "cs", "clean",
-        "dot", "dot?", "dotp", "fill",
+        "dot", "dot?", "dotp", "fill", "filled",
         "fence", "window", "wrap",
         "setpalette", "palette", "restorepalette"
     };
@@ -2184,6 +2259,157 @@ void test_touching_rejects_bad_turtle(void)
     TEST_ASSERT_EQUAL(ERR_DOESNT_LIKE_INPUT, result_get_error_code(r));
 }
 
+void test_touching_repacks_a_restaged_raster(void)
+{
+    // The packed mask is cached per turtle; moving turtle 1 away rebuilds
+    // its raster (same buffer, new serial) and must be seen.
+    static uint8_t solid[8 * 8];
+    memset(solid, 1, sizeof(solid));
+    run_string("window");
+    stage_raster(0, 100, 100, 8, 8, false, true, solid);
+    stage_raster(1, 104, 104, 8, 8, false, true, solid);
+    run_string("print touching? 0 1");
+    TEST_ASSERT_TRUE(output_has("true"));
+
+    mock_device_clear_output();
+    stage_raster(1, 150, 100, 8, 8, false, true, solid);
+    run_string("print touching? 0 1");
+    TEST_ASSERT_TRUE(output_has("false"));
+}
+
+// Pixel-by-pixel answer for two staged mono rasters (no wrap)
+static bool reference_touch(const uint8_t *a, int ax, int ay, int aw, int ah,
+                            const uint8_t *b, int bx, int by, int bw, int bh)
+{
+    for (int y = 0; y < ah; y++)
+    {
+        for (int x = 0; x < aw; x++)
+        {
+            int u = ax + x - bx, v = ay + y - by;
+            if (a[y * aw + x] && u >= 0 && u < bw && v >= 0 && v < bh &&
+                b[v * bw + u])
+            {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+void test_touching_matches_pixels_at_every_offset(void)
+{
+    // Sparse full-width masks slid past each other in both directions:
+    // every shift of the packed rows must agree with the pixel test.
+    static uint8_t a[32 * 32];
+    static uint8_t b[32 * 20];
+    uint32_t seed = 12345;
+    for (size_t i = 0; i < sizeof(a); i++)
+    {
+        seed = seed * 1103515245u + 12345u;
+        a[i] = ((seed >> 16) % 23) == 0;
+    }
+    for (size_t i = 0; i < sizeof(b); i++)
+    {
+        seed = seed * 1103515245u + 12345u;
+        b[i] = ((seed >> 16) % 19) == 0;
+    }
+    run_string("window");
+    stage_raster(0, 100, 100, 32, 32, false, true, a);
+
+    int hits = 0;
+    for (int dy = -21; dy <= 33; dy += 3)
+    {
+        for (int dx = -33; dx <= 33; dx++)
+        {
+            stage_raster(1, 100 + dx, 100 + dy, 32, 20, false, true, b);
+            mock_device_clear_output();
+            run_string("print touching? 0 1");
+            bool want = reference_touch(a, 100, 100, 32, 32,
+                                        b, 100 + dx, 100 + dy, 32, 20);
+            TEST_ASSERT_TRUE_MESSAGE(output_has(want ? "true" : "false"),
+                                     "touching? disagrees with the pixels");
+            hits += want;
+        }
+    }
+    TEST_ASSERT_TRUE(hits > 0);
+}
+
+void test_touching_any_finds_one_of_several(void)
+{
+    static uint8_t solid[8 * 8];
+    memset(solid, 1, sizeof(solid));
+    run_string("window");
+    stage_raster(0, 100, 100, 8, 8, false, true, solid);
+    stage_raster(1, 10, 10, 8, 8, false, true, solid);
+    stage_raster(2, 200, 200, 8, 8, false, true, solid);
+    stage_raster(5, 106, 95, 8, 8, false, true, solid);   // overlaps 0
+
+    Result r = run_string("print touching.any? 0");
+    TEST_ASSERT_EQUAL(RESULT_NONE, r.status);
+    TEST_ASSERT_TRUE(output_has("true"));
+
+    mock_device_clear_output();
+    run_string("print touching.any? 2");
+    TEST_ASSERT_TRUE(output_has("false"));
+}
+
+void test_touching_any_ignores_hidden_and_near_misses(void)
+{
+    // Turtle 1 overlaps but is hidden; turtle 3 shares a grid cell and a
+    // bounding box with 0 but no opaque pixel.
+    static uint8_t solid[8 * 8];
+    static uint8_t left[8 * 8];
+    static uint8_t right[8 * 8];
+    memset(solid, 1, sizeof(solid));
+    memset(left, 0, sizeof(left));
+    memset(right, 0, sizeof(right));
+    for (int row = 0; row < 8; row++)
+    {
+        left[row * 8 + 0] = 1;
+        right[row * 8 + 7] = 1;
+    }
+    run_string("window");
+    stage_raster(0, 100, 100, 8, 8, false, true, left);
+    stage_raster(1, 100, 100, 8, 8, false, false, solid);
+    stage_raster(3, 102, 100, 8, 8, false, true, right);
+
+    run_string("print touching.any? 0");
+    TEST_ASSERT_TRUE(output_has("false"));
+
+    // A hidden turtle touches nothing itself
+    mock_device_clear_output();
+    run_string("print touching.any? 1");
+    TEST_ASSERT_TRUE(output_has("false"));
+}
+
+void test_touching_any_across_cells_and_wrap_edge(void)
+{
+    static uint8_t solid[8 * 8];
+    memset(solid, 1, sizeof(solid));
+
+    // A contact on a grid cell boundary (x = 32) in window mode
+    run_string("window");
+    stage_raster(0, 26, 60, 8, 8, false, true, solid);
+    stage_raster(4, 33, 62, 8, 8, false, true, solid);
+    run_string("print touching.any? 4");
+    TEST_ASSERT_TRUE(output_has("true"));
+
+    // A contact across the right and bottom edges in wrap mode
+    mock_device_clear_output();
+    run_string("wrap");
+    stage_raster(0, 316, 316, 8, 8, false, true, solid);  // 316..323
+    stage_raster(4, 0, 0, 8, 8, false, true, solid);      // 0..7
+    run_string("print touching.any? 4");
+    TEST_ASSERT_TRUE(output_has("true"));
+}
+
+void test_touching_any_rejects_bad_turtle(void)
+{
+    Result r = run_string("print touching.any? 8");
+    TEST_ASSERT_EQUAL(RESULT_ERROR, r.status);
+    TEST_ASSERT_EQUAL(ERR_DOESNT_LIKE_INPUT, result_get_error_code(r));
+}
+
 void test_over_true_when_canvas_matches(void)
 {
     static uint8_t solid[8 * 8];
@@ -2277,6 +2503,8 @@ void test_sensing_primitives_registered(void)
 {
     Result r = run_string("show touchingp 0 1");
     TEST_ASSERT_NOT_EQUAL(RESULT_ERROR, r.status);
+    r = run_string("show touching.anyp 0");
+    TEST_ASSERT_NOT_EQUAL(RESULT_ERROR, r.status);
     r = run_string("show overp 0");
     TEST_ASSERT_NOT_EQUAL(RESULT_ERROR, r.status);
     r = run_string("show colorunder");
@@ -2386,6 +2614,13 @@ int main(void)
     RUN_TEST(test_dotp_true_when_dot_exists);
     RUN_TEST(test_dotp_false_when_no_dot);
     RUN_TEST(test_fill_command);
+    RUN_TEST(test_filled_fills_the_traced_polygon);
+    RUN_TEST(test_filled_records_every_kind_of_move);
+    RUN_TEST(test_filled_needs_three_vertices);
+    RUN_TEST(test_filled_does_not_fill_after_an_error);
+    RUN_TEST(test_filled_blocks_nest);
+    RUN_TEST(test_filled_outside_a_block_records_nothing);
+    RUN_TEST(test_filled_requires_a_list);
     RUN_TEST(test_dot_requires_list);
     
     // Boundary mode tests
@@ -2523,6 +2758,12 @@ int main(void)
     RUN_TEST(test_touching_wrap_edge_contact);
     RUN_TEST(test_touching_indexed_transparency);
     RUN_TEST(test_touching_rejects_bad_turtle);
+    RUN_TEST(test_touching_repacks_a_restaged_raster);
+    RUN_TEST(test_touching_matches_pixels_at_every_offset);
+    RUN_TEST(test_touching_any_finds_one_of_several);
+    RUN_TEST(test_touching_any_ignores_hidden_and_near_misses);
+    RUN_TEST(test_touching_any_across_cells_and_wrap_edge);
+    RUN_TEST(test_touching_any_rejects_bad_turtle);
     RUN_TEST(test_over_true_when_canvas_matches);
     RUN_TEST(test_over_false_for_other_colour);
     RUN_TEST(test_over_ignores_transparent_mask_pixels);
@@ -332,6 +332,57 @@ void test_error_no_value(void)
     TEST_ASSERT_EQUAL_STRING("undefined_var has no value", msg);
 }
 
+//==========================================================================
+// Global references: `:name` remembers its global but stays dynamic
+//==========================================================================
+
+void test_global_ref_sees_each_make(void)
+{
+    run_string("make \"gr 1");
+    reset_output();
+    run_string("repeat 3 [print :gr make \"gr :gr + 1]");
+    TEST_ASSERT_EQUAL_STRING("1\n2\n3\n", output_buffer);
+}
+
+void test_global_ref_hidden_by_a_later_local(void)
+{
+    // gr.read learns the global, then runs under a local of the same name.
+    run_string("make \"gr \"global");
+    run_string("define \"gr.read [[] [output :gr]]");
+    run_string("define \"gr.local [[] [local \"gr make \"gr \"local output gr.read]]");
+    reset_output();
+    run_string("repeat 2 [print gr.read print gr.local]");
+    TEST_ASSERT_EQUAL_STRING("global\nlocal\nglobal\nlocal\n", output_buffer);
+}
+
+void test_global_ref_hidden_by_an_input(void)
+{
+    run_string("make \"gr \"global");
+    run_string("define \"gr.read [[] [output :gr]]");
+    run_string("define \"gr.input [[gr] [output gr.read]]");
+    reset_output();
+    run_string("repeat 2 [print gr.read print gr.input \"input]");
+    TEST_ASSERT_EQUAL_STRING("global\ninput\nglobal\ninput\n", output_buffer);
+}
+
+void test_global_ref_follows_erase(void)
+{
+    run_string("make \"gr 1");
+    run_string("make \"gr.other 2");
+    reset_output();
+    run_string("print :gr");
+    run_string("ern \"gr");
+    Result r = run_string("print :gr");
+    TEST_ASSERT_EQUAL(RESULT_ERROR, r.status);
+    TEST_ASSERT_EQUAL(ERR_NO_VALUE, result_get_error_code(r));
+
+    // A new global may take the erased one's slot.
+    run_string("make \"gr.new 3");
+    run_string("make \"gr 4");
+    run_string("print :gr print :gr.new");
+    TEST_ASSERT_EQUAL_STRING("1\n4\n3\n", output_buffer);
+}
+
 int main(void)
 {
     UNITY_BEGIN();
@@ -357,6 +408,10 @@ int main(void)
     RUN_TEST(test_name_question_alias);
     RUN_TEST(test_nested_scopes);
     RUN_TEST(test_error_no_value);
+    RUN_TEST(test_global_ref_sees_each_make);
+    RUN_TEST(test_global_ref_hidden_by_an_input);
+    RUN_TEST(test_global_ref_hidden_by_a_later_local);
+    RUN_TEST(test_global_ref_follows_erase);
 
     return UNITY_END();
 }
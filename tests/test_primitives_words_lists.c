@@ -140,6 +140,23 @@ void test_item_is_one_indexed(void)
     TEST_ASSERT_EQUAL_STRING("a", mem_word_ptr(r2.value.as.node));
 }
 
+void test_numbers_in_lists_keep_full_precision(void)
+{
+    // A number put in a list comes back as the same float, not as its
+    // six-digit text read back in.
+    Result r = eval_string("item 2 (list \"a 1/3 2)");
+    TEST_ASSERT_EQUAL(RESULT_OK, r.status);
+    TEST_ASSERT_EQUAL(VALUE_NUMBER, r.value.type);
+    TEST_ASSERT_TRUE(r.value.as.number == 1.0f / 3.0f);
+
+    r = eval_string("3 * first fput 1/3 []");
+    TEST_ASSERT_EQUAL(RESULT_OK, r.status);
+    TEST_ASSERT_EQUAL_FLOAT(1.0f, r.value.as.number);
+
+    run_string("print lput 1/3 [1] show sentence 2.5 -1");
+    TEST_ASSERT_EQUAL_STRING("1 0.333333\n[2.5 -1]\n", output_buffer);
+}
+
 void test_item_zero_index_errors(void)
 {
     // 0 is below the valid range; should error per 1-indexed semantics.
@@ -1041,17 +1058,29 @@ void test_word_long_blob_on_psram(void)
 
 // Exhaust the node pool so any further mem_cons fails. The garbage chain
 // is reclaimed when the scaffold re-inits memory in tearDown.
+// The filler that exhausts memory has to stay reachable, or the automatic
+// collection at the next primitive call frees it and nothing runs out. It is
+// held by a root scope that the next setUp's logo_mem_init discards.
+static Node filler;
+static MemGcRootScope filler_scope;
+
+static void keep_filler_rooted(void)
+{
+    filler = NODE_NIL;
+    mem_gc_roots_push(&filler_scope, &filler, 1);
+}
+
 static void exhaust_node_pool(void)
 {
-    Node chain = NODE_NIL;
+    keep_filler_rooted();
     for (;;)
     {
-        Node c = mem_cons(NODE_NIL, chain);
+        Node c = mem_cons(NODE_NIL, filler);
         if (mem_is_nil(c))
         {
             return;
         }
-        chain = c;
+        filler = c;
     }
 }
 
@@ -1115,18 +1144,20 @@ void test_remdup_out_of_nodes_errors(void)
     TEST_ASSERT_EQUAL(ERR_OUT_OF_SPACE, result_get_error_code(r));
 }
 
-// Exhaust the atom table so further interning fails. Atoms needed by the
-// test itself must be interned before calling this.
-static void exhaust_atom_table(void)
+// Fill the atom table with rooted filler words until interning fails.
+static void fill_atom_table(void)
 {
+    static int next_name;
     char buf[16];
-    for (int i = 0;; i++)
+    for (;;)
     {
-        int len = snprintf(buf, sizeof(buf), "a%d", i);
-        if (mem_is_nil(mem_atom(buf, (size_t)len)))
+        int len = snprintf(buf, sizeof(buf), "a%d", next_name++);
+        Node atom = mem_atom(buf, (size_t)len);
+        if (mem_is_nil(atom))
         {
             break;
         }
+        filler = mem_cons(atom, filler);
     }
     // The names above grow, so the first refusal can leave a gap that a
     // shorter word still fits into. Top the table up with the smallest fresh
@@ -1136,13 +1167,27 @@ static void exhaust_atom_table(void)
     for (char c = '0'; c <= '9'; c++)
     {
         char name[2] = {'z', c};
-        if (mem_is_nil(mem_atom(name, sizeof(name))))
+        Node atom = mem_atom(name, sizeof(name));
+        if (mem_is_nil(atom))
         {
             return;
         }
+        filler = mem_cons(atom, filler);
     }
 }
 
+// Exhaust the atom table so further interning fails. Atoms needed by the
+// test itself must be interned before calling this. Filling, collecting and
+// filling again leaves no garbage word for the automatic collection at the
+// test's next primitive call to hand back.
+static void exhaust_atom_table(void)
+{
+    keep_filler_rooted();
+    fill_atom_table();
+    run_string("recycle");
+    fill_atom_table();
+}
+
 void test_word_of_numbers_out_of_atoms_errors(void)
 {
     // number_to_word interns the formatted number; on atom exhaustion it
@@ -1601,6 +1646,7 @@ int main(void)
     RUN_TEST(test_item_list);
     RUN_TEST(test_item_number);
     RUN_TEST(test_item_is_one_indexed);
+    RUN_TEST(test_numbers_in_lists_keep_full_precision);
     RUN_TEST(test_item_zero_index_errors);
     
     // Replace
@@ -561,8 +561,8 @@ void test_nodes_returns_correct_type(void)
 
 // `atoms` is the companion to `nodes`, and it exists because the two are not
 // interchangeable: a program can be rich in free nodes and out of word space.
-// Storing a stream of distinct numbers is the way to spend the one and not the
-// other -- a number stored in a list is interned as a word.
+// Storing a stream of distinct words is the way to spend the one and not the
+// other -- each new word is interned, and a list slot reused for it.
 void test_atoms_reports_the_word_table_and_recycle_gives_it_back(void)
 {
     reset_output();
@@ -575,14 +575,14 @@ void test_atoms_reports_the_word_table_and_recycle_gives_it_back(void)
     run_string("print atoms");
     int before = atoi(output_buffer);
 
-    // Distinct numbers into a list slot: each one mints a word.
+    // Distinct words into a list slot: each one mints an atom.
     run_string("make \"l (list 0)");
-    run_string("repeat 300 [make \"n 100000 + repcount  .setitem 1 :l :n]");
+    run_string("repeat 300 [make \"n word \"n 100000 + repcount  .setitem 1 :l :n]");
     reset_output();
     run_string("print atoms");
     int during = atoi(output_buffer);
     TEST_ASSERT_TRUE_MESSAGE(during < before,
-                             "storing 300 distinct numbers did not spend any word space");
+                             "storing 300 distinct words did not spend any word space");
 
     // And the room comes back, since nothing refers to those words now.
     run_string("recycle");
@@ -597,10 +597,11 @@ void test_atoms_reports_the_word_table_and_recycle_gives_it_back(void)
 // of word table, and nothing the program could ask about could see that.
 //
 // Pinned as behaviour rather than as `nodes != atoms`, which two different
-// units can satisfy or fail by coincidence: storing distinct numbers into an
-// EXISTING list slot mints a word per number and mutates in place, so it must
-// spend word table without spending cells to match.
-void test_storing_numbers_spends_word_table_and_not_nodes(void)
+// units can satisfy or fail by coincidence: storing distinct words into an
+// EXISTING list slot mints a word each and mutates in place, so it must
+// spend word table without spending cells to match. (Numbers no longer
+// serve: a list holds them as number nodes, which mint no word.)
+void test_storing_words_spends_word_table_and_not_nodes(void)
 {
     run_string("make \"l (list 0)");
     run_string("recycle");
@@ -611,7 +612,7 @@ void test_storing_numbers_spends_word_table_and_not_nodes(void)
     run_string("print atoms");
     int atoms_before = atoi(output_buffer);
 
-    run_string("repeat 300 [make \"n 100000 + repcount  .setitem 1 :l :n]");
+    run_string("repeat 300 [make \"n word \"n 100000 + repcount  .setitem 1 :l :n]");
 
     reset_output();
     run_string("print nodes");
@@ -621,7 +622,7 @@ void test_storing_numbers_spends_word_table_and_not_nodes(void)
     int atoms_after = atoi(output_buffer);
 
     TEST_ASSERT_TRUE_MESSAGE(atoms_after < atoms_before,
-                             "storing 300 distinct numbers spent no word table");
+                             "storing 300 distinct words spent no word table");
 
     // `.setitem` writes in place, so no cells are consumed to hold them. Free
     // nodes still drift, because the atom region grows into the arena beneath
@@ -760,6 +761,74 @@ void test_recycle_inside_map_preserves_partial_result(void)
     TEST_ASSERT_EQUAL_STRING("one two three\n", output_buffer);
 }
 
+// A loop that only ever makes garbage used to die with "out of space" unless
+// the program called recycle itself. The allocator now asks for a collection
+// and the evaluator answers it at the next primitive call.
+void test_churn_without_recycle_collects_automatically(void)
+{
+    run_string("make \"keep [important data]");
+    size_t collections = mem_gc_count();
+
+    // 4,000 ten-cell lists is more cells than the whole pool holds.
+    Result r = eval_string("repeat 4000 [make \"junk (list 1 2 3 4 5 6 7 8 9 10)]");
+    TEST_ASSERT_EQUAL(RESULT_NONE, r.status);
+    TEST_ASSERT_TRUE_MESSAGE(mem_gc_count() > collections, "the loop never collected");
+
+    reset_output();
+    run_string("print :keep");
+    TEST_ASSERT_EQUAL_STRING("important data\n", output_buffer);
+}
+
+// The same for the word table: distinct words are atoms, and 3,000 of them
+// overrun the 32 KB table.
+void test_word_churn_without_recycle_collects_automatically(void)
+{
+    Result r = eval_string("repeat 3000 [make \"junk word \"longishword repcount]");
+    TEST_ASSERT_EQUAL(RESULT_NONE, r.status);
+
+    reset_output();
+    run_string("print :junk");
+    TEST_ASSERT_EQUAL_STRING("longishword3000\n", output_buffer);
+}
+
+// A typed list literal interns its words before any primitive runs, so a
+// full word table of garbage used to fail the line that would have
+// collected it.
+void test_list_literal_collects_a_full_word_table(void)
+{
+    char word[24];    // "filler", an int and the NUL
+    for (int i = 0; ; i++)
+    {
+        snprintf(word, sizeof(word), "filler%d", i);
+        if (mem_is_nil(mem_atom(word, strlen(word))))
+            break;
+    }
+
+    reset_output();
+    Result r = run_string("print [newly typed words]");
+    TEST_ASSERT_EQUAL(RESULT_NONE, r.status);
+    TEST_ASSERT_EQUAL_STRING("newly typed words\n", output_buffer);
+}
+
+// Values waiting in the evaluator's C frames must be roots, since the next
+// primitive call may collect. The junk after the collection reuses anything
+// wrongly freed.
+void test_pending_infix_operand_survives_a_collection(void)
+{
+    reset_output();
+    Result r = eval_string("print (list \"a \"b) = run [recycle make \"j [x y z] list \"a \"b]");
+    TEST_ASSERT_EQUAL(RESULT_NONE, r.status);
+    TEST_ASSERT_EQUAL_STRING("true\n", output_buffer);
+}
+
+void test_paren_call_arguments_survive_a_collection(void)
+{
+    reset_output();
+    Result r = eval_string("print (sentence list 1 2 run [recycle make \"j [x y z] list 3 4])");
+    TEST_ASSERT_EQUAL(RESULT_NONE, r.status);
+    TEST_ASSERT_EQUAL_STRING("1 2 3 4\n", output_buffer);
+}
+
 //==========================================================================
 // Erase Tests (erall, erase, ern, erns, erps)
 //==========================================================================
@@ -1430,7 +1499,7 @@ int main(void)
     RUN_TEST(test_nodes_returns_number);
     RUN_TEST(test_nodes_returns_correct_type);
     RUN_TEST(test_atoms_reports_the_word_table_and_recycle_gives_it_back);
-    RUN_TEST(test_storing_numbers_spends_word_table_and_not_nodes);
+    RUN_TEST(test_storing_words_spends_word_table_and_not_nodes);
     RUN_TEST(test_the_maintained_word_count_matches_a_full_scan);
     RUN_TEST(test_recycle_runs_without_error);
     RUN_TEST(test_recycle_frees_memory);
@@ -1438,6 +1507,11 @@ int main(void)
     RUN_TEST(test_recycle_inside_repeat_body);
     RUN_TEST(test_recycle_preserves_procedure_locals);
     RUN_TEST(test_recycle_inside_map_preserves_partial_result);
+    RUN_TEST(test_churn_without_recycle_collects_automatically);
+    RUN_TEST(test_word_churn_without_recycle_collects_automatically);
+    RUN_TEST(test_list_literal_collects_a_full_word_table);
+    RUN_TEST(test_pending_infix_operand_survives_a_collection);
+    RUN_TEST(test_paren_call_arguments_survive_a_collection);
 
     // primitives operation tests
     RUN_TEST(test_primitives_returns_list);
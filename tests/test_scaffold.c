@@ -35,6 +35,7 @@ bool mock_status_led_reachable = true;
 
 // User interrupt flag for testing
 bool mock_user_interrupt = false;
+int mock_interrupt_checks = 0;
 
 // Pause request flag for testing (F9 key)
 bool mock_pause_requested = false;
@@ -231,6 +232,7 @@ bool mock_set_status_led(bool on)
 
 bool mock_check_user_interrupt(void)
 {
+    mock_interrupt_checks++;
     return mock_user_interrupt;
 }
 
@@ -522,6 +524,7 @@ void test_scaffold_setUp(void)
     mock_input_pos = 0;
     use_mock_device = false;
     mock_user_interrupt = false;  // Reset user interrupt flag
+    mock_interrupt_checks = 0;
     mock_pause_requested = false; // Reset pause request flag
     mock_freeze_requested = false; // Reset freeze request flag
     mock_ticks_value = 0;         // Reset mock monotonic clock
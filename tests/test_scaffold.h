@@ -46,6 +46,9 @@ extern bool mock_battery_charging;
 // User interrupt flag for testing
 extern bool mock_user_interrupt;
 
+// Times the evaluator has polled for a user interrupt
+extern int mock_interrupt_checks;
+
 // Pause request flag for testing (F9 key)
 extern bool mock_pause_requested;
 
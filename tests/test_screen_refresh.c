@@ -3,7 +3,8 @@
 //  Copyright 2026 Blair Leduc. See LICENSE for details.
 //
 //  Refresh policy of the PicoCalc screen driver: what reaches the panel
-//  before the program says refresh, and what only reaches the canvas.
+//  before the program says refresh, and what only reaches the canvas; and
+//  the sprite compositor's output.
 //
 //  Compiles devices/picocalc/screen.c on the host against tests/fake_lcd.c,
 //  which records the panel writes (see fake_lcd.h).
@@ -21,6 +22,11 @@ void setUp(void)
 {
     // screen.c holds its state statically; put it back to a known one.
     screen_gfx_set_refresh_auto(true);
+    screen_gfx_set_boundary_mode(SCREEN_BOUNDARY_WRAP);
+    for (uint8_t id = 0; id < SCREEN_MAX_SPRITES; id++)
+    {
+        screen_sprite_hide(id);
+    }
     screen_set_mode(SCREEN_MODE_TXT);
     screen_gfx_clear();
     screen_set_mode(SCREEN_MODE_GFX);
@@ -30,6 +36,7 @@ void setUp(void)
 void tearDown(void)
 {
     screen_gfx_set_refresh_auto(true);
+    screen_gfx_set_boundary_mode(SCREEN_BOUNDARY_WRAP);
     screen_set_mode(SCREEN_MODE_TXT);
 }
 
@@ -160,6 +167,562 @@ void test_a_manual_clear_and_redraw_frame_never_shows_black(void)
     TEST_ASSERT_EQUAL_UINT8(DRAWN, fake_lcd_panel_point(30, 40));
 }
 
+//
+// Sprites: the compositor overlays each mask's opaque runs on the rows the
+// sprite covers. Each test checks the panel against the mask pixel by pixel.
+//
+
+#define SPRITE_COLOUR (9)
+
+// The panel under sprite `s` alone over a clear canvas: its opaque pixels,
+// and the background through its transparent ones. Off-screen pixels are
+// wrapped or skipped per `wrap`.
+static void assert_sprite_on_panel(const ScreenSprite *s, bool wrap)
+{
+    for (int r = 0; r < s->h; r++)
+    {
+        for (int c = 0; c < s->w; c++)
+        {
+            int x = s->x + c;
+            int y = s->y + r;
+            if (wrap)
+            {
+                x = (x % SCREEN_WIDTH + SCREEN_WIDTH) % SCREEN_WIDTH;
+                y = (y % SCREEN_HEIGHT + SCREEN_HEIGHT) % SCREEN_HEIGHT;
+            }
+            else if (x < 0 || x >= SCREEN_WIDTH || y < 0 || y >= SCREEN_HEIGHT)
+            {
+                continue;
+            }
+
+            uint8_t px = s->mask[r * s->w + c];
+            uint8_t want = GFX_DEFAULT_BACKGROUND;
+            if (s->indexed ? px != SCREEN_SPRITE_TRANSPARENT : px != 0)
+            {
+                want = s->indexed ? px : s->colour;
+            }
+            TEST_ASSERT_EQUAL_UINT8_MESSAGE(want, fake_lcd_panel_point(x, y), "sprite pixel");
+        }
+    }
+}
+
+static ScreenSprite make_sprite(int x, int y, int w, int h, bool indexed, const uint8_t *mask)
+{
+    ScreenSprite s = {
+        .visible = true,
+        .indexed = indexed,
+        .x = (int16_t)x,
+        .y = (int16_t)y,
+        .w = (uint8_t)w,
+        .h = (uint8_t)h,
+        .colour = SPRITE_COLOUR,
+        .mask = mask,
+    };
+    return s;
+}
+
+#define T SCREEN_SPRITE_TRANSPARENT
+
+void test_indexed_sprite_shows_its_runs_and_holes(void)
+{
+    static const uint8_t mask[] = {
+        T, 3, 4, T, 5,
+        6, T, T, T, 7,
+        T, T, T, T, T,
+        1, 2, 3, 4, 5,
+    };
+    ScreenSprite s = make_sprite(40, 50, 5, 4, true, mask);
+    screen_sprite_set(0, &s);
+    screen_gfx_present();
+
+    assert_sprite_on_panel(&s, true);
+}
+
+void test_mono_sprite_paints_its_colour(void)
+{
+    static const uint8_t mask[] = {
+        0, 1, 1, 0,
+        1, 0, 0, 1,
+        0, 1, 1, 0,
+    };
+    ScreenSprite s = make_sprite(100, 7, 4, 3, false, mask);
+    screen_sprite_set(3, &s);
+    screen_gfx_present();
+
+    assert_sprite_on_panel(&s, true);
+    // Rows the sprite does not cover are the canvas alone
+    TEST_ASSERT_EQUAL_UINT8(GFX_DEFAULT_BACKGROUND, fake_lcd_panel_point(101, 6));
+    TEST_ASSERT_EQUAL_UINT8(GFX_DEFAULT_BACKGROUND, fake_lcd_panel_point(101, 10));
+}
+
+void test_lower_sprite_id_is_on_top(void)
+{
+    static const uint8_t under[] = { 2, 2, 2, 2 };
+    static const uint8_t over[] = { T, 5, 5, T };
+    ScreenSprite a = make_sprite(10, 10, 4, 1, true, under);
+    ScreenSprite b = make_sprite(10, 10, 4, 1, true, over);
+    screen_sprite_set(6, &a);
+    screen_sprite_set(1, &b);
+    screen_gfx_present();
+
+    TEST_ASSERT_EQUAL_UINT8(2, fake_lcd_panel_point(10, 10));
+    TEST_ASSERT_EQUAL_UINT8(5, fake_lcd_panel_point(11, 10));
+    TEST_ASSERT_EQUAL_UINT8(5, fake_lcd_panel_point(12, 10));
+    TEST_ASSERT_EQUAL_UINT8(2, fake_lcd_panel_point(13, 10));
+}
+
+void test_sprite_runs_wrap_across_both_edges(void)
+{
+    static const uint8_t mask[] = {
+        1, 2, 3, 4,
+        5, T, T, 6,
+        7, 8, 9, 10,
+    };
+    ScreenSprite s = make_sprite(SCREEN_WIDTH - 2, SCREEN_HEIGHT - 1, 4, 3, true, mask);
+    screen_sprite_set(0, &s);
+    screen_gfx_present();
+
+    assert_sprite_on_panel(&s, true);
+    TEST_ASSERT_EQUAL_UINT8(3, fake_lcd_panel_point(0, SCREEN_HEIGHT - 1));
+    TEST_ASSERT_EQUAL_UINT8(10, fake_lcd_panel_point(1, 1));
+}
+
+void test_sprite_runs_clip_at_the_window_edge(void)
+{
+    static const uint8_t mask[] = {
+        1, 2, 3, 4,
+        5, 6, 7, 8,
+    };
+    screen_gfx_set_boundary_mode(SCREEN_BOUNDARY_WINDOW);
+    ScreenSprite s = make_sprite(-2, -1, 4, 2, true, mask);
+    screen_sprite_set(0, &s);
+    screen_gfx_present();
+
+    assert_sprite_on_panel(&s, false);
+    // Nothing wrapped to the far edges
+    TEST_ASSERT_NOT_EQUAL_UINT8(3, fake_lcd_panel_point(SCREEN_WIDTH - 1, SCREEN_HEIGHT - 1));
+    TEST_ASSERT_NOT_EQUAL_UINT8(8, fake_lcd_panel_point(SCREEN_WIDTH - 1, 0));
+}
+
+// A mask with more runs than the compositor keeps, and one taller than it
+// keeps runs for, are composed pixel by pixel, to the same result
+void test_sprites_too_busy_or_tall_for_runs_compose_the_same(void)
+{
+    static uint8_t checker[40 * 16];
+    for (int i = 0; i < 40 * 16; i++)
+    {
+        checker[i] = ((i % 40 + i / 40) % 2) ? 11 : T;
+    }
+    static uint8_t tall[3 * 70];
+    for (int i = 0; i < 3 * 70; i++)
+    {
+        tall[i] = (i % 3 == 1) ? 0 : 1;
+    }
+    ScreenSprite busy = make_sprite(200, 100, 40, 16, true, checker);
+    ScreenSprite high = make_sprite(20, 150, 3, 70, false, tall);
+    screen_sprite_set(2, &busy);
+    screen_sprite_set(4, &high);
+    screen_gfx_present();
+
+    assert_sprite_on_panel(&busy, true);
+    assert_sprite_on_panel(&high, true);
+}
+
+void test_moved_sprite_leaves_no_trail(void)
+{
+    static const uint8_t mask[] = { 4, 4, 4, 4 };
+    ScreenSprite s = make_sprite(60, 60, 2, 2, true, mask);
+    screen_sprite_set(0, &s);
+    screen_gfx_present();
+
+    s.x = 70;
+    s.y = 90;
+    screen_sprite_set(0, &s);
+    screen_gfx_present();
+    assert_sprite_on_panel(&s, true);
+    TEST_ASSERT_EQUAL_UINT8(GFX_DEFAULT_BACKGROUND, fake_lcd_panel_point(60, 60));
+
+    screen_sprite_hide(0);
+    screen_gfx_present();
+    TEST_ASSERT_EQUAL_UINT8(GFX_DEFAULT_BACKGROUND, fake_lcd_panel_point(70, 90));
+}
+
+#undef T
+
+//
+// Presenting: a present sends the canvas and sprites as they are when it is
+// made. Built as test_screen_refresh_async too, where the frame is sent by
+// the present queue's consumer after screen_gfx_present returns.
+//
+
+void test_a_full_screen_present_arrives_whole(void)
+{
+    uint8_t *canvas = screen_gfx_frame();
+    for (int y = 0; y < SCREEN_HEIGHT; y++)
+    {
+        for (int x = 0; x < SCREEN_WIDTH; x++)
+        {
+            canvas[y * SCREEN_WIDTH + x] = (uint8_t)((x / 7 + y * 3) & 0x3f);
+        }
+    }
+    screen_gfx_mark_all_dirty();
+    screen_gfx_present();
+
+    for (int y = 0; y < SCREEN_HEIGHT; y++)
+    {
+        for (int x = 0; x < SCREEN_WIDTH; x++)
+        {
+            TEST_ASSERT_EQUAL_UINT8(canvas[y * SCREEN_WIDTH + x], fake_lcd_panel_point(x, y));
+        }
+    }
+    TEST_ASSERT_EQUAL_INT(SCREEN_HEIGHT, fake_lcd_blit_row_count());
+}
+
+void test_drawing_after_a_present_waits_for_the_next(void)
+{
+    static const uint8_t mask[] = { 4, 4, 4, 4 };
+    ScreenSprite s = make_sprite(200, 200, 2, 2, true, mask);
+    screen_gfx_set_refresh_auto(false);
+    screen_gfx_set_point(10, 10, DRAWN);
+    screen_sprite_set(0, &s);
+    screen_gfx_present();
+
+    // Redraw the canvas under the frame and take the sprite away; neither
+    // is presented, so the panel keeps what the present saw
+    uint8_t *canvas = screen_gfx_frame();
+    memset(canvas, 3, SCREEN_WIDTH * SCREEN_HEIGHT);
+    screen_sprite_hide(0);
+
+    TEST_ASSERT_EQUAL_UINT8(DRAWN, fake_lcd_panel_point(10, 10));
+    TEST_ASSERT_EQUAL_UINT8(4, fake_lcd_panel_point(201, 201));
+    TEST_ASSERT_EQUAL_UINT8(GFX_DEFAULT_BACKGROUND, fake_lcd_panel_point(11, 11));
+}
+
+//
+// Wide lines and filled polygons: each row is written as one run.
+//
+
+// The pen a wide line is the trail of: a disc of diameter `width` stamped at
+// every point of the Bresenham path, plotted pixel by pixel into `out`.
+static void reference_line(uint8_t *out, int ix1, int iy1, int ix2, int iy2,
+                           int width, bool wrap)
+{
+    int dx = ix2 - ix1, dy = iy2 - iy1;
+    int sx = (dx > 0) - (dx < 0), sy = (dy > 0) - (dy < 0);
+    dx = dx < 0 ? -dx : dx;
+    dy = dy < 0 ? -dy : dy;
+    const float r = width * 0.5f;
+    const int e = (int)r;
+    int x = ix1, y = iy1;
+    int steps = dx >= dy ? dx : dy;
+    int err = dx >= dy ? 2 * dy - dx : 2 * dx - dy;
+    for (int i = 0; i <= steps; i++)
+    {
+        for (int oy = -e; oy <= e; oy++)
+        {
+            for (int ox = -e; ox <= e; ox++)
+            {
+                if ((float)(ox * ox + oy * oy) > r * r)
+                {
+                    continue;
+                }
+                int px = x + ox, py = y + oy;
+                if (wrap)
+                {
+                    px = ((px % SCREEN_WIDTH) + SCREEN_WIDTH) % SCREEN_WIDTH;
+                    py = ((py % SCREEN_HEIGHT) + SCREEN_HEIGHT) % SCREEN_HEIGHT;
+                }
+                else if (px < 0 || px >= SCREEN_WIDTH || py < 0 || py >= SCREEN_HEIGHT)
+                {
+                    continue;
+                }
+                out[py * SCREEN_WIDTH + px] = DRAWN;
+            }
+        }
+        if (dx >= dy)
+        {
+            if (err > 0) { y += sy; err -= 2 * dx; }
+            err += 2 * dy;
+            x += sx;
+        }
+        else
+        {
+            if (err > 0) { x += sx; err -= 2 * dy; }
+            err += 2 * dx;
+            y += sy;
+        }
+    }
+}
+
+static void assert_wide_lines_match_the_disc_trail(bool wrap)
+{
+    static uint8_t expected[SCREEN_WIDTH * SCREEN_HEIGHT];
+    uint32_t seed = 12345;
+    screen_gfx_set_boundary_mode(wrap ? SCREEN_BOUNDARY_WRAP : SCREEN_BOUNDARY_WINDOW);
+
+    for (int n = 0; n < 60; n++)
+    {
+        int v[5];
+        for (int i = 0; i < 5; i++)
+        {
+            seed = seed * 1103515245u + 12345u;
+            v[i] = (int)((seed >> 8) % 400) - 40;   // Some ends off-screen
+        }
+        int width = 2 + v[4] % 31;
+        if (width < 2) width = 2 + (-width % 31);
+
+        screen_gfx_clear();
+        memset(expected, GFX_DEFAULT_BACKGROUND, sizeof(expected));
+        screen_gfx_line((float)v[0], (float)v[1], (float)v[2], (float)v[3], DRAWN, false, width);
+        // screen_gfx_line rounds its ends as (int)(v + 0.5f), which is
+        // not round-to-nearest for negative v
+        reference_line(expected, (int)(v[0] + 0.5f), (int)(v[1] + 0.5f),
+                       (int)(v[2] + 0.5f), (int)(v[3] + 0.5f), width, wrap);
+
+        TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, screen_gfx_frame(), sizeof(expected));
+    }
+}
+
+void test_wide_lines_match_the_disc_trail_when_clipped(void)
+{
+    assert_wide_lines_match_the_disc_trail(false);
+}
+
+void test_wide_lines_match_the_disc_trail_when_wrapped(void)
+{
+    assert_wide_lines_match_the_disc_trail(true);
+}
+
+void test_wide_dot_is_a_disc(void)
+{
+    static uint8_t expected[SCREEN_WIDTH * SCREEN_HEIGHT];
+    memset(expected, GFX_DEFAULT_BACKGROUND, sizeof(expected));
+    reference_line(expected, 160, 160, 160, 160, 9, true);
+
+    screen_gfx_line(160.0f, 160.0f, 160.0f, 160.0f, DRAWN, false, 9);
+
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, screen_gfx_frame(), sizeof(expected));
+}
+
+// A diagonal's bounding box is the whole screen; only the tiles along it
+// reach the panel.
+void test_wide_diagonal_presents_only_the_tiles_it_touches(void)
+{
+    screen_gfx_set_refresh_auto(false);
+    screen_gfx_present();
+    fake_lcd_reset();
+
+    screen_gfx_line(10.0f, 10.0f, 310.0f, 310.0f, DRAWN, false, 8);
+    screen_gfx_present();
+
+    TEST_ASSERT_EQUAL_UINT8(DRAWN, fake_lcd_panel_point(160, 160));
+    TEST_ASSERT_EQUAL_UINT8(FAKE_LCD_UNWRITTEN, fake_lcd_panel_point(300, 20));
+    TEST_ASSERT_EQUAL_UINT8(FAKE_LCD_UNWRITTEN, fake_lcd_panel_point(20, 300));
+}
+
+void test_polygon_fills_pixel_centres_inside(void)
+{
+    const float square[] = { 10.5f, 20.5f, 15.5f, 20.5f, 15.5f, 24.5f, 10.5f, 24.5f };
+    screen_gfx_polygon(square, 4, DRAWN);
+
+    const uint8_t *canvas = screen_gfx_frame();
+    for (int y = 15; y < 30; y++)
+    {
+        for (int x = 5; x < 20; x++)
+        {
+            bool inside = x >= 11 && x <= 15 && y >= 21 && y <= 24;
+            TEST_ASSERT_EQUAL_UINT8(inside ? DRAWN : GFX_DEFAULT_BACKGROUND,
+                                    canvas[y * SCREEN_WIDTH + x]);
+        }
+    }
+}
+
+// One path around an outer square and back round an inner one: even-odd
+// leaves the inner square empty.
+void test_polygon_is_filled_even_odd(void)
+{
+    const float path[] = {
+        10, 10, 100, 10, 100, 100, 10, 100, 10, 10,
+        40, 40, 70, 40, 70, 70, 40, 70, 40, 40,
+    };
+    screen_gfx_polygon(path, 10, DRAWN);
+
+    const uint8_t *canvas = screen_gfx_frame();
+    TEST_ASSERT_EQUAL_UINT8(DRAWN, canvas[55 * SCREEN_WIDTH + 20]);
+    TEST_ASSERT_EQUAL_UINT8(DRAWN, canvas[20 * SCREEN_WIDTH + 55]);
+    TEST_ASSERT_EQUAL_UINT8(GFX_DEFAULT_BACKGROUND, canvas[55 * SCREEN_WIDTH + 55]);
+    TEST_ASSERT_EQUAL_UINT8(GFX_DEFAULT_BACKGROUND, canvas[5 * SCREEN_WIDTH + 5]);
+}
+
+void test_polygon_is_clipped_to_the_screen(void)
+{
+    const float triangle[] = { -100, -100, 500, 160, -100, 420 };
+    screen_gfx_polygon(triangle, 3, DRAWN);
+
+    const uint8_t *canvas = screen_gfx_frame();
+    TEST_ASSERT_EQUAL_UINT8(DRAWN, canvas[160 * SCREEN_WIDTH + 0]);
+    TEST_ASSERT_EQUAL_UINT8(DRAWN, canvas[160 * SCREEN_WIDTH + SCREEN_WIDTH - 1]);
+    TEST_ASSERT_EQUAL_UINT8(GFX_DEFAULT_BACKGROUND, canvas[0 * SCREEN_WIDTH + SCREEN_WIDTH - 1]);
+}
+
+//
+// Flood fill
+//
+
+// Scatter walls of `colour` over the canvas: a maze of tiny pockets that
+// keeps many spans pending at once.
+static void scatter_walls(uint8_t colour, int percent, uint32_t seed)
+{
+    uint8_t *canvas = screen_gfx_frame();
+    for (int i = 0; i < SCREEN_WIDTH * SCREEN_HEIGHT; i++)
+    {
+        seed = seed * 1103515245u + 12345u;
+        if ((int)((seed >> 16) % 100) < percent)
+        {
+            canvas[i] = colour;
+        }
+    }
+}
+
+// The region screen_gfx_fill should produce: every pixel 4-connected to
+// (x, y) through pixels that are not `colour`
+static void reference_fill(uint8_t *out, int x, int y, uint8_t colour)
+{
+    static int pending[SCREEN_WIDTH * SCREEN_HEIGHT];
+    int head = 0, tail = 0;
+    if (out[y * SCREEN_WIDTH + x] == colour)
+    {
+        return;
+    }
+    out[y * SCREEN_WIDTH + x] = colour;
+    pending[tail++] = y * SCREEN_WIDTH + x;
+    while (head < tail)
+    {
+        int i = pending[head++];
+        int px = i % SCREEN_WIDTH, py = i / SCREEN_WIDTH;
+        const int nx[4] = { px - 1, px + 1, px, px };
+        const int ny[4] = { py, py, py - 1, py + 1 };
+        for (int k = 0; k < 4; k++)
+        {
+            if (nx[k] < 0 || nx[k] >= SCREEN_WIDTH || ny[k] < 0 || ny[k] >= SCREEN_HEIGHT)
+            {
+                continue;
+            }
+            int j = ny[k] * SCREEN_WIDTH + nx[k];
+            if (out[j] != colour)
+            {
+                out[j] = colour;
+                pending[tail++] = j;
+            }
+        }
+    }
+}
+
+static void assert_fill_matches_reference(int x, int y, uint8_t colour)
+{
+    static uint8_t expected[SCREEN_WIDTH * SCREEN_HEIGHT];
+    memcpy(expected, screen_gfx_frame(), sizeof(expected));
+    reference_fill(expected, x, y, colour);
+
+    screen_gfx_fill((float)x, (float)y, colour);
+
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, screen_gfx_frame(), sizeof(expected));
+}
+
+void test_fill_of_a_closed_shape_stops_at_its_outline(void)
+{
+    for (int i = 0; i < 4; i++)
+    {
+        static const float box[4][4] = {
+            { 50, 50, 150, 50 }, { 150, 50, 150, 150 },
+            { 150, 150, 50, 150 }, { 50, 150, 50, 50 },
+        };
+        screen_gfx_line(box[i][0], box[i][1], box[i][2], box[i][3], DRAWN, false, 1);
+    }
+    assert_fill_matches_reference(100, 100, DRAWN);
+
+    const uint8_t *canvas = screen_gfx_frame();
+    TEST_ASSERT_EQUAL_UINT8(DRAWN, canvas[100 * SCREEN_WIDTH + 100]);
+    TEST_ASSERT_EQUAL_UINT8(GFX_DEFAULT_BACKGROUND, canvas[40 * SCREEN_WIDTH + 40]);
+
+    // A shape this simple fits the queue and is filled in its colour directly
+    ScreenFillStats stats;
+    screen_gfx_fill_stats(&stats);
+    TEST_ASSERT_FALSE(stats.marker);
+    TEST_ASSERT_EQUAL_UINT32(99 * 99, stats.pixels_filled);
+}
+
+// Put a wall pixel at every odd (x, y): every other row is broken into 160
+// runs, which keeps that many spans pending at once.
+static void lattice_walls(uint8_t colour)
+{
+    uint8_t *canvas = screen_gfx_frame();
+    for (int y = 1; y < SCREEN_HEIGHT; y += 2)
+    {
+        for (int x = 1; x < SCREEN_WIDTH; x += 2)
+        {
+            canvas[y * SCREEN_WIDTH + x] = colour;
+        }
+    }
+}
+
+// The lattice overflows the SRAM queue twice over: the fill switches to a
+// marker, drops spans, and the sweep still reaches every pixel the region
+// joins, and no other.
+void test_fill_completes_when_the_queue_overflows(void)
+{
+    lattice_walls(DRAWN);
+    assert_fill_matches_reference(160, 160, DRAWN);
+
+    ScreenFillStats stats;
+    screen_gfx_fill_stats(&stats);
+    TEST_ASSERT_TRUE(stats.marker);
+    TEST_ASSERT_TRUE(stats.sweeps > 0);
+}
+
+void test_fill_through_random_walls(void)
+{
+    scatter_walls(DRAWN, 30, 99);
+    assert_fill_matches_reference(160, 160, DRAWN);
+}
+
+void test_fill_with_a_lent_store_needs_no_sweep(void)
+{
+    static FillSpan store[32768];
+    screen_gfx_set_fill_store(store, sizeof(store));
+    lattice_walls(DRAWN);
+    assert_fill_matches_reference(160, 160, DRAWN);
+    screen_gfx_set_fill_store(NULL, 0);
+
+    ScreenFillStats stats;
+    screen_gfx_fill_stats(&stats);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.sweeps);
+}
+
+// With every palette index on the canvas there is no marker to spare; a
+// simple shape still fills.
+void test_fill_without_a_free_palette_index(void)
+{
+    uint8_t *canvas = screen_gfx_frame();
+    for (int i = 0; i < 256; i++)
+    {
+        canvas[i] = (uint8_t)i;
+    }
+    for (int x = 0; x < SCREEN_WIDTH; x++)
+    {
+        canvas[10 * SCREEN_WIDTH + x] = DRAWN;
+    }
+    assert_fill_matches_reference(100, 200, DRAWN);
+    TEST_ASSERT_EQUAL_UINT8(GFX_DEFAULT_BACKGROUND, canvas[5 * SCREEN_WIDTH + 300]);
+}
+
+void test_fill_leaves_no_marker_behind(void)
+{
+    scatter_walls(7, 30, 5);
+    scatter_walls(DRAWN, 30, 6);
+    assert_fill_matches_reference(3, 3, DRAWN);
+}
+
 int main(void)
 {
     UNITY_BEGIN();
@@ -169,5 +732,27 @@ int main(void)
     RUN_TEST(test_auto_clean_fills_the_panel_directly);
     RUN_TEST(test_auto_clean_in_split_mode_fills_the_graphics_area_directly);
     RUN_TEST(test_a_manual_clear_and_redraw_frame_never_shows_black);
+    RUN_TEST(test_indexed_sprite_shows_its_runs_and_holes);
+    RUN_TEST(test_mono_sprite_paints_its_colour);
+    RUN_TEST(test_lower_sprite_id_is_on_top);
+    RUN_TEST(test_sprite_runs_wrap_across_both_edges);
+    RUN_TEST(test_sprite_runs_clip_at_the_window_edge);
+    RUN_TEST(test_sprites_too_busy_or_tall_for_runs_compose_the_same);
+    RUN_TEST(test_moved_sprite_leaves_no_trail);
+    RUN_TEST(test_a_full_screen_present_arrives_whole);
+    RUN_TEST(test_drawing_after_a_present_waits_for_the_next);
+    RUN_TEST(test_wide_lines_match_the_disc_trail_when_clipped);
+    RUN_TEST(test_wide_lines_match_the_disc_trail_when_wrapped);
+    RUN_TEST(test_wide_dot_is_a_disc);
+    RUN_TEST(test_wide_diagonal_presents_only_the_tiles_it_touches);
+    RUN_TEST(test_polygon_fills_pixel_centres_inside);
+    RUN_TEST(test_polygon_is_filled_even_odd);
+    RUN_TEST(test_polygon_is_clipped_to_the_screen);
+    RUN_TEST(test_fill_of_a_closed_shape_stops_at_its_outline);
+    RUN_TEST(test_fill_completes_when_the_queue_overflows);
+    RUN_TEST(test_fill_through_random_walls);
+    RUN_TEST(test_fill_with_a_lent_store_needs_no_sweep);
+    RUN_TEST(test_fill_without_a_free_palette_index);
+    RUN_TEST(test_fill_leaves_no_marker_behind);
     return UNITY_END();
 }
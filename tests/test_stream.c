@@ -7,6 +7,7 @@
 
 #include "unity.h"
 #include "devices/stream.h"
+#include <stdlib.h>
 #include <string.h>
 
 //
@@ -175,6 +176,287 @@ void test_write_error_flag_persistence(void)
     TEST_ASSERT_FALSE(logo_stream_has_write_error(&test_stream));
 }
 
+//============================================================================
+// logo_stream_buffered Tests
+//
+// The backend is a seekable in-memory file with separate read and write
+// positions, as the storage backends have, counting the calls that reach it.
+//============================================================================
+
+#define MEM_FILE_MAX 4096
+
+typedef struct MemFile
+{
+    char data[MEM_FILE_MAX];
+    long size;
+    long capacity;      // Writes past this fail as disk full
+    long read_pos;
+    long write_pos;
+    int reads;          // read_chars calls
+    int writes;         // write_bytes calls
+    int flushes;
+    bool closed;
+} MemFile;
+
+static MemFile mem_file;
+
+static int mem_read_chars(LogoStream *stream, char *buffer, int count)
+{
+    MemFile *f = (MemFile *)stream->context;
+    f->reads++;
+    long n = f->size - f->read_pos;
+    if (n > count)
+        n = count;
+    memcpy(buffer, f->data + f->read_pos, (size_t)n);
+    f->read_pos += n;
+    return (int)n;
+}
+
+static int mem_read_char(LogoStream *stream)
+{
+    char c;
+    return mem_read_chars(stream, &c, 1) == 1 ? (unsigned char)c : -1;
+}
+
+static void mem_write_bytes(LogoStream *stream, const char *buffer, size_t len)
+{
+    MemFile *f = (MemFile *)stream->context;
+    f->writes++;
+    for (size_t i = 0; i < len; i++)
+    {
+        if (f->write_pos >= f->capacity)
+        {
+            stream->write_error = true;
+            stream->disk_full = true;
+            return;
+        }
+        f->data[f->write_pos++] = buffer[i];
+        if (f->write_pos > f->size)
+            f->size = f->write_pos;
+    }
+}
+
+static void mem_flush(LogoStream *stream)
+{
+    ((MemFile *)stream->context)->flushes++;
+}
+
+static long mem_get_read_pos(LogoStream *stream)
+{
+    return ((MemFile *)stream->context)->read_pos;
+}
+
+static bool mem_set_read_pos(LogoStream *stream, long pos)
+{
+    MemFile *f = (MemFile *)stream->context;
+    if (pos < 0 || pos > f->size)
+        return false;
+    f->read_pos = pos;
+    return true;
+}
+
+static long mem_get_write_pos(LogoStream *stream)
+{
+    return ((MemFile *)stream->context)->write_pos;
+}
+
+static bool mem_set_write_pos(LogoStream *stream, long pos)
+{
+    MemFile *f = (MemFile *)stream->context;
+    if (pos < 0 || pos > f->size)
+        return false;
+    f->write_pos = pos;
+    return true;
+}
+
+static long mem_get_length(LogoStream *stream)
+{
+    return ((MemFile *)stream->context)->size;
+}
+
+static void mem_close(LogoStream *stream)
+{
+    ((MemFile *)stream->context)->closed = true;
+}
+
+static const LogoStreamOps mem_file_ops = {
+    .read_char = mem_read_char,
+    .read_chars = mem_read_chars,
+    .write_bytes = mem_write_bytes,
+    .flush = mem_flush,
+    .get_read_pos = mem_get_read_pos,
+    .set_read_pos = mem_set_read_pos,
+    .get_write_pos = mem_get_write_pos,
+    .set_write_pos = mem_set_write_pos,
+    .get_length = mem_get_length,
+    .close = mem_close,
+};
+
+// A buffered stream over mem_file holding `content`, writes appending
+static LogoStream *open_mem_file(const char *content)
+{
+    memset(&mem_file, 0, sizeof(mem_file));
+    mem_file.size = (long)strlen(content);
+    mem_file.capacity = MEM_FILE_MAX;
+    mem_file.write_pos = mem_file.size;
+    memcpy(mem_file.data, content, (size_t)mem_file.size);
+
+    LogoStream *inner = (LogoStream *)malloc(sizeof(LogoStream));
+    logo_stream_init(inner, LOGO_STREAM_FILE, &mem_file_ops, &mem_file, "mem");
+    LogoStream *stream = logo_stream_buffered(inner);
+    TEST_ASSERT_NOT_NULL(stream);
+    TEST_ASSERT_TRUE(stream != inner);
+    return stream;
+}
+
+static void close_mem_file(LogoStream *stream)
+{
+    logo_stream_close(stream);
+    free(stream);
+    TEST_ASSERT_TRUE(mem_file.closed);
+}
+
+void test_buffered_read_char_reads_the_backend_a_buffer_at_a_time(void)
+{
+    char content[2001];
+    for (int i = 0; i < 2000; i++)
+        content[i] = (char)('a' + i % 26);
+    content[2000] = '\0';
+    LogoStream *stream = open_mem_file(content);
+
+    for (int i = 0; i < 2000; i++)
+    {
+        TEST_ASSERT_EQUAL_INT(content[i], logo_stream_read_char(stream));
+    }
+    TEST_ASSERT_EQUAL_INT(-1, logo_stream_read_char(stream));
+    TEST_ASSERT_EQUAL_INT((2000 + LOGO_STREAM_BUFFER_SIZE - 1) / LOGO_STREAM_BUFFER_SIZE + 1,
+                          mem_file.reads);
+    TEST_ASSERT_EQUAL_INT(2000, logo_stream_get_read_pos(stream));
+    close_mem_file(stream);
+}
+
+void test_buffered_read_line_matches_the_backends(void)
+{
+    LogoStream *stream = open_mem_file("to sq :n\r\noutput :n * :n\nend\n\nlast");
+    char line[16];
+
+    TEST_ASSERT_EQUAL_INT(8, logo_stream_read_line(stream, line, sizeof(line)));
+    TEST_ASSERT_EQUAL_STRING("to sq :n", line);
+    // "\r\n" ends a line at the "\r", leaving an empty line, as before
+    TEST_ASSERT_EQUAL_INT(0, logo_stream_read_line(stream, line, sizeof(line)));
+    TEST_ASSERT_EQUAL_INT(14, logo_stream_read_line(stream, line, sizeof(line)));
+    TEST_ASSERT_EQUAL_STRING("output :n * :n", line);
+    TEST_ASSERT_EQUAL_INT(3, logo_stream_read_line(stream, line, sizeof(line)));
+    TEST_ASSERT_EQUAL_INT(0, logo_stream_read_line(stream, line, sizeof(line)));
+    TEST_ASSERT_EQUAL_INT(4, logo_stream_read_line(stream, line, sizeof(line)));
+    TEST_ASSERT_EQUAL_STRING("last", line);
+    TEST_ASSERT_EQUAL_INT(-1, logo_stream_read_line(stream, line, sizeof(line)));
+
+    // A line longer than the caller's buffer comes back in pieces
+    TEST_ASSERT_TRUE(logo_stream_set_read_pos(stream, 10));
+    TEST_ASSERT_EQUAL_INT(3, logo_stream_read_line(stream, line, 4));
+    TEST_ASSERT_EQUAL_STRING("out", line);
+    close_mem_file(stream);
+}
+
+void test_buffered_read_chars_copies_large_reads_directly(void)
+{
+    static char content[3001];
+    for (int i = 0; i < 3000; i++)
+        content[i] = (char)('0' + i % 10);
+    content[3000] = '\0';
+    LogoStream *stream = open_mem_file(content);
+
+    char buf[3000];
+    TEST_ASSERT_EQUAL_INT(5, logo_stream_read_chars(stream, buf, 5));
+    TEST_ASSERT_EQUAL_INT(1, mem_file.reads);
+    TEST_ASSERT_EQUAL_INT(2995, logo_stream_read_chars(stream, buf + 5, 2995));
+    TEST_ASSERT_EQUAL_MEMORY(content, buf, 3000);
+    TEST_ASSERT_EQUAL_INT(2, mem_file.reads);
+    TEST_ASSERT_EQUAL_INT(0, logo_stream_read_chars(stream, buf, 10));
+    close_mem_file(stream);
+}
+
+void test_buffered_writes_reach_the_backend_in_runs(void)
+{
+    LogoStream *stream = open_mem_file("");
+
+    for (int i = 0; i < 100; i++)
+    {
+        logo_stream_write(stream, "0123456789");
+    }
+    TEST_ASSERT_EQUAL_INT(1000, logo_stream_get_write_pos(stream));
+    TEST_ASSERT_EQUAL_INT(1000 / LOGO_STREAM_BUFFER_SIZE, mem_file.writes);
+
+    logo_stream_flush(stream);
+    TEST_ASSERT_EQUAL_INT(1000 / LOGO_STREAM_BUFFER_SIZE + 1, mem_file.writes);
+    TEST_ASSERT_EQUAL_INT(1, mem_file.flushes);
+    TEST_ASSERT_EQUAL_INT(1000, mem_file.size);
+    TEST_ASSERT_EQUAL_MEMORY("0123456789", mem_file.data + 990, 10);
+    close_mem_file(stream);
+}
+
+void test_buffered_read_sees_unflushed_writes(void)
+{
+    LogoStream *stream = open_mem_file("ab");
+
+    TEST_ASSERT_EQUAL_INT('a', logo_stream_read_char(stream));
+    TEST_ASSERT_EQUAL_INT('b', logo_stream_read_char(stream));
+    logo_stream_write(stream, "cd");
+    TEST_ASSERT_EQUAL_INT(4, logo_stream_get_length(stream));
+    TEST_ASSERT_EQUAL_INT('c', logo_stream_read_char(stream));
+
+    // Overwriting bytes already buffered for reading replaces them
+    TEST_ASSERT_TRUE(logo_stream_set_write_pos(stream, 3));
+    logo_stream_write(stream, "D");
+    TEST_ASSERT_EQUAL_INT('D', logo_stream_read_char(stream));
+    TEST_ASSERT_TRUE(logo_stream_set_read_pos(stream, 0));
+    logo_stream_write(stream, "E");
+    char buf[8];
+    TEST_ASSERT_EQUAL_INT(5, logo_stream_read_chars(stream, buf, sizeof(buf)));
+    TEST_ASSERT_EQUAL_MEMORY("abcDE", buf, 5);
+    close_mem_file(stream);
+}
+
+void test_buffered_seek_within_the_buffer_stays_in_memory(void)
+{
+    LogoStream *stream = open_mem_file("hello, world");
+
+    TEST_ASSERT_EQUAL_INT('h', logo_stream_read_char(stream));
+    TEST_ASSERT_TRUE(logo_stream_set_read_pos(stream, 7));
+    TEST_ASSERT_EQUAL_INT('w', logo_stream_read_char(stream));
+    TEST_ASSERT_TRUE(logo_stream_set_read_pos(stream, 0));
+    TEST_ASSERT_EQUAL_INT('h', logo_stream_read_char(stream));
+    TEST_ASSERT_EQUAL_INT(1, mem_file.reads);
+
+    TEST_ASSERT_FALSE(logo_stream_set_read_pos(stream, 13));
+    TEST_ASSERT_EQUAL_INT(1, logo_stream_get_read_pos(stream));
+    close_mem_file(stream);
+}
+
+void test_buffered_write_error_surfaces_on_flush(void)
+{
+    LogoStream *stream = open_mem_file("");
+    mem_file.capacity = 8;
+
+    logo_stream_write(stream, "0123456789");
+    TEST_ASSERT_FALSE(logo_stream_has_write_error(stream));
+    logo_stream_flush(stream);
+    TEST_ASSERT_TRUE(logo_stream_has_write_error(stream));
+    TEST_ASSERT_TRUE(stream->disk_full);
+
+    logo_stream_clear_write_error(stream);
+    logo_stream_flush(stream);
+    TEST_ASSERT_FALSE(logo_stream_has_write_error(stream));
+    close_mem_file(stream);
+}
+
+void test_buffered_leaves_an_unseekable_stream_alone(void)
+{
+    TEST_ASSERT_TRUE(logo_stream_buffered(&test_stream) == &test_stream);
+    TEST_ASSERT_NULL(logo_stream_buffered(NULL));
+}
+
 //============================================================================
 // Main
 //============================================================================
@@ -197,6 +479,16 @@ int main(void)
     RUN_TEST(test_clear_write_error_with_null_stream);
     RUN_TEST(test_has_write_error_with_null_stream);
     RUN_TEST(test_write_error_flag_persistence);
+
+    // logo_stream_buffered tests
+    RUN_TEST(test_buffered_read_char_reads_the_backend_a_buffer_at_a_time);
+    RUN_TEST(test_buffered_read_line_matches_the_backends);
+    RUN_TEST(test_buffered_read_chars_copies_large_reads_directly);
+    RUN_TEST(test_buffered_writes_reach_the_backend_in_runs);
+    RUN_TEST(test_buffered_read_sees_unflushed_writes);
+    RUN_TEST(test_buffered_seek_within_the_buffer_stays_in_memory);
+    RUN_TEST(test_buffered_write_error_surfaces_on_flush);
+    RUN_TEST(test_buffered_leaves_an_unseekable_stream_alone);
     
     return UNITY_END();
 }
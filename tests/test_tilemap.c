@@ -380,6 +380,379 @@ void test_sampler_fills_a_partial_span_only(void)
     TEST_ASSERT_EQUAL_UINT8(0xEE, row[0]);
 }
 
+//==========================================================================
+// Layers
+//==========================================================================
+
+// A tile of one colour, with the pixels of its left half `hole` instead
+static void fill_slot_halves(int slot, uint8_t colour, uint8_t hole)
+{
+    int size = tilemap_tile_size();
+    uint8_t *px = tilemap_slot_pixels(slot);
+    TEST_ASSERT_NOT_NULL(px);
+    for (int i = 0; i < size * size; i++)
+    {
+        px[i] = (i % size < size / 2) ? hole : colour;
+    }
+    tilemap_slot_fill_done(slot);
+}
+
+void test_layers_are_chosen_within_range(void)
+{
+    TEST_ASSERT_EQUAL(0, tilemap_layer());
+    TEST_ASSERT_TRUE(tilemap_select_layer(TILEMAP_LAYERS - 1));
+    TEST_ASSERT_EQUAL(TILEMAP_LAYERS - 1, tilemap_layer());
+    TEST_ASSERT_FALSE(tilemap_select_layer(TILEMAP_LAYERS));
+    TEST_ASSERT_FALSE(tilemap_select_layer(-1));
+    TEST_ASSERT_EQUAL(TILEMAP_LAYERS - 1, tilemap_layer());
+}
+
+void test_each_layer_has_its_own_map_and_scroll(void)
+{
+    TEST_ASSERT_TRUE(tilemap_new_tiles(8));
+    TEST_ASSERT_TRUE(tilemap_new_map(4, 2));
+    TEST_ASSERT_TRUE(tilemap_set_cell(3, 1, 5));
+    tilemap_set_scroll(1, 2);
+
+    TEST_ASSERT_TRUE(tilemap_select_layer(1));
+    TEST_ASSERT_EQUAL(0, tilemap_cols());
+    TEST_ASSERT_TRUE(tilemap_new_map(2, 3));
+    TEST_ASSERT_TRUE(tilemap_set_cell(1, 2, 6));
+    int x, y;
+    tilemap_get_scroll(&x, &y);
+    TEST_ASSERT_EQUAL(0, x);
+
+    TEST_ASSERT_TRUE(tilemap_select_layer(0));
+    TEST_ASSERT_EQUAL(4, tilemap_cols());
+    TEST_ASSERT_EQUAL(5, tilemap_cell(3, 1));
+    tilemap_get_scroll(&x, &y);
+    TEST_ASSERT_EQUAL(1, x);
+    TEST_ASSERT_EQUAL(2, y);
+}
+
+void test_resizing_a_layer_keeps_the_layers_above(void)
+{
+    TEST_ASSERT_TRUE(tilemap_new_tiles(8));
+    TEST_ASSERT_TRUE(tilemap_select_layer(2));
+    TEST_ASSERT_TRUE(tilemap_new_map(3, 3));
+    TEST_ASSERT_TRUE(tilemap_set_cell(2, 2, 9));
+
+    TEST_ASSERT_TRUE(tilemap_select_layer(0));
+    TEST_ASSERT_TRUE(tilemap_new_map(10, 10));
+    TEST_ASSERT_TRUE(tilemap_new_map(2, 2));
+
+    TEST_ASSERT_TRUE(tilemap_select_layer(2));
+    TEST_ASSERT_EQUAL(9, tilemap_cell(2, 2));
+    TEST_ASSERT_EQUAL(0, tilemap_cell(0, 0));
+}
+
+void test_layers_share_the_map_pool(void)
+{
+    int capacity = tilemap_map_capacity();
+    TEST_ASSERT_TRUE(tilemap_new_map(capacity / 2, 1));
+
+    TEST_ASSERT_TRUE(tilemap_select_layer(1));
+    TEST_ASSERT_FALSE(tilemap_new_map(capacity / 2 + 1, 1));
+    TEST_ASSERT_EQUAL(0, tilemap_cols());
+    TEST_ASSERT_TRUE(tilemap_new_map(capacity - capacity / 2, 1));
+}
+
+void test_upper_layer_draws_over_the_base_where_it_has_tiles(void)
+{
+    TEST_ASSERT_TRUE(tilemap_new_tiles(8));
+    TEST_ASSERT_TRUE(tilemap_new_map(3, 1));
+    fill_slot(1, 0);
+    fill_slot(2, 128);
+    for (int c = 0; c < 3; c++)
+    {
+        TEST_ASSERT_TRUE(tilemap_set_cell(c, 0, 1));
+    }
+
+    TEST_ASSERT_TRUE(tilemap_select_layer(1));
+    TEST_ASSERT_TRUE(tilemap_new_map(3, 1));
+    TEST_ASSERT_TRUE(tilemap_set_cell(1, 0, 2));    // Cell 0 elsewhere: see-through
+
+    uint8_t row[24];
+    tilemap_fill_row(row, 0, 0, 24, 200);
+    for (int x = 0; x < 8; x++)
+    {
+        TEST_ASSERT_EQUAL_UINT8(slot_pixel(0, x, 0), row[x]);
+        TEST_ASSERT_EQUAL_UINT8(slot_pixel(128, x, 0), row[8 + x]);
+        TEST_ASSERT_EQUAL_UINT8(slot_pixel(0, x, 0), row[16 + x]);
+    }
+}
+
+void test_layers_scroll_independently(void)
+{
+    TEST_ASSERT_TRUE(tilemap_new_tiles(8));
+    fill_slot_halves(1, 10, 11);
+    fill_slot_halves(2, 20, 21);
+    TEST_ASSERT_TRUE(tilemap_new_map(1, 1));
+    TEST_ASSERT_TRUE(tilemap_set_cell(0, 0, 1));
+
+    TEST_ASSERT_TRUE(tilemap_select_layer(1));
+    TEST_ASSERT_TRUE(tilemap_new_map(2, 1));
+    TEST_ASSERT_TRUE(tilemap_set_cell(0, 0, 2));
+    tilemap_set_scroll(4, 0);   // Half a tile along; the base stays put
+
+    uint8_t row[16];
+    tilemap_fill_row(row, 0, 0, 16, 200);
+    for (int x = 0; x < 4; x++)
+    {
+        TEST_ASSERT_EQUAL_UINT8(20, row[x]);        // Right half of slot 2
+    }
+    for (int x = 4; x < 12; x++)
+    {
+        TEST_ASSERT_EQUAL_UINT8(x % 8 < 4 ? 11 : 10, row[x]);  // Base through cell 0
+    }
+    for (int x = 12; x < 16; x++)
+    {
+        TEST_ASSERT_EQUAL_UINT8(21, row[x]);        // Left half, wrapped
+    }
+}
+
+void test_transparent_index_shows_the_layer_beneath(void)
+{
+    TEST_ASSERT_TRUE(tilemap_new_tiles(8));
+    fill_slot_halves(1, 10, 11);
+    fill_slot_halves(2, 20, 0);     // A left half of index 0
+    TEST_ASSERT_TRUE(tilemap_new_map(1, 1));
+    TEST_ASSERT_TRUE(tilemap_set_cell(0, 0, 1));
+
+    TEST_ASSERT_TRUE(tilemap_select_layer(1));
+    TEST_ASSERT_TRUE(tilemap_new_map(1, 1));
+    TEST_ASSERT_TRUE(tilemap_set_cell(0, 0, 2));
+
+    // Opaque: the hole is drawn as index 0
+    uint8_t row[8];
+    tilemap_fill_row(row, 0, 0, 8, 200);
+    TEST_ASSERT_EQUAL_UINT8(0, row[0]);
+    TEST_ASSERT_EQUAL(-1, tilemap_transparent());
+
+    // Keyed after the tile was filled: the bank is rescanned
+    tilemap_set_transparent(0);
+    TEST_ASSERT_EQUAL(0, tilemap_transparent());
+    tilemap_fill_row(row, 0, 0, 8, 200);
+    for (int x = 0; x < 4; x++)
+    {
+        TEST_ASSERT_EQUAL_UINT8(11, row[x]);
+        TEST_ASSERT_EQUAL_UINT8(20, row[4 + x]);
+    }
+
+    // And a tile filled after the key is scanned as it is filled
+    fill_slot_halves(2, 30, 0);
+    tilemap_fill_row(row, 0, 0, 8, 200);
+    TEST_ASSERT_EQUAL_UINT8(11, row[0]);
+    TEST_ASSERT_EQUAL_UINT8(30, row[7]);
+
+    tilemap_set_transparent(-1);
+    tilemap_fill_row(row, 0, 0, 8, 200);
+    TEST_ASSERT_EQUAL_UINT8(0, row[0]);
+}
+
+void test_transparent_index_on_the_base_shows_the_background(void)
+{
+    TEST_ASSERT_TRUE(tilemap_new_tiles(8));
+    fill_slot_halves(1, 10, 3);
+    TEST_ASSERT_TRUE(tilemap_new_map(1, 1));
+    TEST_ASSERT_TRUE(tilemap_set_cell(0, 0, 1));
+    tilemap_set_transparent(3);
+
+    uint8_t row[8];
+    tilemap_fill_row(row, 0, 0, 8, 200);
+    TEST_ASSERT_EQUAL_UINT8(200, row[0]);
+    TEST_ASSERT_EQUAL_UINT8(10, row[7]);
+}
+
+//==========================================================================
+// Bulk updates
+//==========================================================================
+
+// Number the cells of the current layer's map 1, 2, 3... in row-major order
+static void number_cells(void)
+{
+    int n = 1;
+    for (int r = 0; r < tilemap_rows(); r++)
+    {
+        for (int c = 0; c < tilemap_cols(); c++)
+        {
+            TEST_ASSERT_TRUE(tilemap_set_cell(c, r, (uint8_t)n++));
+        }
+    }
+}
+
+void test_fill_rect_sets_only_the_rectangle(void)
+{
+    TEST_ASSERT_TRUE(tilemap_new_map(5, 4));
+    TEST_ASSERT_TRUE(tilemap_fill_rect(1, 1, 3, 2, 9));
+
+    TEST_ASSERT_EQUAL(9, tilemap_cell(1, 1));
+    TEST_ASSERT_EQUAL(9, tilemap_cell(3, 2));
+    TEST_ASSERT_EQUAL(0, tilemap_cell(0, 1));
+    TEST_ASSERT_EQUAL(0, tilemap_cell(4, 1));
+    TEST_ASSERT_EQUAL(0, tilemap_cell(1, 0));
+    TEST_ASSERT_EQUAL(0, tilemap_cell(1, 3));
+}
+
+void test_fill_rect_outside_the_map_changes_nothing(void)
+{
+    TEST_ASSERT_TRUE(tilemap_new_map(5, 4));
+
+    TEST_ASSERT_FALSE(tilemap_fill_rect(3, 0, 3, 1, 9));   // one column too wide
+    TEST_ASSERT_FALSE(tilemap_fill_rect(0, 3, 1, 2, 9));   // one row too tall
+    TEST_ASSERT_FALSE(tilemap_fill_rect(-1, 0, 1, 1, 9));
+    TEST_ASSERT_FALSE(tilemap_fill_rect(0, 0, 0, 1, 9));
+    TEST_ASSERT_EQUAL(0, tilemap_cell(3, 0));
+    TEST_ASSERT_EQUAL(0, tilemap_cell(0, 3));
+
+    TEST_ASSERT_TRUE(tilemap_fill_rect(0, 0, 5, 4, 9));    // the whole map
+}
+
+void test_copy_rect_handles_overlap_in_either_direction(void)
+{
+    TEST_ASSERT_TRUE(tilemap_new_map(4, 4));
+    number_cells();
+
+    // Down and right by one: every source cell is read before it is written
+    TEST_ASSERT_TRUE(tilemap_copy_rect(0, 0, 3, 3, 1, 1));
+    TEST_ASSERT_EQUAL(1, tilemap_cell(1, 1));
+    TEST_ASSERT_EQUAL(3, tilemap_cell(3, 1));
+    TEST_ASSERT_EQUAL(11, tilemap_cell(3, 3));
+    TEST_ASSERT_EQUAL(1, tilemap_cell(0, 0));              // source corner kept
+
+    number_cells();
+    // Up and left by one
+    TEST_ASSERT_TRUE(tilemap_copy_rect(1, 1, 3, 3, 0, 0));
+    TEST_ASSERT_EQUAL(6, tilemap_cell(0, 0));
+    TEST_ASSERT_EQUAL(16, tilemap_cell(2, 2));
+    TEST_ASSERT_EQUAL(16, tilemap_cell(3, 3));
+
+    TEST_ASSERT_FALSE(tilemap_copy_rect(0, 0, 2, 2, 3, 0));
+}
+
+void test_shift_rotates_the_map_both_ways(void)
+{
+    TEST_ASSERT_TRUE(tilemap_new_map(3, 2));
+    number_cells();                                         // 1 2 3 / 4 5 6
+
+    tilemap_shift(1, 0);                                    // 3 1 2 / 6 4 5
+    TEST_ASSERT_EQUAL(3, tilemap_cell(0, 0));
+    TEST_ASSERT_EQUAL(2, tilemap_cell(2, 0));
+    TEST_ASSERT_EQUAL(6, tilemap_cell(0, 1));
+
+    tilemap_shift(0, -1);                                   // 6 4 5 / 3 1 2
+    TEST_ASSERT_EQUAL(6, tilemap_cell(0, 0));
+    TEST_ASSERT_EQUAL(2, tilemap_cell(2, 1));
+
+    // Whole turns are no move at all
+    tilemap_shift(-4, 5);                                   // left 1, down 1
+    TEST_ASSERT_EQUAL(1, tilemap_cell(0, 0));
+    TEST_ASSERT_EQUAL(6, tilemap_cell(2, 1));
+}
+
+void test_bulk_updates_address_the_current_layer(void)
+{
+    TEST_ASSERT_TRUE(tilemap_new_map(2, 2));
+    TEST_ASSERT_TRUE(tilemap_select_layer(1));
+    TEST_ASSERT_TRUE(tilemap_new_map(2, 2));
+    TEST_ASSERT_TRUE(tilemap_fill_rect(0, 0, 2, 2, 4));
+
+    TEST_ASSERT_TRUE(tilemap_select_layer(0));
+    TEST_ASSERT_EQUAL(0, tilemap_cell(1, 1));
+}
+
+//==========================================================================
+// Animation
+//==========================================================================
+
+void test_animated_slot_is_drawn_as_its_frames_in_turn(void)
+{
+    TEST_ASSERT_TRUE(tilemap_new_tiles(8));
+    fill_slot(1, 10);
+    fill_slot(2, 100);
+    fill_slot(3, 150);
+    TEST_ASSERT_TRUE(tilemap_new_map(1, 1));
+    TEST_ASSERT_TRUE(tilemap_set_cell(0, 0, 1));
+
+    uint8_t frames[] = {2, 3};
+    TEST_ASSERT_TRUE(tilemap_animate(1, frames, 2, 100));
+    TEST_ASSERT_EQUAL(2, tilemap_frame(1));
+
+    uint8_t row[8];
+    tilemap_fill_row(row, 0, 0, 8, 0);
+    TEST_ASSERT_EQUAL_UINT8(slot_pixel(100, 0, 0), row[0]);
+
+    uint8_t changed[TILEMAP_MAX_SLOTS / 8] = {0};
+    TEST_ASSERT_FALSE(tilemap_tick(99, changed));
+    TEST_ASSERT_TRUE(tilemap_tick(1, changed));
+    TEST_ASSERT_EQUAL_UINT8(0x02, changed[0]);             // slot 1
+    tilemap_fill_row(row, 0, 0, 8, 0);
+    TEST_ASSERT_EQUAL_UINT8(slot_pixel(150, 0, 0), row[0]);
+
+    // The map still names the slot, not the frame
+    TEST_ASSERT_EQUAL(1, tilemap_cell(0, 0));
+}
+
+void test_a_long_tick_skips_frames(void)
+{
+    TEST_ASSERT_TRUE(tilemap_new_tiles(8));
+    uint8_t frames[] = {2, 3, 4};
+    TEST_ASSERT_TRUE(tilemap_animate(1, frames, 3, 50));
+
+    uint8_t changed[TILEMAP_MAX_SLOTS / 8] = {0};
+    // Three steps and 20 ms over: round to the first frame again, which is
+    // no change to draw
+    TEST_ASSERT_FALSE(tilemap_tick(170, changed));
+    TEST_ASSERT_EQUAL(2, tilemap_frame(1));
+    TEST_ASSERT_TRUE(tilemap_tick(30, changed));
+    TEST_ASSERT_EQUAL(3, tilemap_frame(1));
+}
+
+void test_a_frame_of_0_blinks_the_slot_out(void)
+{
+    TEST_ASSERT_TRUE(tilemap_new_tiles(8));
+    fill_slot(1, 10);
+    TEST_ASSERT_TRUE(tilemap_new_map(1, 1));
+    TEST_ASSERT_TRUE(tilemap_set_cell(0, 0, 1));
+
+    uint8_t frames[] = {1, 0};
+    TEST_ASSERT_TRUE(tilemap_animate(1, frames, 2, 10));
+    uint8_t changed[TILEMAP_MAX_SLOTS / 8] = {0};
+    TEST_ASSERT_TRUE(tilemap_tick(10, changed));
+
+    uint8_t row[8];
+    tilemap_fill_row(row, 0, 0, 8, 77);
+    TEST_ASSERT_EQUAL_UINT8(77, row[3]);
+}
+
+void test_animations_stop_and_are_bounded(void)
+{
+    TEST_ASSERT_TRUE(tilemap_new_tiles(8));
+    uint8_t frames[TILEMAP_ANIM_FRAMES + 1] = {2, 3};
+
+    TEST_ASSERT_FALSE(tilemap_animate(0, frames, 2, 10));  // background
+    TEST_ASSERT_FALSE(tilemap_animate(tilemap_bank_slots(), frames, 2, 10));
+    TEST_ASSERT_FALSE(tilemap_animate(1, frames, TILEMAP_ANIM_FRAMES + 1, 10));
+
+    // Stopping frees the entry and shows the slot itself again
+    TEST_ASSERT_TRUE(tilemap_animate(1, frames, 2, 10));
+    TEST_ASSERT_TRUE(tilemap_animate(1, frames, 0, 10));
+    TEST_ASSERT_EQUAL(1, tilemap_frame(1));
+
+    for (int slot = 1; slot <= TILEMAP_ANIMS; slot++)
+    {
+        TEST_ASSERT_TRUE(tilemap_animate(slot, frames, 2, 10));
+    }
+    TEST_ASSERT_FALSE(tilemap_animate(TILEMAP_ANIMS + 1, frames, 2, 10));
+    TEST_ASSERT_TRUE(tilemap_animate(1, frames, 2, 20));   // re-animating is no new entry
+
+    // A new bank stops them all
+    TEST_ASSERT_TRUE(tilemap_new_tiles(8));
+    TEST_ASSERT_EQUAL(1, tilemap_frame(1));
+    uint8_t changed[TILEMAP_MAX_SLOTS / 8] = {0};
+    TEST_ASSERT_FALSE(tilemap_tick(1000, changed));
+}
+
 //==========================================================================
 // Lifecycle
 //==========================================================================
@@ -409,6 +782,20 @@ void test_reset_forgets_bank_map_and_view(void)
     TEST_ASSERT_EQUAL(0, w);
 }
 
+void test_reset_forgets_every_layer(void)
+{
+    TEST_ASSERT_TRUE(tilemap_select_layer(2));
+    TEST_ASSERT_TRUE(tilemap_new_map(2, 2));
+    tilemap_set_transparent(7);
+
+    tilemap_reset();
+
+    TEST_ASSERT_EQUAL(0, tilemap_layer());
+    TEST_ASSERT_TRUE(tilemap_select_layer(2));
+    TEST_ASSERT_EQUAL(0, tilemap_cols());
+    TEST_ASSERT_EQUAL(-1, tilemap_transparent());
+}
+
 int main(void)
 {
     UNITY_BEGIN();
@@ -435,7 +822,28 @@ int main(void)
     RUN_TEST(test_sampler_handles_16_pixel_tiles);
     RUN_TEST(test_sampler_fills_a_partial_span_only);
 
+    RUN_TEST(test_layers_are_chosen_within_range);
+    RUN_TEST(test_each_layer_has_its_own_map_and_scroll);
+    RUN_TEST(test_resizing_a_layer_keeps_the_layers_above);
+    RUN_TEST(test_layers_share_the_map_pool);
+    RUN_TEST(test_upper_layer_draws_over_the_base_where_it_has_tiles);
+    RUN_TEST(test_layers_scroll_independently);
+    RUN_TEST(test_transparent_index_shows_the_layer_beneath);
+    RUN_TEST(test_transparent_index_on_the_base_shows_the_background);
+
+    RUN_TEST(test_fill_rect_sets_only_the_rectangle);
+    RUN_TEST(test_fill_rect_outside_the_map_changes_nothing);
+    RUN_TEST(test_copy_rect_handles_overlap_in_either_direction);
+    RUN_TEST(test_shift_rotates_the_map_both_ways);
+    RUN_TEST(test_bulk_updates_address_the_current_layer);
+
+    RUN_TEST(test_animated_slot_is_drawn_as_its_frames_in_turn);
+    RUN_TEST(test_a_long_tick_skips_frames);
+    RUN_TEST(test_a_frame_of_0_blinks_the_slot_out);
+    RUN_TEST(test_animations_stop_and_are_bounded);
+
     RUN_TEST(test_reset_forgets_bank_map_and_view);
+    RUN_TEST(test_reset_forgets_every_layer);
 
     return UNITY_END();
 }
@@ -9,12 +9,15 @@
 #include "core/token_source.h"
 #include "core/memory.h"
 #include "core/lexer.h"
+#include "core/limits.h"
+#include "core/atom_memo.h"
 
 #include <string.h>
 
 void setUp(void)
 {
     logo_mem_init();
+    token_source_flush_code();
 }
 
 void tearDown(void)
@@ -1100,6 +1103,387 @@ void test_comment_word_skips_to_end_of_line(void)
     }
 }
 
+//============================================================================
+// Compiled procedure code
+//
+// A compiled line must give exactly the tokens its list gives, on every
+// path: the run that registers it, the run that compiles it, the runs that
+// use the ops, and any run where the ops and the list disagree.
+//============================================================================
+
+static Node word(const char *text)
+{
+    return mem_atom(text, strlen(text));
+}
+
+// A line with every shape node_iter_next treats specially: a newline, a
+// comment, a sublist, binary and unary minus, a numeral, a quoted word and
+// a variable.
+static Node mixed_line(void)
+{
+    Node sub = mem_cons(word("fd"), mem_cons(word("10"), NODE_NIL));
+    return mem_cons(word("make"),
+           mem_cons(word("\"x"),
+           mem_cons(word(":y"),
+           mem_cons(word("-"),
+           mem_cons(word("1.5"),
+           mem_cons(mem_newline_marker,
+           mem_cons(word(";skip"),
+           mem_cons(word("this"),
+           mem_cons(mem_newline_marker,
+           mem_cons(word("-"),
+           mem_cons(word("2"),
+           mem_cons(sub,
+           mem_cons(NODE_NIL, NODE_NIL)))))))))))));
+}
+
+// Compare a run of `list` as code with the plain walk, token by token.
+static void assert_code_matches_walk(Node list)
+{
+    TokenSource walk, code;
+    token_source_init_list(&walk, list);
+    token_source_init_code(&code, list);
+    for (;;)
+    {
+        Token a = token_source_next(&walk);
+        Token b = token_source_next(&code);
+        TEST_ASSERT_EQUAL_INT(a.type, b.type);
+        TEST_ASSERT_EQUAL_size_t(a.length, b.length);
+        TEST_ASSERT_EQUAL_PTR(a.start, b.start);
+        TEST_ASSERT_EQUAL_UINT32(a.atom, b.atom);
+        if (a.type == TOKEN_LEFT_BRACKET)
+        {
+            TEST_ASSERT_EQUAL_UINT32(token_source_get_sublist(&walk),
+                                     token_source_get_sublist(&code));
+            token_source_consume_sublist(&walk);
+            token_source_consume_sublist(&code);
+        }
+        if (a.type == TOKEN_EOF)
+            break;
+    }
+}
+
+void test_code_line_compiles_on_second_run(void)
+{
+    Node line = mixed_line();
+
+    assert_code_matches_walk(line);
+    TEST_ASSERT_EQUAL_INT(0, token_source_code_used());
+
+    assert_code_matches_walk(line);
+    int used = token_source_code_used();
+    TEST_ASSERT_GREATER_THAN_INT(0, used);
+
+    // Later runs use the ops and add none.
+    assert_code_matches_walk(line);
+    TEST_ASSERT_EQUAL_INT(used, token_source_code_used());
+}
+
+void test_code_sublist_compiles_when_run(void)
+{
+    Node sub = mem_cons(word("fd"), mem_cons(word("10"), NODE_NIL));
+    Node line = mem_cons(word("repeat"), mem_cons(word("4"), mem_cons(sub, NODE_NIL)));
+    TokenSource ts;
+    token_source_init_code(&ts, line);
+    token_source_init_code(&ts, line);
+    int used = token_source_code_used();
+
+    // A list that is not part of a compiled line is only ever walked.
+    Node data = mem_cons(word("fd"), mem_cons(word("10"), NODE_NIL));
+    token_source_init_list(&ts, data);
+    TEST_ASSERT_EQUAL_INT(used, token_source_code_used());
+
+    token_source_init_list(&ts, sub);
+    TEST_ASSERT_GREATER_THAN_INT(used, token_source_code_used());
+    assert_token(token_source_next(&ts), TOKEN_WORD, "fd");
+    assert_token(token_source_next(&ts), TOKEN_NUMBER, "10");
+    assert_token_type(token_source_next(&ts), TOKEN_EOF);
+}
+
+void test_code_follows_an_edited_list(void)
+{
+    // The list is the source of truth: `.setfirst` on a compiled line is
+    // seen on its next run, and so is a cell spliced out of it.
+    Node line = mixed_line();
+    assert_code_matches_walk(line);
+    assert_code_matches_walk(line);
+
+    TEST_ASSERT_TRUE(mem_set_car(line, word("print")));
+    Node third = mem_cdr(mem_cdr(line));
+    TEST_ASSERT_TRUE(mem_set_cdr(mem_cdr(line), mem_cdr(third)));
+    assert_code_matches_walk(line);
+
+    TokenSource ts;
+    token_source_init_code(&ts, line);
+    assert_token(token_source_next(&ts), TOKEN_WORD, "print");
+    assert_token(token_source_next(&ts), TOKEN_QUOTED, "\"x");
+    assert_token(token_source_next(&ts), TOKEN_MINUS, "-");
+}
+
+void test_code_flushed_under_a_running_line(void)
+{
+    // A flush leaves a running line's op index behind, and the next line to
+    // compile reuses those ops. The running line must still read its list.
+    Node line = mixed_line();
+    TokenSource ts;
+    token_source_init_code(&ts, line);
+    token_source_init_code(&ts, line);
+    assert_token(token_source_next(&ts), TOKEN_WORD, "make");
+
+    token_source_flush_code();
+    Node other = mem_cons(word("print"), mem_cons(word("\"other"), NODE_NIL));
+    TokenSource ots;
+    token_source_init_code(&ots, other);
+    token_source_init_code(&ots, other);
+    TEST_ASSERT_GREATER_THAN_INT(0, token_source_code_used());
+
+    assert_token(token_source_next(&ts), TOKEN_QUOTED, "\"x");
+    assert_token(token_source_next(&ts), TOKEN_COLON, ":y");
+    assert_token(token_source_next(&ts), TOKEN_MINUS, "-");
+    assert_token(token_source_next(&ts), TOKEN_NUMBER, "1.5");
+}
+
+void test_code_caches_numbers_and_names(void)
+{
+    Node line = mem_cons(word("1.5"), mem_cons(word("\"abc"),
+                mem_cons(word(":x"), NODE_NIL)));
+    TokenSource ts;
+    float n;
+
+    // Walked: no op, so the numeral is read from its atom.
+    token_source_init_code(&ts, line);
+    Token t = token_source_next(&ts);
+    TEST_ASSERT_TRUE(token_source_number(&ts, t, &n));
+    TEST_ASSERT_EQUAL_FLOAT(1.5f, n);
+
+    token_source_init_code(&ts, line);
+    t = token_source_next(&ts);
+    TEST_ASSERT_TRUE(token_source_number(&ts, t, &n));
+    TEST_ASSERT_EQUAL_FLOAT(1.5f, n);
+    TEST_ASSERT_EQUAL_UINT32(NODE_NIL, token_source_name(&ts, t));
+
+    t = token_source_next(&ts);
+    TEST_ASSERT_FALSE(token_source_number(&ts, t, &n));
+    TEST_ASSERT_EQUAL_UINT32(word("abc"), token_source_name(&ts, t));
+
+    t = token_source_next(&ts);
+    TEST_ASSERT_EQUAL_UINT32(word("x"), token_source_name(&ts, t));
+}
+
+void test_walked_numeral_value_is_cached_on_its_atom(void)
+{
+    Node line = mem_cons(word("88"), mem_cons(word("2.5"), NODE_NIL));
+    TokenSource ts;
+    float n;
+
+    token_source_init_list(&ts, line);
+    Token t = token_source_next(&ts);
+    TEST_ASSERT_TRUE(token_source_number(&ts, t, &n));
+    TEST_ASSERT_EQUAL_FLOAT(88.0f, n);
+
+    // A whole number is kept in the memo; a fraction is parsed each time
+    const char *str;
+    size_t len;
+    uint8_t *memo = NULL;
+    TEST_ASSERT_TRUE(mem_word_view(word("88"), &str, &len, &memo));
+    TEST_ASSERT_TRUE(atom_memo_number(mem_atom_memo_get(memo), &n));
+    TEST_ASSERT_EQUAL_FLOAT(88.0f, n);
+
+    t = token_source_next(&ts);
+    TEST_ASSERT_TRUE(token_source_number(&ts, t, &n));
+    TEST_ASSERT_EQUAL_FLOAT(2.5f, n);
+    TEST_ASSERT_TRUE(mem_word_view(word("2.5"), &str, &len, &memo));
+    TEST_ASSERT_FALSE(atom_memo_number(mem_atom_memo_get(memo), &n));
+}
+
+// Build a list from words separated by single spaces.
+static Node words(const char *text)
+{
+    Node list = NODE_NIL;
+    Node tail = NODE_NIL;
+    while (*text)
+    {
+        const char *end = strchr(text, ' ');
+        size_t len = end ? (size_t)(end - text) : strlen(text);
+        mem_list_append(&list, &tail, mem_atom(text, len));
+        text += len;
+        while (*text == ' ')
+            text++;
+    }
+    return list;
+}
+
+// Compile `text` and read its first token as a number.
+static Token first_compiled(const char *text, TokenSource *ts)
+{
+    Node line = words(text);
+    token_source_init_code(ts, line);
+    token_source_init_code(ts, line);
+    return token_source_next(ts);
+}
+
+void test_code_folds_a_literal_expression(void)
+{
+    TokenSource ts;
+    float n;
+
+    Token t = first_compiled("360 / 8 * 2 + 1", &ts);
+    TEST_ASSERT_EQUAL_INT(TOKEN_NUMBER, t.type);
+    TEST_ASSERT_TRUE(token_source_number(&ts, t, &n));
+    TEST_ASSERT_EQUAL_FLOAT(91.0f, n);
+    assert_token_type(token_source_next(&ts), TOKEN_EOF);
+
+    // Precedence is kept: 1 + (2 * 3) folds whole, from the inside out
+    t = first_compiled("1 + 2 * 3 - 4", &ts);
+    TEST_ASSERT_TRUE(token_source_number(&ts, t, &n));
+    TEST_ASSERT_EQUAL_FLOAT(3.0f, n);
+    assert_token_type(token_source_next(&ts), TOKEN_EOF);
+}
+
+void test_code_folds_only_where_the_parse_agrees(void)
+{
+    TokenSource ts;
+    float n;
+
+    // :x / 2 * 3 is (:x / 2) * 3: nothing folds
+    Token t = first_compiled(":x / 2 * 3", &ts);
+    assert_token_type(token_source_next(&ts), TOKEN_DIVIDE);
+    t = token_source_next(&ts);
+    TEST_ASSERT_TRUE(token_source_number(&ts, t, &n));
+    TEST_ASSERT_EQUAL_FLOAT(2.0f, n);
+    assert_token_type(token_source_next(&ts), TOKEN_MULTIPLY);
+
+    // A unary minus takes the 2 alone, so - 2 + 3 stays as written...
+    t = first_compiled("- 2 + 3", &ts);
+    TEST_ASSERT_EQUAL_INT(TOKEN_UNARY_MINUS, t.type);
+    t = token_source_next(&ts);
+    TEST_ASSERT_TRUE(token_source_number(&ts, t, &n));
+    TEST_ASSERT_EQUAL_FLOAT(2.0f, n);
+    assert_token_type(token_source_next(&ts), TOKEN_PLUS);
+
+    // ...but - 2 * 3 is the same either way
+    t = first_compiled("- 2 * 3", &ts);
+    t = token_source_next(&ts);
+    TEST_ASSERT_TRUE(token_source_number(&ts, t, &n));
+    TEST_ASSERT_EQUAL_FLOAT(6.0f, n);
+    assert_token_type(token_source_next(&ts), TOKEN_EOF);
+
+    // Division by zero is left for the evaluator to report
+    t = first_compiled("1 / 0", &ts);
+    assert_token(t, TOKEN_NUMBER, "1");
+    assert_token_type(token_source_next(&ts), TOKEN_DIVIDE);
+}
+
+void test_code_fold_follows_an_edited_list(void)
+{
+    Node line = words("fd 3 * 4");
+    TokenSource ts;
+    float n;
+    token_source_init_code(&ts, line);
+    token_source_init_code(&ts, line);
+
+    TEST_ASSERT_TRUE(mem_set_car(mem_cdr(mem_cdr(mem_cdr(line))), word(":x")));
+    token_source_init_code(&ts, line);
+    assert_token(token_source_next(&ts), TOKEN_WORD, "fd");
+    Token t = token_source_next(&ts);
+    assert_token(t, TOKEN_NUMBER, "3");
+    TEST_ASSERT_TRUE(token_source_number(&ts, t, &n));
+    TEST_ASSERT_EQUAL_FLOAT(3.0f, n);
+    assert_token_type(token_source_next(&ts), TOKEN_MULTIPLY);
+    assert_token(token_source_next(&ts), TOKEN_COLON, ":x");
+}
+
+// A line of twenty `fd`s, twenty ops.
+static Node fd_line(void)
+{
+    Node line = NODE_NIL;
+    for (int j = 0; j < 20; j++)
+        line = mem_cons(word("fd"), line);
+    return line;
+}
+
+void test_code_arena_full_evicts_cold_lines(void)
+{
+    // Each line runs twice and is not run again, as setup code does. Once
+    // the arena is full the old lines have gone cold and give way, so the
+    // newest line always compiles.
+    Node first = fd_line();
+    assert_code_matches_walk(first);
+    assert_code_matches_walk(first);
+    uint32_t compiled, walked, compiled_after, walked_after, evicted;
+    for (int i = 0; i < LOGO_CODE_OPS / 20 + 4; i++)
+    {
+        Node line = fd_line();
+        assert_code_matches_walk(line);
+        token_source_code_stats(&compiled, &walked, &evicted);
+        assert_code_matches_walk(line);
+        token_source_code_stats(&compiled_after, &walked_after, &evicted);
+        TEST_ASSERT_EQUAL_UINT32(compiled + 1, compiled_after);
+        TEST_ASSERT_LESS_THAN_INT(LOGO_CODE_OPS, token_source_code_used());
+    }
+
+    // The first line lost its ops to the others but kept its slot, so it
+    // compiles again as soon as it runs, taking the ops of one gone cold.
+    token_source_code_stats(&compiled, &walked, &evicted);
+    assert_code_matches_walk(first);
+    token_source_code_stats(&compiled_after, &walked_after, &evicted);
+    TEST_ASSERT_EQUAL_UINT32(compiled + 1, compiled_after);
+    TEST_ASSERT_LESS_THAN_INT(LOGO_CODE_OPS, token_source_code_used());
+}
+
+void test_code_arena_loop_bigger_than_arena_does_not_thrash(void)
+{
+    // A loop of more lines than fit: what compiled stays compiled, what did
+    // not walks, and no pass recompiles anything.
+    enum { LINES = LOGO_CODE_OPS / 20 + 4 };
+    static Node lines[LINES];
+    for (int i = 0; i < LINES; i++)
+        lines[i] = fd_line();
+    for (int pass = 0; pass < 2; pass++)
+        for (int i = 0; i < LINES; i++)
+            assert_code_matches_walk(lines[i]);
+
+    int used = token_source_code_used();
+    uint32_t compiled, walked, evicted, evicted_before;
+    token_source_code_stats(&compiled, &walked, &evicted_before);
+    for (int pass = 0; pass < 3; pass++)
+        for (int i = 0; i < LINES; i++)
+            assert_code_matches_walk(lines[i]);
+
+    uint32_t compiled_after, walked_after;
+    token_source_code_stats(&compiled_after, &walked_after, &evicted);
+    TEST_ASSERT_EQUAL_INT(used, token_source_code_used());
+    TEST_ASSERT_EQUAL_UINT32(evicted_before, evicted);
+    TEST_ASSERT_EQUAL_UINT32(3u * (uint32_t)(LOGO_CODE_OPS / 21), compiled_after - compiled);
+    TEST_ASSERT_EQUAL_UINT32(3u * LINES, (compiled_after - compiled) + (walked_after - walked));
+}
+
+void test_code_arena_hot_loop_displaces_a_finished_one(void)
+{
+    // A title screen's loop fills the arena; once the game's loop runs
+    // instead, the title lines go cold and the game's lines take the room.
+    enum { LINES = LOGO_CODE_OPS / 20 + 4 };
+    static Node title[LINES], game[LINES];
+    for (int i = 0; i < LINES; i++)
+    {
+        title[i] = fd_line();
+        game[i] = fd_line();
+    }
+    for (int pass = 0; pass < 3; pass++)
+        for (int i = 0; i < LINES; i++)
+            assert_code_matches_walk(title[i]);
+    for (int pass = 0; pass < 6; pass++)
+        for (int i = 0; i < LINES; i++)
+            assert_code_matches_walk(game[i]);
+
+    uint32_t compiled, walked, compiled_after, walked_after, evicted;
+    token_source_code_stats(&compiled, &walked, &evicted);
+    for (int i = 0; i < LINES; i++)
+        assert_code_matches_walk(game[i]);
+    token_source_code_stats(&compiled_after, &walked_after, &evicted);
+    TEST_ASSERT_EQUAL_UINT32((uint32_t)(LOGO_CODE_OPS / 21), compiled_after - compiled);
+}
+
 int main(void)
 {
     UNITY_BEGIN();
@@ -1175,5 +1559,19 @@ int main(void)
     RUN_TEST(test_collected_atom_does_not_leave_its_class_behind);
     RUN_TEST(test_comment_word_skips_to_end_of_line);
 
+    // Compiled procedure code
+    RUN_TEST(test_code_line_compiles_on_second_run);
+    RUN_TEST(test_code_sublist_compiles_when_run);
+    RUN_TEST(test_code_follows_an_edited_list);
+    RUN_TEST(test_code_flushed_under_a_running_line);
+    RUN_TEST(test_code_caches_numbers_and_names);
+    RUN_TEST(test_walked_numeral_value_is_cached_on_its_atom);
+    RUN_TEST(test_code_folds_a_literal_expression);
+    RUN_TEST(test_code_folds_only_where_the_parse_agrees);
+    RUN_TEST(test_code_fold_follows_an_edited_list);
+    RUN_TEST(test_code_arena_full_evicts_cold_lines);
+    RUN_TEST(test_code_arena_loop_bigger_than_arena_does_not_thrash);
+    RUN_TEST(test_code_arena_hot_loop_displaces_a_finished_one);
+
     return UNITY_END();
 }
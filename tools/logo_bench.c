@@ -0,0 +1,100 @@
+//
+//  Pico Logo
+//  Copyright 2026 Blair Leduc. See LICENSE for details.
+//
+//  logo-bench CLI:
+//    logo-bench [-n runs] [-w warmup] [-s setup-line] [--json] <file.logo> <line>
+//
+//  Loads <file.logo> against the mock device and times <line> (usually a
+//  procedure name, e.g. play.frame). The file's `startup` is not run: a game's
+//  usually starts its main loop. See tools/logo_bench.h.
+//
+
+#include "logo_bench.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static int usage(const char *argv0)
+{
+    fprintf(stderr,
+            "usage: %s [-n runs] [-w warmup] [-s setup-line] [--json] <file.logo> <line>\n"
+            "  -n runs         timed runs (default 100)\n"
+            "  -w warmup       untimed runs first (default 10)\n"
+            "  -s setup-line   run once after loading, before the warm-up\n"
+            "  --json          write the report as one JSON object\n",
+            argv0);
+    return 2;
+}
+
+// A non-negative count, or -1
+static int parse_count(const char *s)
+{
+    char *end;
+    long v = strtol(s, &end, 10);
+    if (*s == '\0' || *end != '\0' || v < 0 || v > 1000000000L)
+        return -1;
+    return (int)v;
+}
+
+int main(int argc, char **argv)
+{
+    LogoBenchConfig config = {
+        .source = NULL,
+        .setup = NULL,
+        .run = NULL,
+        .warmup = 10,
+        .iterations = 100,
+    };
+    bool json = false;
+
+    int i = 1;
+    for (; i < argc && argv[i][0] == '-'; i++)
+    {
+        if (strcmp(argv[i], "--json") == 0)
+        {
+            json = true;
+        }
+        else if (i + 1 < argc && strcmp(argv[i], "-n") == 0)
+        {
+            config.iterations = parse_count(argv[++i]);
+            if (config.iterations < 1)
+                return usage(argv[0]);
+        }
+        else if (i + 1 < argc && strcmp(argv[i], "-w") == 0)
+        {
+            config.warmup = parse_count(argv[++i]);
+            if (config.warmup < 0)
+                return usage(argv[0]);
+        }
+        else if (i + 1 < argc && strcmp(argv[i], "-s") == 0)
+        {
+            config.setup = argv[++i];
+        }
+        else
+        {
+            return usage(argv[0]);
+        }
+    }
+    if (argc - i != 2)
+    {
+        return usage(argv[0]);
+    }
+    config.source = argv[i];
+    config.run = argv[i + 1];
+
+    LogoBenchResult result;
+    char err[512];
+    if (!logo_bench_measure(&config, &result, err, sizeof(err)))
+    {
+        fprintf(stderr, "logo-bench: %s\n", err);
+        return 1;
+    }
+
+    if (json)
+        logo_bench_write_json(stdout, &config, &result);
+    else
+        logo_bench_write_text(stdout, &config, &result);
+    return 0;
+}
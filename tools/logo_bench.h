@@ -0,0 +1,73 @@
+//
+//  Pico Logo
+//  Copyright 2026 Blair Leduc. See LICENSE for details.
+//
+//  logo-bench: time any Logo program on the host against the mock device.
+//
+//  Loads a .logo file the way `load` does, runs an optional setup line, runs
+//  the measured line a number of times untimed to warm the caches, then
+//  times each further run alone. The report gives min/median/p95/p99 of the
+//  per-run wall time, and the cells, atoms and blobs allocated and the
+//  collections run, per run. As JSON it is one object, so reports taken at
+//  two commits can be diffed or fed to a dashboard.
+//
+//  The mock device records drawing rather than rasterising it (the method of
+//  docs/interpreter-throughput-design.md §2.1), and its clock stands still,
+//  so `sync` and `wait` never sleep: the figures are interpreting alone.
+//
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+typedef struct
+{
+    const char *source;    // .logo file to load
+    const char *setup;     // Line run once after loading, or NULL
+    const char *run;       // Line measured, e.g. "play.frame"
+    int warmup;            // Untimed runs first
+    int iterations;        // Timed runs
+} LogoBenchConfig;
+
+typedef struct
+{
+    int iterations;
+    double min_us, median_us, p95_us, p99_us, mean_us, max_us;
+    double cells, atoms, blobs, gcs;   // Means per timed run
+} LogoBenchResult;
+
+// Reset the interpreter and wire it to the mock device.
+void logo_bench_init(void);
+
+// Load `path` as `load` would: definitions are defined, other lines run.
+// Returns false with a reason in `errbuf` on a missing file or a failing
+// line.
+bool logo_bench_load(const char *path, char *errbuf, size_t errbuf_len);
+
+// Run `line` once. Returns false with the Logo error in `errbuf`.
+bool logo_bench_run_line(const char *line, char *errbuf, size_t errbuf_len);
+
+// Load, set up, warm and time per `config`. Returns false with a reason in
+// `errbuf` if anything fails, including any timed run.
+bool logo_bench_measure(const LogoBenchConfig *config, LogoBenchResult *out,
+                        char *errbuf, size_t errbuf_len);
+
+// The `p`th percentile (0-100) of `n` ascending samples, by nearest rank.
+double logo_bench_percentile(const double *sorted, int n, double p);
+
+// Write the report, as text or as one JSON object.
+void logo_bench_write_text(FILE *f, const LogoBenchConfig *config,
+                           const LogoBenchResult *result);
+void logo_bench_write_json(FILE *f, const LogoBenchConfig *config,
+                           const LogoBenchResult *result);
+
+#ifdef __cplusplus
+}
+#endif
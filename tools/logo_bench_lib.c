@@ -0,0 +1,254 @@
+//
+//  Pico Logo
+//  Copyright 2026 Blair Leduc. See LICENSE for details.
+//
+//  logo-bench core: load, run and time Logo against the mock device, and
+//  write the report. Host-only (uses clock_gettime). See tools/logo_bench.h.
+//
+
+#include "logo_bench.h"
+
+#include "core/error.h"
+#include "core/eval.h"
+#include "core/lexer.h"
+#include "core/loader.h"
+#include "core/memory.h"
+#include "core/primitives.h"
+#include "core/procedures.h"
+#include "core/properties.h"
+#include "core/variables.h"
+#include "devices/io.h"
+#include "tests/mock_device.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+static LogoIO bench_io;
+
+static double now_us(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e6 + (double)ts.tv_nsec / 1e3;
+}
+
+// "where: why", or "why" alone when `where` is NULL
+static void set_err(char *errbuf, size_t errbuf_len, const char *where, const char *why)
+{
+    if (errbuf == NULL || errbuf_len == 0)
+        return;
+    if (where != NULL)
+        snprintf(errbuf, errbuf_len, "%s: %s", where, why);
+    else
+        snprintf(errbuf, errbuf_len, "%s", why);
+}
+
+void logo_bench_init(void)
+{
+    logo_mem_init();
+    primitives_init();
+    procedures_init();
+    variables_init();
+    properties_init();
+
+    mock_device_init();
+    logo_io_init(&bench_io, mock_device_get_console(), NULL, NULL);
+    primitives_set_io(&bench_io);
+}
+
+bool logo_bench_run_line(const char *line, char *errbuf, size_t errbuf_len)
+{
+    Lexer lexer;
+    Evaluator eval;
+    lexer_init(&lexer, line);
+    eval_init(&eval, &lexer);
+    eval_set_frames(&eval, proc_get_frame_stack());
+
+    while (!eval_at_end(&eval))
+    {
+        Result r = eval_instruction(&eval);
+        if (r.status == RESULT_ERROR)
+        {
+            set_err(errbuf, errbuf_len, line, error_format(r));
+            return false;
+        }
+        if (r.status == RESULT_THROW)
+        {
+            set_err(errbuf, errbuf_len, line, "uncaught throw");
+            return false;
+        }
+    }
+    return true;
+}
+
+// The next line of a host file, for loader_run
+static int read_file_line(void *context, char *line, size_t size)
+{
+    if (fgets(line, (int)size, (FILE *)context) == NULL)
+        return -1;
+    return (int)strlen(line);
+}
+
+bool logo_bench_load(const char *path, char *errbuf, size_t errbuf_len)
+{
+    FILE *f = fopen(path, "rb");
+    if (f == NULL)
+    {
+        set_err(errbuf, errbuf_len, path, "cannot open");
+        return false;
+    }
+
+    // The same single pass `load` makes, without the file device under it
+    LoadStats stats;
+    Result r = loader_run(read_file_line, f, &stats);
+    fclose(f);
+
+    if (r.status == RESULT_ERROR)
+    {
+        set_err(errbuf, errbuf_len, path, error_format(r));
+        return false;
+    }
+    if (r.status == RESULT_THROW)
+    {
+        set_err(errbuf, errbuf_len, path, "uncaught throw");
+        return false;
+    }
+    return true;
+}
+
+static int compare_doubles(const void *a, const void *b)
+{
+    double x = *(const double *)a;
+    double y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+double logo_bench_percentile(const double *sorted, int n, double p)
+{
+    if (n <= 0)
+        return 0.0;
+    int rank = (int)ceil(p / 100.0 * n);
+    if (rank < 1)
+        rank = 1;
+    if (rank > n)
+        rank = n;
+    return sorted[rank - 1];
+}
+
+bool logo_bench_measure(const LogoBenchConfig *config, LogoBenchResult *out,
+                        char *errbuf, size_t errbuf_len)
+{
+    memset(out, 0, sizeof(*out));
+    if (config->iterations < 1)
+    {
+        set_err(errbuf, errbuf_len, NULL, "iterations must be at least 1");
+        return false;
+    }
+
+    logo_bench_init();
+    if (!logo_bench_load(config->source, errbuf, errbuf_len))
+        return false;
+    if (config->setup != NULL && !logo_bench_run_line(config->setup, errbuf, errbuf_len))
+        return false;
+    for (int i = 0; i < config->warmup; i++)
+    {
+        if (!logo_bench_run_line(config->run, errbuf, errbuf_len))
+            return false;
+    }
+
+    double *samples = (double *)malloc(sizeof(double) * (size_t)config->iterations);
+    if (samples == NULL)
+    {
+        set_err(errbuf, errbuf_len, NULL, "out of host memory");
+        return false;
+    }
+
+    size_t cells = mem_cells_allocated();
+    size_t atoms = mem_atoms_interned();
+    size_t blobs = mem_blobs_allocated();
+    size_t gcs = mem_gc_count();
+    double sum = 0.0;
+
+    for (int i = 0; i < config->iterations; i++)
+    {
+        double t0 = now_us();
+        bool ok = logo_bench_run_line(config->run, errbuf, errbuf_len);
+        samples[i] = now_us() - t0;
+        if (!ok)
+        {
+            free(samples);
+            return false;
+        }
+        sum += samples[i];
+    }
+
+    int n = config->iterations;
+    out->iterations = n;
+    out->cells = (double)(mem_cells_allocated() - cells) / n;
+    out->atoms = (double)(mem_atoms_interned() - atoms) / n;
+    out->blobs = (double)(mem_blobs_allocated() - blobs) / n;
+    out->gcs = (double)(mem_gc_count() - gcs) / n;
+
+    qsort(samples, (size_t)n, sizeof(double), compare_doubles);
+    out->min_us = samples[0];
+    out->median_us = logo_bench_percentile(samples, n, 50.0);
+    out->p95_us = logo_bench_percentile(samples, n, 95.0);
+    out->p99_us = logo_bench_percentile(samples, n, 99.0);
+    out->max_us = samples[n - 1];
+    out->mean_us = sum / n;
+    free(samples);
+    return true;
+}
+
+void logo_bench_write_text(FILE *f, const LogoBenchConfig *config,
+                           const LogoBenchResult *result)
+{
+    fprintf(f, "%s: %s, %d runs after %d warm-up\n",
+            config->source, config->run, result->iterations, config->warmup);
+    fprintf(f, "  time us   min %.1f  median %.1f  p95 %.1f  p99 %.1f  mean %.1f  max %.1f\n",
+            result->min_us, result->median_us, result->p95_us, result->p99_us,
+            result->mean_us, result->max_us);
+    fprintf(f, "  per run   cells %.1f  atoms %.1f  blobs %.1f  gcs %.3f\n",
+            result->cells, result->atoms, result->blobs, result->gcs);
+}
+
+// A JSON string: quotes, backslashes and control characters escaped
+static void write_json_string(FILE *f, const char *s)
+{
+    fputc('"', f);
+    for (; s != NULL && *s; s++)
+    {
+        unsigned char c = (unsigned char)*s;
+        if (c == '"' || c == '\\')
+            fprintf(f, "\\%c", c);
+        else if (c < 0x20)
+            fprintf(f, "\\u%04x", c);
+        else
+            fputc(c, f);
+    }
+    fputc('"', f);
+}
+
+void logo_bench_write_json(FILE *f, const LogoBenchConfig *config,
+                           const LogoBenchResult *result)
+{
+    fputs("{\"source\": ", f);
+    write_json_string(f, config->source);
+    fputs(", \"setup\": ", f);
+    if (config->setup != NULL)
+        write_json_string(f, config->setup);
+    else
+        fputs("null", f);
+    fputs(", \"run\": ", f);
+    write_json_string(f, config->run);
+    fprintf(f, ", \"warmup\": %d, \"iterations\": %d", config->warmup, result->iterations);
+    fprintf(f, ", \"time_us\": {\"min\": %.3f, \"median\": %.3f, \"p95\": %.3f, "
+               "\"p99\": %.3f, \"mean\": %.3f, \"max\": %.3f}",
+            result->min_us, result->median_us, result->p95_us, result->p99_us,
+            result->mean_us, result->max_us);
+    fprintf(f, ", \"per_iteration\": {\"cells\": %.3f, \"atoms\": %.3f, "
+               "\"blobs\": %.3f, \"gcs\": %.3f}}\n",
+            result->cells, result->atoms, result->blobs, result->gcs);
+}